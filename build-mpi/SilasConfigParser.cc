@@ -67,7 +67,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2020                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -123,12 +123,15 @@ yyerror(const string& message);
 void
 parse_config(const std::string& filename);
 
+extern void
+begin_hypothesis(const std::string& name);
+
 extern int
 yylex();
 
 
 
-#line 132 "SilasConfigParser.cc" /* yacc.c:339  */
+#line 135 "SilasConfigParser.cc" /* yacc.c:339  */
 
 # ifndef YY_NULLPTR
 #  if defined __cplusplus && 201103L <= __cplusplus
@@ -221,7 +224,7 @@ int yyparse (void);
 
 /* Copy the second part of user declarations.  */
 
-#line 225 "SilasConfigParser.cc" /* yacc.c:358  */
+#line 228 "SilasConfigParser.cc" /* yacc.c:358  */
 
 #ifdef short
 # undef short
@@ -463,16 +466,16 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  6
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   34
+#define YYLAST   53
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  23
+#define YYNTOKENS  26
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  16
+#define YYNNTS  20
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  31
+#define YYNRULES  39
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  50
+#define YYNSTATES  64
 
 /* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
    by yylex, with out-of-bounds checking.  */
@@ -489,8 +492,7 @@ static const yytype_uint8 yytranslate[] =
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,    22,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,    25,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -499,6 +501,7 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    22,     2,    23,    24,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -518,12 +521,12 @@ static const yytype_uint8 yytranslate[] =
 
 #if YYDEBUG
   /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint8 yyrline[] =
+static const yytype_uint16 yyrline[] =
 {
-       0,    73,    73,    78,    77,    88,    89,    93,   109,   117,
-     125,   133,   141,   145,   146,   150,   151,   152,   153,   157,
-     164,   171,   177,   181,   186,   192,   196,   205,   212,   219,
-     223,   227
+       0,    76,    76,    77,    82,    81,    92,    93,    97,   113,
+     121,   129,   137,   145,   149,   150,   154,   155,   156,   157,
+     161,   162,   167,   166,   173,   180,   187,   191,   201,   207,
+     211,   216,   222,   226,   232,   244,   251,   258,   262,   266
 };
 #endif
 
@@ -536,9 +539,10 @@ static const char *const yytname[] =
   "SC_IDLE_OVERHEAD", "SC_CUT", "SC_NOOP_THRESHOLD", "SC_OPTION",
   "SC_STRING", "SC_NUMBER", "SC_UNSIGNED", "SC_INTEGER", "SC_REAL",
   "SC_MESSAGE", "SC_MODEL", "SC_REGION", "SC_SCALE", "SC_SKIP_THRESHOLD",
-  "SC_SIZE", "SC_TAG", "SC_RELATION", "'\"'", "$accept", "Config", "Model",
-  "$@1", "ModelOptions", "ModelOption", "Hypothesis", "HypothesisItem",
-  "Region", "Balance", "Cut", "MessageOption", "Scale", "Relation",
+  "SC_SIZE", "SC_TAG", "SC_RELATION", "'{'", "'}'", "'~'", "'\"'",
+  "$accept", "Config", "Model", "$@1", "ModelOptions", "ModelOption",
+  "Hypothesis", "HypothesisItem", "Batch", "BatchItem", "$@2", "Region",
+  "RegionPattern", "Balance", "Cut", "MessageOption", "Scale", "Relation",
   "String", "Number", YY_NULLPTR
 };
 #endif
@@ -550,14 +554,14 @@ static const yytype_uint16 yytoknum[] =
 {
        0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
      265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,    34
+     275,   276,   123,   125,   126,    34
 };
 # endif
 
-#define YYPACT_NINF -18
+#define YYPACT_NINF -11
 
 #define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-18)))
+  (!!((Yystate) == (-11)))
 
 #define YYTABLE_NINF -1
 
@@ -568,11 +572,13 @@ static const yytype_uint16 yytoknum[] =
      STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      -7,    -9,    15,     3,    14,   -18,   -18,    11,   -12,    11,
-       3,   -18,   -18,   -18,   -18,     7,    -2,    -9,   -18,     2,
-     -18,     6,   -18,   -18,   -18,     6,     6,    -9,     6,    -2,
-     -18,   -18,     9,     9,   -18,   -18,   -18,   -18,   -18,   -18,
-     -18,    -9,   -18,   -18,   -18,    20,    21,   -18,   -18,   -18
+      -8,    -5,    27,     2,    23,   -11,   -11,    20,    -4,    20,
+      -2,   -11,   -11,   -11,   -11,    17,     6,    10,   -11,   -11,
+      19,    -5,   -11,    18,    18,   -11,    -5,   -11,    21,   -11,
+     -11,    18,    18,    -5,    18,     6,   -11,    -5,   -11,    24,
+      24,   -11,   -11,   -11,   -11,   -11,   -11,   -11,   -11,   -11,
+     -11,    -5,   -11,   -11,   -11,   -11,    33,    35,     2,   -11,
+     -11,   -11,    -1,   -11
 };
 
   /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -580,25 +586,27 @@ static const yytype_int8 yypact[] =
      means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       0,     0,     0,    18,     0,     3,     1,     0,     0,     0,
-       2,    13,    15,    16,    17,     0,    12,     0,    20,    25,
-      21,     0,    14,    28,     8,     0,     0,     0,     0,     4,
-       5,    19,     0,     0,    22,    29,    30,    31,    26,    11,
-       9,     0,    10,     6,    27,     0,     0,     7,    23,    24
+       0,     0,     0,    19,     0,     4,     1,     0,     0,     0,
+       2,    14,    16,    17,    18,     0,    13,     0,    26,    27,
+      32,     0,    28,     0,     0,    15,     3,    20,     0,    36,
+       9,     0,     0,     0,     0,     5,     6,     0,    24,     0,
+       0,    29,    37,    38,    39,    33,    34,    21,    22,    12,
+      10,     0,    11,     7,    25,    35,     0,     0,    19,     8,
+      30,    31,     0,    23
 };
 
   /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -18,   -18,   -18,   -18,   -18,    -1,   -18,    23,    17,   -18,
-     -18,   -18,   -18,     1,   -17,   -14
+     -11,   -11,   -11,   -11,   -11,    12,    -9,   -10,   -11,    22,
+     -11,    32,    41,   -11,   -11,   -11,   -11,    13,     0,    -6
 };
 
   /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     2,     3,    16,    29,    30,    10,    11,    18,    12,
-      13,    34,    14,    45,     5,    38
+      -1,     2,     3,    16,    35,    36,    10,    11,    26,    27,
+      58,    18,    19,    12,    13,    41,    14,    56,    28,    45
 };
 
   /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -606,47 +614,53 @@ static const yytype_int8 yydefgoto[] =
      number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      31,    24,    19,    25,    17,    26,    27,     7,     1,     8,
-      41,    39,    40,     4,    42,     6,    28,    35,    36,    37,
-       9,    32,    33,    15,    47,    20,    21,    17,    43,    23,
-      44,    48,    49,    22,    46
+      25,     5,     7,     7,     8,     8,     7,     1,     8,    30,
+      20,    31,    21,    32,    33,     9,     9,    38,    46,     9,
+       4,    38,    63,     4,    34,    49,    50,     6,    52,    42,
+      43,    44,    15,    51,    37,     4,    17,    54,    39,    40,
+      22,    23,    29,    48,    60,    55,    61,    53,    47,    62,
+      24,    59,    25,    57
 };
 
 static const yytype_uint8 yycheck[] =
 {
-      17,     3,    14,     5,    16,     7,     8,     4,    15,     6,
-      27,    25,    26,    22,    28,     0,    18,    11,    12,    13,
-      17,    19,    20,     9,    41,     8,     9,    16,    29,    22,
-      21,    11,    11,    10,    33
+      10,     1,     4,     4,     6,     6,     4,    15,     6,     3,
+      14,     5,    16,     7,     8,    17,    17,    17,    24,    17,
+      25,    21,    23,    25,    18,    31,    32,     0,    34,    11,
+      12,    13,     9,    33,    24,    25,    16,    37,    19,    20,
+       8,     9,    25,    22,    11,    21,    11,    35,    26,    58,
+       9,    51,    62,    40
 };
 
   /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
      symbol of state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
-       0,    15,    24,    25,    22,    37,     0,     4,     6,    17,
-      29,    30,    32,    33,    35,     9,    26,    16,    31,    14,
-      31,    31,    30,    22,     3,     5,     7,     8,    18,    27,
-      28,    37,    19,    20,    34,    11,    12,    13,    38,    38,
-      38,    37,    38,    28,    21,    36,    36,    37,    11,    11
+       0,    15,    27,    28,    25,    44,     0,     4,     6,    17,
+      32,    33,    39,    40,    42,     9,    29,    16,    37,    38,
+      14,    16,    37,    37,    38,    33,    34,    35,    44,    25,
+       3,     5,     7,     8,    18,    30,    31,    24,    44,    19,
+      20,    41,    11,    12,    13,    45,    45,    35,    22,    45,
+      45,    44,    45,    31,    44,    21,    43,    43,    36,    44,
+      11,    11,    32,    23
 };
 
   /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
 static const yytype_uint8 yyr1[] =
 {
-       0,    23,    24,    26,    25,    27,    27,    28,    28,    28,
-      28,    28,    28,    29,    29,    30,    30,    30,    30,    31,
-      32,    33,    33,    34,    34,    34,    35,    36,    37,    38,
-      38,    38
+       0,    26,    27,    27,    29,    28,    30,    30,    31,    31,
+      31,    31,    31,    31,    32,    32,    33,    33,    33,    33,
+      34,    34,    36,    35,    37,    38,    39,    39,    40,    40,
+      41,    41,    41,    42,    42,    43,    44,    45,    45,    45
 };
 
   /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
 static const yytype_uint8 yyr2[] =
 {
-       0,     2,     2,     0,     4,     1,     2,     3,     1,     2,
-       2,     2,     0,     1,     2,     1,     1,     1,     0,     2,
-       2,     2,     3,     3,     3,     0,     3,     1,     3,     1,
-       1,     1
+       0,     2,     2,     3,     0,     4,     1,     2,     3,     1,
+       2,     2,     2,     0,     1,     2,     1,     1,     1,     0,
+       1,     2,     0,     5,     2,     3,     2,     2,     2,     3,
+       3,     3,     0,     3,     3,     1,     3,     1,     1,     1
 };
 
 
@@ -1322,8 +1336,8 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 3:
-#line 78 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+        case 4:
+#line 82 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         model = silas::ModelFactory::create_model((yyvsp[0]));
                         if (!model)
@@ -1331,11 +1345,11 @@ yyreduce:
                             yyerror("Undefined model!");
                         }
                     }
-#line 1335 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1349 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 7:
-#line 94 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 8:
+#line 98 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         if (!model)
                         {
@@ -1351,11 +1365,11 @@ yyreduce:
                             model->set_option((yyvsp[-1]), (yyvsp[0]));
                         }
                     }
-#line 1355 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1369 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 8:
-#line 110 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 9:
+#line 114 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         if (!model)
                         {
@@ -1363,11 +1377,11 @@ yyreduce:
                         }
                         model->set_flag("aggregate idle");
                     }
-#line 1367 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1381 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 9:
-#line 118 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 10:
+#line 122 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         if (!model)
                         {
@@ -1375,11 +1389,11 @@ yyreduce:
                         }
                         model->set_option("noop threshold", (yyvsp[0]));
                     }
-#line 1379 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1393 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 10:
-#line 126 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 11:
+#line 130 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         if (!model)
                         {
@@ -1387,11 +1401,11 @@ yyreduce:
                         }
                         model->set_option("skip threshold", (yyvsp[0]));
                     }
-#line 1391 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1405 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 11:
-#line 134 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 12:
+#line 138 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         if (!model)
                         {
@@ -1399,106 +1413,146 @@ yyreduce:
                         }
                         model->set_option("idle overhead", (yyvsp[0]));
                     }
-#line 1403 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1417 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 19:
-#line 158 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 22:
+#line 167 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+    {
+                        begin_hypothesis((yyvsp[-1]));
+                    }
+#line 1425 "SilasConfigParser.cc" /* yacc.c:1646  */
+    break;
+
+  case 24:
+#line 174 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         (yyval) = (yyvsp[0]);
                     }
-#line 1411 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1433 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 20:
-#line 165 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 25:
+#line 181 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+    {
+                        (yyval) = (yyvsp[0]);
+                    }
+#line 1441 "SilasConfigParser.cc" /* yacc.c:1646  */
+    break;
+
+  case 26:
+#line 188 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         balancer->register_region((yyvsp[0]));
                     }
-#line 1419 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1449 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 21:
-#line 172 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 27:
+#line 192 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+    {
+                        if (!balancer->register_region_pattern((yyvsp[0])))
+                        {
+                            yyerror("Invalid regular expression!");
+                        }
+                    }
+#line 1460 "SilasConfigParser.cc" /* yacc.c:1646  */
+    break;
+
+  case 28:
+#line 202 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         /*
                         surgeon->register_region($2);
                         */
                     }
-#line 1429 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1470 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 23:
-#line 182 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 30:
+#line 212 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         unsigned int value = strtol((yyvsp[0]).c_str(), NULL, 0);
                         message_surgeon->register_message_size((yyvsp[-1]), value);
                     }
-#line 1438 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1479 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 24:
-#line 187 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 31:
+#line 217 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         unsigned int value = strtol((yyvsp[0]).c_str(), NULL, 0);
 
                         message_surgeon->register_message_tag((yyvsp[-1]), value);
                     }
-#line 1448 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1489 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 26:
-#line 197 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 33:
+#line 227 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         double value = strtod((yyvsp[0]).c_str(), NULL);
 
                         rescaler->register_region((yyvsp[-1]).c_str(),value);
                     }
-#line 1458 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1499 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 27:
-#line 206 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 34:
+#line 233 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+    {
+                        double value = strtod((yyvsp[0]).c_str(), NULL);
+
+                        if (!rescaler->register_region_pattern((yyvsp[-1]), value))
+                        {
+                            yyerror("Invalid regular expression!");
+                        }
+                    }
+#line 1512 "SilasConfigParser.cc" /* yacc.c:1646  */
+    break;
+
+  case 35:
+#line 245 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         (yyval) = (yyvsp[0]);
                     }
-#line 1466 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1520 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 28:
-#line 213 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 36:
+#line 252 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         (yyval) = (yyvsp[-1]);
                     }
-#line 1474 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1528 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 29:
-#line 220 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 37:
+#line 259 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         (yyval) = (yyvsp[0]);
                     }
-#line 1482 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1536 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 30:
-#line 224 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 38:
+#line 263 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         (yyval) = (yyvsp[0]);
                     }
-#line 1490 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1544 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
-  case 31:
-#line 228 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
+  case 39:
+#line 267 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1646  */
     {
                         (yyval) = (yyvsp[0]);
                     }
-#line 1498 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1552 "SilasConfigParser.cc" /* yacc.c:1646  */
     break;
 
 
-#line 1502 "SilasConfigParser.cc" /* yacc.c:1646  */
+#line 1556 "SilasConfigParser.cc" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1726,7 +1780,7 @@ yyreturn:
 #endif
   return yyresult;
 }
-#line 234 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1906  */
+#line 273 "../../build-mpi/../src/silas/SilasConfigParser.yy" /* yacc.c:1906  */
 
 
 
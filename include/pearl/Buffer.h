@@ -19,6 +19,7 @@
 
 
 #include <cstddef>
+#include <string>
 
 #include <pearl/pearl_types.h>
 
@@ -115,6 +116,21 @@ class Buffer
         void
         put_double(const double& value);
 
+        void
+        put_uint32_array(const uint32_t* values,
+                         std::size_t     count);
+
+        void
+        put_uint64_array(const uint64_t* values,
+                         std::size_t     count);
+
+        void
+        put_double_array(const double* values,
+                         std::size_t   count);
+
+        void
+        put_string(const std::string& value);
+
         void
         put_event(const Event& event);
 
@@ -146,6 +162,21 @@ class Buffer
         double
         get_double();
 
+        void
+        get_uint32_array(uint32_t*   values,
+                         std::size_t count);
+
+        void
+        get_uint64_array(uint64_t*   values,
+                         std::size_t count);
+
+        void
+        get_double_array(double*     values,
+                         std::size_t count);
+
+        std::string
+        get_string();
+
         RemoteEvent
         get_event(const GlobalDefs& defs);
 
@@ -190,6 +221,16 @@ class Buffer
         void
         get_value(T& value);
 
+        template< typename T >
+        void
+        put_array(const T*    values,
+                  std::size_t count);
+
+        template< typename T >
+        void
+        get_array(T*          values,
+                  std::size_t count);
+
         /// @}
 };
 }    // namespace pearl
@@ -18,6 +18,7 @@
 #define PEARL_CALLBACKMANAGER_H
 
 
+#include <bitset>
 #include <map>
 #include <vector>
 
@@ -70,6 +71,12 @@ class CallbackManager
         /// @name Notification routines
         /// @{
 
+        bool
+        has_callbacks(event_t event_type) const;
+
+        const std::bitset< NUM_EVENT_TYPES >&
+        get_event_types() const;
+
         void
         notify(const Event&  event,
                CallbackData* data) const;
@@ -86,19 +93,63 @@ class CallbackManager
         /// Container type for callback objects
         typedef std::vector< CallbackPtr > callback_container;
 
-        /// Container type for trace event |-@> callback mapping
-        typedef std::map< event_t, callback_container > event_cb_map;
+        /// Container type for the callbacks of a single trace event type;
+        /// the callback objects are owned by CallbackManager::m_callbacks
+        typedef std::vector< Callback* > dispatch_container;
 
         /// Container type for user event |-@> callback mapping
         typedef std::map< int, callback_container > user_cb_map;
 
+        /// Trace event callback objects (in order of registration)
+        callback_container m_callbacks;
+
+        /// Trace event callback dispatch table, indexed by event type
+        dispatch_container m_event_cbs[NUM_EVENT_TYPES];
 
-        /// Trace event callback mapping
-        event_cb_map m_event_cbs;
+        /// Event types with at least one registered callback
+        std::bitset< NUM_EVENT_TYPES > m_event_mask;
 
         /// User event callback mapping
         user_cb_map m_user_cbs;
+
+
+        void
+        add_callback(event_t   event_type,
+                     Callback* callback);
 };
+
+
+// --- Inline methods -------------------------------------------------------
+
+/// @brief Check for trace event callbacks.
+///
+/// Returns whether at least one callback is registered for the given trace
+/// event type.  This allows replay loops to skip the notification of events
+/// without callbacks entirely.
+///
+/// @param  event_type  Event type (no event group)
+/// @return @em true if a callback is registered, @em false otherwise
+///
+inline bool
+CallbackManager::has_callbacks(event_t event_type) const
+{
+    return m_event_mask.test(event_type);
+}
+
+
+/// @brief Get set of subscribed event types.
+///
+/// Returns the set of trace event types for which at least one callback is
+/// registered.  This set can be used to skip over irrelevant events when
+/// searching the event trace (see LocalTrace::find()).
+///
+/// @return Set of event types (no event groups)
+///
+inline const std::bitset< NUM_EVENT_TYPES >&
+CallbackManager::get_event_types() const
+{
+    return m_event_mask;
+}
 }    // namespace pearl
 
 
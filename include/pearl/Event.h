@@ -166,6 +166,9 @@ class Event
         /// @name Access local event information
         /// @{
 
+        event_t
+        get_type() const;
+
         Callpath*
         get_cnode() const;
 
@@ -68,6 +68,47 @@ class PEARL_NOPAD_ATTR Event_rep
         virtual
         ~Event_rep();
 
+        /// @}
+        /// @name Memory allocation operators
+        /// @{
+
+        /// @brief Allocate storage space.
+        ///
+        /// Allocates @p objectSize bytes of storage space for an event
+        /// representation.  While a trace is read via TraceArchive::getTrace,
+        /// the storage is taken from the memory arena of the corresponding
+        /// LocalTrace object, otherwise the SmallObject allocator is used.
+        ///
+        /// @param objectSize
+        ///     Size of the requested memory block (in bytes)
+        ///
+        /// @throws bad_alloc
+        ///     on failure to allocate the object memory or any of the
+        ///     required internal data structures
+        ///
+        static void*
+        operator new(std::size_t objectSize);
+
+        /// @brief Deallocate storage space.
+        ///
+        /// Deallocates the memory block of size @p objectSize pointed to by
+        /// @p deadObject.  Memory blocks owned by the arena of a LocalTrace
+        /// object are left untouched, i.e., their storage is not reused;
+        /// it is released in bulk when the trace is destroyed.  Like for
+        /// other small objects, event representations have to be deleted
+        /// on the same thread they were allocated on.
+        ///
+        /// @param deadObject
+        ///     Pointer to the allocated memory
+        /// @param objectSize
+        ///     Size of the memory block (in bytes)
+        ///
+        /// @exception_nothrow
+        ///
+        static void
+        operator delete(void*       deadObject,
+                        std::size_t objectSize);
+
         /// @}
         /// @name Event type information
         /// @{
@@ -19,6 +19,7 @@
 
 
 #include <pearl/Event_rep.h>
+#include <pearl/pearlfwd_detail.h>
 
 
 /*-------------------------------------------------------------------------*/
@@ -137,6 +138,7 @@ class PEARL_NOPAD_ATTR Leave_rep
         /* Declare friends */
         friend class Event;
         friend class LocalTrace;
+        friend class detail::SegmentState;
 
         friend void
         PEARL_verify_calltree(GlobalDefs& defs,
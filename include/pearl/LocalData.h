@@ -104,6 +104,11 @@ class LocalData
               int            dest,
               int            tag) const;
 
+        void
+        isend(MpiMessage& message,
+              int         dest,
+              int         tag) const;
+
         MpiMessage*
         issend(const MpiComm& comm,
                int            dest,
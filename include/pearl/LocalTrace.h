@@ -21,10 +21,13 @@
 #define PEARL_LOCALTRACE_H
 
 
+#include <bitset>
+#include <cstddef>
 #include <iterator>
 #include <vector>
 
 #include <pearl/Event.h>
+#include <pearl/pearlfwd_detail.h>
 
 
 /*-------------------------------------------------------------------------*/
@@ -52,6 +55,16 @@ class Location;
  *  @class   LocalTrace
  *  @ingroup PEARL_base
  *  @brief   Container class for local event traces.
+ *
+ *  Events are stored as individually allocated, polymorphic event
+ *  representations (see Event_rep), referenced by a vector of pointers in
+ *  trace order.  Event representations are handed out by reference and
+ *  modified in place (e.g., timestamp correction, trace simulation), and
+ *  may be inserted, replaced, or removed individually.  Event
+ *  representations created while reading the trace are carved from a
+ *  per-trace memory arena, so that consecutive events are mostly adjacent
+ *  in memory.  Type-based searches are accelerated by a block index of the
+ *  event types (see find()).
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -74,6 +87,9 @@ class LocalTrace
                                            Event > reverse_iterator;
         #endif
 
+        /// Set of event types (no event groups)
+        typedef std::bitset< NUM_EVENT_TYPES > type_set;
+
         /// @name Constructors & destructor
         /// @{
 
@@ -98,6 +114,20 @@ class LocalTrace
         reverse_iterator
         rend() const;
 
+        /// @}
+        /// @name Searching for events
+        /// @{
+
+        iterator
+        find(const iterator& first,
+             const iterator& last,
+             const type_set& types) const;
+
+        reverse_iterator
+        find(const reverse_iterator& first,
+             const reverse_iterator& last,
+             const type_set&         types) const;
+
         /// @}
         /// @name Get trace information
         /// @{
@@ -120,6 +150,25 @@ class LocalTrace
         const GlobalDefs&
         get_definitions() const;
 
+        std::size_t
+        memory_usage() const;
+
+        /// @}
+        /// @name Get segment information
+        /// @{
+
+        uint64_t
+        segment_begin() const;
+
+        uint64_t
+        segment_end() const;
+
+        uint32_t
+        num_carried() const;
+
+        bool
+        is_partial() const;
+
         /// @}
         /// @name Store new events
         /// @{
@@ -172,18 +221,65 @@ class LocalTrace
         /// Trace location
         Location* m_location;
 
+        /// Memory arena holding the event representations created while
+        /// reading the trace; released as a whole on destruction.  The
+        /// storage of arena-owned events that are erased, replaced, or
+        /// deleted early is not reused before that.  As the arena is
+        /// registered with the reading thread, the trace has to be destroyed
+        /// on the same thread.
+        detail::MemoryArena* m_arena;
+
+        /// Index of the enclosing ENTER event for each event (see
+        /// Event::enterptr()); computed by PEARL_preprocess_trace()
+        mutable std::vector< uint32_t > m_enterptr;
+
+        /// Index of the matching LEAVE event for each ENTER event (see
+        /// Event::leaveptr()); computed by PEARL_preprocess_trace()
+        mutable std::vector< uint32_t > m_leaveptr;
+
+        /// Marker for events without an index entry
+        static const uint32_t NO_INDEX = 0xFFFFFFFF;
+
+        /// Set of event types occurring in each block of BLOCK_SIZE
+        /// consecutive events (see find()); computed on demand
+        mutable std::vector< type_set > m_blocktypes;
+
+        /// Number of events per block of the event type index
+        static const uint32_t BLOCK_SIZE = 256;
+
+        /// State of segment-wise reading (see TraceArchive::getTraceSegment());
+        /// null if the entire trace has been read at once
+        detail::SegmentState* m_segments;
+
 
         /* Private methods */
         LocalTrace(const GlobalDefs& defs,
-                   const Location&   location);
+                   const Location&   location,
+                   uint64_t          numEvents);
+
+        void
+        clear();
+
+        void
+        release_events();
 
         Event_rep*
         operator[](uint32_t index) const;
 
+        void
+        invalidate_index();
+
+        void
+        build_block_index() const;
+
 
         /* Declare friends */
         friend class Event;
         friend class TraceArchive;
+
+        friend void
+        PEARL_preprocess_trace(const GlobalDefs& defs,
+                               const LocalTrace& trace);
 };
 }    // namespace pearl
 
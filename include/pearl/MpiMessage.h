@@ -64,6 +64,13 @@ class MpiMessage
         MpiMessage(const MpiComm& comm,
                    int            size = 128);
 
+        /// @}
+        /// @name Reusing message objects
+        /// @{
+
+        void
+        reset(MPI_Comm comm);
+
         /// @}
         /// @name Sending & receiving
         /// @{
@@ -119,6 +126,11 @@ class MpiMessage
 
         /// Request object used for non-blocking communication
         MPI_Request m_request;
+
+
+        /* Private methods */
+        void
+        prepare_receive(int length);
 };
 }    // namespace pearl
 
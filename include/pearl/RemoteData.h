@@ -18,10 +18,11 @@
 #define PEARL_REMOTEDATA_H
 
 
-#include <map>
+#include <utility>
 #include <vector>
 
 #include <pearl/RemoteEvent.h>
+#include <pearl/ScopedPtr.h>
 
 
 /*-------------------------------------------------------------------------*/
@@ -41,6 +42,7 @@ namespace pearl
 
 class GlobalDefs;
 class MpiComm;
+class MpiMessage;
 
 
 /*-------------------------------------------------------------------------*/
@@ -54,9 +56,11 @@ class MpiComm;
 class RemoteData
 {
     public:
-        /// @name Destructor
+        /// @name Constructors & destructor
         /// @{
 
+        RemoteData();
+
         ~RemoteData();
 
         /// @}
@@ -107,8 +111,10 @@ class RemoteData
 
 
     private:
-        /// Container type for role |-@> index mapping
-        typedef std::map< uint32_t, uint32_t > KeyMap;
+        /// Container type for role |-@> index mapping, sorted by role ID.
+        /// A sorted vector is used instead of a map as the tables are cleared
+        /// after every replayed event, but retain their storage.
+        typedef std::vector< std::pair< uint32_t, uint32_t > > KeyMap;
 
         /// Container type for local events
         typedef std::vector< RemoteEvent > EventList;
@@ -124,6 +130,19 @@ class RemoteData
 
         /// Current set of buffers
         BufferList m_buffers;
+
+        /// Receive message, reused across recv()/bcast() calls to avoid
+        /// reallocating the message storage for every transfer
+        ScopedPtr< MpiMessage > m_message;
+
+
+        /* Private methods */
+        MpiMessage&
+        get_message(const MpiComm& comm);
+
+        void
+        unpack(const GlobalDefs& defs,
+               MpiMessage&       message);
 };
 }    // namespace pearl
 
@@ -20,7 +20,6 @@
 
 #include <iosfwd>
 
-#include <pearl/CountedPtr.h>
 #include <pearl/Event_rep.h>
 #include <pearl/pearl_types.h>
 
@@ -64,6 +63,17 @@ class RemoteEvent
         RemoteEvent(const GlobalDefs& defs,
                     Buffer&           buffer);
 
+        RemoteEvent(const RemoteEvent& rhs);
+
+        ~RemoteEvent();
+
+        /// @}
+        /// @name Assignment operator
+        /// @{
+
+        RemoteEvent&
+        operator=(const RemoteEvent& rhs);
+
         /// @}
         /// @name Access remote event information
         /// @{
@@ -91,8 +101,12 @@ class RemoteEvent
 
 
     private:
-        /// Reference-counted event representation
-        CountedPtr< Event_rep > m_event;
+        /// Reference-counted event representation shared by all copies
+        struct SharedRep;
+
+
+        /// Shared event representation
+        SharedRep* m_shared;
 
         /// %Event location
         Location* m_location;
@@ -105,6 +119,9 @@ class RemoteEvent
 
 
         /* Private methods */
+        void
+        release();
+
         std::ostream&
         output(std::ostream& stream) const;
 
@@ -30,15 +30,19 @@
 #define PEARL_TRACEARCHIVE_H
 
 
+#include <stdint.h>
+
 #include <string>
 
 #include <pearl/Uncopyable.h>
+#include <pearl/pearlfwd_detail.h>
 
 
 namespace pearl
 {
 // --- Forward declarations -------------------------------------------------
 
+class Buffer;
 class GlobalDefs;
 class LocalIdMaps;
 class LocalTrace;
@@ -211,6 +215,46 @@ class TraceArchive
         GlobalDefs*
         getDefinitions();
 
+        /// @brief Pack global definitions for distribution.
+        ///
+        /// Reads the global definition data from the trace experiment archive
+        /// and appends a compact binary representation of it to the given
+        /// @a buffer, without creating a global definitions object.  The
+        /// buffer can then be transferred to other processes, which create
+        /// the definitions object using getDefinitions(Buffer&).  This allows
+        /// a single process to read the global definitions on behalf of all
+        /// others.
+        ///
+        /// @note
+        ///     If the archive type does not support packing its definition
+        ///     data (e.g., EPIK trace archives), nothing is appended to
+        ///     @a buffer and getDefinitions(Buffer&) falls back to reading
+        ///     the definitions from the archive.
+        ///
+        /// @param buffer
+        ///     %Buffer to which the packed definition data is appended
+        ///
+        void
+        packDefinitions(Buffer& buffer);
+
+        /// @brief Get global definitions from packed definition data.
+        ///
+        /// Creates a new global definitions object from the packed definition
+        /// data in @a buffer, previously created by a call to
+        /// packDefinitions() for the same experiment archive (usually on
+        /// another process), without accessing the archive's definition
+        /// files.  The definitions object's ownership is transferred to the
+        /// caller.
+        ///
+        /// @param buffer
+        ///     %Buffer providing the packed definition data at its current
+        ///     read position
+        /// @returns
+        ///     Pointer to global definitions object
+        ///
+        GlobalDefs*
+        getDefinitions(Buffer& buffer);
+
         /// @}
         /// @name Access local mapping & event trace data
         /// @{
@@ -310,6 +354,81 @@ class TraceArchive
                  const Location&   location,
                  LocalIdMaps*      idMaps = 0);
 
+        /// @brief Get first trace segment.
+        ///
+        /// Reads the first segment of the event trace data for the given
+        /// @a location, consisting of at least @a numEvents events, and
+        /// creates a new trace data object providing access to it.  The
+        /// same trace data object can then be refilled with subsequent
+        /// segments using readTraceSegment(), which allows processing event
+        /// traces that do not fit into memory as a whole.  The parameters
+        /// and ownership semantics are the same as for getTrace(), except
+        /// that the mapping data object @a idMaps is kept until the trace
+        /// data object is deleted.
+        ///
+        /// A segment only ends at a position where all buffer flush events
+        /// read so far can be put into their correct place within the
+        /// segment (see PEARL_verify_calltree()), and may therefore contain
+        /// slightly more events than requested.  Segments other than the
+        /// first start with copies of the ENTER events of all regions which
+        /// have been entered in earlier segments and are still active (see
+        /// LocalTrace::num_carried()).  If the segment does not reach the
+        /// end of the trace (see LocalTrace::is_partial()), some regions are
+        /// left only in later segments.
+        ///
+        /// @note
+        ///     Segment-wise reading is currently only supported for OTF2
+        ///     trace archives without OpenMP tasks.  The trace container has
+        ///     to stay open until the last segment has been read.
+        ///
+        /// @param defs
+        ///     Global definitions object
+        /// @param location
+        ///     %Location whose trace data should be read
+        /// @param numEvents
+        ///     Requested number of events of the first segment
+        /// @param idMaps
+        ///     Pointer to identifier mapping data object. If 0, mappings will
+        ///     be read from the experiment archive.
+        /// @returns
+        ///     Pointer to trace data object
+        ///
+        /// @throws pearl::RuntimeError
+        ///     if the archive type does not support segment-wise reading
+        ///
+        LocalTrace*
+        getTraceSegment(const GlobalDefs& defs,
+                        const Location&   location,
+                        uint64_t          numEvents,
+                        LocalIdMaps*      idMaps = 0);
+
+        /// @brief Read trace segment.
+        ///
+        /// Replaces the events of the trace data object @a trace, previously
+        /// created by getTraceSegment() for the same archive, by the trace
+        /// segment starting at event position @a begin and consisting of at
+        /// least @a numEvents events.  Valid begin positions are 0 and the
+        /// end positions of all segments read so far (see
+        /// LocalTrace::segment_end()), i.e., segments can be read in order
+        /// as well as revisited in any order afterwards.  Previously
+        /// obtained iterators of @a trace are invalidated.
+        ///
+        /// @param trace
+        ///     Trace data object created by getTraceSegment()
+        /// @param begin
+        ///     Position of the first event of the segment
+        /// @param numEvents
+        ///     Requested number of events
+        ///
+        /// @throws pearl::RuntimeError
+        ///     if @a trace was not created by getTraceSegment() or @a begin
+        ///     is not a valid segment begin
+        ///
+        void
+        readTraceSegment(LocalTrace& trace,
+                         uint64_t    begin,
+                         uint64_t    numEvents);
+
         /// @}
 
 
@@ -361,6 +480,13 @@ class TraceArchive
         virtual void
         readDefinitions(GlobalDefs* defs) = 0;
 
+        virtual void
+        readPackedDefinitions(Buffer& buffer);
+
+        virtual void
+        unpackDefinitions(GlobalDefs* defs,
+                          Buffer&     buffer);
+
         virtual LocalIdMaps*
         readIdMaps(const Location& location) = 0;
 
@@ -369,6 +495,13 @@ class TraceArchive
                   const Location&   location,
                   LocalIdMaps*      idMaps,
                   LocalTrace*       trace) = 0;
+
+        virtual void
+        readSegment(const GlobalDefs&     defs,
+                    const Location&       location,
+                    LocalIdMaps*          idMaps,
+                    LocalTrace*           trace,
+                    detail::SegmentState& segment);
 };
 }    // namespace pearl
 
@@ -71,6 +71,32 @@ PEARL_backward_replay(const LocalTrace&      trace,
                       const CallbackManager& cbmanager,
                       CallbackData*          data);
 
+
+void
+PEARL_selective_forward_replay(const LocalTrace&           trace,
+                               const CallbackManager&      cbmanager,
+                               CallbackData*               data,
+                               const LocalTrace::iterator& begin,
+                               const LocalTrace::iterator& end);
+
+void
+PEARL_selective_forward_replay(const LocalTrace&      trace,
+                               const CallbackManager& cbmanager,
+                               CallbackData*          data);
+
+
+void
+PEARL_selective_backward_replay(const LocalTrace&                   trace,
+                                const CallbackManager&              cbmanager,
+                                CallbackData*                       data,
+                                const LocalTrace::reverse_iterator& rbegin,
+                                const LocalTrace::reverse_iterator& rend);
+
+void
+PEARL_selective_backward_replay(const LocalTrace&      trace,
+                                const CallbackManager& cbmanager,
+                                CallbackData*          data);
+
 /// @}
 
 
@@ -92,6 +118,26 @@ PEARL_backward_replay(const LocalTrace&      trace,
 {
     PEARL_backward_replay(trace, cbmanager, data, trace.rbegin(), trace.rend());
 }
+
+
+inline void
+PEARL_selective_forward_replay(const LocalTrace&      trace,
+                               const CallbackManager& cbmanager,
+                               CallbackData*          data)
+{
+    PEARL_selective_forward_replay(trace, cbmanager, data,
+                                   trace.begin(), trace.end());
+}
+
+
+inline void
+PEARL_selective_backward_replay(const LocalTrace&      trace,
+                                const CallbackManager& cbmanager,
+                                CallbackData*          data)
+{
+    PEARL_selective_backward_replay(trace, cbmanager, data,
+                                    trace.rbegin(), trace.rend());
+}
 }    // namespace pearl
 
 
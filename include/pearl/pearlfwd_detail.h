@@ -38,6 +38,8 @@ template< typename DefClassT >
 class DefinitionContainer;
 template< typename DefClassT >
 class DefinitionTree;
+class MemoryArena;
+class SegmentState;
 }    // namespace pearl::detail
 }    // namespace pearl
 
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2014                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -34,7 +34,8 @@ Clock::Clock()
       num_viol(0),
       m_p2p_violation(0),
       m_coll_violation(0),
-      m_omp_violation(0)
+      m_omp_violation(0),
+      m_controlled(false)
 {
     controller = new Controller;
 }
@@ -75,7 +76,11 @@ timestamp_t
 Clock::amortize_forward_intern(const timestamp_t curEvtT)
 {
     // Calculate simple controlled logical clock value
-    value = max(max(value + delta, value + (controller->get_gamma() * (curEvtT - prevEvtT))), curEvtT);
+    const timestamp_t controlled = value + (controller->get_gamma() * (curEvtT - prevEvtT));
+    const timestamp_t minimum    = max(value + delta, curEvtT);
+
+    m_controlled = (controlled > minimum);
+    value        = max(controlled, minimum);
 
     // Store preceding event for further processing
     prevEvtT = curEvtT;
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2016                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -106,6 +106,13 @@ class Clock
             return m_omp_violation;
         }
 
+        // Whether the last amortization was determined by the control variable
+        bool
+        is_controlled()
+        {
+            return m_controlled;
+        }
+
         // Reset clock for new pass
         void
         reset();
@@ -132,6 +139,9 @@ class Clock
         int  m_coll_violation;
         int  m_omp_violation;
 
+        // Last amortization determined by the control variable?
+        bool m_controlled;
+
 
         // Internal helper method
         void
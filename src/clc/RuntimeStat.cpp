@@ -232,3 +232,103 @@ RuntimeStat::set_statistics(const timestamp_t curEvtT,
         e_time = value;
     }
 }
+
+
+/**
+ *  Sets the number of intervals for which statistics are recorded and
+ *  resets all of them.
+ **/
+void
+RuntimeStat::set_num_intervals(const size_t num)
+{
+    m_intervals.assign(num, Summary());
+}
+
+
+/**
+ *  Resets the statistics of the given interval before it is replayed.
+ **/
+void
+RuntimeStat::reset_interval(const size_t index)
+{
+    m_intervals[index] = Summary();
+}
+
+
+/**
+ *  Calculates clock's statistics like set_statistics() and additionally
+ *  records them for the given interval.
+ **/
+void
+RuntimeStat::set_interval_statistics(const size_t      index,
+                                     const timestamp_t curEvtT,
+                                     const timestamp_t value)
+{
+    set_statistics(curEvtT, value);
+
+    Summary& summary = m_intervals[index];
+    summary.num_events++;
+    summary.clock_diff      = clock_diff;
+    summary.sum_clock_diff += clock_diff;
+    if (clock_diff > 0.0)
+    {
+        summary.num_clock_corr++;
+    }
+    if (summary.max_clock_diff < clock_diff)
+    {
+        summary.max_clock_diff = clock_diff;
+    }
+    if (value < summary.s_time)
+    {
+        summary.s_time = value;
+    }
+    if (value > summary.e_time)
+    {
+        summary.e_time = value;
+    }
+}
+
+
+/**
+ *  Adds the statistics recorded for the given interval as if
+ *  set_statistics() had been called for each of its events again.
+ **/
+void
+RuntimeStat::add_interval_statistics(const size_t index)
+{
+    const Summary& summary = m_intervals[index];
+    if (summary.num_events == 0)
+    {
+        return;
+    }
+
+    clock_diff      = summary.clock_diff;
+    sum_clock_diff += summary.sum_clock_diff;
+    num_clock_corr += summary.num_clock_corr;
+
+    if (max_clock_diff < summary.max_clock_diff)
+    {
+        max_clock_diff = summary.max_clock_diff;
+    }
+
+    if (summary.s_time < s_time)
+    {
+        s_time = summary.s_time;
+    }
+    if (summary.e_time > e_time)
+    {
+        e_time = summary.e_time;
+    }
+}
+
+
+RuntimeStat::Summary::Summary()
+    : num_events(0),
+      clock_diff(0.0),
+      max_clock_diff(0.0),
+      sum_clock_diff(0.0),
+      num_clock_corr(0),
+      s_time(DBL_MAX),
+      e_time(-DBL_MAX)
+{
+}
@@ -18,6 +18,8 @@
 #define CLC_RUNTIMESTAT_H
 
 
+#include <vector>
+
 #include <pearl/pearl_types.h>
 
 
@@ -74,6 +76,21 @@ class RuntimeStat
         set_statistics(const pearl::timestamp_t curEvtT,
                        const pearl::timestamp_t value);
 
+        // Interval statistics (see Synchronizer::replay_intervals())
+        void
+        set_num_intervals(std::size_t num);
+
+        void
+        reset_interval(std::size_t index);
+
+        void
+        set_interval_statistics(std::size_t              index,
+                                const pearl::timestamp_t curEvtT,
+                                const pearl::timestamp_t value);
+
+        void
+        add_interval_statistics(std::size_t index);
+
 
     private:
         // Some statistics
@@ -98,6 +115,25 @@ class RuntimeStat
         // End time
         pearl::timestamp_t e_time;
 
+        // Statistics of a sequence of events, which can be added to the
+        // overall statistics at once
+        struct Summary
+        {
+            Summary();
+
+            long               num_events;
+            pearl::timestamp_t clock_diff;
+            pearl::timestamp_t max_clock_diff;
+            pearl::timestamp_t sum_clock_diff;
+            long               num_clock_corr;
+            pearl::timestamp_t s_time;
+            pearl::timestamp_t e_time;
+        };
+
+        // Statistics of the events of each interval in the last pass it
+        // was replayed
+        std::vector< Summary > m_intervals;
+
 
         // Helper function
         void
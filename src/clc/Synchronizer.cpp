@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2019                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -67,7 +67,9 @@ Synchronizer::Synchronizer(const int           rank,
       num_sends(0),
       t_stat(timeStat),
       i_stat(intervalStat),
-      tsa(0)
+      tsa(0),
+      m_incremental(false),
+      m_num_replayed(0)
 {
     // Get location
     const Location& loc = trace.get_location();
@@ -113,6 +115,39 @@ Synchronizer::~Synchronizer()
 }
 
 
+// --- Configuration --------------------------------------------------------
+
+/**
+ *  Sets the maximum number of forward amortization passes.
+ **/
+void
+Synchronizer::set_num_passes(const int passes)
+{
+    r_stat->set_num_passes(passes);
+}
+
+
+/**
+ *  Enables or disables incremental forward amortization.  In incremental
+ *  mode, the passes after the first one replay all communication events,
+ *  but only those intervals between them whose amortization may change
+ *  (see replay_intervals()).
+ *
+ *  An interval is only skipped if its events would obtain the same
+ *  timestamps as in the previous pass, which is decided anew in every pass
+ *  based on the timestamp of the preceding communication event.  While the
+ *  control variable is non-increasing from pass to pass, communication
+ *  events may be moved to earlier or later timestamps, so an event that
+ *  kept its original timestamp in one pass may still be corrected in a
+ *  later one.
+ **/
+void
+Synchronizer::set_incremental(const bool incremental)
+{
+    m_incremental = incremental;
+}
+
+
 // --- Timestamp correction -------------------------------------------------
 
 /**
@@ -162,7 +197,24 @@ Synchronizer::forward_amortization()
             #pragma omp barrier
         }
         FwdAmortData data(this);
-        PEARL_forward_replay(trace, *cbmanager, &data);
+        if (  m_incremental
+           && (r_stat->get_pass() > 1))
+        {
+            replay_intervals(*cbmanager, &data);
+        }
+        else
+        {
+            if (m_incremental)
+            {
+                find_intervals();
+            }
+            PEARL_forward_replay(trace, *cbmanager, &data);
+            m_num_replayed += trace.num_events();
+        }
+        if (m_incremental)
+        {
+            save_anchors();
+        }
         #pragma omp barrier
 
         // Until accuracy is sufficient
@@ -240,6 +292,8 @@ Synchronizer::print_statistics()
     timestamp_t gl_violations = 0.0;
     timestamp_t violations    = (timestamp_t)m_clc->get_num_viol();
     timestamp_t gl_max_slope  = 0.0;
+    timestamp_t gl_replayed   = 0.0;
+    timestamp_t replayed      = (timestamp_t)m_num_replayed;
 
     int sum_p2p_violation  = 0;
     int p2p_violation      = m_clc->get_p2p_viol();
@@ -253,6 +307,8 @@ Synchronizer::print_statistics()
         num = omp_global_sum_timestamp;
         OMP_Allreduce_sum(violations, omp_global_sum_timestamp);
         violations = omp_global_sum_timestamp;
+        OMP_Allreduce_sum(replayed, omp_global_sum_timestamp);
+        replayed = omp_global_sum_timestamp;
         OMP_Allreduce_max(m_max_slope, omp_global_max_timestamp);
         m_max_slope = omp_global_max_timestamp;
         OMP_Allreduce_sum(p2p_violation, omp_global_sum_count);
@@ -267,6 +323,7 @@ Synchronizer::print_statistics()
     {
         MPI_Allreduce(&num, &gl_num, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
         MPI_Allreduce(&violations, &gl_violations, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(&replayed, &gl_replayed, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
         MPI_Allreduce(&m_max_slope, &gl_max_slope, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
         MPI_Allreduce(&p2p_violation, &sum_p2p_violation, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
         MPI_Allreduce(&coll_violation, &sum_coll_violation, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
@@ -276,6 +333,7 @@ Synchronizer::print_statistics()
         if (m_rank == 0)
         {
             printf("\n\t# passes        : %d\n", r_stat->get_pass());
+            printf("\t# replayed      : %.0f\n", gl_replayed);
             printf("\t# violated      : %.0f\n", gl_violations);
             if (gl_violations > 0.0)
             {
@@ -1036,8 +1094,16 @@ Synchronizer::fa_amortize_intern(const Event&        event,
     // Set new timestamp
     event->setTimestamp(m_clc->get_value());
 
-    // Adjust statistics and timestamp
-    r_stat->set_statistics(curT, m_clc->get_value());
+    // Adjust statistics and timestamp; in incremental mode, also remember
+    // how the interval was amortized
+    if (m_incremental)
+    {
+        mark_interval(event, curT);
+    }
+    else
+    {
+        r_stat->set_statistics(curT, m_clc->get_value());
+    }
 
     // Suppress implicit internal amortization
     data->setAmortized();
@@ -1585,24 +1651,272 @@ Synchronizer::prepare_replay()
     // Apply controller to obtain control variable for next pass
     m_clc->apply_controller(r_stat->get_pass());
 
+    // Restart the clock at the first event
+    firstEvtT = -DBL_MAX;
+
     // Clear clock violation list
     m_violations.clear();
 
     // Reset number of send events for subsequent replay
     num_sends = 0;
 
-    // Copy/restore timestamps for subsequent replay
+    // Copy/restore timestamps for subsequent replay; in incremental mode,
+    // timestamps are restored per replayed interval
     if (r_stat->get_pass() == 1)
     {
         get_ts();
     }
-    else
+    else if (!m_incremental)
     {
         set_ts();
     }
 }
 
 
+/**
+ *  Checks whether the given event takes part in a communication operation
+ *  handled by the forward amortization callbacks.
+ */
+bool
+Synchronizer::is_communication(const Event& event) const
+{
+    if (  event->isOfType(GROUP_SEND)
+       || event->isOfType(GROUP_RECV)
+       || event->isOfType(MPI_COLLECTIVE_END))
+    {
+        return true;
+    }
+
+    #ifdef _OPENMP
+        if (  event->isOfType(THREAD_FORK)
+           || event->isOfType(THREAD_TEAM_BEGIN)
+           || event->isOfType(THREAD_TEAM_END)
+           || event->isOfType(THREAD_JOIN))
+        {
+            return true;
+        }
+    #endif    // _OPENMP
+
+    if (event->isOfType(GROUP_LEAVE))
+    {
+        const Region& region = event->getRegion();
+
+        return (  is_omp_barrier(region)
+               || is_mpi_init(region)
+               || is_mpi_finalize(region));
+    }
+
+    return false;
+}
+
+
+/**
+ *  Determines the communication events separating the intervals tracked
+ *  in incremental mode.  All intervals are initially unaffected and get
+ *  marked during the first pass.
+ */
+void
+Synchronizer::find_intervals()
+{
+    m_anchors.clear();
+
+    LocalTrace::iterator it = trace.begin();
+    while (it != trace.end())
+    {
+        if (is_communication(it))
+        {
+            m_anchors.push_back(it.get_id());
+        }
+        ++it;
+    }
+
+    m_anchor_ts.assign(m_anchors.size(), 0.0);
+    m_affected.assign(m_anchors.size() + 1, false);
+    m_controlled.assign(m_anchors.size() + 1, false);
+    r_stat->set_num_intervals(m_anchors.size() + 1);
+}
+
+
+/**
+ *  Records the amortization result and statistics of the given event for
+ *  the interval containing it, unless it is a communication event.
+ */
+void
+Synchronizer::mark_interval(const Event&      event,
+                            const timestamp_t curT)
+{
+    const uint32_t id = event.get_id();
+
+    vector< uint32_t >::const_iterator it = upper_bound(m_anchors.begin(),
+                                                        m_anchors.end(),
+                                                        id);
+
+    // Communication events are replayed anyway
+    if (  (it != m_anchors.begin())
+       && (*(it - 1) == id))
+    {
+        r_stat->set_statistics(curT, m_clc->get_value());
+
+        return;
+    }
+
+    const size_t index = it - m_anchors.begin();
+    if (m_clc->get_value() > curT)
+    {
+        m_affected[index] = true;
+    }
+    if (m_clc->is_controlled())
+    {
+        m_controlled[index] = true;
+    }
+    r_stat->set_interval_statistics(index, curT, m_clc->get_value());
+}
+
+
+/**
+ *  Replays all communication events and the intervals between them which
+ *  may change during this pass.  An interval is skipped if either
+ *   - none of its events was corrected in the previous pass and the
+ *     preceding communication event did not obtain a later timestamp, or
+ *   - none of its events depended on the control variable in the previous
+ *     pass and the preceding communication event obtained the same
+ *     timestamp again.
+ *  In the first case, the clock entering the interval is not later than
+ *  in the previous pass, so its events still keep their original
+ *  timestamps.  In the second case, the clock entering the interval is
+ *  unchanged and its events do not depend on the control variable, so they
+ *  obtain the same timestamps as before.  All other intervals, including
+ *  uncorrected ones whose preceding communication event was moved to a
+ *  later time, are replayed.  Consecutive replayed intervals are merged
+ *  into a single range.
+ */
+void
+Synchronizer::replay_intervals(const CallbackManager& cbmanager,
+                               FwdAmortData* const    data)
+{
+    const uint32_t num_events  = trace.num_events();
+    const uint32_t num_anchors = m_anchors.size();
+
+    uint32_t begin = 0;
+    for (uint32_t i = 0; i <= num_anchors; ++i)
+    {
+        // Interval i is located between communication events i-1 and i
+        const uint32_t first = (i == 0) ? 0 : m_anchors[i - 1] + 1;
+        const uint32_t last  = (i == num_anchors) ? num_events : m_anchors[i];
+        if (first == last)
+        {
+            continue;
+        }
+
+        // Intervals depending on the control variable are re-evaluated
+        // anyway; all others require the timestamp of the preceding
+        // communication event for the decision
+        if (  !m_affected[i]
+           || !m_controlled[i])
+        {
+            replay_range(cbmanager, data, begin, first);
+            begin = first;
+
+            bool skip = true;
+            if (i > 0)
+            {
+                const timestamp_t anchorT = trace.at(first - 1)->getTimestamp();
+
+                skip = m_affected[i]
+                       ? (anchorT == m_anchor_ts[i - 1])
+                       : (anchorT <= m_anchor_ts[i - 1]);
+            }
+            if (skip)
+            {
+                skip_interval(i, first, last);
+                begin = last;
+                continue;
+            }
+        }
+
+        // Re-evaluated during this pass
+        m_affected[i]   = false;
+        m_controlled[i] = false;
+        r_stat->reset_interval(i);
+    }
+    replay_range(cbmanager, data, begin, num_events);
+}
+
+
+/**
+ *  Restores the original timestamps of the events in the range
+ *  [first,last) and replays them.
+ */
+void
+Synchronizer::replay_range(const CallbackManager& cbmanager,
+                           FwdAmortData* const    data,
+                           const uint32_t         first,
+                           const uint32_t         last)
+{
+    if (first == last)
+    {
+        return;
+    }
+
+    const LocalTrace::iterator begin = trace.at(first);
+    const LocalTrace::iterator end   = (last == trace.num_events())
+                                       ? trace.end()
+                                       : trace.at(last);
+
+    uint32_t             i  = first;
+    LocalTrace::iterator it = begin;
+    while (it != end)
+    {
+        it->setTimestamp(tsa[i]);
+        ++i;
+        ++it;
+    }
+
+    PEARL_forward_replay(trace, cbmanager, data, begin, end);
+    m_num_replayed += last - first;
+}
+
+
+/**
+ *  Skips the interval [first,last) with the given index, whose events keep
+ *  the timestamps of the previous pass.  The clock simply continues from
+ *  the last one, and the statistics recorded when the interval was last
+ *  replayed are accounted for once more.
+ */
+void
+Synchronizer::skip_interval(const uint32_t index,
+                            const uint32_t first,
+                            const uint32_t last)
+{
+    if (firstEvtT == -DBL_MAX)
+    {
+        firstEvtT = tsa[0];
+    }
+
+    const timestamp_t curT  = tsa[last - 1];
+    const timestamp_t value = trace.at(last - 1)->getTimestamp();
+    m_clc->set_value(value);
+    m_clc->set_prev(curT);
+
+    r_stat->add_interval_statistics(index);
+}
+
+
+/**
+ *  Stores the amortized timestamps of all communication events, to be
+ *  compared in the next pass.
+ */
+void
+Synchronizer::save_anchors()
+{
+    const size_t num_anchors = m_anchors.size();
+    for (size_t i = 0; i < num_anchors; ++i)
+    {
+        m_anchor_ts[i] = trace.at(m_anchors[i])->getTimestamp();
+    }
+}
+
+
 /**
  *  Store original timestamps in buffer.
  */
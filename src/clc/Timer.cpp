@@ -121,7 +121,7 @@ Timer::check()
     #endif    // _OPENMP
 
     // Replay the target application and check timestamps...
-    PEARL_forward_replay(trace, cbmanager, NULL);
+    PEARL_selective_forward_replay(trace, cbmanager, NULL);
 }
 
 
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2018                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -16,7 +16,10 @@
 
 #include <config.h>
 
+#include <cerrno>
+#include <climits>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include <mpi.h>
@@ -60,6 +63,51 @@ main(int    argc,
     // Initialize PEARL & validate arguments
     PEARL_mpi_init();
 
+    // Usage: clc_synchronize [-p <passes>] [-i] <archive>
+    //   -p  maximum number of forward amortization passes
+    //   -i  replay only intervals affected by corrections in later passes
+    int   passes      = 0;
+    bool  incremental = false;
+    bool  error       = false;
+    char* anchor      = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-p") == 0)
+        {
+            // Number of passes has to be a positive integer
+            const char* value = (i + 1 < argc) ? argv[++i] : "";
+            char*       end;
+
+            errno = 0;
+            const long num = strtol(value, &end, 10);
+            if (  (*value == '\0')
+               || (*end != '\0')
+               || (errno == ERANGE)
+               || (num < 1)
+               || (num > INT_MAX))
+            {
+                cerr << "Invalid number of passes: '" << value << "'" << endl;
+                error = true;
+                break;
+            }
+            passes = num;
+        }
+        else if (strcmp(argv[i], "-i") == 0)
+        {
+            incremental = true;
+        }
+        else
+        {
+            anchor = argv[i];
+        }
+    }
+    if (  error
+       || !anchor)
+    {
+        cerr << "Usage: clc_synchronize [-p <passes>] [-i] <archive>" << endl;
+        exit(EXIT_FAILURE);
+    }
+
     // Open the trace archive
     // All processes will open the same archive simultaneously. In case of an
     // error, bad things can happen if not all processes fail at the same time.
@@ -67,7 +115,7 @@ main(int    argc,
     TraceArchive* archive = NULL;
     try
     {
-        archive = TraceArchive::open(argv[1]);
+        archive = TraceArchive::open(anchor);
     }
     catch (const Error& error)
     {
@@ -152,6 +200,11 @@ main(int    argc,
 
         // Create one Synchronizer object per process
         Synchronizer* sync = new Synchronizer(rank, *trace);
+        if (passes > 0)
+        {
+            sync->set_num_passes(passes);
+        }
+        sync->set_incremental(incremental);
 
         // Synchronize event stream
         sync->synchronize();
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2018                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -83,6 +83,16 @@ class Synchronizer
 
         ~Synchronizer();
 
+        /// @}
+        /// @name Configuration
+        /// @{
+
+        void
+        set_num_passes(int passes);
+
+        void
+        set_incremental(bool incremental);
+
         /// @}
         /// @name Timestamp correction
         /// @{
@@ -154,6 +164,28 @@ class Synchronizer
         /// Timestamp array
         pearl::timestamp_t* tsa;
 
+        /// Flag indicating whether forward amortization passes after the
+        /// first one only replay the intervals affected by corrections
+        bool m_incremental;
+
+        /// IDs of the communication events, which separate the intervals
+        /// tracked in incremental mode and are replayed in every pass
+        std::vector< uint32_t > m_anchors;
+
+        /// Amortized timestamps of the communication events in the last pass
+        std::vector< pearl::timestamp_t > m_anchor_ts;
+
+        /// Flags indicating whether an interval between two communication
+        /// events carried a correction in the last pass
+        std::vector< bool > m_affected;
+
+        /// Flags indicating whether an interval between two communication
+        /// events depended on the control variable in the last pass
+        std::vector< bool > m_controlled;
+
+        /// Number of events replayed during forward amortization
+        long m_num_replayed;
+
         // Asynchronous message handling
         std::vector< amortization_data* > m_data;
         std::vector< MPI_Request >        m_requests;
@@ -386,6 +418,34 @@ class Synchronizer
         void
         prepare_replay();
 
+        bool
+        is_communication(const pearl::Event& event) const;
+
+        void
+        find_intervals();
+
+        void
+        mark_interval(const pearl::Event& event,
+                      pearl::timestamp_t  curT);
+
+        void
+        replay_intervals(const pearl::CallbackManager& cbmanager,
+                         FwdAmortData*                 data);
+
+        void
+        replay_range(const pearl::CallbackManager& cbmanager,
+                     FwdAmortData*                 data,
+                     uint32_t                      first,
+                     uint32_t                      last);
+
+        void
+        skip_interval(uint32_t index,
+                      uint32_t first,
+                      uint32_t last);
+
+        void
+        save_anchors();
+
         void
         get_ts();
 
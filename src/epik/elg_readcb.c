@@ -294,11 +294,11 @@ elg_read_dispatch(ElgRCB* handle,
                             pos++;
                         }
 
-                        /* Potentially read continuation records */
+                        /* Potentially read continuation records (invalidates rec) */
                         maxLength = 255 / sizeof(elg_ui4);
                         while (pos < grpc)
                         {
-                            ElgRec* contRec = ElgIn_read_record(handle->in);
+                            ElgRec* contRec = ElgIn_next_record(handle->in);
 
                             /* Validate record type */
                             if (ElgRec_get_type(contRec) != ELG_MPI_GROUP_CNT)
@@ -318,8 +318,6 @@ elg_read_dispatch(ElgRCB* handle,
                                 grpv[pos] = ElgRec_read_ui4(contRec);
                                 pos++;
                             }
-
-                            ElgRec_free(contRec);
                         }
                     }
 
@@ -385,10 +383,10 @@ elg_read_dispatch(ElgRCB* handle,
                         grpv[pos++] = ElgRec_read_ui1(rec);
                     }
 
-                    /* Read continuation records */
+                    /* Read continuation records (invalidates rec) */
                     while (pos < grpc)
                     {
-                        ElgRec* contRec = ElgIn_read_record(handle->in);
+                        ElgRec* contRec = ElgIn_next_record(handle->in);
                         if (ElgRec_get_type(contRec) != ELG_MPI_COMM_CNT)
                         {
                             UTILS_FATAL("MPI_COMM_CNT record expected.");
@@ -403,8 +401,6 @@ elg_read_dispatch(ElgRCB* handle,
                         {
                             grpv[pos++] = ElgRec_read_ui1(contRec);
                         }
-
-                        ElgRec_free(contRec);
                     }
 
                     elg_readcb_MPI_COMM(cid, mode, grpc, grpv, userdata);
@@ -590,11 +586,11 @@ elg_read_dispatch(ElgRCB* handle,
                         mapv[pos++] = ElgRec_read_ui4(rec);
                     }
 
-                    /* Read continuation records */
+                    /* Read continuation records (invalidates rec) */
                     max = 255 / sizeof(elg_ui4);
                     while (pos < count)
                     {
-                        ElgRec* contRec = ElgIn_read_record(handle->in);
+                        ElgRec* contRec = ElgIn_next_record(handle->in);
                         if (ElgRec_get_type(contRec) != ELG_IDMAP_CNT)
                         {
                             UTILS_FATAL("IDMAP_CNT record expected.");
@@ -609,8 +605,6 @@ elg_read_dispatch(ElgRCB* handle,
                         {
                             mapv[pos++] = ElgRec_read_ui4(contRec);
                         }
-
-                        ElgRec_free(contRec);
                     }
 
                     elg_readcb_IDMAP(type, mode, count, mapv, userdata);
@@ -1926,7 +1920,7 @@ elg_read_next_def(ElgRCB* handle,
 
     while (1)
     {
-        rec = ElgIn_read_record(handle->in);
+        rec = ElgIn_next_record(handle->in);
         if (rec == NULL)
         {
             return 0;
@@ -1939,7 +1933,6 @@ elg_read_next_def(ElgRCB* handle,
     }
 
     res = elg_read_dispatch(handle, rec, userdata);
-    ElgRec_free(rec);
 
     return res;
 }
@@ -1954,7 +1947,7 @@ elg_read_next_event(ElgRCB* handle,
 
     while (1)
     {
-        rec = ElgIn_read_record(handle->in);
+        rec = ElgIn_next_record(handle->in);
         if (rec == NULL)
         {
             return 0;
@@ -1968,7 +1961,6 @@ elg_read_next_event(ElgRCB* handle,
     }
 
     res = elg_read_dispatch(handle, rec, userdata);
-    ElgRec_free(rec);
 
     return res;
 }
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -41,8 +42,17 @@
 #endif    /* HAVE(LIBZ) */
 
 
-#define ELGIN_MODE_FILE      0
-#define ELGIN_MODE_BUFFER    1
+#if defined(_POSIX_MAPPED_FILES) && (_POSIX_MAPPED_FILES > 0)
+    #include <sys/mman.h>
+    #define ELGIN_USE_MMAP
+#endif    /* _POSIX_MAPPED_FILES */
+
+
+#define ELGIN_MODE_FILE      0    /* block-buffered reads from file */
+#define ELGIN_MODE_BUFFER    1    /* whole file mapped into memory */
+
+/* size of the input block buffer (file mode) */
+#define ELGIN_BLOCK_SIZE     (1024 * 1024)
 
 
 /*--- Helper functions ------------------------------------------------------*/
@@ -209,10 +219,10 @@ struct ElgIn_struct
         gzFile file;
     #endif    /* HAVE(LIBZ) */
     const elg_ui1* buffer;
-    int            sionid;
-    long           bytes_avail_in_block;
+    elg_ui1*       block;
     size_t         size;
     size_t         offset;
+    ElgRec         rec;
     char           name[PATH_MAX];
     elg_ui1        minor_vnr;
     elg_ui1        major_vnr;
@@ -220,13 +230,125 @@ struct ElgIn_struct
 };
 
 
+/* Input buffer management */
+
+/*
+ * Ensures that at least `count` unread bytes are available in the input
+ * buffer, refilling the block buffer from the file if necessary.  Returns
+ * non-zero on success, zero if the end of the input has been reached.
+ */
+static int
+elgin_ensure(ElgIn* in,
+             size_t count)
+{
+    size_t avail = in->size - in->offset;
+
+    if (avail >= count)
+    {
+        return 1;
+    }
+    if (in->mode != ELGIN_MODE_FILE)
+    {
+        return 0;
+    }
+    UTILS_ASSERT(count <= ELGIN_BLOCK_SIZE);
+
+    /* move unread bytes to the front, then refill */
+    memmove(in->block, in->block + in->offset, avail);
+    in->offset = 0;
+    in->size   = avail;
+    while (in->size < count)
+    {
+        #if !HAVE(LIBZ)
+            size_t bytes = fread(in->block + in->size, 1,
+                                 ELGIN_BLOCK_SIZE - in->size, in->file);
+            if (bytes == 0)
+        #else    /* HAVE(LIBZ) */
+            int bytes = gzread(in->file, in->block + in->size,
+                               ELGIN_BLOCK_SIZE - in->size);
+            if (bytes <= 0)
+        #endif    /* HAVE(LIBZ) */
+        {
+            return 0;
+        }
+        in->size += bytes;
+    }
+
+    return 1;
+}
+
+
+#ifdef ELGIN_USE_MMAP
+
+/*
+ * Maps the uncompressed file `path_name` of `length` bytes into memory.
+ * Returns non-zero on success, zero if the file is compressed or cannot be
+ * mapped, in which case the caller falls back to buffered reading.
+ */
+static int
+elgin_map(ElgIn*      in,
+          const char* path_name,
+          size_t      length)
+{
+    void* addr;
+    int   fd;
+
+    if (length == 0)
+    {
+        return 0;
+    }
+
+    fd = open(path_name, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    /* compressed files are only supported via zlib */
+    #if HAVE(LIBZ)
+        {
+            unsigned char magic[2];
+
+            if (  (read(fd, magic, sizeof(magic)) != sizeof(magic))
+               || ((magic[0] == 0x1f) && (magic[1] == 0x8b)))
+            {
+                close(fd);
+
+                return 0;
+            }
+        }
+    #endif    /* HAVE(LIBZ) */
+
+    /* private writable mapping, as record strings are handed out in place */
+    addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        UTILS_DEBUG("mmap(%s): %s", path_name, strerror(errno));
+
+        return 0;
+    }
+    #ifdef MADV_SEQUENTIAL
+        madvise(addr, length, MADV_SEQUENTIAL);
+    #endif
+
+    in->mode   = ELGIN_MODE_BUFFER;
+    in->buffer = (const elg_ui1*)addr;
+    in->size   = length;
+
+    return 1;
+}
+
+#endif    /* ELGIN_USE_MMAP */
+
+
 /* Open and close trace file */
 
 ElgIn*
 ElgIn_open(const char* path_name)
 {
     ElgIn*      in;
-    char        label[7];
+    size_t      label_length = strlen(ELG_HEADER) + 1;
     struct stat sbuf;
     int         status;
 
@@ -246,59 +368,63 @@ ElgIn_open(const char* path_name)
     }
 
     /* allocate ElgIn record */
-    in = (ElgIn*)malloc(sizeof(ElgIn));
+    in = (ElgIn*)calloc(1, sizeof(ElgIn));
     if (in == NULL)
     {
         UTILS_FATAL("Allocation of EPILOG record struct failed");
     }
 
-    /* open file */
-    in->mode = ELGIN_MODE_FILE;
-    #if !HAVE(LIBZ)
-        if ((in->file = fopen(path_name, "r")) == NULL)
-    #else    /* HAVE(LIBZ) */
-        if ((in->file = gzopen(path_name, "r")) == NULL)
-    #endif    /* HAVE(LIBZ) */
-    {
-        UTILS_WARNING("Cannot open %s file %s", epk_archive_filetype(path_name), path_name);
-        free(in);
-
-        return NULL;
-    }
-    else
+    /* map uncompressed files into memory, otherwise use buffered reads */
+    #ifdef ELGIN_USE_MMAP
+        if (elgin_map(in, path_name, sbuf.st_size))
+        {
+            UTILS_DEBUG("Mapped %s file %s for reading %d bytes",
+                        epk_archive_filetype(path_name), path_name, sbuf.st_size);
+        }
+        else
+    #endif    /* ELGIN_USE_MMAP */
     {
-        UTILS_DEBUG("Opened %s file %s for reading %d bytes",
-                    epk_archive_filetype(path_name), path_name, sbuf.st_size);
-    }
-
-    /* store file name */
-    strcpy(in->name, path_name);
-
-    #if !HAVE(LIBZ)
-        if (  (fread(label, strlen(ELG_HEADER) + 1, 1, in->file) != 1)
-           || (fread(&in->major_vnr, sizeof(in->major_vnr), 1, in->file) != 1)
-           || (fread(&in->minor_vnr, sizeof(in->minor_vnr), 1, in->file) != 1)
-           || (fread(&in->byte_order, sizeof(in->byte_order), 1, in->file) != 1)
-           || (strcmp(label, ELG_HEADER) != 0))
+        in->mode = ELGIN_MODE_FILE;
+        #if !HAVE(LIBZ)
+            if ((in->file = fopen(path_name, "r")) == NULL)
+        #else    /* HAVE(LIBZ) */
+            if ((in->file = gzopen(path_name, "r")) == NULL)
+        #endif    /* HAVE(LIBZ) */
         {
-            fclose(in->file);
+            UTILS_WARNING("Cannot open %s file %s", epk_archive_filetype(path_name), path_name);
             free(in);
 
             return NULL;
         }
-    #else    /* HAVE(LIBZ) */
-        if (  (gzread(in->file, label, strlen(ELG_HEADER) + 1) != (strlen(ELG_HEADER) + 1))
-           || (gzread(in->file, &in->major_vnr, sizeof(in->major_vnr)) != sizeof(in->major_vnr))
-           || (gzread(in->file, &in->minor_vnr, sizeof(in->minor_vnr)) != sizeof(in->minor_vnr))
-           || (gzread(in->file, &in->byte_order, sizeof(in->byte_order)) != sizeof(in->byte_order))
-           || (strcmp(label, ELG_HEADER) != 0))
+        else
         {
-            gzclose(in->file);
-            free(in);
+            UTILS_DEBUG("Opened %s file %s for reading %d bytes",
+                        epk_archive_filetype(path_name), path_name, sbuf.st_size);
+        }
 
-            return NULL;
+        in->block = (elg_ui1*)malloc(ELGIN_BLOCK_SIZE);
+        if (in->block == NULL)
+        {
+            UTILS_FATAL("Allocation of EPILOG input buffer failed");
         }
-    #endif    /* HAVE(LIBZ) */
+        in->buffer = in->block;
+    }
+
+    /* store file name */
+    strcpy(in->name, path_name);
+
+    /* read header */
+    if (  !elgin_ensure(in, label_length + 3)
+       || (memcmp(in->buffer, ELG_HEADER, label_length) != 0))
+    {
+        ElgIn_close(in);
+
+        return NULL;
+    }
+    in->major_vnr  = in->buffer[label_length];
+    in->minor_vnr  = in->buffer[label_length + 1];
+    in->byte_order = in->buffer[label_length + 2];
+    in->offset    += label_length + 3;
 
     return in;
 }
@@ -321,11 +447,14 @@ ElgIn_close(ElgIn* in)
             UTILS_DEBUG("Closed %s file %s",
                         epk_archive_filetype(in->name), in->name);
         }
+        free(in->block);
     }
     else    /* ELGIN_MODE_BUFFER */
     {
-        /* UTILS_DEBUG("Closed buffer"); */
         result = 0;
+        #ifdef ELGIN_USE_MMAP
+            result = munmap((void*)in->buffer, in->size);
+        #endif    /* ELGIN_USE_MMAP */
     }
 
     free(in);
@@ -351,10 +480,14 @@ ElgIn_seek(ElgIn* in,
 {
     if (in->mode == ELGIN_MODE_FILE)
     {
+        /* discard buffered data */
+        in->size   = 0;
+        in->offset = 0;
+
         #if !HAVE(LIBZ)
             return fseek(in->file, offset, SEEK_SET);
         #else    /* HAVE(LIBZ) */
-            return gzseek(in->file, offset, SEEK_SET);
+            return (gzseek(in->file, offset, SEEK_SET) < 0) ? -1 : 0;
         #endif    /* HAVE(LIBZ) */
     }
 
@@ -374,46 +507,53 @@ ElgIn_seek(ElgIn* in,
 /* Reading trace records */
 
 ElgRec*
-ElgIn_read_record(ElgIn* in)
+ElgIn_next_record(ElgIn* in)
 {
-    ElgRec* rec;
+    ElgRec* rec = &in->rec;
 
-    /* allocate record */
-    rec = calloc(1, sizeof(ElgRec));
-    if (rec == NULL)
+    /* record header: length + type */
+    if (!elgin_ensure(in, 2))
     {
-        UTILS_FATAL("Allocation of EPILOG record struct failed");
+        return NULL;
     }
+    rec->length = in->buffer[in->offset];
+    rec->type   = in->buffer[in->offset + 1];
 
-    if (in->mode == ELGIN_MODE_FILE)
+    /* record body is decoded in place */
+    if (!elgin_ensure(in, 2 + rec->length))
     {
-        #if !HAVE(LIBZ)
-            if (  (fread(&rec->length, sizeof(rec->length), 1, in->file) != 1)
-               || (fread(&rec->type, sizeof(rec->type), 1, in->file) != 1))
-        #else    /* HAVE(LIBZ) */
-            if (  (gzread(in->file, &rec->length, sizeof(rec->length)) != sizeof(rec->length))
-               || (gzread(in->file, &rec->type, sizeof(rec->type)) != sizeof(rec->type)))
-        #endif    /* HAVE(LIBZ) */
-        {
-            free(rec);
-
-            return NULL;
-        }
+        return NULL;
     }
-    else    /* ELGIN_MODE_BUFFER */
-    {
-        if ((in->size - in->offset) < (sizeof(rec->length) + sizeof(rec->type)))
-        {
-            free(rec);
+    rec->body       = (buffer_t)&in->buffer[in->offset + 2];
+    rec->pos        = rec->body;
+    rec->byte_order = in->byte_order;
+    in->offset     += 2 + rec->length;
 
-            return NULL;
-        }
+    return rec;
+}
+
+
+ElgRec*
+ElgIn_read_record(ElgIn* in)
+{
+    ElgRec* cur;
+    ElgRec* rec;
 
-        rec->length = in->buffer[in->offset++];
-        rec->type   = in->buffer[in->offset++];
+    cur = ElgIn_next_record(in);
+    if (cur == NULL)
+    {
+        return NULL;
     }
 
-    /* allocate record body */
+    /* allocate record */
+    rec = calloc(1, sizeof(ElgRec));
+    if (rec == NULL)
+    {
+        UTILS_FATAL("Allocation of EPILOG record struct failed");
+    }
+    *rec = *cur;
+
+    /* copy record body */
     if (rec->length)
     {
         rec->body = malloc(rec->length);
@@ -421,41 +561,13 @@ ElgIn_read_record(ElgIn* in)
         {
             UTILS_FATAL("Allocation of EPILOG record body failed");
         }
-
-        /* read record body */
-        if (in->mode == ELGIN_MODE_FILE)
-        {
-            #if !HAVE(LIBZ)
-                if (fread(rec->body, rec->length, 1, in->file) != 1)
-            #else    /* HAVE(LIBZ) */
-                if (gzread(in->file, rec->body, rec->length) != rec->length)
-            #endif    /* HAVE(LIBZ) */
-            {
-                ElgRec_free(rec);
-
-                return NULL;
-            }
-        }
-        else    /* ELGIN_MODE_BUFFER */
-        {
-            if ((in->size - in->offset) < rec->length)
-            {
-                ElgRec_free(rec);
-
-                return NULL;
-            }
-
-            memcpy(rec->body, &in->buffer[in->offset], rec->length);
-            in->offset += rec->length;
-        }
+        memcpy(rec->body, cur->body, rec->length);
     }
     else
     {
         rec->body = NULL;
     }
-
-    rec->byte_order = in->byte_order;
-    rec->pos        = rec->body;
+    rec->pos = rec->body;
 
     return rec;
 }
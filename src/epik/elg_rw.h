@@ -131,8 +131,15 @@ ElgIn_seek(ElgIn* in,
 
 /* Reading trace records */
 
+/* Returns a newly allocated copy of the next record (free with ElgRec_free) */
 EXTERN ElgRec*
 ElgIn_read_record(ElgIn* in);
 
+/* Returns the next record, decoded in place.  The record is owned by `in`
+ * and only valid until the next call to any ElgIn function; it must not be
+ * passed to ElgRec_free. */
+EXTERN ElgRec*
+ElgIn_next_record(ElgIn* in);
+
 
 #endif    // !EPIK_ELG_RW_H
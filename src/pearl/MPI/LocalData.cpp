@@ -238,6 +238,20 @@ LocalData::isend(const MpiComm& comm,
 }
 
 
+void
+LocalData::isend(MpiMessage& message,
+                 int         dest,
+                 int         tag) const
+{
+    // Construct message; the caller-provided message object usually
+    // already provides sufficient storage from a previous use
+    pack(message);
+
+    // Send message
+    message.isend(dest, tag);
+}
+
+
 MpiMessage*
 LocalData::issend(const MpiComm& comm,
                   int            dest,
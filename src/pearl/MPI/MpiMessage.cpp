@@ -43,6 +43,20 @@ MpiMessage::MpiMessage(const MpiComm& comm,
 }
 
 
+// --- Reusing message objects ----------------------------------------------
+
+void
+MpiMessage::reset(MPI_Comm comm)
+{
+    // Discard contents, but retain the allocated storage as well as the
+    // byte-order marker in the first byte
+    m_comm     = comm;
+    m_request  = MPI_REQUEST_NULL;
+    m_size     = 1;
+    m_position = 1;
+}
+
+
 // --- Sending & receiving --------------------------------------------------
 
 void
@@ -106,13 +120,9 @@ MpiMessage::recv(int source,
     // Retrieve message length
     MPI_Probe(source, tag, m_comm, &status);
     MPI_Get_count(&status, MPI_BYTE, &length);
-    if (static_cast< size_t >(length) > m_size)
-    {
-        delete[] m_data;
-        m_data     = new uint8_t[length];
-        m_capacity = length;
-        m_size     = length;
-    }
+
+    prepare_receive(length);
+    m_position = 1;
 
     MPI_Recv(m_data, length, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG,
              m_comm, &status);
@@ -130,14 +140,11 @@ MpiMessage::probe(int source,
     {
         int length;
         MPI_Get_count(&status, MPI_BYTE, &length);
-        if (static_cast< size_t >(length) > m_size)
-        {
-            reserve(static_cast< size_t >(length) - m_size);
-        }
+        prepare_receive(length);
+        m_position = 1;
+
         MPI_Recv(m_data, length, MPI_BYTE, status.MPI_SOURCE,
                  status.MPI_TAG, m_comm, &status);
-        m_size     = length;
-        m_position = 1;
 
         return true;
     }
@@ -153,13 +160,9 @@ MpiMessage::bcast(int root)
 
     // Retrieve message length
     MPI_Bcast(&length, 1, MPI_INT, root, m_comm);
-    if (static_cast< size_t >(length) > m_size)
-    {
-        delete[] m_data;
-        m_data     = new uint8_t[length];
-        m_capacity = length;
-        m_size     = length;
-    }
+
+    // No-op on the root, as its message size equals the broadcast length
+    prepare_receive(length);
 
     MPI_Bcast(m_data, length, MPI_BYTE, root, m_comm);
 }
@@ -179,3 +182,26 @@ MpiMessage::get_request() const
 {
     return m_request;
 }
+
+
+// --- Private methods ------------------------------------------------------
+
+/// @brief Prepares the message storage for receiving data.
+///
+/// Sets the message size to @a length bytes.  The storage is only
+/// reallocated if its current capacity is insufficient, in which case the
+/// previous contents are discarded.
+///
+/// @param  length  Size of the incoming message (in bytes)
+///
+void
+MpiMessage::prepare_receive(int length)
+{
+    if (static_cast< size_t >(length) > m_capacity)
+    {
+        delete[] m_data;
+        m_data     = new uint8_t[length];
+        m_capacity = length;
+    }
+    m_size = length;
+}
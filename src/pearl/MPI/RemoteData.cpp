@@ -34,7 +34,70 @@ using namespace pearl;
 using namespace pearl::detail;
 
 
-// --- Destructor -----------------------------------------------------------
+namespace
+{
+// --- Key table helpers ----------------------------------------------------
+
+typedef vector< pair< uint32_t, uint32_t > > KeyTable;
+
+
+struct KeyLess
+{
+    bool
+    operator()(const KeyTable::value_type& entry,
+               uint32_t                    key) const
+    {
+        return entry.first < key;
+    }
+};
+
+
+// Inserts the given entry unless the key is already present (i.e., the same
+// semantics as `std::map::insert`).  Keys usually arrive in ascending order,
+// so appending is checked first.
+void
+insertKey(KeyTable& table,
+          uint32_t  key,
+          uint32_t  index)
+{
+    if (table.empty() || (table.back().first < key))
+    {
+        table.push_back(KeyTable::value_type(key, index));
+
+        return;
+    }
+
+    KeyTable::iterator it = lower_bound(table.begin(), table.end(),
+                                        key, KeyLess());
+    if (it->first != key)
+    {
+        table.insert(it, KeyTable::value_type(key, index));
+    }
+}
+
+
+KeyTable::const_iterator
+findKey(const KeyTable& table,
+        uint32_t        key)
+{
+    KeyTable::const_iterator it = lower_bound(table.begin(), table.end(),
+                                              key, KeyLess());
+    if ((it != table.end()) && (it->first != key))
+    {
+        return table.end();
+    }
+
+    return it;
+}
+}    // unnamed namespace
+
+
+// --- Constructors & destructor --------------------------------------------
+
+RemoteData::RemoteData()
+{
+}
+
 
 RemoteData::~RemoteData()
 {
@@ -48,7 +111,7 @@ void
 RemoteData::add_event(const RemoteEvent& event,
                       uint32_t           key)
 {
-    m_event_keys.insert(KeyMap::value_type(key, m_events.size()));
+    insertKey(m_event_keys, key, m_events.size());
     m_events.push_back(event);
 }
 
@@ -57,7 +120,7 @@ void
 RemoteData::add_buffer(Buffer*  buffer,
                        uint32_t key)
 {
-    m_buffer_keys.insert(KeyMap::value_type(key, m_buffers.size()));
+    insertKey(m_buffer_keys, key, m_buffers.size());
     m_buffers.push_back(buffer);
 }
 
@@ -67,7 +130,7 @@ RemoteData::add_buffer(Buffer*  buffer,
 RemoteEvent
 RemoteData::get_event(uint32_t key) const
 {
-    KeyMap::const_iterator it = m_event_keys.find(key);
+    KeyMap::const_iterator it = findKey(m_event_keys, key);
     if (it == m_event_keys.end())
     {
         throw RuntimeError("RemoteData::get_event(uint32_t) "
@@ -81,7 +144,7 @@ RemoteData::get_event(uint32_t key) const
 Buffer*
 RemoteData::get_buffer(uint32_t key) const
 {
-    KeyMap::const_iterator it = m_buffer_keys.find(key);
+    KeyMap::const_iterator it = findKey(m_buffer_keys, key);
     if (it == m_buffer_keys.end())
     {
         throw RuntimeError("RemoteData::get_buffer(uint32_t) "
@@ -120,72 +183,62 @@ RemoteData::recv(const GlobalDefs& defs,
                  int               tag)
 {
     // Receive message
-    MpiMessage message(comm);
+    MpiMessage& message = get_message(comm);
     message.recv(source, tag);
 
-    // Unpack events
-    {
-        uint32_t key_count = message.get_uint32();
-        for (uint32_t i = 0; i < key_count; ++i)
-        {
-            uint32_t key   = message.get_uint32();
-            uint32_t index = message.get_uint32();
+    unpack(defs, message);
+}
 
-            m_event_keys.insert(KeyMap::value_type(key, index));
-        }
 
-        uint32_t ev_count = message.get_uint32();
-        for (uint32_t i = 0; i < ev_count; ++i)
-        {
-            RemoteEvent event = message.get_event(defs);
-
-            m_events.push_back(event);
-        }
-    }
+void
+RemoteData::bcast(const GlobalDefs& defs,
+                  const MpiComm&    comm,
+                  int               root)
+{
+    // Receive message
+    MpiMessage& message = get_message(comm);
+    message.bcast(root);
 
-    // Unpack buffers
-    {
-        uint32_t key_count = message.get_uint32();
-        for (uint32_t i = 0; i < key_count; ++i)
-        {
-            uint32_t key   = message.get_uint32();
-            uint32_t index = message.get_uint32();
+    unpack(defs, message);
+}
 
-            m_buffer_keys.insert(KeyMap::value_type(key, index));
-        }
 
-        uint32_t ev_count = message.get_uint32();
-        for (uint32_t i = 0; i < ev_count; ++i)
-        {
-            Buffer* buffer = message.get_buffer();
+// --- Private methods ------------------------------------------------------
 
-            m_buffers.push_back(buffer);
-        }
+MpiMessage&
+RemoteData::get_message(const MpiComm& comm)
+{
+    if (m_message.get() == 0)
+    {
+        m_message.reset(new MpiMessage(comm));
+    }
+    else
+    {
+        m_message->reset(comm.getHandle());
     }
+
+    return *m_message;
 }
 
 
 void
-RemoteData::bcast(const GlobalDefs& defs,
-                  const MpiComm&    comm,
-                  int               root)
+RemoteData::unpack(const GlobalDefs& defs,
+                   MpiMessage&       message)
 {
-    // Receive message
-    MpiMessage message(comm);
-    message.bcast(root);
-
     // Unpack events
     {
         uint32_t key_count = message.get_uint32();
+        m_event_keys.reserve(m_event_keys.size() + key_count);
         for (uint32_t i = 0; i < key_count; ++i)
         {
             uint32_t key   = message.get_uint32();
             uint32_t index = message.get_uint32();
 
-            m_event_keys.insert(KeyMap::value_type(key, index));
+            insertKey(m_event_keys, key, index);
         }
 
         uint32_t ev_count = message.get_uint32();
+        m_events.reserve(m_events.size() + ev_count);
         for (uint32_t i = 0; i < ev_count; ++i)
         {
             RemoteEvent event = message.get_event(defs);
@@ -202,7 +255,7 @@ RemoteData::bcast(const GlobalDefs& defs,
             uint32_t key   = message.get_uint32();
             uint32_t index = message.get_uint32();
 
-            m_buffer_keys.insert(KeyMap::value_type(key, index));
+            insertKey(m_buffer_keys, key, index);
         }
 
         uint32_t ev_count = message.get_uint32();
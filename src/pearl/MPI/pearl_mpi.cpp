@@ -134,6 +134,10 @@ pearl::PEARL_mpi_unify_calltree(GlobalDefs& defs)
         --maxIter;
     }
 
+    // All processes share the callpaths provided by the global definitions,
+    // thus only callpaths added afterwards need to be exchanged
+    const uint32_t numCommon = ctree->numCommon();
+
     // Hierarchical call-tree unification
     for (iter = 0; iter < maxIter; ++iter)
     {
@@ -144,11 +148,10 @@ pearl::PEARL_mpi_unify_calltree(GlobalDefs& defs)
         // Am I a receiver and is there a corresponding sender?
         if (((rank % step) == 0) && (source < size))
         {
-            // Receive and merge local call trees
+            // Receive and merge local call tree delta
             MpiMessage message(MPI_COMM_WORLD);
             message.recv(source, 0);
-            CallTree local_ctree(defs, message);
-            ctree->merge(local_ctree);
+            ctree->mergeDelta(defs, message);
         }
 
         /* Am I a sender? */
@@ -156,17 +159,26 @@ pearl::PEARL_mpi_unify_calltree(GlobalDefs& defs)
         {
             int dest = rank - dist;    // Receiver rank
 
-            // Pack and send local call tree
+            // Pack and send local call tree delta
             MpiMessage message(MPI_COMM_WORLD);
-            ctree->pack(message);
+            ctree->packDelta(message, numCommon);
             message.send(dest, 0);
         }
     }
 
-    // Broadcast global call tree
+    // Broadcast delta of global call tree; merging it into the common part
+    // of the local call tree yields callpath identifiers consistent with
+    // rank 0
     MpiMessage message(MPI_COMM_WORLD);
-    ctree->pack(message);
+    if (rank == 0)
+    {
+        ctree->packDelta(message, numCommon);
+    }
     message.bcast(0);
-    CallTree* global_ctree = new CallTree(defs, message);
-    mutableDefs.setCallTree(global_ctree);
+    if (rank != 0)
+    {
+        ctree->truncate(numCommon);
+        ctree->mergeDelta(defs, message);
+    }
+    ctree->setCommon();
 }
@@ -260,6 +260,73 @@ Buffer::put_double(const double& value)
 }
 
 
+/**
+ *  Appends the given array of @a count unsigned 32-bit integer @a values to
+ *  the buffer. The required buffer space is reserved only once and the data
+ *  is copied in bulk, which is considerably faster than appending the values
+ *  one by one.
+ *
+ *  @param values Pointer to the first value to be appended
+ *  @param count  Number of values
+ **/
+void
+Buffer::put_uint32_array(const uint32_t* values,
+                         std::size_t     count)
+{
+    put_array(values, count);
+}
+
+
+/**
+ *  Appends the given array of @a count unsigned 64-bit integer @a values to
+ *  the buffer. See put_uint32_array() for details.
+ *
+ *  @param values Pointer to the first value to be appended
+ *  @param count  Number of values
+ **/
+void
+Buffer::put_uint64_array(const uint64_t* values,
+                         std::size_t     count)
+{
+    put_array(values, count);
+}
+
+
+/**
+ *  Appends the given array of @a count double-precision floating-point
+ *  @a values to the buffer. See put_uint32_array() for details.
+ *
+ *  @param values Pointer to the first value to be appended
+ *  @param count  Number of values
+ **/
+void
+Buffer::put_double_array(const double* values,
+                         std::size_t   count)
+{
+    put_array(values, count);
+}
+
+
+/**
+ *  Appends the given @a value string (i.e., its length followed by the
+ *  characters) to the buffer. If not enough buffer space is available, the
+ *  buffer will be automatically resized.
+ *
+ *  @param value String to be appended
+ **/
+void
+Buffer::put_string(const std::string& value)
+{
+    const uint32_t length = value.length();
+    put_value(length);
+
+    // Increase capacity if necessary
+    reserve(length);
+    memcpy(m_data + m_size, value.data(), length);
+    m_size += length;
+}
+
+
 /**
  *  Appends the data of the given @a event to the buffer. If not enough
  *  buffer space is available, the buffer will be automatically resized.
@@ -407,6 +474,73 @@ Buffer::get_double()
 }
 
 
+/**
+ *  Reads @a count unsigned 32-bit integer values stored in the buffer at the
+ *  current read position and stores them in the array pointed to by
+ *  @a values. The data is copied in bulk; byte swapping is only applied if
+ *  the buffer originates from a system with a different byte order.
+ *
+ *  @param values Pointer to the result array (at least @a count entries)
+ *  @param count  Number of values
+ **/
+void
+Buffer::get_uint32_array(uint32_t*   values,
+                         std::size_t count)
+{
+    get_array(values, count);
+}
+
+
+/**
+ *  Reads @a count unsigned 64-bit integer values stored in the buffer at the
+ *  current read position. See get_uint32_array() for details.
+ *
+ *  @param values Pointer to the result array (at least @a count entries)
+ *  @param count  Number of values
+ **/
+void
+Buffer::get_uint64_array(uint64_t*   values,
+                         std::size_t count)
+{
+    get_array(values, count);
+}
+
+
+/**
+ *  Reads @a count double-precision floating-point values stored in the
+ *  buffer at the current read position. See get_uint32_array() for details.
+ *
+ *  @param values Pointer to the result array (at least @a count entries)
+ *  @param count  Number of values
+ **/
+void
+Buffer::get_double_array(double*     values,
+                         std::size_t count)
+{
+    get_array(values, count);
+}
+
+
+/**
+ *  Returns the string stored in the buffer at the current read position.
+ *
+ *  @return String value
+ **/
+string
+Buffer::get_string()
+{
+    uint32_t length;
+    get_value(length);
+
+    assert((m_size - m_position) >= length);
+
+    string value(reinterpret_cast< const char* >(m_data + m_position), length);
+    m_position += length;
+
+    return value;
+}
+
+
 /**
  *  Returns a new instance of RemoteEvent, initialized with the data stored
  *  in the buffer at the current read position.
@@ -494,6 +628,60 @@ Buffer::get_value(T& value)
 }
 
 
+/**
+ *  Appends the array of @a count items pointed to by @a values to the
+ *  buffer. If not enough buffer space is available, the buffer will be
+ *  automatically resized.
+ *
+ *  @param values Pointer to the first item
+ *  @param count  Number of items
+ **/
+template< typename T >
+void
+Buffer::put_array(const T*    values,
+                  std::size_t count)
+{
+    const size_t nbytes = count * sizeof(T);
+
+    // If necessary, resize buffer
+    reserve(nbytes);
+
+    // Append values
+    memcpy(m_data + m_size, values, nbytes);
+    m_size += nbytes;
+}
+
+
+/**
+ *  Reads @a count items from the buffer at the current read position and
+ *  stores them in the array pointed to by @a values.
+ *
+ *  @param values Pointer to the result array
+ *  @param count  Number of items
+ **/
+template< typename T >
+void
+Buffer::get_array(T*          values,
+                  std::size_t count)
+{
+    const size_t nbytes = count * sizeof(T);
+    assert((m_size - m_position) >= nbytes);
+
+    // Copy values
+    memcpy(values, m_data + m_position, nbytes);
+    m_position += nbytes;
+
+    // Adjust byte order
+    if (m_data[0] != ELG_BYTE_ORDER)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            swap_bytes(&values[i], sizeof(T));
+        }
+    }
+}
+
+
 /**
  *  Increases buffer capacity to be able to contain at least @a nbytes more
  *  bytes of data.
@@ -48,27 +48,66 @@ using namespace pearl::detail;
 /*-------------------------------------------------------------------------*/
 
 
+// --- Local helper functions -----------------------------------------------
+
+namespace
+{
+/// @brief Compute callpath hash value.
+///
+/// Computes the hash value used to locate a callpath in the callpath hash
+/// index, based on the identifiers of its @a parent, @a region, and
+/// @a callsite.
+///
+/// @param  parent    Parent callpath identifier (Callpath::NO_ID for roots)
+/// @param  region    Region identifier
+/// @param  callsite  Callsite identifier
+///
+/// @return Hash value
+///
+inline uint64_t
+hashCallpath(const uint32_t parent,
+             const uint32_t region,
+             const uint32_t callsite)
+{
+    uint64_t key = (static_cast< uint64_t >(region) << 32) | callsite;
+    key ^= static_cast< uint64_t >(parent) * 0x9e3779b97f4a7c15ULL;
+    key ^= key >> 31;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 29;
+
+    return key;
+}
+}    // unnamed namespace
+
+
 // --- Constructors & destructor --------------------------------------------
 
 CallTree::CallTree()
-    : mModified(false)
+    : mModified(false),
+      mNumCommon(0)
 {
 }
 
 
-/// @todo Replace get_uint32() calls by more generic version
 CallTree::CallTree(const GlobalDefs& defs,
                    Buffer&           buffer)
-    : mModified(false)
+    : mModified(false),
+      mNumCommon(0)
 {
     try
     {
         uint32_t count = buffer.get_uint32();
+
+        vector< uint32_t > records(3 * count);
+        if (count > 0)
+        {
+            buffer.get_uint32_array(&records[0], records.size());
+        }
         for (uint32_t id = 0; id < count; ++id)
         {
-            uint32_t regionId   = buffer.get_uint32();
-            uint32_t callsiteId = buffer.get_uint32();
-            uint32_t parentId   = buffer.get_uint32();
+            uint32_t regionId   = records[3 * id];
+            uint32_t callsiteId = records[3 * id + 1];
+            uint32_t parentId   = records[3 * id + 2];
 
             addCallpath(new Callpath(id,
                                      defs.getRegion(regionId),
@@ -149,10 +188,49 @@ CallTree::addCallpath(Callpath* const callpath)
     {
         mRootCallpaths.push_back(callpath);
     }
+    if (!mIndex.empty())
+    {
+        insertIndex(callpath);
+    }
     mModified = true;
 }
 
 
+void
+CallTree::truncate(const uint32_t count)
+{
+    // Remove callpaths in reverse creation order, so that each one is the
+    // last entry in the child list of its parent (or the root list)
+    for (size_t id = mCallpaths.size(); id > count; --id)
+    {
+        Callpath* const callpath = mCallpaths[id - 1];
+        Callpath* const parent   = callpath->getParent();
+        if (parent)
+        {
+            assert(parent->mChildren.back() == callpath);
+            parent->mChildren.pop_back();
+        }
+        else
+        {
+            assert(mRootCallpaths.back() == callpath);
+            mRootCallpaths.pop_back();
+        }
+        delete callpath;
+    }
+
+    if (count < mCallpaths.size())
+    {
+        mCallpaths.resize(count);
+        mIndex.clear();
+        mModified = true;
+    }
+    if (mNumCommon > count)
+    {
+        mNumCommon = count;
+    }
+}
+
+
 // --- Merging of call trees ------------------------------------------------
 
 void
@@ -182,26 +260,68 @@ CallTree::merge(const CallTree& calltree)
 }
 
 
+void
+CallTree::mergeDelta(const GlobalDefs& defs,
+                     Buffer&           buffer)
+{
+    const Callpath::IdType first = buffer.get_uint32();
+    const uint32_t         count = buffer.get_uint32();
+    if (first > mCallpaths.size())
+    {
+        throw RuntimeError("CallTree::mergeDelta(...) -- Invalid delta.");
+    }
+
+    vector< uint32_t > records(3 * count);
+    if (count > 0)
+    {
+        buffer.get_uint32_array(&records[0], records.size());
+    }
+
+    // Callpath IDs in the delta have to be mapped to Callpath objects in the
+    // merged tree, except for the common callpaths preceding the delta
+    vector< Callpath* > idmap;
+    idmap.reserve(count);
+
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        const uint32_t regionId   = records[3 * index];
+        const uint32_t callsiteId = records[3 * index + 1];
+        const uint32_t parentId   = records[3 * index + 2];
+
+        Callpath* parent = NULL;
+        if (parentId != Callpath::NO_ID)
+        {
+            parent = (parentId < first)
+                     ? mCallpaths[parentId]
+                     : idmap.at(parentId - first);
+        }
+        idmap.push_back(getCallpath(defs.getRegion(regionId),
+                                    defs.getCallsite(callsiteId),
+                                    parent));
+    }
+}
+
+
 // --- Serialize call tree data ---------------------------------------------
 
-/// @todo Replace put_uint32() calls by more generic version
 void
 CallTree::pack(Buffer& buffer) const
 {
-    uint32_t count = mCallpaths.size();
+    buffer.put_uint32(mCallpaths.size());
+    packRecords(buffer, 0);
+}
 
-    buffer.put_uint32(count);
-    for (uint32_t id = 0; id < count; ++id)
-    {
-        Callpath*       current  = mCallpaths[id];
-        Callpath*       parent   = current->getParent();
-        const Region&   region   = current->getRegion();
-        const Callsite& callsite = current->getCallsite();
-
-        buffer.put_uint32(region.getId());
-        buffer.put_uint32(callsite.getId());
-        buffer.put_uint32(parent ? parent->getId() : Callpath::NO_ID);
-    }
+
+void
+CallTree::packDelta(Buffer&                buffer,
+                    const Callpath::IdType first) const
+{
+    const uint32_t count = mCallpaths.size();
+    assert(first <= count);
+
+    buffer.put_uint32(first);
+    buffer.put_uint32(count - first);
+    packRecords(buffer, first);
 }
 
 
@@ -218,7 +338,9 @@ CallTree::clear()
     for_each(mCallpaths.begin(), mCallpaths.end(), delete_ptr< Callpath >());
     mCallpaths.clear();
     mRootCallpaths.clear();
-    mModified = false;
+    mIndex.clear();
+    mModified  = false;
+    mNumCommon = 0;
 }
 
 
@@ -262,6 +384,15 @@ CallTree::findCallpath(const Region&   region,
                        const Callsite& callsite,
                        Callpath* const parent) const
 {
+    // Large number of siblings -> Use hash index
+    const uint32_t numSiblings = parent
+                                 ? parent->numChildren()
+                                 : mRootCallpaths.size();
+    if (numSiblings >= INDEX_THRESHOLD)
+    {
+        return lookupCallpath(region, callsite, parent);
+    }
+
     // Has parent -> Search in child list
     if (parent)
     {
@@ -282,6 +413,142 @@ CallTree::findCallpath(const Region&   region,
 }
 
 
+/// @brief Search a particular callpath using the hash index.
+///
+/// Same as findCallpath(), but always uses the callpath hash index, which is
+/// built first if necessary.  If multiple matching callpaths exist, the one
+/// with the lowest identifier is returned, consistent with a linear search.
+///
+/// @param  region    Called region
+/// @param  callsite  Specific callsite (Callsite::UNDEFINED if not applicable)
+/// @param  parent    Parent callpath (NULL for root callpaths)
+///
+/// @return Pointer to callpath object if existent, NULL otherwise
+///
+Callpath*
+CallTree::lookupCallpath(const Region&   region,
+                         const Callsite& callsite,
+                         Callpath* const parent) const
+{
+    if (mIndex.empty())
+    {
+        buildIndex();
+    }
+
+    const size_t mask  = mIndex.size() - 1;
+    size_t       index = hashCallpath(parent ? parent->getId() : Callpath::NO_ID,
+                                      region.getId(),
+                                      callsite.getId()) & mask;
+    while (mIndex[index] != Callpath::NO_ID)
+    {
+        Callpath* const callpath = mCallpaths[mIndex[index]];
+        if (  (callpath->getParent() == parent)
+           && (callpath->getRegion().getId() == region.getId())
+           && (callpath->getCallsite().getId() == callsite.getId()))
+        {
+            return callpath;
+        }
+        index = (index + 1) & mask;
+    }
+
+    return NULL;
+}
+
+
+/// @brief Build the callpath hash index.
+///
+/// (Re-)Builds the callpath hash index from scratch, sized such that its load
+/// factor does not exceed 50% even after the number of callpaths doubled.
+///
+void
+CallTree::buildIndex() const
+{
+    size_t size = 64;
+    while (size < (4 * mCallpaths.size()))
+    {
+        size *= 2;
+    }
+
+    mIndex.assign(size, Callpath::NO_ID);
+
+    // Insert in ID order, so that earlier callpaths are found first when
+    // probing
+    const size_t count = mCallpaths.size();
+    for (size_t id = 0; id < count; ++id)
+    {
+        insertIndex(mCallpaths[id]);
+    }
+}
+
+
+/// @brief Add a callpath to the hash index.
+///
+/// Inserts the given @a callpath into the callpath hash index using linear
+/// probing.  If the load factor would exceed 50%, the index is rebuilt with
+/// a larger size instead.
+///
+/// @param  callpath  %Callpath to insert
+///
+void
+CallTree::insertIndex(const Callpath* const callpath) const
+{
+    if ((2 * mCallpaths.size()) > mIndex.size())
+    {
+        buildIndex();
+
+        return;
+    }
+
+    const Callpath* const parent = callpath->getParent();
+    const size_t          mask   = mIndex.size() - 1;
+    size_t                index  = hashCallpath(parent
+                                                ? parent->getId()
+                                                : Callpath::NO_ID,
+                                                callpath->getRegion().getId(),
+                                                callpath->getCallsite().getId())
+                                   & mask;
+    while (mIndex[index] != Callpath::NO_ID)
+    {
+        index = (index + 1) & mask;
+    }
+    mIndex[index] = callpath->getId();
+}
+
+
+/// @brief Pack callpath records.
+///
+/// Serializes the (region ID, callsite ID, parent ID) triples of all
+/// callpaths with an ID greater than or equal to @a first into @a buffer.
+/// The triples are collected in a local array and then appended in bulk.
+///
+/// @param  buffer  Buffer to pack the records into
+/// @param  first   ID of the first callpath to pack
+///
+void
+CallTree::packRecords(Buffer&                buffer,
+                      const Callpath::IdType first) const
+{
+    const uint32_t count = mCallpaths.size();
+    if (first >= count)
+    {
+        return;
+    }
+
+    vector< uint32_t > records;
+    records.reserve(3 * (count - first));
+    for (uint32_t id = first; id < count; ++id)
+    {
+        const Callpath* current = mCallpaths[id];
+        const Callpath* parent  = current->getParent();
+
+        records.push_back(current->getRegion().getId());
+        records.push_back(current->getCallsite().getId());
+        records.push_back(parent ? parent->getId() : Callpath::NO_ID);
+    }
+    buffer.put_uint32_array(&records[0], records.size());
+}
+
+
 // --- Related functions ----------------------------------------------------
 
 namespace pearl
@@ -151,6 +151,18 @@ class CallTree
         void
         addCallpath(Callpath* callpath);
 
+        /// @brief Remove trailing callpaths.
+        ///
+        /// Removes and releases all callpaths with an identifier greater than
+        /// or equal to @a count, i.e., shrinks the call tree to its first
+        /// @a count callpaths.  Callpaths are always created after their
+        /// parents, thus the remaining callpaths form a valid call tree.
+        ///
+        /// @param  count  Number of callpaths to keep
+        ///
+        void
+        truncate(uint32_t count);
+
         /// @}
         /// @name Merging of call trees
         /// @{
@@ -168,6 +180,20 @@ class CallTree
         void
         merge(const CallTree& calltree);
 
+        /// @brief Merge serialized call tree delta.
+        ///
+        /// Merges the callpaths serialized by packDelta() into the given memory
+        /// @a buffer into the tree represented by the instance, equivalent to
+        /// merge().  The first callpaths of both call trees up to the start
+        /// of the delta are required to be identical.
+        ///
+        /// @param  defs    Global definition object
+        /// @param  buffer  Memory buffer object
+        ///
+        void
+        mergeDelta(const GlobalDefs& defs,
+                   Buffer&           buffer);
+
         /// @}
         /// @name Serialize call tree data
         /// @{
@@ -183,6 +209,21 @@ class CallTree
         void
         pack(Buffer& buffer) const;
 
+        /// @brief Serialize call tree delta into memory buffer.
+        ///
+        /// Serializes only the callpaths with identifiers greater than or
+        /// equal to @a first into the provided memory @a buffer, e.g., the
+        /// callpaths added to a call tree after marking its callpaths as
+        /// common to all processes.  The delta can then be merged into call
+        /// trees sharing the same first @a first callpaths using mergeDelta().
+        ///
+        /// @param  buffer  Memory buffer object
+        /// @param  first   Identifier of the first callpath to serialize
+        ///
+        void
+        packDelta(Buffer&          buffer,
+                  Callpath::IdType first) const;
+
         /// @}
         /// @name Tracking modifications
         /// @{
@@ -199,6 +240,32 @@ class CallTree
             mModified = flag;
         }
 
+        /// @brief Get number of common callpaths.
+        ///
+        /// Returns the number of callpaths marked as common by setCommon(),
+        /// i.e., the callpaths known to be identical in the call trees of
+        /// all processes.
+        ///
+        /// @return Number of common callpaths
+        ///
+        uint32_t
+        numCommon() const
+        {
+            return mNumCommon;
+        }
+
+        /// @brief Mark callpaths as common.
+        ///
+        /// Marks all callpaths currently stored in the call tree as common to
+        /// the call trees of all processes, e.g., as they were provided by
+        /// the global definitions.
+        ///
+        void
+        setCommon()
+        {
+            mNumCommon = mCallpaths.size();
+        }
+
         /// @}
 
 
@@ -208,6 +275,16 @@ class CallTree
         /// Container type for callpaths
         typedef std::vector< Callpath* > CallpathContainer;
 
+        /// Container type for the callpath hash index
+        typedef std::vector< Callpath::IdType > IndexContainer;
+
+
+        // --- Static class data ---------------------------
+
+        /// Minimum number of sibling callpaths for which callpath lookups use
+        /// the hash index instead of a linear search
+        static const uint32_t INDEX_THRESHOLD = 16;
+
 
         /// Callpath definitions: callpath ID |-@> callpath
         CallpathContainer mCallpaths;
@@ -215,10 +292,18 @@ class CallTree
         /// List of root callpaths
         CallpathContainer mRootCallpaths;
 
+        /// Open-addressing hash index (parent, region, callsite) |-@> callpath
+        /// ID; lazily built on the first lookup among a large number of
+        /// siblings, empty otherwise
+        mutable IndexContainer mIndex;
+
         /// Denotes whether the call tree has been modified after the last
         /// reset of this flag
         bool mModified;
 
+        /// Number of callpaths common to the call trees of all processes
+        uint32_t mNumCommon;
+
 
         // --- Private methods & friends -------------------
 
@@ -233,6 +318,21 @@ class CallTree
                      const Callsite& callsite,
                      Callpath*       parent) const;
 
+        Callpath*
+        lookupCallpath(const Region&   region,
+                       const Callsite& callsite,
+                       Callpath*       parent) const;
+
+        void
+        buildIndex() const;
+
+        void
+        insertIndex(const Callpath* callpath) const;
+
+        void
+        packRecords(Buffer&          buffer,
+                    Callpath::IdType first) const;
+
 
         friend std::ostream&
         operator<<(std::ostream&   stream,
@@ -157,6 +157,16 @@ Event::is_valid() const
 Event
 Event::enterptr() const
 {
+    // Use matching index computed during trace preprocessing (if available)
+    if (m_index < m_trace->m_enterptr.size())
+    {
+        const uint32_t index = m_trace->m_enterptr[m_index];
+        if (index != LocalTrace::NO_INDEX)
+        {
+            return Event(m_trace, index);
+        }
+    }
+
     // Search for associated ENTER event while keeping track of nested
     // ENTERs/LEAVEs (necessary because of possible buffer flushing)
     int   depth = 0;
@@ -229,6 +239,38 @@ Event::enterptr() const
 Event
 Event::leaveptr() const
 {
+    // Use matching index computed during trace preprocessing (if available).
+    // The LEAVE event is looked up via the ENTER event of the enclosing
+    // region (or the event itself in case of an ENTER).
+    if (m_index < m_trace->m_enterptr.size())
+    {
+        uint32_t index = m_index;
+        if (!ITEM->isOfType(GROUP_ENTER))
+        {
+            index = m_trace->m_enterptr[index];
+            if (  (index != LocalTrace::NO_INDEX)
+               && ITEM->isOfType(GROUP_LEAVE))
+            {
+                index = m_trace->m_enterptr[index];
+            }
+        }
+        if (index != LocalTrace::NO_INDEX)
+        {
+            index = m_trace->m_leaveptr[index];
+            if (index != LocalTrace::NO_INDEX)
+            {
+                return Event(m_trace, index);
+            }
+        }
+
+        // Regions still active at the end of a partial trace segment are
+        // left in a later segment
+        if (m_trace->is_partial())
+        {
+            return m_trace->end();
+        }
+    }
+
     // Search for associated LEAVE event while keeping track of nested
     // ENTERs/LEAVEs (necessary because of possible buffer flushing)
     int   depth = 0;
@@ -395,17 +437,29 @@ Event::prev_request_event() const
 
 // --- Access local event information ---------------------------------------
 
+event_t
+Event::get_type() const
+{
+    return ITEM->getType();
+}
+
+
 Callpath*
 Event::get_cnode() const
 {
-    if (const Enter_rep* event = dynamic_cast< const Enter_rep* >(ITEM))
+    switch (get_type())
     {
-        return event->getCallpath();
-    }
+        case ENTER:
+        case ENTER_CS:
+        case ENTER_PROGRAM:
+            return static_cast< const Enter_rep* >(ITEM)->getCallpath();
 
-    if (const Leave_rep* event = dynamic_cast< const Leave_rep* >(ITEM))
-    {
-        return event->getCallpath();
+        case LEAVE:
+        case LEAVE_PROGRAM:
+            return static_cast< const Leave_rep* >(ITEM)->getCallpath();
+
+        default:
+            break;
     }
 
     return enterptr().get_cnode();
@@ -37,6 +37,7 @@
 #include <pearl/Error.h>
 
 #include "iomanip_detail.h"
+#include "pearl_memory.h"
 
 #if defined(__SUNPRO_CC)
     #include <pearl/Callsite.h>
@@ -67,6 +68,23 @@ Event_rep::~Event_rep()
 }
 
 
+// --- Memory allocation operators ------------------------------------------
+
+void*
+Event_rep::operator new(const size_t objectSize)
+{
+    return memoryArenaAllocate(objectSize);
+}
+
+
+void
+Event_rep::operator delete(void* const  deadObject,
+                           const size_t objectSize)
+{
+    memoryArenaDeallocate(deadObject, objectSize);
+}
+
+
 // --- Access event data ----------------------------------------------------
 
 const Region&
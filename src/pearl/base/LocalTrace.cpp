@@ -36,42 +36,56 @@
 #include <pearl/Region.h>
 
 #include "CallTree.h"
-#include "Functors.h"
+#include "MemoryArena.h"
 #include "MutableGlobalDefs.h"
+#include "SegmentState.h"
+#include "pearl_memory.h"
 
 using namespace std;
 using namespace pearl;
 using namespace pearl::detail;
 
 
+// --- Static class data ----------------------------------------------------
+
+const uint32_t LocalTrace::NO_INDEX;
+const uint32_t LocalTrace::BLOCK_SIZE;
+
+
 // --- Constructors & destructor --------------------------------------------
 
 LocalTrace::LocalTrace(const GlobalDefs& defs,
-                       const Location&   location)
+                       const Location&   location,
+                       uint64_t          numEvents)
     : m_defs(defs),
       m_omp_parallel(0),
       m_mpi_regions(0),
-      m_location(const_cast< Location* >(&location))
+      m_location(const_cast< Location* >(&location)),
+      m_arena(0),
+      m_segments(0)
 {
-    // Estimate capacity for the event representation vector.
+    // Estimate capacity for the event representation vector using the
+    // given number of events (usually the one stored in the location
+    // definition, or the segment size when reading segment-wise).
     //
     // The number of events may be underestimated in the presence of buffer
     // flushes and overestimated in the presence of metric events.  However,
     // even if the number is underestimated and a single reallocation happens,
     // this is still more efficient than resizing the event representation
     // vector multiple times on-the-fly.
-    const uint64_t numEvents = m_location->getNumEvents();
     if (numEvents > 0)
     {
         m_events.reserve(numEvents);
     }
+
+    m_arena = new MemoryArena;
 }
 
 
 LocalTrace::~LocalTrace()
 {
-    /* Delete events */
-    for_each(m_events.begin(), m_events.end(), delete_ptr< Event_rep >());
+    release_events();
+    delete m_segments;
 }
 
 
@@ -112,6 +126,105 @@ LocalTrace::at(uint32_t index) const
 }
 
 
+// --- Searching for events -------------------------------------------------
+
+/// @brief Find next event of a given set of types.
+///
+/// Returns an iterator to the first event in the range [@a first, @a last)
+/// whose type is contained in @a types.  Blocks of events that do not
+/// contain any of the requested types are skipped as a whole, i.e., the
+/// cost of the search is proportional to the number of relevant blocks
+/// rather than the number of events.
+///
+/// @param  first  Start of the search range
+/// @param  last   End of the search range
+/// @param  types  Set of event types to search for
+/// @return Iterator to the matching event, or @a last if there is none
+///
+LocalTrace::iterator
+LocalTrace::find(const LocalTrace::iterator& first,
+                 const LocalTrace::iterator& last,
+                 const type_set&             types) const
+{
+    assert(first.m_trace == this && last.m_trace == this);
+
+    if (m_blocktypes.empty())
+    {
+        build_block_index();
+    }
+
+    uint32_t index = first.m_index;
+    while (index < last.m_index)
+    {
+        const uint32_t block = index / BLOCK_SIZE;
+        const uint32_t limit = min((block + 1) * BLOCK_SIZE, last.m_index);
+
+        if ((m_blocktypes[block] & types).any())
+        {
+            for (; index < limit; ++index)
+            {
+                if (types.test(m_events[index]->getType()))
+                {
+                    return Event(this, index);
+                }
+            }
+        }
+        index = limit;
+    }
+
+    return last;
+}
+
+
+/// @brief Find next event of a given set of types in reverse order.
+///
+/// Returns a reverse iterator to the first event in the reverse range
+/// [@a first, @a last) whose type is contained in @a types, skipping
+/// irrelevant blocks of events as described above.
+///
+/// @param  first  Start of the search range
+/// @param  last   End of the search range
+/// @param  types  Set of event types to search for
+/// @return Reverse iterator to the matching event, or @a last if there is
+///         none
+///
+LocalTrace::reverse_iterator
+LocalTrace::find(const LocalTrace::reverse_iterator& first,
+                 const LocalTrace::reverse_iterator& last,
+                 const type_set&                     types) const
+{
+    assert(first.base().m_trace == this && last.base().m_trace == this);
+
+    if (m_blocktypes.empty())
+    {
+        build_block_index();
+    }
+
+    // Reverse iterators refer to the event preceding their base position
+    uint32_t       index = first.base().m_index;
+    const uint32_t lower = last.base().m_index;
+    while (index > lower)
+    {
+        const uint32_t block = (index - 1) / BLOCK_SIZE;
+        const uint32_t limit = max(block * BLOCK_SIZE, lower);
+
+        if ((m_blocktypes[block] & types).any())
+        {
+            for (; index > limit; --index)
+            {
+                if (types.test(m_events[index - 1]->getType()))
+                {
+                    return reverse_iterator(Event(this, index));
+                }
+            }
+        }
+        index = limit;
+    }
+
+    return last;
+}
+
+
 // --- Get trace information ------------------------------------------------
 
 uint32_t
@@ -156,6 +269,87 @@ LocalTrace::get_definitions() const
 }
 
 
+/// @brief Get memory usage.
+///
+/// Returns the amount of memory held by the event data of the trace, i.e.,
+/// the memory arena holding the event representations, the event container,
+/// and the ENTER/LEAVE matching index (if already computed).  Memory used by
+/// events that are not allocated from the arena is not included.
+///
+/// @return Memory usage (in bytes)
+///
+size_t
+LocalTrace::memory_usage() const
+{
+    return m_arena->size()
+           + m_events.capacity() * sizeof(Event_rep*)
+           + (m_enterptr.capacity() + m_leaveptr.capacity()) * sizeof(uint32_t);
+}
+
+
+// --- Get segment information ----------------------------------------------
+
+/// @brief Get segment begin.
+///
+/// Returns the position of the first event of the trace segment (not
+/// counting carried events, see num_carried()) in the event stream of the
+/// location.  Traces read at once always start at position 0.
+///
+/// @return Segment begin
+///
+uint64_t
+LocalTrace::segment_begin() const
+{
+    return m_segments ? m_segments->getBegin() : 0;
+}
+
+
+/// @brief Get segment end.
+///
+/// Returns the position following the last event of the trace segment in
+/// the event stream of the location.  It can be passed to
+/// TraceArchive::readTraceSegment() to read the next segment.
+///
+/// @return Segment end
+///
+uint64_t
+LocalTrace::segment_end() const
+{
+    return m_segments ? m_segments->getEnd() : m_events.size();
+}
+
+
+/// @brief Get number of carried events.
+///
+/// Returns the number of events at the beginning of a trace segment which
+/// are copies of the ENTER events of regions entered in earlier segments
+/// and still active at the segment begin.
+///
+/// @return Number of carried events
+///
+uint32_t
+LocalTrace::num_carried() const
+{
+    return m_segments ? m_segments->getNumCarried() : 0;
+}
+
+
+/// @brief Check for partial traces.
+///
+/// Returns whether the trace is a segment ending before the end of the
+/// event stream of the location.  In this case, the regions that are still
+/// active at the segment end are left in a later segment, i.e., ENTER
+/// events may lack a matching LEAVE event.
+///
+/// @return True if the trace is partial, false otherwise
+///
+bool
+LocalTrace::is_partial() const
+{
+    return m_segments && m_segments->isPartial();
+}
+
+
 // --- Store new events -----------------------------------------------------
 
 void
@@ -180,6 +374,7 @@ LocalTrace::add_event(Event_rep* event)
 
     // Store event representation
     m_events.push_back(event);
+    m_blocktypes.clear();
 }
 
 
@@ -192,6 +387,8 @@ LocalTrace::remove_if(bool (* predicate)(const Event_rep* event))
                                     m_events.end(),
                                     predicate) - m_events.begin();
 
+    invalidate_index();
+
     return Event(this, index);
 }
 
@@ -202,6 +399,8 @@ LocalTrace::insert(LocalTrace::iterator pos,
 {
     m_events.insert(m_events.begin() + pos.m_index, event);
 
+    invalidate_index();
+
     const MutableGlobalDefs& mutableDefs =
         dynamic_cast< const MutableGlobalDefs& >(m_defs);
     mutableDefs.getCallTree()->setModified();
@@ -217,6 +416,8 @@ LocalTrace::erase(LocalTrace::iterator pos)
 
     m_events.erase(m_events.begin() + pos.m_index);
 
+    invalidate_index();
+
     const MutableGlobalDefs& mutableDefs =
         dynamic_cast< const MutableGlobalDefs& >(m_defs);
     mutableDefs.getCallTree()->setModified();
@@ -234,6 +435,8 @@ LocalTrace::erase(LocalTrace::iterator begin,
     m_events.erase(m_events.begin() + begin.m_index,
                    m_events.begin() + end.m_index);
 
+    invalidate_index();
+
     const MutableGlobalDefs& mutableDefs =
         dynamic_cast< const MutableGlobalDefs& >(m_defs);
     mutableDefs.getCallTree()->setModified();
@@ -248,6 +451,8 @@ LocalTrace::replace(LocalTrace::iterator pos,
 {
     m_events[pos.m_index] = event;
 
+    invalidate_index();
+
     const MutableGlobalDefs& mutableDefs =
         dynamic_cast< const MutableGlobalDefs& >(m_defs);
     mutableDefs.getCallTree()->setModified();
@@ -262,6 +467,8 @@ LocalTrace::swap(const LocalTrace::iterator& a,
 {
     std::iter_swap(m_events.begin() + a.m_index, m_events.begin() + b.m_index);
 
+    invalidate_index();
+
     const MutableGlobalDefs& mutableDefs =
         dynamic_cast< const MutableGlobalDefs& >(m_defs);
     mutableDefs.getCallTree()->setModified();
@@ -277,3 +484,87 @@ LocalTrace::operator[](uint32_t index) const
 {
     return m_events[index];
 }
+
+
+/// @brief Remove all events
+///
+/// Deletes all events and replaces the memory arena by a new, empty one,
+/// so that the trace object can be refilled with the next trace segment.
+/// The capacity of the event container is retained.
+///
+void
+LocalTrace::clear()
+{
+    release_events();
+    m_events.clear();
+    m_arena = new MemoryArena;
+
+    m_omp_parallel = 0;
+    m_mpi_regions  = 0;
+    invalidate_index();
+}
+
+
+/// @brief Delete all events and release the memory arena
+///
+/// The storage of events allocated from the arena is released in bulk, so
+/// only their destructors need to run.  Afterwards, the event container
+/// holds dangling pointers and the arena pointer is invalid.
+///
+void
+LocalTrace::release_events()
+{
+    for (container_type::iterator it = m_events.begin();
+         it != m_events.end();
+         ++it)
+    {
+        Event_rep* const event = *it;
+        if (m_arena->contains(event))
+        {
+            event->~Event_rep();
+        }
+        else
+        {
+            delete event;
+        }
+    }
+
+    memoryReleaseArena(m_arena);
+    delete m_arena;
+}
+
+
+/// @brief Invalidate the event matching index
+///
+/// Discards the ENTER/LEAVE matching index computed during trace
+/// preprocessing, as it is no longer valid after modifying the event
+/// sequence.  Event::enterptr() and Event::leaveptr() then fall back to
+/// searching the event trace.  The event type block index is discarded
+/// as well and rebuilt on the next call to find().
+///
+void
+LocalTrace::invalidate_index()
+{
+    std::vector< uint32_t >().swap(m_enterptr);
+    std::vector< uint32_t >().swap(m_leaveptr);
+    m_blocktypes.clear();
+}
+
+
+/// @brief Build the event type block index
+///
+/// Records the set of event types occurring in each block of BLOCK_SIZE
+/// consecutive events.  The index is used by find() to skip over blocks
+/// without any relevant events.
+///
+void
+LocalTrace::build_block_index() const
+{
+    const uint32_t numEvents = m_events.size();
+
+    m_blocktypes.assign((numEvents + BLOCK_SIZE - 1) / BLOCK_SIZE, type_set());
+    for (uint32_t index = 0; index < numEvents; ++index)
+    {
+        m_blocktypes[index / BLOCK_SIZE].set(m_events[index]->getType());
+    }
+}
@@ -500,8 +500,10 @@ MutableGlobalDefs::setup()
         addRegion(mThreadRootRegion);
     }
 
-    // Reset call tree modification flag
+    // Reset call tree modification flag; all callpaths defined so far are
+    // identical on all processes
     mCallTree->setModified(false);
+    mCallTree->setCommon();
 }
 
 
@@ -32,7 +32,9 @@
 
 #include <cassert>
 
+#include <pearl/Buffer.h>
 #include <pearl/Error.h>
+#include <pearl/Location.h>
 
 #include "LocalIdMaps.h"
 #include "MutableGlobalDefs.h"
@@ -40,6 +42,7 @@
 #include "Otf2DefCallbacks.h"
 #include "Otf2EvtCallbacks.h"
 #include "Otf2LockCallbacks.h"
+#include "SegmentState.h"
 #include "pearl_ipc.h"
 
 using namespace std;
@@ -143,6 +146,57 @@ Otf2Archive::openArchive()
 
 void
 Otf2Archive::readDefinitions(GlobalDefs* defs)
+{
+    MutableGlobalDefs* mutableDefs = dynamic_cast< MutableGlobalDefs* >(defs);
+    assert(mutableDefs);
+    Otf2DefCbData cbData(*mutableDefs);
+
+    readGlobalDefs(cbData);
+
+    applyTimerData(defs, cbData.mTimerResolution, cbData.mGlobalOffset);
+}
+
+
+void
+Otf2Archive::readPackedDefinitions(Buffer& buffer)
+{
+    // Definition records are only recorded, thus the definitions object
+    // passed to the callbacks remains untouched
+    MutableGlobalDefs unused;
+    Otf2DefCbData     cbData(unused);
+    cbData.mPackBuffer = &buffer;
+
+    readGlobalDefs(cbData);
+
+    // Mark end of packed records
+    otf2DefPackEnd(buffer);
+}
+
+
+void
+Otf2Archive::unpackDefinitions(GlobalDefs* defs,
+                               Buffer&     buffer)
+{
+    MutableGlobalDefs* mutableDefs = dynamic_cast< MutableGlobalDefs* >(defs);
+    assert(mutableDefs);
+    Otf2DefCbData cbData(*mutableDefs);
+
+    // Replay recorded definition records
+    otf2DefUnpackRecords(cbData, buffer);
+
+    applyTimerData(defs, cbData.mTimerResolution, cbData.mGlobalOffset);
+}
+
+
+/// @brief Read OTF2 global definitions.
+///
+/// Reads all global definition records of the archive, passing them to the
+/// definition callbacks using the given callback data @a cbData.  Depending
+/// on whether a pack buffer is set in @a cbData, the records are either
+/// applied to the associated definitions object or only packed.
+///
+void
+Otf2Archive::readGlobalDefs(Otf2DefCbData& cbData)
 {
     // Create definition reader
     OTF2_GlobalDefReader* defReader;
@@ -193,9 +247,6 @@ Otf2Archive::readDefinitions(GlobalDefs* defs)
     SET_DEF_CALLBACK(SystemTreeNodeProperty);
 
     // Install callbacks
-    MutableGlobalDefs* mutableDefs = dynamic_cast< MutableGlobalDefs* >(defs);
-    assert(mutableDefs);
-    Otf2DefCbData  cbData(*mutableDefs);
     OTF2_ErrorCode result;
     result = OTF2_GlobalDefReader_SetCallbacks(defReader, callbacks, &cbData);
     if (result != OTF2_SUCCESS)
@@ -213,19 +264,28 @@ Otf2Archive::readDefinitions(GlobalDefs* defs)
         throw RuntimeError(cbData.mErrorMessage);
     }
 
-    // Store timer data
-    mTimerResolution = cbData.mTimerResolution;
-    mGlobalOffset    = cbData.mGlobalOffset;
-
     // Close definition reader
     result = OTF2_Reader_CloseGlobalDefReader(mArchiveReader, defReader);
     if (result != OTF2_SUCCESS)
     {
         throw RuntimeError("Error closing OTF2 global definition reader!");
     }
+}
+
+
+void
+Otf2Archive::applyTimerData(GlobalDefs* defs,
+                            uint64_t    timerResolution,
+                            uint64_t    globalOffset)
+{
+    // Store timer data
+    mTimerResolution = timerResolution;
+    mGlobalOffset    = globalOffset;
 
     // For OTF2 traces, global time offset subtraction is implicitly
     // applied during trace reading
+    MutableGlobalDefs* mutableDefs = dynamic_cast< MutableGlobalDefs* >(defs);
+    assert(mutableDefs);
     mutableDefs->setGlobalOffset(0.0);
 }
 
@@ -339,6 +399,96 @@ Otf2Archive::readTrace(const GlobalDefs& defs,
                        const Location&   location,
                        LocalIdMaps*      idMaps,
                        LocalTrace*       trace)
+{
+    Otf2EvtCbData   cbData(defs, *trace, mTimerResolution, mGlobalOffset);
+    OTF2_EvtReader* evtReader = openEvtReader(location, cbData);
+
+    // Read event trace data
+    uint64_t       recordsRead;
+    OTF2_ErrorCode result;
+    result = OTF2_EvtReader_ReadEvents(evtReader, UINT64_MAX, &recordsRead);
+    if (  (result != OTF2_SUCCESS)
+       || !cbData.mErrorMessage.empty())
+    {
+        throw RuntimeError(cbData.mErrorMessage);
+    }
+    OTF2_Reader_CloseEvtReader(mArchiveReader, evtReader);
+}
+
+
+void
+Otf2Archive::readSegment(const GlobalDefs& defs,
+                         const Location&   location,
+                         LocalIdMaps*      idMaps,
+                         LocalTrace*       trace,
+                         SegmentState&     segment)
+{
+    Otf2EvtCbData cbData(defs, *trace, mTimerResolution, mGlobalOffset);
+    cbData.mSegment = &segment;
+
+    OTF2_EvtReader* evtReader = openEvtReader(location, cbData);
+
+    // Continue with the record that interrupted the preceding segment
+    const uint64_t recordPosition = segment.getRecordPosition();
+    if (recordPosition > 0)
+    {
+        Buffer readerState(segment.getReaderState());
+        cbData.unpackState(readerState);
+
+        OTF2_ErrorCode result;
+        result = OTF2_EvtReader_Seek(evtReader, recordPosition);
+        if (result != OTF2_SUCCESS)
+        {
+            throw RuntimeError("Error seeking in OTF2 local trace data!");
+        }
+    }
+
+    // Read event trace data; the callbacks interrupt reading once the
+    // segment is complete
+    uint64_t       recordsRead;
+    OTF2_ErrorCode result;
+    result = OTF2_EvtReader_ReadEvents(evtReader, UINT64_MAX, &recordsRead);
+    if (  (  (result != OTF2_SUCCESS)
+          && (result != OTF2_ERROR_INTERRUPTED_BY_CALLBACK))
+       || !cbData.mErrorMessage.empty())
+    {
+        throw RuntimeError(cbData.mErrorMessage);
+    }
+
+    // Segment ends before the end of the trace => store reader position and
+    // state for the next segment.  The interrupting record has been counted
+    // as read, but not processed yet.
+    if (result == OTF2_ERROR_INTERRUPTED_BY_CALLBACK)
+    {
+        uint64_t position;
+        OTF2_EvtReader_GetPos(evtReader, &position);
+
+        Buffer readerState;
+        cbData.packState(readerState);
+        segment.setResumeState(position, readerState);
+
+        // The call stack of CCT traces is closed in the last segment
+        cbData.mPreviousContext = 0;
+    }
+    OTF2_Reader_CloseEvtReader(mArchiveReader, evtReader);
+}
+
+
+/// @brief Open event trace reader.
+///
+/// Creates an OTF2 event reader for the given @a location and installs
+/// the event callbacks using @a cbData as callback data.
+///
+/// @param location
+///     %Location whose trace data should be read
+/// @param cbData
+///     Event callback data
+/// @returns
+///     OTF2 event reader
+///
+OTF2_EvtReader*
+Otf2Archive::openEvtReader(const Location& location,
+                           Otf2EvtCbData&  cbData)
 {
     // Create event trace reader
     OTF2_EvtReader* evtReader = OTF2_Reader_GetEvtReader(mArchiveReader, location.getId());
@@ -411,7 +561,6 @@ Otf2Archive::readTrace(const GlobalDefs& defs,
     SET_EVT_CALLBACK(ThreadWait);
 
     // Install callbacks
-    Otf2EvtCbData  cbData(defs, *trace, mTimerResolution, mGlobalOffset);
     OTF2_ErrorCode result;
     result = OTF2_EvtReader_SetCallbacks(evtReader, callbacks, &cbData);
     if (result != OTF2_SUCCESS)
@@ -420,13 +569,5 @@ Otf2Archive::readTrace(const GlobalDefs& defs,
     }
     OTF2_EvtReaderCallbacks_Delete(callbacks);
 
-    // Read event trace data
-    uint64_t recordsRead;
-    result = OTF2_EvtReader_ReadEvents(evtReader, UINT64_MAX, &recordsRead);
-    if (  (result != OTF2_SUCCESS)
-       || !cbData.mErrorMessage.empty())
-    {
-        throw RuntimeError(cbData.mErrorMessage);
-    }
-    OTF2_Reader_CloseEvtReader(mArchiveReader, evtReader);
+    return evtReader;
 }
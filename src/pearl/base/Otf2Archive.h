@@ -39,6 +39,12 @@ namespace pearl
 {
 namespace detail
 {
+// --- Forward declarations -------------------------------------------------
+
+struct Otf2DefCbData;
+struct Otf2EvtCbData;
+
+
 /*-------------------------------------------------------------------------*/
 /**
  *  @ingroup PEARL_base
@@ -107,6 +113,21 @@ class Otf2Archive
         virtual void
         readDefinitions(GlobalDefs* defs);
 
+        virtual void
+        readPackedDefinitions(Buffer& buffer);
+
+        virtual void
+        unpackDefinitions(GlobalDefs* defs,
+                          Buffer&     buffer);
+
+        void
+        readGlobalDefs(Otf2DefCbData& cbData);
+
+        void
+        applyTimerData(GlobalDefs* defs,
+                       uint64_t    timerResolution,
+                       uint64_t    globalOffset);
+
         virtual void
         openContainer(const LocationGroup& locGroup);
 
@@ -121,6 +142,17 @@ class Otf2Archive
                   const Location&   location,
                   LocalIdMaps*      idMaps,
                   LocalTrace*       trace);
+
+        virtual void
+        readSegment(const GlobalDefs& defs,
+                    const Location&   location,
+                    LocalIdMaps*      idMaps,
+                    LocalTrace*       trace,
+                    SegmentState&     segment);
+
+        OTF2_EvtReader*
+        openEvtReader(const Location& location,
+                      Otf2EvtCbData&  cbData);
 };
 }    // namespace pearl::detail
 }    // namespace pearl
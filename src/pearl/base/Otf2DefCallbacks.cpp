@@ -33,7 +33,9 @@
 #include <cassert>
 #include <exception>
 #include <string>
+#include <vector>
 
+#include <pearl/Buffer.h>
 #include <pearl/Error.h>
 
 #include "DefsFactory.h"
@@ -46,7 +48,33 @@ using namespace pearl;
 using namespace pearl::detail;
 
 
-// --- Local helper macros --------------------------------------------------
+// --- Local types & helper macros -----------------------------------------
+
+namespace
+{
+/// Record types of packed definition records
+enum PackedRecordType
+{
+    PACKED_END,
+    PACKED_CALLING_CONTEXT,
+    PACKED_CALLPATH,
+    PACKED_CALLSITE,
+    PACKED_CART_COORDINATE,
+    PACKED_CART_DIMENSION,
+    PACKED_CART_TOPOLOGY,
+    PACKED_CLOCK_PROPERTIES,
+    PACKED_COMM,
+    PACKED_GROUP,
+    PACKED_LOCATION,
+    PACKED_LOCATION_GROUP,
+    PACKED_REGION,
+    PACKED_SOURCE_CODE_LOCATION,
+    PACKED_STRING,
+    PACKED_SYSTEM_TREE_NODE
+};
+}    // unnamed namespace
+
+
 
 // *INDENT-OFF*    Uncrustify issues #2742 & #2791
 #define CALLBACK_SETUP                                                 \
@@ -89,6 +117,17 @@ pearl::detail::otf2DefCbCallingContext(void* const                      userData
                                        const OTF2_CallingContextRef     parent)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_CALLING_CONTEXT);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(region);
+        data->mPackBuffer->put_uint32(sourceCodeLocation);
+        data->mPackBuffer->put_uint32(parent);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     DefsFactory::instance()->createCallingContext(defs,
                                                   self,
                                                   region,
@@ -121,6 +160,16 @@ pearl::detail::otf2DefCbCallpath(void* const            userData,
                                  const OTF2_RegionRef   region)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_CALLPATH);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(parent);
+        data->mPackBuffer->put_uint32(region);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     DefsFactory::instance()->createCallpath(defs,
                                             self,
                                             region,
@@ -143,6 +192,18 @@ pearl::detail::otf2DefCbCallsite(void* const            userData,
                                  const OTF2_RegionRef   leftRegion)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_CALLSITE);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(sourceFile);
+        data->mPackBuffer->put_uint32(lineNumber);
+        data->mPackBuffer->put_uint32(enteredRegion);
+        data->mPackBuffer->put_uint32(leftRegion);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     DefsFactory::instance()->createCallsite(defs,
                                             self,
                                             sourceFile,
@@ -162,6 +223,20 @@ pearl::detail::otf2DefCbCartCoordinate(void* const                userData,
                                        const uint32_t* const      coordinates)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_CART_COORDINATE);
+        data->mPackBuffer->put_uint32(cartTopology);
+        data->mPackBuffer->put_uint32(rank);
+        data->mPackBuffer->put_uint8(numberOfDimensions);
+        for (uint8_t i = 0; i < numberOfDimensions; ++i)
+        {
+            data->mPackBuffer->put_uint32(coordinates[i]);
+        }
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     CartCoordinate coordinate;
     coordinate.assign(coordinates, coordinates + numberOfDimensions);
     defs.assignCartCoordinate(cartTopology, rank, coordinate);
@@ -179,6 +254,17 @@ pearl::detail::otf2DefCbCartDimension(void* const                 userData,
                                       const OTF2_CartPeriodicity  cartPeriodicity)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_CART_DIMENSION);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint32(size);
+        data->mPackBuffer->put_uint8(cartPeriodicity);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     CartDimension::Periodicity periodicity = CartDimension::NON_PERIODIC;
     if (cartPeriodicity == OTF2_CART_PERIODIC_TRUE)
     {
@@ -205,6 +291,20 @@ pearl::detail::otf2DefCbCartTopology(void* const                        userData
                                      const OTF2_CartDimensionRef* const cartDimensions)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_CART_TOPOLOGY);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint32(communicator);
+        data->mPackBuffer->put_uint8(numberOfDimensions);
+        for (uint8_t i = 0; i < numberOfDimensions; ++i)
+        {
+            data->mPackBuffer->put_uint32(cartDimensions[i]);
+        }
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
 
     DefsFactory::instance()->createCartTopology(defs,
                                                 self,
@@ -226,6 +326,16 @@ pearl::detail::otf2DefCbClockProperties(void* const    userData,
                                         const uint64_t traceLength)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_CLOCK_PROPERTIES);
+        data->mPackBuffer->put_uint64(timerResolution);
+        data->mPackBuffer->put_uint64(globalOffset);
+        data->mPackBuffer->put_uint64(traceLength);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     data->mTimerResolution = timerResolution;
     data->mGlobalOffset    = globalOffset;
     CALLBACK_CLEANUP
@@ -242,6 +352,16 @@ pearl::detail::otf2DefCbComm(void* const          userData,
                              const OTF2_CommRef   parent)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_COMM);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint32(group);
+        data->mPackBuffer->put_uint32(parent);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
 
     DefsFactory::instance()->createCommunicator(defs,
                                                 self,
@@ -271,6 +391,22 @@ pearl::detail::otf2DefCbGroup(void* const           userData,
                               const uint64_t* const members)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_GROUP);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint8(groupType);
+        data->mPackBuffer->put_uint8(paradigm);
+        data->mPackBuffer->put_uint32(groupFlags);
+        data->mPackBuffer->put_uint32(numberOfMembers);
+        for (uint32_t i = 0; i < numberOfMembers; ++i)
+        {
+            data->mPackBuffer->put_uint64(members[i]);
+        }
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
 
     if (groupType == OTF2_GROUP_TYPE_LOCATIONS)
     {
@@ -369,6 +505,17 @@ pearl::detail::otf2DefCbLocation(void* const                 userData,
                                  const OTF2_LocationGroupRef locationGroup)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_LOCATION);
+        data->mPackBuffer->put_uint64(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint8(locationType);
+        data->mPackBuffer->put_uint64(numberOfEvents);
+        data->mPackBuffer->put_uint32(locationGroup);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
 
     // Sanity check
     if (locationType != OTF2_LOCATION_TYPE_CPU_THREAD)
@@ -400,6 +547,17 @@ pearl::detail::otf2DefCbLocationGroup(void* const                  userData,
                                       const OTF2_SystemTreeNodeRef systemTreeParent)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_LOCATION_GROUP);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint8(locationGroupType);
+        data->mPackBuffer->put_uint32(systemTreeParent);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     DefsFactory::instance()->createLocationGroup(defs,
                                                  self,
                                                  name,
@@ -549,6 +707,22 @@ pearl::detail::otf2DefCbRegion(void* const           userData,
                                const uint32_t        endLineNumber)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_REGION);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint32(canonicalName);
+        data->mPackBuffer->put_uint32(description);
+        data->mPackBuffer->put_uint8(regionRole);
+        data->mPackBuffer->put_uint8(paradigm);
+        data->mPackBuffer->put_uint32(regionFlags);
+        data->mPackBuffer->put_uint32(sourceFile);
+        data->mPackBuffer->put_uint32(beginLineNumber);
+        data->mPackBuffer->put_uint32(endLineNumber);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
 
     string        rname     = defs.getString(name).getString();
     const String& rfile     = defs.getString(sourceFile);
@@ -646,6 +820,16 @@ pearl::detail::otf2DefCbSourceCodeLocation(void* const                      user
                                            const uint32_t                   lineNumber)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_SOURCE_CODE_LOCATION);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(file);
+        data->mPackBuffer->put_uint32(lineNumber);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     DefsFactory::instance()->createSourceLocation(defs,
                                                   self,
                                                   file,
@@ -662,6 +846,15 @@ pearl::detail::otf2DefCbString(void* const          userData,
                                const char* const    str)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_STRING);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_string(str);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     DefsFactory::instance()->createString(defs,
                                           self,
                                           str);
@@ -679,6 +872,17 @@ pearl::detail::otf2DefCbSystemTreeNode(void* const                  userData,
                                        const OTF2_SystemTreeNodeRef parent)
 {
     CALLBACK_SETUP
+    if (data->mPackBuffer)
+    {
+        data->mPackBuffer->put_uint8(PACKED_SYSTEM_TREE_NODE);
+        data->mPackBuffer->put_uint32(self);
+        data->mPackBuffer->put_uint32(name);
+        data->mPackBuffer->put_uint32(className);
+        data->mPackBuffer->put_uint32(parent);
+
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
     DefsFactory::instance()->createSystemNode(defs,
                                               self,
                                               name,
@@ -714,3 +918,231 @@ pearl::detail::otf2DefCbSystemTreeNodeProperty(void* const                  user
 {
     return OTF2_CALLBACK_SUCCESS;
 }
+
+
+// --- OTF2: Packed global definitions --------------------------------------
+
+void
+pearl::detail::otf2DefPackEnd(Buffer& buffer)
+{
+    buffer.put_uint8(PACKED_END);
+}
+
+
+void
+pearl::detail::otf2DefUnpackRecords(Otf2DefCbData& data,
+                                    Buffer&        buffer)
+{
+    vector< uint32_t > refs;
+    vector< uint64_t > members;
+
+    OTF2_CallbackCode result = OTF2_CALLBACK_SUCCESS;
+    uint8_t           type;
+    while (  (result == OTF2_CALLBACK_SUCCESS)
+          && ((type = buffer.get_uint8()) != PACKED_END))
+    {
+        switch (type)
+        {
+            case PACKED_CALLING_CONTEXT:
+                {
+                    const uint32_t self   = buffer.get_uint32();
+                    const uint32_t region = buffer.get_uint32();
+                    const uint32_t scl    = buffer.get_uint32();
+                    const uint32_t parent = buffer.get_uint32();
+
+                    result = otf2DefCbCallingContext(&data, self, region, scl, parent);
+                }
+                break;
+
+            case PACKED_CALLPATH:
+                {
+                    const uint32_t self   = buffer.get_uint32();
+                    const uint32_t parent = buffer.get_uint32();
+                    const uint32_t region = buffer.get_uint32();
+
+                    result = otf2DefCbCallpath(&data, self, parent, region);
+                }
+                break;
+
+            case PACKED_CALLSITE:
+                {
+                    const uint32_t self    = buffer.get_uint32();
+                    const uint32_t file    = buffer.get_uint32();
+                    const uint32_t line    = buffer.get_uint32();
+                    const uint32_t entered = buffer.get_uint32();
+                    const uint32_t left    = buffer.get_uint32();
+
+                    result = otf2DefCbCallsite(&data, self, file, line, entered, left);
+                }
+                break;
+
+            case PACKED_CART_COORDINATE:
+                {
+                    const uint32_t topology = buffer.get_uint32();
+                    const uint32_t rank     = buffer.get_uint32();
+                    const uint8_t  numDims  = buffer.get_uint8();
+
+                    refs.resize(numDims);
+                    for (uint8_t i = 0; i < numDims; ++i)
+                    {
+                        refs[i] = buffer.get_uint32();
+                    }
+
+                    result = otf2DefCbCartCoordinate(&data, topology, rank, numDims,
+                                                     refs.empty() ? 0 : &refs[0]);
+                }
+                break;
+
+            case PACKED_CART_DIMENSION:
+                {
+                    const uint32_t self        = buffer.get_uint32();
+                    const uint32_t name        = buffer.get_uint32();
+                    const uint32_t size        = buffer.get_uint32();
+                    const uint8_t  periodicity = buffer.get_uint8();
+
+                    result = otf2DefCbCartDimension(&data, self, name, size, periodicity);
+                }
+                break;
+
+            case PACKED_CART_TOPOLOGY:
+                {
+                    const uint32_t self    = buffer.get_uint32();
+                    const uint32_t name    = buffer.get_uint32();
+                    const uint32_t comm    = buffer.get_uint32();
+                    const uint8_t  numDims = buffer.get_uint8();
+
+                    refs.resize(numDims);
+                    for (uint8_t i = 0; i < numDims; ++i)
+                    {
+                        refs[i] = buffer.get_uint32();
+                    }
+
+                    result = otf2DefCbCartTopology(&data, self, name, comm, numDims,
+                                                   refs.empty() ? 0 : &refs[0]);
+                }
+                break;
+
+            case PACKED_CLOCK_PROPERTIES:
+                {
+                    const uint64_t resolution = buffer.get_uint64();
+                    const uint64_t offset     = buffer.get_uint64();
+                    const uint64_t length     = buffer.get_uint64();
+
+                    result = otf2DefCbClockProperties(&data, resolution, offset, length);
+                }
+                break;
+
+            case PACKED_COMM:
+                {
+                    const uint32_t self   = buffer.get_uint32();
+                    const uint32_t name   = buffer.get_uint32();
+                    const uint32_t group  = buffer.get_uint32();
+                    const uint32_t parent = buffer.get_uint32();
+
+                    result = otf2DefCbComm(&data, self, name, group, parent);
+                }
+                break;
+
+            case PACKED_GROUP:
+                {
+                    const uint32_t self       = buffer.get_uint32();
+                    const uint32_t name       = buffer.get_uint32();
+                    const uint8_t  groupType  = buffer.get_uint8();
+                    const uint8_t  paradigm   = buffer.get_uint8();
+                    const uint32_t groupFlags = buffer.get_uint32();
+                    const uint32_t numMembers = buffer.get_uint32();
+
+                    members.resize(numMembers);
+                    for (uint32_t i = 0; i < numMembers; ++i)
+                    {
+                        members[i] = buffer.get_uint64();
+                    }
+
+                    result = otf2DefCbGroup(&data, self, name, groupType, paradigm,
+                                            groupFlags, numMembers,
+                                            members.empty() ? 0 : &members[0]);
+                }
+                break;
+
+            case PACKED_LOCATION:
+                {
+                    const uint64_t self      = buffer.get_uint64();
+                    const uint32_t name      = buffer.get_uint32();
+                    const uint8_t  locType   = buffer.get_uint8();
+                    const uint64_t numEvents = buffer.get_uint64();
+                    const uint32_t parent    = buffer.get_uint32();
+
+                    result = otf2DefCbLocation(&data, self, name, locType, numEvents, parent);
+                }
+                break;
+
+            case PACKED_LOCATION_GROUP:
+                {
+                    const uint32_t self    = buffer.get_uint32();
+                    const uint32_t name    = buffer.get_uint32();
+                    const uint8_t  grpType = buffer.get_uint8();
+                    const uint32_t parent  = buffer.get_uint32();
+
+                    result = otf2DefCbLocationGroup(&data, self, name, grpType, parent);
+                }
+                break;
+
+            case PACKED_REGION:
+                {
+                    const uint32_t self          = buffer.get_uint32();
+                    const uint32_t name          = buffer.get_uint32();
+                    const uint32_t canonicalName = buffer.get_uint32();
+                    const uint32_t description   = buffer.get_uint32();
+                    const uint8_t  role          = buffer.get_uint8();
+                    const uint8_t  paradigm      = buffer.get_uint8();
+                    const uint32_t flags         = buffer.get_uint32();
+                    const uint32_t file          = buffer.get_uint32();
+                    const uint32_t beginLine     = buffer.get_uint32();
+                    const uint32_t endLine       = buffer.get_uint32();
+
+                    result = otf2DefCbRegion(&data, self, name, canonicalName,
+                                             description, role, paradigm, flags,
+                                             file, beginLine, endLine);
+                }
+                break;
+
+            case PACKED_SOURCE_CODE_LOCATION:
+                {
+                    const uint32_t self = buffer.get_uint32();
+                    const uint32_t file = buffer.get_uint32();
+                    const uint32_t line = buffer.get_uint32();
+
+                    result = otf2DefCbSourceCodeLocation(&data, self, file, line);
+                }
+                break;
+
+            case PACKED_STRING:
+                {
+                    const uint32_t self = buffer.get_uint32();
+                    const string   str  = buffer.get_string();
+
+                    result = otf2DefCbString(&data, self, str.c_str());
+                }
+                break;
+
+            case PACKED_SYSTEM_TREE_NODE:
+                {
+                    const uint32_t self      = buffer.get_uint32();
+                    const uint32_t name      = buffer.get_uint32();
+                    const uint32_t className = buffer.get_uint32();
+                    const uint32_t parent    = buffer.get_uint32();
+
+                    result = otf2DefCbSystemTreeNode(&data, self, name, className, parent);
+                }
+                break;
+
+            default:
+                throw RuntimeError("Invalid packed OTF2 definition record!");
+        }
+    }
+
+    if (result != OTF2_CALLBACK_SUCCESS)
+    {
+        throw RuntimeError(data.mErrorMessage);
+    }
+}
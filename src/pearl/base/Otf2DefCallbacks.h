@@ -38,6 +38,11 @@
 
 namespace pearl
 {
+// --- Forward declarations -------------------------------------------------
+
+class Buffer;
+
+
 namespace detail
 {
 // --- Forward declarations -------------------------------------------------
@@ -75,7 +80,8 @@ struct Otf2DefCbData
     Otf2DefCbData(MutableGlobalDefs& defs)
         : mDefinitions(defs),
           mTimerResolution(0),
-          mGlobalOffset(0)
+          mGlobalOffset(0),
+          mPackBuffer(0)
     {
     }
 
@@ -95,6 +101,11 @@ struct Otf2DefCbData
 
     /// Estimated timestamp of the first event
     uint64_t mGlobalOffset;
+
+    /// %Buffer to which all processed definition records are packed instead
+    /// of applying them to the definitions object, if non-NULL (see
+    /// otf2DefUnpackRecords())
+    Buffer* mPackBuffer;
 };
 
 
@@ -895,6 +906,39 @@ otf2DefCbSystemTreeNodeProperty(void*                  userData,
                                 OTF2_Type              type,
                                 OTF2_AttributeValue    value);
 
+/// @}
+/// @name OTF2: Packed global definitions
+/// @{
+
+/// @brief Mark end of packed definition records
+///
+/// Appends an end marker to the given @a buffer, to which definition records
+/// have been packed by the definition callbacks (see
+/// Otf2DefCbData::mPackBuffer).
+///
+/// @param buffer
+///     %Buffer storing packed definition records
+///
+void
+otf2DefPackEnd(Buffer& buffer);
+
+/// @brief Unpack definition records
+///
+/// Reads the definition records packed into @a buffer (up to the end marker)
+/// and processes them by invoking the corresponding definition callbacks in
+/// the original order, as if they were read from the global definition file.
+///
+/// @param data
+///     %Callback data object
+/// @param buffer
+///     %Buffer storing packed definition records
+/// @throws pearl::RuntimeError
+///     on failure
+///
+void
+otf2DefUnpackRecords(Otf2DefCbData& data,
+                     Buffer&        buffer);
+
 /// @}
 }    // namespace pearl::detail
 }    // namespace pearl
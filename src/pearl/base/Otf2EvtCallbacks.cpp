@@ -35,12 +35,15 @@
 #include <UTILS_Error.h>
 #include <UTILS_IO.h>
 
+#include <pearl/Buffer.h>
+#include <pearl/CallingContext.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
 #include <pearl/Region.h>
 
 #include "EventFactory.h"
 #include "Otf2TypeHelpers.h"
+#include "SegmentState.h"
 
 using namespace std;
 using namespace pearl;
@@ -78,6 +81,43 @@ Otf2EvtCbData::~Otf2EvtCbData()
 }
 
 
+// --- Segment-wise reading -------------------------------------------------
+
+void
+Otf2EvtCbData::packState(Buffer& buffer) const
+{
+    buffer.put_uint64(mActiveRequests.size());
+    for (set< uint64_t >::const_iterator it = mActiveRequests.begin();
+         it != mActiveRequests.end();
+         ++it)
+    {
+        buffer.put_uint64(*it);
+    }
+    buffer.put_uint32(mPreviousContext
+                      ? mPreviousContext->getId()
+                      : CallingContext::NO_ID);
+    buffer.put_uint32(mProgramRegionId);
+}
+
+
+void
+Otf2EvtCbData::unpackState(Buffer& buffer)
+{
+    mActiveRequests.clear();
+    const uint64_t numRequests = buffer.get_uint64();
+    for (uint64_t i = 0; i < numRequests; ++i)
+    {
+        mActiveRequests.insert(mActiveRequests.end(), buffer.get_uint64());
+    }
+
+    const CallingContext::IdType contextId = buffer.get_uint32();
+    mPreviousContext = (contextId != CallingContext::NO_ID)
+                       ? getContext(mDefinitions, contextId)
+                       : 0;
+    mProgramRegionId = buffer.get_uint32();
+}
+
+
 // --- Local helper macros --------------------------------------------------
 
 // *INDENT-OFF*    Uncrustify issues #2742 & #2791
@@ -86,7 +126,12 @@ Otf2EvtCbData::~Otf2EvtCbData()
     const GlobalDefs& defs  = data->mDefinitions;                      \
     LocalTrace&       trace = data->mTrace;                            \
     try                                                                \
-    {
+    {                                                                  \
+        if (  data->mSegment                                           \
+           && data->mSegment->isComplete(trace))                       \
+        {                                                              \
+            return OTF2_CALLBACK_INTERRUPT;                            \
+        }
 
 #define CALLBACK_CLEANUP                 \
     }    /* Closes the try block */      \
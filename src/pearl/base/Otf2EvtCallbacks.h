@@ -43,6 +43,7 @@ namespace pearl
 {
 // --- Forward declarations -------------------------------------------------
 
+class Buffer;
 class CallingContext;
 class GlobalDefs;
 class LocalTrace;
@@ -50,6 +51,11 @@ class LocalTrace;
 
 namespace detail
 {
+// --- Forward declarations -------------------------------------------------
+
+class SegmentState;
+
+
 /*-------------------------------------------------------------------------*/
 /**
  *  @struct  Otf2EvtCbData
@@ -90,7 +96,8 @@ struct Otf2EvtCbData
           mTimerResolution(timerResolution),
           mGlobalOffset(globalOffset),
           mPreviousContext(0),
-          mProgramRegionId(Region::NO_ID)
+          mProgramRegionId(Region::NO_ID),
+          mSegment(0)
     {
     }
 
@@ -100,6 +107,32 @@ struct Otf2EvtCbData
     ///
     ~Otf2EvtCbData();
 
+    /// @}
+    /// @name Segment-wise reading
+    /// @{
+
+    /// @brief Pack reader state.
+    ///
+    /// Appends the state carried over from one event record to the next
+    /// (active requests, calling context, program region) to @a buffer,
+    /// so that reading can be continued later with a new instance.
+    ///
+    /// @param buffer
+    ///     %Buffer to which the state is appended
+    ///
+    void
+    packState(Buffer& buffer) const;
+
+    /// @brief Unpack reader state.
+    ///
+    /// Restores the state previously packed by packState().
+    ///
+    /// @param buffer
+    ///     %Buffer providing the packed state
+    ///
+    void
+    unpackState(Buffer& buffer);
+
     /// @}
 
 
@@ -128,6 +161,9 @@ struct Otf2EvtCbData
 
     /// Global region identifier of program region
     Region::IdType mProgramRegionId;
+
+    /// Segment-wise reading state; null if the entire trace is read
+    SegmentState* mSegment;
 };
 
 
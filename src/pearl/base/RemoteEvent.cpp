@@ -34,6 +34,7 @@
 #include <pearl/Buffer.h>
 #include <pearl/Event.h>
 #include <pearl/GlobalDefs.h>
+#include <pearl/SmallObject.h>
 
 #include "EventFactory.h"
 #include "iomanip_detail.h"
@@ -43,18 +44,88 @@ using namespace pearl;
 using namespace pearl::detail;
 
 
+// --- Shared event representation ------------------------------------------
+
+// Remote events are unpacked for almost every replayed communication
+// operation.  Unlike CountedPtr, which allocates its reference counter on
+// the heap, the shared representation is a small object (as is the event
+// representation itself), thus avoiding general-purpose heap allocations.
+struct RemoteEvent::SharedRep
+    : public SmallObject
+{
+    SharedRep(Event_rep* event)
+        : mEvent(event),
+          mRefCount(1)
+    {
+    }
+
+    ~SharedRep()
+    {
+        delete mEvent;
+    }
+
+
+    Event_rep*   mEvent;
+    unsigned int mRefCount;
+};
+
+
 // --- Constructors & destructor --------------------------------------------
 
 RemoteEvent::RemoteEvent(const GlobalDefs& defs,
                          Buffer&           buffer)
+    : m_shared(0)
 {
     // Unpack data
     event_t type = static_cast< event_t >(buffer.get_uint32());
     m_location     = const_cast< Location* >(&defs.getLocation(buffer.get_uint64()));
     m_cnode        = defs.get_cnode(buffer.get_id());
     m_remote_index = buffer.get_uint32();
-    m_event        = CountedPtr< Event_rep >(
-        EventFactory::instance()->createEvent(type, defs, buffer));
+
+    Event_rep* event = EventFactory::instance()->createEvent(type, defs, buffer);
+    try
+    {
+        m_shared = new SharedRep(event);
+    }
+    catch (...)
+    {
+        delete event;
+        throw;
+    }
+}
+
+
+RemoteEvent::RemoteEvent(const RemoteEvent& rhs)
+    : m_shared(rhs.m_shared),
+      m_location(rhs.m_location),
+      m_cnode(rhs.m_cnode),
+      m_remote_index(rhs.m_remote_index)
+{
+    ++m_shared->mRefCount;
+}
+
+
+RemoteEvent::~RemoteEvent()
+{
+    release();
+}
+
+
+// --- Assignment operator --------------------------------------------------
+
+RemoteEvent&
+RemoteEvent::operator=(const RemoteEvent& rhs)
+{
+    // Increment first to handle self-assignment correctly
+    ++rhs.m_shared->mRefCount;
+    release();
+
+    m_shared       = rhs.m_shared;
+    m_location     = rhs.m_location;
+    m_cnode        = rhs.m_cnode;
+    m_remote_index = rhs.m_remote_index;
+
+    return *this;
 }
 
 
@@ -86,19 +157,29 @@ RemoteEvent::get_remote_index() const
 Event_rep&
 RemoteEvent::operator*() const
 {
-    return *m_event.get();
+    return *m_shared->mEvent;
 }
 
 
 Event_rep*
 RemoteEvent::operator->() const
 {
-    return m_event.get();
+    return m_shared->mEvent;
 }
 
 
 // --- Private methods ------------------------------------------------------
 
+void
+RemoteEvent::release()
+{
+    if (--m_shared->mRefCount == 0)
+    {
+        delete m_shared;
+    }
+}
+
+
 ostream&
 RemoteEvent::output(ostream& stream) const
 {
@@ -113,18 +194,18 @@ RemoteEvent::output(ostream& stream) const
     // Special case: abbreviated output
     if (detail == DETAIL_ABBRV)
     {
-        return stream << event_typestr(m_event->getType());
+        return stream << event_typestr(m_shared->mEvent->getType());
     }
 
     // Print data
     stream << "RemoteEvent"
            << beginObject
-           << "type: " << event_typestr(m_event->getType())
+           << "type: " << event_typestr(m_shared->mEvent->getType())
            << sep
            << "location: " << *m_location
            << sep
            << "index: " << m_remote_index;
-    m_event->output(stream);
+    m_shared->mEvent->output(stream);
     stream << endObject;
 
     return stream;
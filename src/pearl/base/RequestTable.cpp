@@ -0,0 +1,207 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Implementation of the class pearl::detail::RequestTable.
+ *
+ *  This file provides the implementation of the internal helper class
+ *  pearl::detail::RequestTable.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#include <config.h>
+
+#include "RequestTable.h"
+
+#include <UTILS_Error.h>
+
+using namespace std;
+using namespace pearl::detail;
+
+
+// --- Helpers --------------------------------------------------------------
+
+namespace
+{
+// --- Constants -------------------------------------------
+
+/// Initial number of slots (must be a power of two)
+const size_t INITIAL_CAPACITY = 64;
+
+
+// --- Function prototypes ---------------------------------
+
+size_t
+hashRequestId(uint64_t requestId);
+}    // unnamed namespace
+
+
+// --- Static class data ----------------------------------------------------
+
+const uint32_t RequestTable::NO_INDEX;
+
+
+// --- Constructors & destructor --------------------------------------------
+
+RequestTable::RequestTable()
+    : mSize(0)
+{
+    Slot empty;
+    empty.mRequestId = 0;
+    empty.mIndex     = NO_INDEX;
+    mSlots.assign(INITIAL_CAPACITY, empty);
+}
+
+
+// --- Lookup & modification ------------------------------------------------
+
+uint32_t
+RequestTable::find(const uint64_t requestId) const
+{
+    return mSlots[findSlot(requestId)].mIndex;
+}
+
+
+void
+RequestTable::insert(const uint64_t requestId,
+                     const uint32_t index)
+{
+    UTILS_ASSERT(index != NO_INDEX);
+
+    size_t pos = findSlot(requestId);
+    if (mSlots[pos].mIndex == NO_INDEX)
+    {
+        // Keep the load factor at or below 1/2
+        if (2 * (mSize + 1) > mSlots.size())
+        {
+            grow();
+            pos = findSlot(requestId);
+        }
+        mSlots[pos].mRequestId = requestId;
+        ++mSize;
+    }
+    mSlots[pos].mIndex = index;
+}
+
+
+void
+RequestTable::erase(const uint64_t requestId)
+{
+    size_t pos = findSlot(requestId);
+    if (mSlots[pos].mIndex == NO_INDEX)
+    {
+        return;
+    }
+
+    // Backward-shift deletion: move subsequent entries of the cluster into
+    // the hole unless they would end up before their home slot
+    const size_t mask = mSlots.size() - 1;
+    size_t       next = pos;
+    while (true)
+    {
+        next = (next + 1) & mask;
+        if (mSlots[next].mIndex == NO_INDEX)
+        {
+            break;
+        }
+
+        const size_t home = hashRequestId(mSlots[next].mRequestId) & mask;
+        if (((next - home) & mask) >= ((next - pos) & mask))
+        {
+            mSlots[pos] = mSlots[next];
+            pos         = next;
+        }
+    }
+    mSlots[pos].mIndex = NO_INDEX;
+    --mSize;
+}
+
+
+size_t
+RequestTable::size() const
+{
+    return mSize;
+}
+
+
+// --- Private member functions ---------------------------------------------
+
+size_t
+RequestTable::findSlot(const uint64_t requestId) const
+{
+    const size_t mask = mSlots.size() - 1;
+    size_t       pos  = hashRequestId(requestId) & mask;
+    while (  (mSlots[pos].mIndex != NO_INDEX)
+          && (mSlots[pos].mRequestId != requestId))
+    {
+        pos = (pos + 1) & mask;
+    }
+
+    return pos;
+}
+
+
+void
+RequestTable::grow()
+{
+    Slot empty;
+    empty.mRequestId = 0;
+    empty.mIndex     = NO_INDEX;
+
+    vector< Slot > slots(2 * mSlots.size(), empty);
+    slots.swap(mSlots);
+
+    const size_t mask = mSlots.size() - 1;
+    for (vector< Slot >::const_iterator it = slots.begin();
+         it != slots.end();
+         ++it)
+    {
+        if (it->mIndex != NO_INDEX)
+        {
+            size_t pos = hashRequestId(it->mRequestId) & mask;
+            while (mSlots[pos].mIndex != NO_INDEX)
+            {
+                pos = (pos + 1) & mask;
+            }
+            mSlots[pos] = *it;
+        }
+    }
+}
+
+
+// --- Helpers --------------------------------------------------------------
+
+namespace
+{
+/// @brief Hash a request identifier.
+///
+/// Scrambles the bits of the given @p requestId using a multiplicative
+/// hash, so that the consecutive identifiers typically assigned by
+/// measurement systems are spread evenly across the table.
+///
+/// @param requestId
+///     Request identifier
+/// @returns
+///     Hash value
+///
+size_t
+hashRequestId(const uint64_t requestId)
+{
+    uint64_t hash = requestId * 0x9E3779B97F4A7C15ULL;
+
+    return static_cast< size_t >(hash ^ (hash >> 32));
+}
+}    // unnamed namespace
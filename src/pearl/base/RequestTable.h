@@ -0,0 +1,206 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Declaration of the class pearl::detail::RequestTable.
+ *
+ *  This header file provides the declaration of the internal helper class
+ *  pearl::detail::RequestTable.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#ifndef PEARL_REQUESTTABLE_H
+#define PEARL_REQUESTTABLE_H
+
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace pearl
+{
+namespace detail
+{
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   RequestTable
+ *  @ingroup PEARL_base
+ *  @brief   Flat hash table mapping request identifiers to event indices.
+ *
+ *  The class `%RequestTable` keeps track of the most recent event of each
+ *  active non-blocking request while a local trace is preprocessed.  It
+ *  stores (request ID, event index) pairs in a single open-addressing
+ *  array using linear probing, which avoids the per-entry node allocations
+ *  and pointer chasing of a tree-based map.  Erased entries are removed
+ *  using backward-shift deletion, i.e., the table never contains
+ *  tombstones and lookups of absent keys stop at the first empty slot.
+ *
+ *  As event indices are used as values, the index `0xFFFFFFFF` (i.e.,
+ *  pearl::LocalTrace::NO_INDEX) is reserved to mark empty slots and can
+ *  not be stored.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class RequestTable
+{
+    public:
+        // --- Public constants ----------------------------
+
+        /// Value returned by find() for unknown request identifiers
+        static const uint32_t NO_INDEX = 0xFFFFFFFF;
+
+
+        // --- Public member functions ---------------------
+
+        /// @name Constructors & destructor
+        /// @{
+
+        /// @brief Default constructor.
+        ///
+        /// Creates a new, empty request table with a small initial capacity.
+        ///
+        /// @exception_strong
+        ///
+        /// @throws std::bad_alloc
+        ///     on failure to allocate the initial slot array
+        ///
+        RequestTable();
+
+        /// @}
+        /// @name Lookup & modification
+        /// @{
+
+        /// @brief Find an entry.
+        ///
+        /// Returns the event index stored for the request with the given
+        /// identifier @p requestId.
+        ///
+        /// @param requestId
+        ///     Request identifier
+        /// @returns
+        ///     Stored event index if found, NO_INDEX otherwise
+        ///
+        /// @exception_nothrow
+        ///
+        uint32_t
+        find(uint64_t requestId) const;
+
+        /// @brief Insert or update an entry.
+        ///
+        /// Stores @p index as event index for the request with the given
+        /// identifier @p requestId, replacing any previously stored index.
+        ///
+        /// @param requestId
+        ///     Request identifier
+        /// @param index
+        ///     Event index (must not be NO_INDEX)
+        ///
+        /// @exception_strong
+        ///
+        /// @throws std::bad_alloc
+        ///     on failure to grow the slot array
+        ///
+        void
+        insert(uint64_t requestId,
+               uint32_t index);
+
+        /// @brief Remove an entry.
+        ///
+        /// Removes the entry for the request with the given identifier
+        /// @p requestId.  Unknown identifiers are silently ignored.
+        ///
+        /// @param requestId
+        ///     Request identifier
+        ///
+        /// @exception_nothrow
+        ///
+        void
+        erase(uint64_t requestId);
+
+        /// @brief Get number of entries.
+        ///
+        /// Returns the number of entries currently stored in the table.
+        ///
+        /// @returns
+        ///     Number of entries
+        ///
+        /// @exception_nothrow
+        ///
+        std::size_t
+        size() const;
+
+        /// @}
+
+
+    private:
+        // --- Type definitions ----------------------------
+
+        /// Hash table slot
+        struct Slot
+        {
+            /// Request identifier
+            uint64_t mRequestId;
+
+            /// Event index, NO_INDEX for empty slots
+            uint32_t mIndex;
+        };
+
+
+        // --- Data members --------------------------------
+
+        /// Slot array; its size is always a power of two
+        std::vector< Slot > mSlots;
+
+        /// Number of occupied slots
+        std::size_t mSize;
+
+
+        // --- Private member functions --------------------
+
+        /// @brief Determine the slot for a request identifier.
+        ///
+        /// Returns the position of the slot storing the given @p requestId,
+        /// or of the empty slot terminating its probe sequence.
+        ///
+        /// @param requestId
+        ///     Request identifier
+        /// @returns
+        ///     Slot position
+        ///
+        /// @exception_nothrow
+        ///
+        std::size_t
+        findSlot(uint64_t requestId) const;
+
+        /// @brief Double the capacity.
+        ///
+        /// Doubles the size of the slot array and rehashes all entries.
+        ///
+        /// @exception_strong
+        ///
+        /// @throws std::bad_alloc
+        ///     on failure to allocate the new slot array
+        ///
+        void
+        grow();
+};
+}    // namespace pearl::detail
+}    // namespace pearl
+
+
+#endif    // !PEARL_REQUESTTABLE_H
@@ -0,0 +1,296 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Implementation of the class pearl::detail::SegmentState.
+ *
+ *  This file provides the implementation of the internal helper class
+ *  pearl::detail::SegmentState.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#include <config.h>
+
+#include "SegmentState.h"
+
+#include <cassert>
+#include <cfloat>
+
+#include <pearl/EnterCS_rep.h>
+#include <pearl/EnterProgram_rep.h>
+#include <pearl/Enter_rep.h>
+#include <pearl/Error.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/Leave_rep.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Region.h>
+
+#include "LocalIdMaps.h"
+
+using namespace std;
+using namespace pearl;
+using namespace pearl::detail;
+
+
+// --- Constructors & destructor --------------------------------------------
+
+SegmentState::SegmentState(LocalIdMaps* const idMaps)
+    : mIdMaps(idMaps),
+      mCurrent(0),
+      mBegin(0),
+      mEnd(0),
+      mNumCarried(0),
+      mTarget(0),
+      mNumScanned(0),
+      mFlushTime(-DBL_MAX),
+      mPartial(false),
+      mResumePosition(0)
+{
+}
+
+
+SegmentState::~SegmentState()
+{
+    for (CheckpointMap::iterator it = mCheckpoints.begin();
+         it != mCheckpoints.end();
+         ++it)
+    {
+        vector< Event_rep* >& enters = it->second.mEnters;
+        for (vector< Event_rep* >::iterator event = enters.begin();
+             event != enters.end();
+             ++event)
+        {
+            delete *event;
+        }
+    }
+    delete mIdMaps;
+}
+
+
+// --- Query functions ------------------------------------------------------
+
+LocalIdMaps*
+SegmentState::getIdMaps() const
+{
+    return mIdMaps;
+}
+
+
+uint64_t
+SegmentState::getBegin() const
+{
+    return mBegin;
+}
+
+
+uint64_t
+SegmentState::getEnd() const
+{
+    return mEnd;
+}
+
+
+uint32_t
+SegmentState::getNumCarried() const
+{
+    return mNumCarried;
+}
+
+
+bool
+SegmentState::isPartial() const
+{
+    return mPartial;
+}
+
+
+uint64_t
+SegmentState::getRecordPosition() const
+{
+    return mCurrent ? mCurrent->mRecordPosition : 0;
+}
+
+
+const Buffer&
+SegmentState::getReaderState() const
+{
+    assert(mCurrent);
+
+    return mCurrent->mReaderState;
+}
+
+
+// --- Reading segments -----------------------------------------------------
+
+void
+SegmentState::beginRead(LocalTrace&    trace,
+                        const uint64_t position,
+                        const uint64_t numEvents)
+{
+    assert(trace.size() == 0);
+
+    mCurrent = 0;
+    if (position > 0)
+    {
+        CheckpointMap::const_iterator it = mCheckpoints.find(position);
+        if (it == mCheckpoints.end())
+        {
+            throw RuntimeError("Trace segments can only start at the end of "
+                               "a previously read segment!");
+        }
+        mCurrent = &it->second;
+    }
+
+    mBegin          = position;
+    mEnd            = position;
+    mTarget         = numEvents;
+    mFlushTime      = -DBL_MAX;
+    mPartial        = false;
+    mResumePosition = 0;
+    mEnterStack.clear();
+
+    // Carry over the ENTER events of the regions entered in earlier segments
+    if (mCurrent)
+    {
+        const vector< Event_rep* >& enters = mCurrent->mEnters;
+        for (vector< Event_rep* >::const_iterator it = enters.begin();
+             it != enters.end();
+             ++it)
+        {
+            mEnterStack.push_back(trace.size());
+            trace.add_event(copyEnter(**it));
+        }
+    }
+    mNumCarried = trace.size();
+    mNumScanned = mNumCarried;
+}
+
+
+bool
+SegmentState::isComplete(const LocalTrace& trace)
+{
+    const GlobalDefs& defs      = trace.get_definitions();
+    const uint32_t    numEvents = trace.size();
+    for (; mNumScanned < numEvents; ++mNumScanned)
+    {
+        const Event_rep& event = *trace.at(mNumScanned);
+
+        if (event.isOfType(GROUP_ENTER))
+        {
+            const Enter_rep& enter = static_cast< const Enter_rep& >(event);
+            if (enter.getRegionEntered() == defs.getFlushingRegion())
+            {
+                mFlushTime = max(mFlushTime, event.getTimestamp());
+            }
+            mEnterStack.push_back(mNumScanned);
+        }
+        else if (event.isOfType(GROUP_LEAVE))
+        {
+            const Leave_rep& leave = static_cast< const Leave_rep& >(event);
+            if (leave.getRegionLeft() == defs.getFlushingRegion())
+            {
+                mFlushTime = max(mFlushTime, event.getTimestamp());
+            }
+            if (!mEnterStack.empty())
+            {
+                mEnterStack.pop_back();
+            }
+        }
+        else if (event.isOfType(THREAD_TASK_SWITCH))
+        {
+            throw RuntimeError("Reading traces with OpenMP tasks in segments "
+                               "is not supported!");
+        }
+    }
+
+    return (  (numEvents > mNumCarried)
+           && (numEvents - mNumCarried >= mTarget)
+           && (trace.at(numEvents - 1)->getTimestamp() > mFlushTime));
+}
+
+
+void
+SegmentState::setResumeState(const uint64_t recordPosition,
+                             const Buffer&  readerState)
+{
+    mPartial        = true;
+    mResumePosition = recordPosition;
+    mResumeState    = readerState;
+}
+
+
+void
+SegmentState::endRead(const LocalTrace& trace)
+{
+    // Account for events added after the last completion check (e.g., at
+    // the end of CCT traces)
+    isComplete(trace);
+
+    mEnd = mBegin + (trace.size() - mNumCarried);
+    if (  !mPartial
+       || (mCheckpoints.find(mEnd) != mCheckpoints.end()))
+    {
+        return;
+    }
+
+    Checkpoint& checkpoint = mCheckpoints[mEnd];
+    checkpoint.mRecordPosition = mResumePosition;
+    checkpoint.mReaderState    = mResumeState;
+    checkpoint.mEnters.reserve(mEnterStack.size());
+    for (vector< uint32_t >::const_iterator it = mEnterStack.begin();
+         it != mEnterStack.end();
+         ++it)
+    {
+        checkpoint.mEnters.push_back(copyEnter(*trace.at(*it)));
+    }
+
+    // The begin checkpoint pointer stays valid, as std::map insertions do
+    // not invalidate references to other elements
+}
+
+
+// --- Private member functions ---------------------------------------------
+
+/// @brief Copy an ENTER event.
+///
+/// Creates a copy of the given ENTER-type @p event.  As the copy is taken
+/// while reading, the event still refers to the region entered instead of
+/// its callpath.
+///
+/// @param event
+///     ENTER-type event representation
+/// @returns
+///     Pointer to the newly created copy
+///
+Event_rep*
+SegmentState::copyEnter(const Event_rep& event)
+{
+    switch (event.getType())
+    {
+        case ENTER_CS:
+            return new EnterCS_rep(static_cast< const EnterCS_rep& >(event));
+
+        case ENTER_PROGRAM:
+            return new EnterProgram_rep(
+                static_cast< const EnterProgram_rep& >(event));
+
+        default:
+            assert(event.getType() == ENTER);
+            break;
+    }
+
+    return new Enter_rep(static_cast< const Enter_rep& >(event));
+}
@@ -0,0 +1,317 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Declaration of the class pearl::detail::SegmentState.
+ *
+ *  This header file provides the declaration of the internal helper class
+ *  pearl::detail::SegmentState.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#ifndef PEARL_SEGMENTSTATE_H
+#define PEARL_SEGMENTSTATE_H
+
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include <pearl/Buffer.h>
+#include <pearl/Uncopyable.h>
+#include <pearl/pearl_types.h>
+
+
+namespace pearl
+{
+// --- Forward declarations -------------------------------------------------
+
+class Event_rep;
+class LocalIdMaps;
+class LocalTrace;
+
+
+namespace detail
+{
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   SegmentState
+ *  @ingroup PEARL_base
+ *  @brief   Bookkeeping for reading the event trace of a location in
+ *           segments.
+ *
+ *  The class `%SegmentState` keeps track of the state required to read the
+ *  event trace of a single location as a sequence of consecutive segments
+ *  using the same LocalTrace object (see TraceArchive::getTraceSegment()).
+ *  Event positions are ordinals of the events in the order they are read
+ *  from the archive.  Whenever a segment ends before the end of the trace,
+ *  a checkpoint is recorded at its end position.  It stores copies of the
+ *  ENTER events of all regions that are still open at this point, as well
+ *  as the archive-specific reader position and state needed to continue
+ *  reading.  Reading a segment may start at any checkpoint; the copies of
+ *  the open ENTER events ("carried" events) are then placed at the front
+ *  of the segment, so that each segment is a properly nested event
+ *  sequence on its own.
+ *
+ *  Segments only end at record boundaries and after all buffer flush
+ *  events of the segment, i.e., they may contain slightly more events
+ *  than requested.  This ensures that reordering the flush events during
+ *  call tree verification never needs to move events across segments.
+ *  Reading event traces using OpenMP tasks in segments is not supported.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class SegmentState
+    : private pearl::Uncopyable
+{
+    public:
+        // --- Public member functions ---------------------
+
+        /// @name Constructors & destructor
+        /// @{
+
+        /// @brief Constructor.
+        ///
+        /// Creates a new instance for reading the event trace of a location
+        /// from its beginning.  Takes ownership of the identifier mapping
+        /// data object @p idMaps, which is needed for every segment.
+        ///
+        /// @param idMaps
+        ///     Pointer to identifier mapping data object
+        ///
+        explicit
+        SegmentState(LocalIdMaps* idMaps);
+
+        /// @brief Destructor.
+        ///
+        /// Releases all checkpoints and the identifier mapping data object.
+        ///
+        ~SegmentState();
+
+        /// @}
+        /// @name Query functions
+        /// @{
+
+        /// @brief Get identifier mappings.
+        ///
+        /// @returns
+        ///     Pointer to identifier mapping data object
+        ///
+        LocalIdMaps*
+        getIdMaps() const;
+
+        /// @brief Get segment begin.
+        ///
+        /// @returns
+        ///     Position of the first (non-carried) event of the segment
+        ///
+        uint64_t
+        getBegin() const;
+
+        /// @brief Get segment end.
+        ///
+        /// @returns
+        ///     Position following the last event of the segment
+        ///
+        uint64_t
+        getEnd() const;
+
+        /// @brief Get number of carried events.
+        ///
+        /// @returns
+        ///     Number of ENTER events of enclosing regions placed in front of
+        ///     the segment's own events
+        ///
+        uint32_t
+        getNumCarried() const;
+
+        /// @brief Check for partial traces.
+        ///
+        /// @returns
+        ///     True if the segment ends before the end of the event trace,
+        ///     false otherwise
+        ///
+        bool
+        isPartial() const;
+
+        /// @brief Get record position.
+        ///
+        /// @returns
+        ///     Archive-specific reader position at the beginning of the
+        ///     segment; 0 for the first segment
+        ///
+        uint64_t
+        getRecordPosition() const;
+
+        /// @brief Get reader state.
+        ///
+        /// Returns the archive-specific reader state packed when the
+        /// preceding segment was read.  Only valid if getRecordPosition()
+        /// is non-zero.
+        ///
+        /// @returns
+        ///     Packed reader state
+        ///
+        const Buffer&
+        getReaderState() const;
+
+        /// @}
+        /// @name Reading segments
+        /// @{
+
+        /// @brief Start reading a segment.
+        ///
+        /// Prepares reading a segment of at least @p numEvents events
+        /// starting at @p position into the empty @p trace, and adds the
+        /// carried ENTER events recorded at this position.
+        ///
+        /// @param trace
+        ///     Local trace data object
+        /// @param position
+        ///     Segment begin; has to be 0 or the end of a previously read
+        ///     segment
+        /// @param numEvents
+        ///     Requested number of events
+        ///
+        /// @throws pearl::RuntimeError
+        ///     if no checkpoint has been recorded at @p position
+        ///
+        void
+        beginRead(LocalTrace& trace,
+                  uint64_t    position,
+                  uint64_t    numEvents);
+
+        /// @brief Check whether the segment is complete.
+        ///
+        /// Examines the events added to @p trace since the last call and
+        /// returns whether reading can stop before the next record, i.e.,
+        /// whether the requested number of events has been read and the
+        /// last event occurred after all buffer flushes of the segment.
+        ///
+        /// @param trace
+        ///     Local trace data object
+        /// @returns
+        ///     True if the segment is complete, false otherwise
+        ///
+        /// @throws pearl::RuntimeError
+        ///     on OpenMP task switch events
+        ///
+        bool
+        isComplete(const LocalTrace& trace);
+
+        /// @brief Store the reader state to continue with.
+        ///
+        /// Marks the segment as partial and stores the archive-specific
+        /// reader position and state needed to read the next segment.
+        ///
+        /// @param recordPosition
+        ///     Reader position of the first record of the next segment
+        /// @param readerState
+        ///     Packed reader state
+        ///
+        void
+        setResumeState(uint64_t      recordPosition,
+                       const Buffer& readerState);
+
+        /// @brief Finish reading a segment.
+        ///
+        /// Determines the segment end and records a checkpoint there if
+        /// the segment is partial.  Has to be called outside of the trace's
+        /// memory arena scope, as the checkpoint outlives the events of the
+        /// segment.
+        ///
+        /// @param trace
+        ///     Local trace data object
+        ///
+        void
+        endRead(const LocalTrace& trace);
+
+        /// @}
+
+
+    private:
+        // --- Type definitions ----------------------------
+
+        /// Resumption point at the end of a partial segment
+        struct Checkpoint
+        {
+            /// Copies of the ENTER events of all open regions
+            std::vector< Event_rep* > mEnters;
+
+            /// Reader position of the first record of the next segment
+            uint64_t mRecordPosition;
+
+            /// Packed reader state
+            Buffer mReaderState;
+        };
+
+        /// Container type for checkpoints, indexed by event position
+        typedef std::map< uint64_t, Checkpoint > CheckpointMap;
+
+
+        // --- Data members --------------------------------
+
+        /// Identifier mapping data object
+        LocalIdMaps* mIdMaps;
+
+        /// Checkpoints recorded so far
+        CheckpointMap mCheckpoints;
+
+        /// Checkpoint at the segment begin (null for the first segment)
+        const Checkpoint* mCurrent;
+
+        /// Segment begin
+        uint64_t mBegin;
+
+        /// Segment end
+        uint64_t mEnd;
+
+        /// Number of carried events
+        uint32_t mNumCarried;
+
+        /// Requested number of events
+        uint64_t mTarget;
+
+        /// Number of trace events examined by isComplete()
+        uint32_t mNumScanned;
+
+        /// Indices of the ENTER events of all open regions
+        std::vector< uint32_t > mEnterStack;
+
+        /// Latest timestamp of a buffer flush event in the segment
+        timestamp_t mFlushTime;
+
+        /// Partial segment marker
+        bool mPartial;
+
+        /// Reader position stored by setResumeState()
+        uint64_t mResumePosition;
+
+        /// Reader state stored by setResumeState()
+        Buffer mResumeState;
+
+
+        // --- Private member functions --------------------
+
+        static Event_rep*
+        copyEnter(const Event_rep& event);
+};
+}    // namespace pearl::detail
+}    // namespace pearl
+
+
+#endif    // !PEARL_SEGMENTSTATE_H
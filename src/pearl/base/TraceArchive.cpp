@@ -32,24 +32,51 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 
 #include <pearl/Error.h>
 #include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
 #include <pearl/ScopedPtr.h>
 
 #include "EpikArchive.h"
 #include "LocalIdMaps.h"
 #include "MutableGlobalDefs.h"
 #include "Otf2Archive.h"
+#include "SegmentState.h"
 #include "epk_archive.h"
+#include "pearl_memory.h"
 
 using namespace std;
 using namespace pearl;
 using namespace pearl::detail;
 
 
+// --- Helpers --------------------------------------------------------------
+
+namespace
+{
+/// Selects a memory arena for event allocations on the calling thread for
+/// the lifetime of the object
+class ArenaScope
+{
+    public:
+        explicit
+        ArenaScope(MemoryArena* arena)
+        {
+            memorySetArena(arena);
+        }
+
+        ~ArenaScope()
+        {
+            memorySetArena(0);
+        }
+};
+}    // unnamed namespace
+
+
 // --- Constructors & destructor --------------------------------------------
 
 TraceArchive::TraceArchive(const string& anchorName,
@@ -178,6 +205,25 @@ TraceArchive::getDefinitions()
 }
 
 
+void
+TraceArchive::packDefinitions(Buffer& buffer)
+{
+    readPackedDefinitions(buffer);
+}
+
+
+GlobalDefs*
+TraceArchive::getDefinitions(Buffer& buffer)
+{
+    ScopedPtr< MutableGlobalDefs > definitions(new MutableGlobalDefs);
+    unpackDefinitions(definitions.get(), buffer);
+    definitions->validate();
+    definitions->setup();
+
+    return definitions.release();
+}
+
+
 // --- Access local mapping & event trace data ------------------------------
 
 void
@@ -212,8 +258,131 @@ TraceArchive::getTrace(const GlobalDefs& defs,
         mapData.reset(getIdMaps(location));
     }
 
-    ScopedPtr< LocalTrace > trace(new LocalTrace(defs, location));
-    readTrace(defs, location, mapData.get(), trace.get());
+    // Events created while reading are allocated from the trace's memory
+    // arena; later modifications fall back to the small object allocator
+    ScopedPtr< LocalTrace > trace(new LocalTrace(defs, location,
+                                                 location.getNumEvents()));
+    {
+        ArenaScope scope(trace->m_arena);
+        readTrace(defs, location, mapData.get(), trace.get());
+    }
 
     return trace.release();
 }
+
+
+LocalTrace*
+TraceArchive::getTraceSegment(const GlobalDefs& defs,
+                              const Location&   location,
+                              const uint64_t    numEvents,
+                              LocalIdMaps*      idMaps)
+{
+    ScopedPtr< LocalIdMaps > mapData(idMaps);
+    if (!mapData)
+    {
+        mapData.reset(getIdMaps(location));
+    }
+
+    const uint64_t          capacity = min(numEvents, location.getNumEvents());
+    ScopedPtr< LocalTrace > trace(new LocalTrace(defs, location, capacity));
+    trace->m_segments = new SegmentState(mapData.release());
+    readTraceSegment(*trace, 0, numEvents);
+
+    return trace.release();
+}
+
+
+void
+TraceArchive::readTraceSegment(LocalTrace&    trace,
+                               const uint64_t begin,
+                               const uint64_t numEvents)
+{
+    if (!trace.m_segments)
+    {
+        throw RuntimeError("Trace data object does not support "
+                           "segment-wise reading!");
+    }
+    SegmentState& segment = *trace.m_segments;
+
+    trace.clear();
+    {
+        ArenaScope scope(trace.m_arena);
+        segment.beginRead(trace, begin, numEvents);
+        readSegment(trace.get_definitions(), trace.get_location(),
+                    segment.getIdMaps(), &trace, segment);
+    }
+
+    // Checkpoint copies of ENTER events have to outlive the arena
+    segment.endRead(trace);
+}
+
+
+// --- Private member functions ---------------------------------------------
+
+/// @brief Read global definitions in packed form.
+///
+/// Reads the global definition data and appends a packed representation to
+/// @a buffer.  The default implementation leaves @a buffer unchanged;
+/// archive types supporting packed definitions override this member
+/// function together with unpackDefinitions().
+///
+/// @param buffer
+///     %Buffer to which the packed definition data is appended
+///
+void
+TraceArchive::readPackedDefinitions(Buffer& buffer)
+{
+}
+
+
+/// @brief Unpack global definitions.
+///
+/// Fills the given definitions object @a defs from the packed definition
+/// data in @a buffer created by readPackedDefinitions().  The default
+/// implementation reads the definition data from the archive instead.
+///
+/// @param defs
+///     Global definitions object to be filled
+/// @param buffer
+///     %Buffer providing the packed definition data
+///
+void
+TraceArchive::unpackDefinitions(GlobalDefs* defs,
+                                Buffer&     buffer)
+{
+    readDefinitions(defs);
+}
+
+
+/// @brief Read trace segment.
+///
+/// Reads the event trace data for the given @a location into @a trace,
+/// starting at the reader position stored in @a segment, until
+/// SegmentState::isComplete() indicates that the segment is complete or the
+/// end of the trace is reached.  In the former case, the reader position and
+/// state required to continue have to be passed to
+/// SegmentState::setResumeState().  The default implementation throws an
+/// exception; archive types supporting segment-wise reading override this
+/// member function.
+///
+/// @param defs
+///     Global definitions object
+/// @param location
+///     %Location whose trace data should be read
+/// @param idMaps
+///     Pointer to identifier mapping data object
+/// @param trace
+///     Trace data object to which the events are added
+/// @param segment
+///     Segment-wise reading state
+///
+void
+TraceArchive::readSegment(const GlobalDefs& defs,
+                          const Location&   location,
+                          LocalIdMaps*      idMaps,
+                          LocalTrace*       trace,
+                          SegmentState&     segment)
+{
+    throw RuntimeError("Segment-wise reading of trace data is not supported "
+                       "for this experiment archive type!");
+}
@@ -20,6 +20,7 @@
 
 #include <cfloat>
 #include <map>
+#include <vector>
 
 #define SCALASCA_DEBUG_MODULE_NAME    PEARL
 #include <UTILS_Debug.h>
@@ -41,6 +42,7 @@
 #include "DefsFactory.h"
 #include "EventFactory.h"
 #include "MutableGlobalDefs.h"
+#include "RequestTable.h"
 #include "Threading.h"
 #include "pearl_ipc.h"
 #include "pearl_memory.h"
@@ -133,6 +135,11 @@ pearl::PEARL_finalize()
  *  the process-local call tree is extended accordingly. This has to be done
  *  before PEARL_preprocess_trace() is called.
  *
+ *  For partial trace segments (see LocalTrace::is_partial()), regions
+ *  which are still active at the end of the segment are accepted.  To
+ *  obtain the complete call tree of a trace read in segments, this function
+ *  has to be called for each segment.
+ *
  *  @param defs  Global definitions object
  *  @param trace Local trace data object
  *
@@ -389,14 +396,15 @@ pearl::PEARL_verify_calltree(GlobalDefs& defs,
     }
 
     // Verify correct nesting of Enter/Leave events
-    // Something left on the call stack ==> too many Enter events
+    // Something left on the call stack ==> too many Enter events (unless
+    // the trace is a segment whose active regions are left later)
     // Call stack empty ==> too many Leave events
     if (  (depth < 0)
        || (status == TOO_MANY_LEAVES))
     {
         throw FatalError("Unbalanced ENTER/LEAVE events (Too many LEAVEs).");
     }
-    else if (  (depth > 0)
+    else if (  ((depth > 0) && !trace.is_partial())
             || (status == TOO_MANY_ENTERS))
     {
         throw FatalError("Unbalanced ENTER/LEAVE events (Too many ENTERs).");
@@ -452,6 +460,11 @@ pearl::PEARL_verify_calltree(GlobalDefs& defs,
  *  last step in setting up the data structures, i.e., after calling
  *  PEARL_verify_calltree() and PEARL_mpi_unify_calltree().
  *
+ *  This also builds the ENTER/LEAVE matching index of the trace, which
+ *  turns Event::enterptr(), Event::leaveptr(), and Event::get_cnode() into
+ *  constant-time lookups.  The index is discarded if the event sequence is
+ *  modified afterwards.
+ *
  *  @param defs  Global definitions object
  *  @param trace Local trace data object
  *
@@ -481,7 +494,15 @@ pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
     uint64_t                        currentTaskId  = trace.get_location().getId();
     uint64_t                        previousTaskId = 0;
     std::map< uint64_t, Callpath* > activeTasks;
-    std::map< uint64_t, Event >     requestMap;
+    RequestTable                    requestTable;
+
+    // ENTER/LEAVE matching index; the stacks of active ENTER events are
+    // maintained per task, as task execution may be interleaved
+    std::map< uint64_t, std::vector< uint32_t > > enterStacks;
+    std::vector< uint32_t >*                      enterStack = &enterStacks[currentTaskId];
+
+    trace.m_enterptr.assign(trace.size(), LocalTrace::NO_INDEX);
+    trace.m_leaveptr.assign(trace.size(), LocalTrace::NO_INDEX);
 
     // Determine program callpath if first event on master thread is of type
     // EnterProgram; used as parent by the artificial TASKS/THREADS callpaths
@@ -517,6 +538,14 @@ pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
 
             // Set callpath pointer
             enter.setCallpath(current);
+
+            // Update matching index
+            const uint32_t index = event.get_id();
+            if (!enterStack->empty())
+            {
+                trace.m_enterptr[index] = enterStack->back();
+            }
+            enterStack->push_back(index);
         }
 
         // LEAVE:
@@ -527,6 +556,16 @@ pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
 
             // Update current callpath
             current = current->getParent();
+
+            // Update matching index
+            if (!enterStack->empty())
+            {
+                const uint32_t index = event.get_id();
+
+                trace.m_enterptr[index]               = enterStack->back();
+                trace.m_leaveptr[enterStack->back()] = index;
+                enterStack->pop_back();
+            }
         }
 
         // THREAD_FORK:
@@ -574,6 +613,7 @@ pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
 
             // store current callpath progress
             activeTasks[previousTaskId] = current;
+            enterStack                  = &enterStacks[currentTaskId];
 
             // unvisited task
             if (activeTasks.count(currentTaskId) == 0)
@@ -595,35 +635,51 @@ pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
             // fall back to the implicit task
             currentTaskId = trace.get_location().getId();    // until the next task switch
             current       = activeTasks[currentTaskId];
+            enterStack    = &enterStacks[currentTaskId];
 
             // task complete remove data to minimize resources
             ThreadTaskComplete_rep& taskComplete = event_cast< ThreadTaskComplete_rep >(*event);
             activeTasks.erase(taskComplete.getTaskId());
+            if (taskComplete.getTaskId() != currentTaskId)
+            {
+                enterStacks.erase(taskComplete.getTaskId());
+            }
         }
 
-        else if (event->isOfType(GROUP_NONBLOCK))
+        // Other events: enclosing ENTER of the current task
+        if (  !event->isOfType(GROUP_ENTER)
+           && !event->isOfType(GROUP_LEAVE)
+           && !event->isOfType(THREAD_TASK_SWITCH)
+           && !event->isOfType(THREAD_TASK_COMPLETE)
+           && !enterStack->empty())
         {
-            // Precompute next/previous request offset
-            uint64_t requestId = event->getRequestId();
+            trace.m_enterptr[event.get_id()] = enterStack->back();
+        }
 
-            std::map< uint64_t, Event >::iterator rmapit = requestMap.find(requestId);
-            if (rmapit != requestMap.end())
+        if (event->isOfType(GROUP_NONBLOCK))
+        {
+            // Precompute next/previous request offset
+            const uint64_t requestId = event->getRequestId();
+            const uint32_t index     = event.get_id();
+            const uint32_t prevIndex = requestTable.find(requestId);
+            if (prevIndex != RequestTable::NO_INDEX)
             {
-                rmapit->second->set_next_reqoffs(event.get_id() - rmapit->second.get_id());
-                event->set_prev_reqoffs(event.get_id() - rmapit->second.get_id());
+                const uint32_t offset = index - prevIndex;
+                trace[prevIndex]->set_next_reqoffs(offset);
+                event->set_prev_reqoffs(offset);
 
                 if (event->isOfType(MPI_REQUEST_TESTED))
                 {
-                    rmapit->second = event;
+                    requestTable.insert(requestId, index);
                 }
                 else
                 {
-                    requestMap.erase(rmapit);
+                    requestTable.erase(requestId);
                 }
             }
             else
             {
-                requestMap.insert(std::make_pair(requestId, event));
+                requestTable.insert(requestId, index);
             }
         }
         ++event;
@@ -24,131 +24,105 @@ using namespace std;
 using namespace pearl;
 
 
-// --- Utility functions ----------------------------------------------------
-
-namespace
-{
-template< class containerT >
-void
-execute_callbacks(const containerT&             cbmap,
-                  typename containerT::key_type key,
-                  const CallbackManager&        cbmanager,
-                  int                           user_event,
-                  const Event&                  event,
-                  CallbackData*                 data)
-{
-    // Any callbacks defined?
-    typename containerT::const_iterator it = cbmap.find(key);
-    if (it == cbmap.end())
-    {
-        return;
-    }
-
-    // Execute callback routines
-    typename containerT::mapped_type::const_iterator cb = it->second.begin();
-    while (cb != it->second.end())
-    {
-        (*cb)->execute(cbmanager, user_event, event, data);
-        ++cb;
-    }
-}
-}    // unnamed namespace
-
-
 // --- Registering callbacks ------------------------------------------------
 
 void
 CallbackManager::register_callback(event_t     event_type,
                                    CallbackPtr callback)
 {
+    // The dispatch table only holds plain pointers for fast notification;
+    // ownership is retained here
+    m_callbacks.push_back(callback);
+
+    Callback* const cb = callback.get();
     switch (event_type)
     {
         case GROUP_ALL:
-            m_event_cbs[ENTER                   ].push_back(callback);
-            m_event_cbs[ENTER_CS                ].push_back(callback);
-            m_event_cbs[ENTER_PROGRAM           ].push_back(callback);
-            m_event_cbs[LEAVE                   ].push_back(callback);
-            m_event_cbs[LEAVE_PROGRAM           ].push_back(callback);
-            m_event_cbs[MPI_COLLECTIVE_BEGIN    ].push_back(callback);
-            m_event_cbs[MPI_COLLECTIVE_END      ].push_back(callback);
-            m_event_cbs[MPI_SEND                ].push_back(callback);
-            m_event_cbs[MPI_SEND_REQUEST        ].push_back(callback);
-            m_event_cbs[MPI_SEND_COMPLETE       ].push_back(callback);
-            m_event_cbs[MPI_RECV                ].push_back(callback);
-            m_event_cbs[MPI_RECV_REQUEST        ].push_back(callback);
-            m_event_cbs[MPI_RECV_COMPLETE       ].push_back(callback);
-            m_event_cbs[MPI_REQUEST_TESTED      ].push_back(callback);
-            m_event_cbs[MPI_CANCELLED           ].push_back(callback);
-            m_event_cbs[THREAD_BEGIN            ].push_back(callback);
-            m_event_cbs[THREAD_END              ].push_back(callback);
-            m_event_cbs[THREAD_CREATE           ].push_back(callback);
-            m_event_cbs[THREAD_WAIT             ].push_back(callback);
-            m_event_cbs[THREAD_FORK             ].push_back(callback);
-            m_event_cbs[THREAD_JOIN             ].push_back(callback);
-            m_event_cbs[THREAD_ACQUIRE_LOCK     ].push_back(callback);
-            m_event_cbs[THREAD_RELEASE_LOCK     ].push_back(callback);
-            m_event_cbs[THREAD_TASK_CREATE      ].push_back(callback);
-            m_event_cbs[THREAD_TASK_COMPLETE    ].push_back(callback);
-            m_event_cbs[THREAD_TASK_SWITCH      ].push_back(callback);
-            m_event_cbs[THREAD_TEAM_BEGIN       ].push_back(callback);
-            m_event_cbs[THREAD_TEAM_END         ].push_back(callback);
-            m_event_cbs[RMA_PUT_START           ].push_back(callback);
-            m_event_cbs[RMA_PUT_END             ].push_back(callback);
-            m_event_cbs[RMA_GET_START           ].push_back(callback);
-            m_event_cbs[RMA_GET_END             ].push_back(callback);
-            m_event_cbs[MPI_RMA_PUT_START       ].push_back(callback);
-            m_event_cbs[MPI_RMA_PUT_END         ].push_back(callback);
-            m_event_cbs[MPI_RMA_GET_START       ].push_back(callback);
-            m_event_cbs[MPI_RMA_GET_END         ].push_back(callback);
-            m_event_cbs[MPI_RMA_GATS            ].push_back(callback);
-            m_event_cbs[MPI_RMA_COLLECTIVE_BEGIN].push_back(callback);
-            m_event_cbs[MPI_RMA_COLLECTIVE_END  ].push_back(callback);
-            m_event_cbs[MPI_RMA_LOCK            ].push_back(callback);
-            m_event_cbs[MPI_RMA_UNLOCK          ].push_back(callback);
+            add_callback(ENTER,                    cb);
+            add_callback(ENTER_CS,                 cb);
+            add_callback(ENTER_PROGRAM,            cb);
+            add_callback(LEAVE,                    cb);
+            add_callback(LEAVE_PROGRAM,            cb);
+            add_callback(MPI_COLLECTIVE_BEGIN,     cb);
+            add_callback(MPI_COLLECTIVE_END,       cb);
+            add_callback(MPI_SEND,                 cb);
+            add_callback(MPI_SEND_REQUEST,         cb);
+            add_callback(MPI_SEND_COMPLETE,        cb);
+            add_callback(MPI_RECV,                 cb);
+            add_callback(MPI_RECV_REQUEST,         cb);
+            add_callback(MPI_RECV_COMPLETE,        cb);
+            add_callback(MPI_REQUEST_TESTED,       cb);
+            add_callback(MPI_CANCELLED,            cb);
+            add_callback(THREAD_BEGIN,             cb);
+            add_callback(THREAD_END,               cb);
+            add_callback(THREAD_CREATE,            cb);
+            add_callback(THREAD_WAIT,              cb);
+            add_callback(THREAD_FORK,              cb);
+            add_callback(THREAD_JOIN,              cb);
+            add_callback(THREAD_ACQUIRE_LOCK,      cb);
+            add_callback(THREAD_RELEASE_LOCK,      cb);
+            add_callback(THREAD_TASK_CREATE,       cb);
+            add_callback(THREAD_TASK_COMPLETE,     cb);
+            add_callback(THREAD_TASK_SWITCH,       cb);
+            add_callback(THREAD_TEAM_BEGIN,        cb);
+            add_callback(THREAD_TEAM_END,          cb);
+            add_callback(RMA_PUT_START,            cb);
+            add_callback(RMA_PUT_END,              cb);
+            add_callback(RMA_GET_START,            cb);
+            add_callback(RMA_GET_END,              cb);
+            add_callback(MPI_RMA_PUT_START,        cb);
+            add_callback(MPI_RMA_PUT_END,          cb);
+            add_callback(MPI_RMA_GET_START,        cb);
+            add_callback(MPI_RMA_GET_END,          cb);
+            add_callback(MPI_RMA_GATS,             cb);
+            add_callback(MPI_RMA_COLLECTIVE_BEGIN, cb);
+            add_callback(MPI_RMA_COLLECTIVE_END,   cb);
+            add_callback(MPI_RMA_LOCK,             cb);
+            add_callback(MPI_RMA_UNLOCK,           cb);
             break;
 
         case GROUP_NONBLOCK:
-            m_event_cbs[MPI_SEND_REQUEST        ].push_back(callback);
-            m_event_cbs[MPI_SEND_COMPLETE       ].push_back(callback);
-            m_event_cbs[MPI_RECV_REQUEST        ].push_back(callback);
-            m_event_cbs[MPI_RECV_COMPLETE       ].push_back(callback);
-            m_event_cbs[MPI_REQUEST_TESTED      ].push_back(callback);
-            m_event_cbs[MPI_CANCELLED           ].push_back(callback);
+            add_callback(MPI_SEND_REQUEST,         cb);
+            add_callback(MPI_SEND_COMPLETE,        cb);
+            add_callback(MPI_RECV_REQUEST,         cb);
+            add_callback(MPI_RECV_COMPLETE,        cb);
+            add_callback(MPI_REQUEST_TESTED,       cb);
+            add_callback(MPI_CANCELLED,            cb);
             break;
 
         case GROUP_ENTER:
-            m_event_cbs[ENTER                   ].push_back(callback);
-            m_event_cbs[ENTER_CS                ].push_back(callback);
-            m_event_cbs[ENTER_PROGRAM           ].push_back(callback);
+            add_callback(ENTER,                    cb);
+            add_callback(ENTER_CS,                 cb);
+            add_callback(ENTER_PROGRAM,            cb);
             break;
 
         case GROUP_LEAVE:
-            m_event_cbs[LEAVE                   ].push_back(callback);
-            m_event_cbs[LEAVE_PROGRAM           ].push_back(callback);
+            add_callback(LEAVE,                    cb);
+            add_callback(LEAVE_PROGRAM,            cb);
             break;
 
         case GROUP_SEND:
-            m_event_cbs[MPI_SEND                ].push_back(callback);
-            m_event_cbs[MPI_SEND_REQUEST        ].push_back(callback);
+            add_callback(MPI_SEND,                 cb);
+            add_callback(MPI_SEND_REQUEST,         cb);
             break;
 
         case GROUP_RECV:
-            m_event_cbs[MPI_RECV                ].push_back(callback);
-            m_event_cbs[MPI_RECV_COMPLETE       ].push_back(callback);
+            add_callback(MPI_RECV,                 cb);
+            add_callback(MPI_RECV_COMPLETE,        cb);
             break;
 
         case GROUP_BEGIN:
-            m_event_cbs[MPI_COLLECTIVE_BEGIN    ].push_back(callback);
-            m_event_cbs[MPI_RMA_COLLECTIVE_BEGIN].push_back(callback);
+            add_callback(MPI_COLLECTIVE_BEGIN,     cb);
+            add_callback(MPI_RMA_COLLECTIVE_BEGIN, cb);
             break;
 
         case GROUP_END:
-            m_event_cbs[MPI_COLLECTIVE_END      ].push_back(callback);
-            m_event_cbs[MPI_RMA_COLLECTIVE_END  ].push_back(callback);
+            add_callback(MPI_COLLECTIVE_END,       cb);
+            add_callback(MPI_RMA_COLLECTIVE_END,   cb);
             break;
 
         default:
-            m_event_cbs[event_type              ].push_back(callback);
+            add_callback(event_type,               cb);
             break;
     }
 }
@@ -168,7 +142,15 @@ void
 CallbackManager::notify(const Event&  event,
                         CallbackData* data) const
 {
-    execute_callbacks(m_event_cbs, event->getType(), *this, 0, event, data);
+    const dispatch_container& callbacks = m_event_cbs[event->getType()];
+
+    // Execute callback routines
+    dispatch_container::const_iterator it = callbacks.begin();
+    while (it != callbacks.end())
+    {
+        (*it)->execute(*this, 0, event, data);
+        ++it;
+    }
 }
 
 
@@ -177,5 +159,29 @@ CallbackManager::notify(int           user_event,
                         const Event&  event,
                         CallbackData* data) const
 {
-    execute_callbacks(m_user_cbs, user_event, *this, user_event, event, data);
+    // Any callbacks defined?
+    user_cb_map::const_iterator entry = m_user_cbs.find(user_event);
+    if (entry == m_user_cbs.end())
+    {
+        return;
+    }
+
+    // Execute callback routines
+    callback_container::const_iterator it = entry->second.begin();
+    while (it != entry->second.end())
+    {
+        (*it)->execute(*this, user_event, event, data);
+        ++it;
+    }
+}
+
+
+// --- Private methods ------------------------------------------------------
+
+void
+CallbackManager::add_callback(event_t   event_type,
+                              Callback* callback)
+{
+    m_event_cbs[event_type].push_back(callback);
+    m_event_mask.set(event_type);
 }
@@ -40,7 +40,10 @@ pearl::PEARL_forward_replay(const LocalTrace&           trace,
         while (it != end)
         {
             data->preprocess(it);
-            cbmanager.notify(it, data);
+            if (cbmanager.has_callbacks(it.get_type()))
+            {
+                cbmanager.notify(it, data);
+            }
             data->postprocess(it);
 
             ++it;
@@ -50,7 +53,10 @@ pearl::PEARL_forward_replay(const LocalTrace&           trace,
     {
         while (it != end)
         {
-            cbmanager.notify(it, data);
+            if (cbmanager.has_callbacks(it.get_type()))
+            {
+                cbmanager.notify(it, data);
+            }
 
             ++it;
         }
@@ -74,7 +80,10 @@ pearl::PEARL_backward_replay(const LocalTrace&                   trace,
             LocalTrace::iterator event = (++it).base();
 
             data->preprocess(event);
-            cbmanager.notify(event, data);
+            if (cbmanager.has_callbacks(event.get_type()))
+            {
+                cbmanager.notify(event, data);
+            }
             data->postprocess(event);
         }
     }
@@ -84,7 +93,86 @@ pearl::PEARL_backward_replay(const LocalTrace&                   trace,
         {
             LocalTrace::iterator event = (++it).base();
 
-            cbmanager.notify(event, data);
+            if (cbmanager.has_callbacks(event.get_type()))
+            {
+                cbmanager.notify(event, data);
+            }
         }
     }
 }
+
+
+/// @brief Forward replay restricted to subscribed event types.
+///
+/// Replays the given range of the event trace in forward direction, but
+/// only visits events for which at least one callback is registered with
+/// @a cbmanager.  Blocks of events without any relevant event type are
+/// skipped entirely (see LocalTrace::find()), so that the replay time of
+/// passes with only a few subscribed event types scales with the number of
+/// relevant events.
+///
+/// @note CallbackData::preprocess() and CallbackData::postprocess() are
+///       only invoked for visited events.  This function is therefore not
+///       suitable if @a data needs to track every event (e.g., to maintain
+///       a call stack).
+///
+void
+pearl::PEARL_selective_forward_replay(const LocalTrace&           trace,
+                                      const CallbackManager&      cbmanager,
+                                      CallbackData*               data,
+                                      const LocalTrace::iterator& begin,
+                                      const LocalTrace::iterator& end)
+{
+    const LocalTrace::type_set& types = cbmanager.get_event_types();
+
+    LocalTrace::iterator it = trace.find(begin, end, types);
+    while (it != end)
+    {
+        if (data)
+        {
+            data->preprocess(it);
+        }
+        cbmanager.notify(it, data);
+        if (data)
+        {
+            data->postprocess(it);
+        }
+
+        it = trace.find(++it, end, types);
+    }
+}
+
+
+/// @brief Backward replay restricted to subscribed event types.
+///
+/// Replays the given range of the event trace in backward direction, but
+/// only visits events for which at least one callback is registered with
+/// @a cbmanager.  See PEARL_selective_forward_replay() for details.
+///
+void
+pearl::PEARL_selective_backward_replay(const LocalTrace&                   trace,
+                                       const CallbackManager&              cbmanager,
+                                       CallbackData*                       data,
+                                       const LocalTrace::reverse_iterator& rbegin,
+                                       const LocalTrace::reverse_iterator& rend)
+{
+    const LocalTrace::type_set& types = cbmanager.get_event_types();
+
+    LocalTrace::reverse_iterator it = trace.find(rbegin, rend, types);
+    while (it != rend)
+    {
+        LocalTrace::iterator event = (++it).base();
+
+        if (data)
+        {
+            data->preprocess(event);
+        }
+        cbmanager.notify(event, data);
+        if (data)
+        {
+            data->postprocess(event);
+        }
+
+        it = trace.find(it, rend, types);
+    }
+}
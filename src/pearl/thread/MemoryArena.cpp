@@ -0,0 +1,179 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_thread
+ *  @brief   Implementation of the class pearl::detail::MemoryArena.
+ *
+ *  This file provides the implementation of the internal helper class
+ *  pearl::detail::MemoryArena.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#include <config.h>
+
+#include "MemoryArena.h"
+
+#include <algorithm>
+
+#include <UTILS_Error.h>
+
+using namespace std;
+using namespace pearl::detail;
+
+
+// --- Helpers --------------------------------------------------------------
+
+namespace
+{
+// --- Constants -------------------------------------------
+
+/// Size of regular slabs (in bytes)
+const size_t SLAB_SIZE = 1024 * 1024;
+
+/// Blocks larger than this size (in bytes) get a dedicated slab, so that
+/// the remainder of the current slab is not wasted
+const size_t MAX_BLOCK_SIZE = SLAB_SIZE / 16;
+
+/// Alignment of allocated memory blocks (in bytes)
+const size_t ALIGNMENT = 8;
+
+
+// --- Function objects ------------------------------------
+
+/// Orders slab ranges and addresses by start address
+struct SlabLess
+{
+    bool
+    operator()(const char*                 ptr,
+               const pair< char*, char* >& slab) const
+    {
+        return ptr < slab.first;
+    }
+
+    bool
+    operator()(const pair< char*, char* >& lhs,
+               const pair< char*, char* >& rhs) const
+    {
+        return lhs.first < rhs.first;
+    }
+};
+}    // unnamed namespace
+
+
+// --- Constructors & destructor --------------------------------------------
+
+/// @todo [C++11] Initialize `mCurrent` and `mEnd` with `nullptr`
+MemoryArena::MemoryArena()
+    : mCurrent(0),
+      mEnd(0)
+{
+}
+
+
+MemoryArena::~MemoryArena()
+{
+    for (vector< SlabRange >::iterator it = mSlabs.begin();
+         it != mSlabs.end();
+         ++it)
+    {
+        delete[] it->first;
+    }
+}
+
+
+// --- Memory allocation functions ------------------------------------------
+
+void*
+MemoryArena::allocate(size_t blockSize)
+{
+    blockSize = (blockSize + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    // Large blocks => dedicated slab, keep current slab
+    if (blockSize > MAX_BLOCK_SIZE)
+    {
+        return newSlab(blockSize);
+    }
+
+    // Current slab exhausted => start a new one
+    if (static_cast< size_t >(mEnd - mCurrent) < blockSize)
+    {
+        mCurrent = newSlab(SLAB_SIZE);
+        mEnd     = mCurrent + SLAB_SIZE;
+    }
+
+    void* const result = mCurrent;
+    mCurrent += blockSize;
+
+    return result;
+}
+
+
+// --- Query functions ------------------------------------------------------
+
+bool
+MemoryArena::contains(const void* const ptr) const
+{
+    const char* const address = static_cast< const char* >(ptr);
+
+    // Find last slab starting at or before the given address
+    vector< SlabRange >::const_iterator it = upper_bound(mSlabs.begin(),
+                                                         mSlabs.end(),
+                                                         address,
+                                                         SlabLess());
+    if (it == mSlabs.begin())
+    {
+        return false;
+    }
+    --it;
+
+    return (address < it->second);
+}
+
+
+size_t
+MemoryArena::size() const
+{
+    size_t result = 0;
+    for (vector< SlabRange >::const_iterator it = mSlabs.begin();
+         it != mSlabs.end();
+         ++it)
+    {
+        result += it->second - it->first;
+    }
+
+    return result;
+}
+
+
+// --- Private member functions ---------------------------------------------
+
+char*
+MemoryArena::newSlab(const size_t slabSize)
+{
+    // Reserve space first to keep the arena unchanged in case of exceptions
+    if (mSlabs.size() == mSlabs.capacity())
+    {
+        mSlabs.reserve(2 * mSlabs.size() + 8);
+    }
+
+    char* const     slab = new char[slabSize];
+    const SlabRange range(slab, slab + slabSize);
+    mSlabs.insert(upper_bound(mSlabs.begin(), mSlabs.end(), range, SlabLess()),
+                  range);
+    UTILS_ASSERT(contains(slab));
+
+    return slab;
+}
@@ -0,0 +1,191 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_thread
+ *  @brief   Declaration of the class pearl::detail::MemoryArena.
+ *
+ *  This header file provides the declaration of the internal helper class
+ *  pearl::detail::MemoryArena.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#ifndef PEARL_MEMORYARENA_H
+#define PEARL_MEMORYARENA_H
+
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <pearl/Uncopyable.h>
+
+
+namespace pearl
+{
+namespace detail
+{
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   MemoryArena
+ *  @ingroup PEARL_thread
+ *  @brief   Bump-pointer allocator releasing all memory blocks at once.
+ *
+ *  The class `%MemoryArena` is part of PEARL's @ref PEARL_memory
+ *  "custom memory management for small objects".  It carves memory blocks
+ *  of arbitrary size out of large slabs allocated from the free store by
+ *  simply advancing a pointer.  Individual memory blocks can not be
+ *  deallocated; instead, all slabs are released together when the arena
+ *  is destroyed.  This avoids any per-block bookkeeping and is therefore
+ *  well suited for large numbers of objects sharing the same lifetime,
+ *  such as the event representations of a local trace.
+ *
+ *  To be able to tell memory blocks allocated from an arena apart from
+ *  those obtained otherwise, the address ranges of all slabs are kept in
+ *  a sorted array which can be queried using contains().
+ **/
+/*-------------------------------------------------------------------------*/
+
+class MemoryArena
+    : private pearl::Uncopyable
+{
+    public:
+        // --- Public member functions ---------------------
+
+        /// @name Constructors & destructor
+        /// @{
+
+        /// @brief Default constructor.
+        ///
+        /// Creates a new, empty memory arena.  Slabs are only allocated on
+        /// demand.
+        ///
+        /// @exception_nothrow
+        ///
+        MemoryArena();
+
+        /// @brief Destructor.
+        ///
+        /// Releases all slabs owned by the arena.  Objects that have been
+        /// constructed in memory blocks allocated from the arena are not
+        /// destructed.
+        ///
+        /// @exception_nothrow
+        ///
+        ~MemoryArena();
+
+        /// @}
+        /// @name Memory allocation functions
+        /// @{
+
+        /// @brief Allocate a single memory block.
+        ///
+        /// Allocates a single, uninitialized memory block of at least
+        /// @p blockSize bytes, suitably aligned for any fundamental type
+        /// up to 8 bytes, and returns a pointer to it.
+        ///
+        /// @param blockSize
+        ///     Size of the requested memory block (in bytes)
+        /// @returns
+        ///     Pointer to the allocated memory block
+        ///
+        /// @exception_strong
+        ///
+        /// @throws std::bad_alloc
+        ///     on failure to allocate a new slab
+        ///
+        void*
+        allocate(std::size_t blockSize);
+
+        /// @}
+        /// @name Query functions
+        /// @{
+
+        /// @brief Check for arena ownership.
+        ///
+        /// Returns whether the memory pointed to by @p ptr is located in
+        /// one of the slabs owned by the arena.
+        ///
+        /// @param ptr
+        ///     Pointer to check
+        /// @returns
+        ///     True if @p ptr points into the arena, false otherwise
+        ///
+        /// @exception_nothrow
+        ///
+        bool
+        contains(const void* ptr) const;
+
+        /// @brief Get arena size.
+        ///
+        /// Returns the total size of all slabs owned by the arena, i.e., the
+        /// amount of memory currently held by it, including the unallocated
+        /// remainder of the current slab.
+        ///
+        /// @returns
+        ///     Arena size (in bytes)
+        ///
+        /// @exception_nothrow
+        ///
+        std::size_t
+        size() const;
+
+        /// @}
+
+
+    private:
+        // --- Type definitions ----------------------------
+
+        /// Address range [first, second) of a slab
+        typedef std::pair< char*, char* > SlabRange;
+
+
+        // --- Data members --------------------------------
+
+        /// Address ranges of all slabs, sorted by start address
+        std::vector< SlabRange > mSlabs;
+
+        /// Pointer to the first unallocated byte of the current slab
+        char* mCurrent;
+
+        /// Pointer to the end of the current slab
+        char* mEnd;
+
+
+        // --- Private member functions --------------------
+
+        /// @brief Allocate a new slab.
+        ///
+        /// Allocates a new slab of @p slabSize bytes and records its
+        /// address range.
+        ///
+        /// @param slabSize
+        ///     Size of the slab (in bytes)
+        /// @returns
+        ///     Pointer to the start of the new slab
+        ///
+        /// @exception_strong
+        ///
+        /// @throws std::bad_alloc
+        ///     on failure to allocate the slab
+        ///
+        char*
+        newSlab(std::size_t slabSize);
+};
+}    // namespace pearl::detail
+}    // namespace pearl
+
+
+#endif    // !PEARL_MEMORYARENA_H
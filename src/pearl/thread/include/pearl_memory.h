@@ -36,6 +36,11 @@ namespace pearl
 {
 namespace detail
 {
+// --- Forward declarations -------------------------------------------------
+
+class MemoryArena;
+
+
 // --- Function prototypes --------------------------------------------------
 
 /// @name Memory management: Environmental management
@@ -106,6 +111,86 @@ void
 memoryDeallocate(void*       ptr,
                  std::size_t blockSize);
 
+/// @}
+/// @name Memory management: Arena allocation
+/// @{
+
+/// @brief Select the active memory arena.
+///
+/// Selects @p arena as the active memory arena of the calling thread, i.e.,
+/// subsequent calls to memoryArenaAllocate() on this thread are served from
+/// @p arena.  Passing `nullptr` deselects the active arena.  Once selected,
+/// an arena is remembered by the calling thread until memoryReleaseArena()
+/// is called, such that memoryArenaDeallocate() can identify memory blocks
+/// allocated from it.
+///
+/// @param arena
+///     Memory arena to select (or `nullptr`)
+///
+/// @exception_strong
+///
+/// @throws std::bad_alloc
+///     on failure to allocate the required internal data structures
+///
+void
+memorySetArena(MemoryArena* arena);
+
+/// @brief Forget about a memory arena.
+///
+/// Removes @p arena from the set of memory arenas remembered by the calling
+/// thread, and deselects it if it is the active arena.  This routine has to
+/// be called on the same thread that selected @p arena before it is
+/// destroyed; calling it on any other thread is detected and reported as
+/// an internal error.
+///
+/// @param arena
+///     Memory arena to release
+///
+/// @exception_nothrow
+///
+void
+memoryReleaseArena(MemoryArena* arena);
+
+/// @brief Allocate a single memory block, preferably from an arena.
+///
+/// Allocates a single, uninitialized memory block of @p blockSize bytes from
+/// the active memory arena of the calling thread and returns a pointer to
+/// it.  If no arena is active, the block is obtained from memoryAllocate().
+///
+/// @param blockSize
+///     Size of the requested memory block (in bytes)
+/// @returns
+///     Pointer to the allocated memory block
+///
+/// @exception_safety
+///     See memoryAllocate().
+///
+/// @throws std::bad_alloc
+///     on failure to allocate a new memory block or any of the required
+///     internal data structures
+///
+void*
+memoryArenaAllocate(std::size_t blockSize);
+
+/// @brief Deallocate a single memory block, possibly owned by an arena.
+///
+/// Deallocates the memory block of @p blockSize bytes pointed to by @p ptr,
+/// which must have been returned by a previous call to memoryArenaAllocate()
+/// on the same thread.  Blocks owned by one of the memory arenas remembered
+/// by the calling thread are left untouched, as they are released together
+/// with their arena.  All other blocks are passed on to memoryDeallocate().
+///
+/// @param ptr
+///     Pointer to the allocated memory block
+/// @param blockSize
+///     Size of the allocated memory block (in bytes)
+///
+/// @exception_nothrow
+///
+void
+memoryArenaDeallocate(void*       ptr,
+                      std::size_t blockSize);
+
 /// @}
 }    // namespace pearl::detail
 }    // namespace pearl
@@ -36,6 +36,7 @@
 #include <pearl/ScopedPtr.h>
 
 #include "Functors.h"
+#include "MemoryArena.h"
 #include "SmallBlockAllocator.h"
 
 using namespace std;
@@ -62,8 +63,25 @@ namespace
     #pragma omp threadprivate(tls_allocator)
 #endif    // !__FUJITSU
 
+/// Thread-local active memory arena and memory arenas remembered for
+/// deallocation (allocated on demand)
+///
+/// @todo [C++11] Initialize with `nullptr`
+#ifdef __FUJITSU
+    __thread MemoryArena*            tls_arena       = 0;
+    __thread vector< MemoryArena* >* tls_knownArenas = 0;
+#else    // !__FUJITSU
+    MemoryArena*            tls_arena       = 0;
+    vector< MemoryArena* >* tls_knownArenas = 0;
+    #pragma omp threadprivate(tls_arena, tls_knownArenas)
+#endif    // !__FUJITSU
+
 /// Vector keeping track of all thread-local small block allocators
 vector< SmallBlockAllocator* > smallBlockAllocators;
+
+/// Vector keeping track of all memory arenas remembered by any thread, used
+/// to detect arenas released on the wrong thread
+vector< MemoryArena* > selectedArenas;
 }    // unnamed namespace
 
 
@@ -118,3 +136,110 @@ pearl::detail::memoryDeallocate(void* const       ptr,
 
     tls_allocator->deallocate(ptr, blockSize);
 }
+
+
+// --- Memory management: Arena allocation ----------------------------------
+
+/// @todo [C++11] Compare `tls_arena` with `nullptr`
+void
+pearl::detail::memorySetArena(MemoryArena* const arena)
+{
+    if (arena != 0)
+    {
+        if (tls_knownArenas == 0)
+        {
+            tls_knownArenas = new vector< MemoryArena* >;
+        }
+        if (find(tls_knownArenas->begin(), tls_knownArenas->end(), arena)
+            == tls_knownArenas->end())
+        {
+            tls_knownArenas->push_back(arena);
+            #pragma omp critical
+            {
+                selectedArenas.push_back(arena);
+            }
+        }
+    }
+    tls_arena = arena;
+}
+
+
+/// @todo [C++11] Assign/compare `nullptr` (2x)
+void
+pearl::detail::memoryReleaseArena(MemoryArena* const arena)
+{
+    if (tls_arena == arena)
+    {
+        tls_arena = 0;
+    }
+
+    bool known = false;
+    if (tls_knownArenas != 0)
+    {
+        vector< MemoryArena* >&          arenas = *tls_knownArenas;
+        vector< MemoryArena* >::iterator it     = remove(arenas.begin(),
+                                                         arenas.end(),
+                                                         arena);
+
+        known = (it != arenas.end());
+        arenas.erase(it, arenas.end());
+        if (arenas.empty())
+        {
+            delete tls_knownArenas;
+            tls_knownArenas = 0;
+        }
+    }
+
+    // Releasing an arena selected by another thread would leave a dangling
+    // pointer in that thread's list of known arenas
+    bool selected = false;
+    #pragma omp critical
+    {
+        vector< MemoryArena* >::iterator it = remove(selectedArenas.begin(),
+                                                     selectedArenas.end(),
+                                                     arena);
+
+        selected = (it != selectedArenas.end());
+        selectedArenas.erase(it, selectedArenas.end());
+    }
+    UTILS_BUG_ON(selected && !known,
+                 "Memory arena released on a thread other than the one "
+                 "it was selected on");
+}
+
+
+/// @todo [C++11] Compare `tls_arena` with `nullptr`
+void*
+pearl::detail::memoryArenaAllocate(const std::size_t blockSize)
+{
+    if (tls_arena != 0)
+    {
+        return tls_arena->allocate(blockSize);
+    }
+
+    return memoryAllocate(blockSize);
+}
+
+
+/// @todo [C++11] Compare `tls_knownArenas` with `nullptr`
+void
+pearl::detail::memoryArenaDeallocate(void* const       ptr,
+                                     const std::size_t blockSize)
+{
+    // Arena-owned blocks are released together with their arena
+    if (tls_knownArenas != 0)
+    {
+        const vector< MemoryArena* >& arenas = *tls_knownArenas;
+        for (vector< MemoryArena* >::const_iterator it = arenas.begin();
+             it != arenas.end();
+             ++it)
+        {
+            if ((*it)->contains(ptr))
+            {
+                return;
+            }
+        }
+    }
+
+    memoryDeallocate(ptr, blockSize);
+}
@@ -28,8 +28,12 @@
 
 #include "pearl_memory.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <UTILS_Error.h>
 
+#include "MemoryArena.h"
 #include "SmallBlockAllocator.h"
 
 using namespace std;
@@ -46,6 +50,16 @@ namespace
 ///
 /// @todo [C++11] Initialize with `nullptr`
 SmallBlockAllocator* smallBlockAllocator = 0;
+
+/// Active memory arena
+///
+/// @todo [C++11] Initialize with `nullptr`
+MemoryArena* activeArena = 0;
+
+/// Memory arenas remembered for deallocation (allocated on demand)
+///
+/// @todo [C++11] Initialize with `nullptr`
+vector< MemoryArena* >* knownArenas = 0;
 }    // unnamed namespace
 
 
@@ -84,3 +98,84 @@ pearl::detail::memoryDeallocate(void* const       ptr,
 
     smallBlockAllocator->deallocate(ptr, blockSize);
 }
+
+
+// --- Memory management: Arena allocation ----------------------------------
+
+/// @todo [C++11] Compare `activeArena` with `nullptr`
+void
+pearl::detail::memorySetArena(MemoryArena* const arena)
+{
+    if (arena != 0)
+    {
+        if (knownArenas == 0)
+        {
+            knownArenas = new vector< MemoryArena* >;
+        }
+        if (find(knownArenas->begin(), knownArenas->end(), arena)
+            == knownArenas->end())
+        {
+            knownArenas->push_back(arena);
+        }
+    }
+    activeArena = arena;
+}
+
+
+/// @todo [C++11] Assign/compare `nullptr` (2x)
+void
+pearl::detail::memoryReleaseArena(MemoryArena* const arena)
+{
+    if (activeArena == arena)
+    {
+        activeArena = 0;
+    }
+    if (knownArenas != 0)
+    {
+        vector< MemoryArena* >& arenas = *knownArenas;
+        arenas.erase(remove(arenas.begin(), arenas.end(), arena),
+                     arenas.end());
+        if (arenas.empty())
+        {
+            delete knownArenas;
+            knownArenas = 0;
+        }
+    }
+}
+
+
+/// @todo [C++11] Compare `activeArena` with `nullptr`
+void*
+pearl::detail::memoryArenaAllocate(const std::size_t blockSize)
+{
+    if (activeArena != 0)
+    {
+        return activeArena->allocate(blockSize);
+    }
+
+    return memoryAllocate(blockSize);
+}
+
+
+/// @todo [C++11] Compare `knownArenas` with `nullptr`
+void
+pearl::detail::memoryArenaDeallocate(void* const       ptr,
+                                     const std::size_t blockSize)
+{
+    // Arena-owned blocks are released together with their arena
+    if (knownArenas != 0)
+    {
+        const vector< MemoryArena* >& arenas = *knownArenas;
+        for (vector< MemoryArena* >::const_iterator it = arenas.begin();
+             it != arenas.end();
+             ++it)
+        {
+            if ((*it)->contains(ptr))
+            {
+                return;
+            }
+        }
+    }
+
+    memoryDeallocate(ptr, blockSize);
+}
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2014                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  This software may be modified and distributed under the terms of       **
@@ -19,22 +19,17 @@
 #include <pearl/Event.h>
 #include <pearl/Region.h>
 
+using namespace std;
 using namespace pearl;
 
 
 SalsaCallback::SalsaCallback(int            r,
                              int            s,
-                             funcs          f,
-                             modes          m,
                              MessageChecker mc)
-    : result(s, 0),
-      counter(s, 0),
-      mc(mc)
+    : mc(mc)
 {
     rank = r;
     size = s;
-    func = f;
-    mode = m;
 }
 
 
@@ -73,8 +68,7 @@ SalsaCallback::recv(const CallbackManager& cbmanager,
                     const Event&           event,
                     CallbackData*          data)
 {
-    CallbackDataneu* dneu    = static_cast< CallbackDataneu* >(data);
-    double           tmp_val = 0.0;
+    CallbackDataneu* dneu = static_cast< CallbackDataneu* >(data);
 
     MpiMessage msg(*(event->getComm()), 512);
     msg.recv(event->getSource(), event->getTag());
@@ -92,57 +86,33 @@ SalsaCallback::recv(const CallbackManager& cbmanager,
     timestamp_t diff      = recv_time - send_time;
     int         id        = send_event.get_location().getRank();
 
-    switch (func)
-    {
-        case COUNT:
-            result[id]++;
-            break;
-
-        case LENGTH:
-            tmp_val = sent;
-            break;
-
-        case DURATION:
-            tmp_val = diff;
-            break;
-
-        case RATE:
-            tmp_val = sent / diff;
-            break;
+    // Update statistics of all functions at once
+    double tmp_val[3];
+    tmp_val[LENGTH - LENGTH]   = sent;
+    tmp_val[DURATION - LENGTH] = diff;
+    tmp_val[RATE - LENGTH]     = sent / diff;
 
-        default:
-            tmp_val = 0.0;
-            break;
+    partner_map::iterator it = partners.find(id);
+    if (it == partners.end())
+    {
+        PartnerStatistics& stats = partners[id];
+        stats.count = 1;
+        for (int i = 0; i < 3; ++i)
+        {
+            stats.minimum[i] = tmp_val[i];
+            stats.maximum[i] = tmp_val[i];
+            stats.sum[i]     = tmp_val[i];
+        }
     }
-
-    if (func != COUNT)
+    else
     {
-        switch (mode)
+        PartnerStatistics& stats = it->second;
+        stats.count++;
+        for (int i = 0; i < 3; ++i)
         {
-            case MINIMUM:
-                if (  (result[id] == 0)
-                   || (tmp_val < result[id]))
-                {
-                    result[id] = tmp_val;
-                }
-                break;
-
-            case MAXIMUM:
-                if (  (result[id] == 0)
-                   || (tmp_val > result[id]))
-                {
-                    result[id] = tmp_val;
-                }
-                break;
-
-            case AVERAGE:
-                result[id] += tmp_val;
-                counter[id]++;
-                break;
-
-            case SUM:
-                result[id] += tmp_val;
-                break;
+            stats.minimum[i] = min(stats.minimum[i], tmp_val[i]);
+            stats.maximum[i] = max(stats.maximum[i], tmp_val[i]);
+            stats.sum[i]    += tmp_val[i];
         }
     }
 
@@ -165,21 +135,38 @@ SalsaCallback::enter(const CallbackManager& cbmanager,
 }
 
 
-double*
-SalsaCallback::get_results()
+void
+SalsaCallback::get_results(funcs           f,
+                           modes           m,
+                           vector< double >& row) const
 {
-    if (mode == AVERAGE)
+    row.assign(size, 0.0);
+    for (partner_map::const_iterator it = partners.begin();
+         it != partners.end();
+         ++it)
     {
-        for (int i = 0; i < size; i++)
-        {
-            if (counter[i] != 0)
-            {
-                result[i] /= counter[i];
-            }
-        }
+        row[it->first] = get_value(it->second, f, m);
     }
+}
 
-    return &result.front();
+
+void
+SalsaCallback::get_sparse_results(funcs             f,
+                                  modes             m,
+                                  vector< int >&    columns,
+                                  vector< double >& values) const
+{
+    columns.clear();
+    values.clear();
+    columns.reserve(partners.size());
+    values.reserve(partners.size());
+    for (partner_map::const_iterator it = partners.begin();
+         it != partners.end();
+         ++it)
+    {
+        columns.push_back(it->first);
+        values.push_back(get_value(it->second, f, m));
+    }
 }
 
 
@@ -217,3 +204,33 @@ SalsaCallback::completion_check()
                                  static_cast< MPI_Request >(MPI_REQUEST_NULL)),
                      m_requests.end());
 }
+
+
+double
+SalsaCallback::get_value(const PartnerStatistics& stats,
+                         funcs                    f,
+                         modes                    m) const
+{
+    if (f == COUNT)
+    {
+        return stats.count;
+    }
+
+    int index = f - LENGTH;
+    switch (m)
+    {
+        case MINIMUM:
+            return stats.minimum[index];
+
+        case MAXIMUM:
+            return stats.maximum[index];
+
+        case AVERAGE:
+            return stats.sum[index] / stats.count;
+
+        case SUM:
+            return stats.sum[index];
+    }
+
+    return 0.0;
+}
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2014                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  This software may be modified and distributed under the terms of       **
@@ -14,6 +14,9 @@
 #define SALSA_SALSACALLBACK_H
 
 
+#include <stdint.h>
+
+#include <map>
 #include <vector>
 
 #include <mpi.h>
@@ -31,8 +34,6 @@ class SalsaCallback
     public:
         SalsaCallback(int            r,
                       int            s,
-                      funcs          f,
-                      modes          m,
                       MessageChecker mc);
 
         virtual
@@ -56,17 +57,40 @@ class SalsaCallback
               const pearl::Event&           event,
               pearl::CallbackData*          data);
 
-        double*
-        get_results();
+        // Dense result row (indexed by sender rank) for the given statistic
+        void
+        get_results(funcs                  f,
+                    modes                  m,
+                    std::vector< double >& row) const;
+
+        // Sparse result row for the given statistic, containing all
+        // senders of applicable messages in ascending order
+        void
+        get_sparse_results(funcs                  f,
+                           modes                  m,
+                           std::vector< int >&    columns,
+                           std::vector< double >& values) const;
 
 
     private:
-        int                   rank, size;
-        std::vector< double > result;
-        std::vector< int >    counter;
-        MessageChecker        mc;
-        funcs                 func;
-        modes                 mode;
+        // Accumulated statistics of the messages received from one sender,
+        // covering all funcs/modes combinations (min/max/sum arrays are
+        // indexed by func - LENGTH)
+        struct PartnerStatistics
+        {
+            uint64_t count;
+            double   minimum[3];
+            double   maximum[3];
+            double   sum[3];
+        };
+
+
+        typedef std::map< int, PartnerStatistics > partner_map;
+
+
+        int            rank, size;
+        partner_map    partners;
+        MessageChecker mc;
 
         // Arrays for MPI message handling - see MPI.pattern in Scout
         std::vector< pearl::MpiMessage* > m_pending;
@@ -77,6 +101,11 @@ class SalsaCallback
 
         void
         completion_check();
+
+        double
+        get_value(const PartnerStatistics& stats,
+                  funcs                    f,
+                  modes                    m) const;
 };
 
 
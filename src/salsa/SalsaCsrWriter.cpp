@@ -0,0 +1,74 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "SalsaCsrWriter.h"
+
+#include <stdint.h>
+
+using namespace std;
+
+
+bool
+write_csr_matrix(const string&           filename,
+                 const vector< int >&    columns,
+                 const vector< double >& values,
+                 MPI_Comm                comm)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    // Determine row offset and total number of non-zero elements
+    int64_t n_nze  = columns.size();
+    int64_t offset = 0;
+    int64_t total  = 0;
+    MPI_Exscan(&n_nze, &offset, 1, SCALASCA_MPI_INT64_T, MPI_SUM, comm);
+    if (rank == 0)
+    {
+        offset = 0;
+    }
+    MPI_Allreduce(&n_nze, &total, 1, SCALASCA_MPI_INT64_T, MPI_SUM, comm);
+
+    MPI_File file;
+    int      result = MPI_File_open(comm, const_cast< char* >(filename.c_str()),
+                                    MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                    MPI_INFO_NULL, &file);
+    if (result != MPI_SUCCESS)
+    {
+        return false;
+    }
+    MPI_File_set_size(file, 0);
+
+    const MPI_Offset col_base = (MPI_Offset)(size + 1) * sizeof(int64_t);
+    const MPI_Offset val_base = col_base + (MPI_Offset)total * sizeof(int);
+
+    // Row offsets; the last rank also writes the terminating entry
+    int64_t    row_ptr[2] = { offset, total };
+    int        count      = (rank == size - 1) ? 2 : 1;
+    MPI_Status status;
+    MPI_File_write_at_all(file, (MPI_Offset)rank * sizeof(int64_t),
+                          row_ptr, count, SCALASCA_MPI_INT64_T, &status);
+
+    // Column indices and values
+    MPI_File_write_at_all(file, col_base + (MPI_Offset)offset * sizeof(int),
+                          columns.empty() ? NULL : const_cast< int* >(&columns[0]),
+                          columns.size(), MPI_INT, &status);
+    MPI_File_write_at_all(file, val_base + (MPI_Offset)offset * sizeof(double),
+                          values.empty() ? NULL : const_cast< double* >(&values[0]),
+                          values.size(), MPI_DOUBLE, &status);
+
+    MPI_File_close(&file);
+
+    return true;
+}
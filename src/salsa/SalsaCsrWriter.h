@@ -0,0 +1,37 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SALSA_SALSACSRWRITER_H
+#define SALSA_SALSACSRWRITER_H
+
+
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+
+// Writes the sparse matrix rows of all ranks in @p comm (one row per rank,
+// in rank order) to @p filename in compressed sparse row format, using
+// collective MPI I/O:
+//   - (size + 1) row offsets as 64-bit integers
+//   - nnz column indices as 32-bit integers
+//   - nnz values as doubles
+// Returns false if the file could not be opened.
+bool
+write_csr_matrix(const std::string&           filename,
+                 const std::vector< int >&    columns,
+                 const std::vector< double >& values,
+                 MPI_Comm                     comm);
+
+
+#endif    // !SALSA_SALSACSRWRITER_H
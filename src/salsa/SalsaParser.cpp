@@ -239,6 +239,11 @@ SalsaParser::output_format()
             format = SION;
             ++it;
         }
+        else if (*it == "csr")
+        {
+            format = CSR;
+            ++it;
+        }
     }
 }
 
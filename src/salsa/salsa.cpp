@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2016                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  This software may be modified and distributed under the terms of       **
@@ -24,8 +24,10 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <UTILS_CStr.h>
 #include <mpi.h>
@@ -39,6 +41,7 @@
 
 #include "MessageChecker.h"
 #include "SalsaCallback.h"
+#include "SalsaCsrWriter.h"
 #include "SalsaParser.h"
 #include "SalsaStringUtils.h"
 
@@ -175,8 +178,12 @@ write_meta_data(string  dir_name,
         case SION:
             metadatafile << "Format: sion" << endl;
             break;
+
+        case CSR:
+            metadatafile << "Format: csr" << endl;
+            break;
     }
-    if (sparse)
+    if (sparse || (format == CSR))
     {
         metadatafile << "Density: sparse" << endl;
     }
@@ -689,7 +696,7 @@ printhelp(int rank)
         cerr << endl;
         cerr << "  -d, --density:        [sparse/dense]               (optional)";
         cerr << endl;
-        cerr << "  -f, --format:         [ascii/binary/sion]          (optional)";
+        cerr << "  -f, --format:         [ascii/binary/sion/csr]      (optional)";
         cerr << endl;
         cerr << "  -b, --blocksize:      blocksize                    (optional)";
         cerr << endl;
@@ -877,6 +884,85 @@ create_sparse_matrix(double*  vector,
 }
 
 
+/**
+ * writes the matrix in compressed sparse row format to a single file
+ * "data.csr" using collective MPI I/O, i.e., without gathering any rows
+ * (see write_csr_matrix() for the file layout)
+ */
+void
+create_csr_matrix(const SalsaCallback& callbacks,
+                  int                  rank,
+                  int                  size,
+                  char*                epik_dir,
+                  MPI_Comm             comm)
+{
+    vector< int >    columns;
+    vector< double > values;
+    callbacks.get_sparse_results(stat_func, stat_mode, columns, values);
+
+    // Determine global matrix min/max
+    double local_min = 0.0;
+    double local_max = 0.0;
+    double global_min, global_max;
+    if (!values.empty())
+    {
+        local_min = *min_element(values.begin(), values.end());
+        local_max = *max_element(values.begin(), values.end());
+    }
+    if (columns.size() < (size_t)size)
+    {
+        local_min = 0.0;
+    }
+    MPI_Reduce(&local_min, &global_min, 1, MPI_DOUBLE, MPI_MIN, 0, comm);
+    MPI_Reduce(&local_max, &global_max, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+
+    #ifdef DEBUG
+        if (rank == 0)
+        {
+            run_time = MPI_Wtime() - start_time;
+            cout << func << " " << mode << ": Time without output= ";
+            cout << run_time << endl;
+        }
+    #endif
+
+    // generate directory name on rank 0 to avoid timestamp mismatches
+    string dir_name;
+    int    length = 0;
+    if (rank == 0)
+    {
+        dir_name = gen_dir_name(epik_dir, size);
+        length   = dir_name.length();
+        mkdirs(dir_name.c_str(), S_IRWXU | S_IRGRP | S_IROTH);
+        cout << "writing output to " << dir_name << endl;
+    }
+    MPI_Bcast(&length, 1, MPI_INT, 0, comm);
+    vector< char > name_buf(length + 1, '\0');
+    if (rank == 0)
+    {
+        copy(dir_name.begin(), dir_name.end(), name_buf.begin());
+    }
+    MPI_Bcast(&name_buf[0], length + 1, MPI_CHAR, 0, comm);
+    dir_name = &name_buf[0];
+
+    string filename = dir_name + "/data.csr";
+    if (!write_csr_matrix(filename, columns, values, comm))
+    {
+        if (rank == 0)
+        {
+            cerr << "Error: could not open " << filename << endl;
+        }
+
+        return;
+    }
+
+    // write metadata file
+    if (rank == 0)
+    {
+        write_meta_data(dir_name, epik_dir, size, size, global_min, global_max);
+    }
+}
+
+
 int
 main(int    argc,
      char** argv)
@@ -950,6 +1036,10 @@ main(int    argc,
             {
                 format_glob = SION;
             }
+            else if (strcmp(argv[i], "csr") == 0)
+            {
+                format_glob = CSR;
+            }
             else
             {
                 printhelp(rank);
@@ -1027,6 +1117,11 @@ main(int    argc,
     // Initialize Parser
     SalsaParser parser(inputfile, sparse_glob, blocksize_glob, format_glob, size);
 
+    // Replay results, indexed by constraints.  As the callbacks accumulate
+    // all function/mode combinations at once, the trace only needs to be
+    // replayed once per distinct set of constraints.
+    map< string, SalsaCallback* > replays;
+
     while (parser.parseNext() == 1)
     {
         mc          = parser.getMessageChecker();
@@ -1040,10 +1135,6 @@ main(int    argc,
         constraints = parser.getContraints();
         line_number++;
 
-        CallbackManager* manager = new CallbackManager();
-        CallbackDataneu  defsneu;
-        defsneu.defs = defs;
-
         #ifdef DEBUG
             // Start timer
             if (rank == 0)
@@ -1052,46 +1143,65 @@ main(int    argc,
             }
         #endif
 
-        SalsaCallback* callbacks;
-
-        callbacks = new SalsaCallback(rank, size, stat_func, stat_mode, mc);
-        manager->register_callback(GROUP_SEND,
-                                   PEARL_create_callback(callbacks, &SalsaCallback::send));
-        manager->register_callback(GROUP_RECV,
-                                   PEARL_create_callback(callbacks, &SalsaCallback::recv));
-
-        // Replay with registered callbacks
-        PEARL_forward_replay(*trace, *manager, &defsneu);
-
-        // Split MPI_COMM_WORLD into block communicators
-        int x_block_size = size < blocksize ? size : blocksize;
-        MPI_Comm_split(world, rank / x_block_size, rank, &block_comm);
-
-        // Determine rank in the new communicator
-        MPI_Comm_rank(block_comm, &block_rank);
-
-        // Generate new communicator consisting of all root-processes
-        MPI_Comm_split(world, block_rank, 0, &local_root_comm);
-        MPI_Comm_rank(local_root_comm, &local_root_rank);
-
-        double* result = callbacks->get_results();
-        if (sparse)
+        SalsaCallback*                          callbacks;
+        map< string, SalsaCallback* >::iterator cached = replays.find(constraints);
+        if (cached != replays.end())
         {
-            create_sparse_matrix(result, rank, size, x_block_size, stat_func,
-                                 experiment_name, block_comm, local_root_comm, block_rank);
+            callbacks = cached->second;
         }
         else
         {
-            create_matrix(result, rank, size, x_block_size, stat_func,
-                          experiment_name, block_comm, local_root_comm, block_rank);
+            CallbackManager manager;
+            CallbackDataneu defsneu;
+            defsneu.defs = defs;
+
+            callbacks = new SalsaCallback(rank, size, mc);
+            manager.register_callback(GROUP_SEND,
+                                      PEARL_create_callback(callbacks, &SalsaCallback::send));
+            manager.register_callback(GROUP_RECV,
+                                      PEARL_create_callback(callbacks, &SalsaCallback::recv));
+
+            // Replay with registered callbacks
+            PEARL_selective_forward_replay(*trace, manager, &defsneu);
+            replays[constraints] = callbacks;
         }
 
-        MPI_Barrier(world);
+        if (format == CSR)
+        {
+            // CSR output is written directly from the sparse rows
+            create_csr_matrix(*callbacks, rank, size, experiment_name, world);
+        }
+        else
+        {
+            // Split MPI_COMM_WORLD into block communicators
+            int x_block_size = size < blocksize ? size : blocksize;
+            MPI_Comm_split(world, rank / x_block_size, rank, &block_comm);
+
+            // Determine rank in the new communicator
+            MPI_Comm_rank(block_comm, &block_rank);
+
+            // Generate new communicator consisting of all root-processes
+            MPI_Comm_split(world, block_rank, 0, &local_root_comm);
+            MPI_Comm_rank(local_root_comm, &local_root_rank);
+
+            vector< double > result;
+            callbacks->get_results(stat_func, stat_mode, result);
+            if (sparse)
+            {
+                create_sparse_matrix(&result[0], rank, size, x_block_size, stat_func,
+                                     experiment_name, block_comm, local_root_comm, block_rank);
+            }
+            else
+            {
+                create_matrix(&result[0], rank, size, x_block_size, stat_func,
+                              experiment_name, block_comm, local_root_comm, block_rank);
+            }
 
-        MPI_Comm_free(&block_comm);
-        MPI_Comm_free(&local_root_comm);
+            MPI_Comm_free(&block_comm);
+            MPI_Comm_free(&local_root_comm);
+        }
 
-        delete callbacks;
+        MPI_Barrier(world);
 
         #ifdef DEBUG
             // Stop timer and print overall time
@@ -1106,6 +1216,13 @@ main(int    argc,
         format    = format_glob;
     }
 
+    for (map< string, SalsaCallback* >::iterator it = replays.begin();
+         it != replays.end();
+         ++it)
+    {
+        delete it->second;
+    }
+
     delete trace;
     delete defs;
 
@@ -40,7 +40,8 @@ enum formats
 {
     ASCII = 1,
     BINARY,
-    SION
+    SION,
+    CSR
 };
 
 
@@ -40,16 +40,14 @@
 #include "TaskData.h"
 #include "TimedPhase.h"
 #include "TmapCacheHandler.h"
+#include "TraceSegments.h"
+#include "scout_options.h"
 #include "user_events.h"
 
 using namespace std;
 using namespace pearl;
 using namespace scout;
 
-extern bool enableCriticalPath;
-extern bool enableDelayAnalysis;
-extern bool enableSinglePass;
-
 
 // --------------------------------------------------------------------------
 //
@@ -70,9 +68,10 @@ class AnalysisReplayTask
 
 
     private:
-        direction_t mDirection;
-        int         mPrepareEvent;
-        int         mFinishEvent;
+        direction_t    mDirection;
+        int            mPrepareEvent;
+        int            mFinishEvent;
+        TraceSegments* mSegments;
 
         bool
         prepare()
@@ -97,6 +96,11 @@ class AnalysisReplayTask
         bool
         replay()
         {
+            if (mSegments)
+            {
+                return replaySegments();
+            }
+
             if (mDirection == forward)
             {
                 PEARL_forward_replay(m_trace, *m_cbmanager, m_cbdata);
@@ -113,6 +117,45 @@ class AnalysisReplayTask
             return false;
         }
 
+        // Replays the trace segment by segment, in reverse order for
+        // backward replays.  The segment callbacks allow handlers and
+        // patterns to adjust state that refers to events of a segment.
+        bool
+        replaySegments()
+        {
+            const uint32_t numSegments = mSegments->numSegments();
+            for (uint32_t i = 0; i < numSegments; ++i)
+            {
+                const uint32_t index = (mDirection == forward)
+                                       ? i
+                                       : (numSegments - 1 - i);
+                mSegments->load(index);
+
+                UTILS_DLOG << "Replay segment " << index;
+
+                m_cbmanager->notify(SEGMENT_BEGIN, m_trace.end(), m_cbdata);
+
+                // Carried ENTER events of enclosing regions are not replayed
+                const LocalTrace::iterator first =
+                    m_trace.at(m_trace.num_carried());
+                if (mDirection == forward)
+                {
+                    PEARL_forward_replay(m_trace, *m_cbmanager, m_cbdata,
+                                         first, m_trace.end());
+                }
+                else
+                {
+                    PEARL_backward_replay(m_trace, *m_cbmanager, m_cbdata,
+                                          m_trace.rbegin(),
+                                          LocalTrace::reverse_iterator(first));
+                }
+
+                m_cbmanager->notify(SEGMENT_END, m_trace.end(), m_cbdata);
+            }
+
+            return true;
+        }
+
 
     public:
         AnalysisReplayTask(AnalyzeTask*     parent,
@@ -126,7 +169,8 @@ class AnalysisReplayTask
                          cbmgr),
               mDirection(direction),
               mPrepareEvent(prepevt),
-              mFinishEvent(finevt)
+              mFinishEvent(finevt),
+              mSegments(parent->mPrivateData.mSegments)
         {
         }
 };
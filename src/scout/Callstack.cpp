@@ -166,6 +166,21 @@ Callstack::update(const Event& event)
 }
 
 
+void
+Callstack::rebuild(const LocalTrace& trace)
+{
+    // Segments are only supported for traces without tasks
+    mCurrentTaskBlockId = (static_cast< uint64_t >(PEARL_GetThreadNumber()) << 32);
+    mStacks[mCurrentTaskBlockId] = stack< Event >();
+    mOutOfTaskTimes[mCurrentTaskBlockId].clear();
+
+    for (uint32_t index = 0; index < trace.num_carried(); ++index)
+    {
+        push(trace.at(index));
+    }
+}
+
+
 Event
 Callstack::top()
 {
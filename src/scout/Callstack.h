@@ -23,6 +23,7 @@
 #include <vector>
 
 #include <pearl/Event.h>
+#include <pearl/LocalTrace.h>
 
 #include "fixed_set.hh"
 #include "scout_types.h"
@@ -75,6 +76,18 @@ class Callstack
         void
         update(const pearl::Event& event);
 
+        /// @brief Rebuilds the callstack for a trace segment
+        ///
+        /// Replaces the callstack of the implicit task by the carried ENTER
+        /// events at the front of the given trace segment, i.e., the
+        /// regions enclosing the segment.
+        ///
+        /// @param trace
+        ///     Local trace data object holding the segment
+        ///
+        void
+        rebuild(const pearl::LocalTrace& trace);
+
         /// @name Implementation of standard stack methods (push, pop, and top)
         ///       for events
         /// @{
@@ -18,26 +18,69 @@
 
 #include "DelayOps.h"
 
+#include <vector>
+
 #include <pearl/Buffer.h>
 #include <pearl/Callpath.h>
 #include <pearl/Event.h>
 
 
+namespace
+{
+/// @brief Look up a time in a sorted time map range
+///
+/// Returns the time stored for @p key in the sorted time map range starting
+/// at @p it, or zero if no entry exists.  @p it is advanced past all entries
+/// with smaller keys, i.e., successive lookups with ascending keys traverse
+/// the time map only once (merge join).
+
+inline double
+advanceTo(scout::timemap_t::const_iterator&      it,
+          const scout::timemap_t::const_iterator end,
+          const pearl::Callpath::IdType          key)
+{
+    while (  (it != end)
+          && (it->first < key))
+    {
+        ++it;
+    }
+
+    return ((it != end) && (it->first == key)) ? it->second : 0.0;
+}
+}    // unnamed namespace
+
+
 namespace scout
 {
 /// @brief pack a timemap into a pearl::Buffer
+///
+/// The identifiers and times are stored as two separate arrays, which allows
+/// for appending them in bulk.
 
 void
 PackTimemap(pearl::Buffer*   buf,
             const timemap_t& tmap)
 {
-    buf->put_uint32(tmap.size());
+    const uint32_t size = tmap.size();
 
+    buf->put_uint32(size);
+    if (size == 0)
+    {
+        return;
+    }
+
+    std::vector< pearl::ident_t > ids;
+    std::vector< double >         times;
+    ids.reserve(size);
+    times.reserve(size);
     for (timemap_t::const_iterator it = tmap.begin(); it != tmap.end(); ++it)
     {
-        buf->put_id(it->first);
-        buf->put_double(it->second);
+        ids.push_back(it->first);
+        times.push_back(it->second);
     }
+
+    buf->put_uint32_array(&ids[0], size);
+    buf->put_double_array(&times[0], size);
 }
 
 
@@ -48,13 +91,19 @@ UnpackTimemap(pearl::Buffer* buf)
 {
     uint32_t  size = buf->get_uint32();
     timemap_t tmap;
+    if (size == 0)
+    {
+        return tmap;
+    }
+
+    std::vector< pearl::ident_t > ids(size);
+    std::vector< double >         times(size);
+    buf->get_uint32_array(&ids[0], size);
+    buf->get_double_array(&times[0], size);
 
     for (uint32_t i = 0; i < size; ++i)
     {
-        pearl::ident_t id   = buf->get_id();
-        double         time = buf->get_double();
-
-        tmap[id] += time;
+        tmap[ids[i]] += times[i];
     }
 
     return tmap;
@@ -121,22 +170,22 @@ CalculateDelay(const timemap_t& ltmap,
     m.mSum = 0.0;
 
     timemap_t::const_iterator ltmend = ltmap.end();
+    timemap_t::const_iterator lwit   = lwmap.begin();
+    timemap_t::const_iterator lwend  = lwmap.end();
+    timemap_t::const_iterator rtit   = rtmap.begin();
+    timemap_t::const_iterator rtend  = rtmap.end();
 
     for (timemap_t::const_iterator it = ltmap.begin(); it != ltmend; ++it)
     {
-        timemap_t::const_iterator fit;
-
-        fit = lwmap.find(it->first);
-        double pw = fit == lwmap.end() ? 0.0 : fit->second;
-        fit = rtmap.find(it->first);
-        double rt = fit == rtmap.end() ? 0.0 : fit->second;
+        double pw = advanceTo(lwit, lwend, it->first);
+        double rt = advanceTo(rtit, rtend, it->first);
 
         double d = it->second - pw - rt;
 
         if (d > 0.0)
         {
-            m.mMap[it->first] = d;
-            m.mSum           += d;
+            m.mMap.append(it->first, d);
+            m.mSum += d;
         }
     }
 
@@ -154,20 +203,18 @@ CalculateDiff(const timemap_t& ltmap,
     m.mSum = 0.0;
 
     timemap_t::const_iterator ltmapend = ltmap.end();
+    timemap_t::const_iterator rtit     = rtmap.begin();
     timemap_t::const_iterator rtmapend = rtmap.end();
 
     for (timemap_t::const_iterator it = ltmap.begin(); it != ltmapend; ++it)
     {
-        timemap_t::const_iterator fit;
-
-        fit = rtmap.find(it->first);
-        double rt = fit == rtmapend ? 0.0 : fit->second;
+        double rt = advanceTo(rtit, rtmapend, it->first);
         double d  = it->second - rt;
 
         if (d > 0.0)
         {
-            m.mMap[it->first] = d;
-            m.mSum           += d;
+            m.mMap.append(it->first, d);
+            m.mSum += d;
         }
     }
 
@@ -185,22 +232,20 @@ CalculateDiff(const TimeMapSum& ltmap,
     m.mSum = 0.0;
 
     timemap_t::const_iterator ltmapend = ltmap.mMap.end();
+    timemap_t::const_iterator rtit     = rtmap.begin();
     timemap_t::const_iterator rtmapend = rtmap.end();
 
     for (timemap_t::const_iterator it = ltmap.mMap.begin();
          it != ltmapend;
          ++it)
     {
-        timemap_t::const_iterator fit;
-
-        fit = rtmap.find(it->first);
-        double rt = fit == rtmapend ? 0.0 : fit->second;
+        double rt = advanceTo(rtit, rtmapend, it->first);
         double d  = it->second - rt;
 
         if (d > 0.0)
         {
-            m.mMap[it->first] = d;
-            m.mSum           += d;
+            m.mMap.append(it->first, d);
+            m.mSum += d;
         }
     }
 
@@ -215,10 +260,49 @@ AddScaledTimemap(const TimeMapSum& from,
 {
     timemap_t::const_iterator end = from.mMap.end();
 
+    // The merged map may exceed the time map capacity: update element-wise,
+    // as the retained entries then depend on the update order
+    if ((from.mMap.size() + to.mMap.size()) > timemap_t::max_size())
+    {
+        for (timemap_t::const_iterator it = from.mMap.begin(); it != end; ++it)
+        {
+            to.mMap[it->first] += scale * it->second;
+            to.mSum            += scale * it->second;
+        }
+
+        return;
+    }
+
+    // Otherwise merge both sorted maps in a single pass
+    timemap_t                 merged;
+    timemap_t::const_iterator toit  = to.mMap.begin();
+    timemap_t::const_iterator toend = to.mMap.end();
     for (timemap_t::const_iterator it = from.mMap.begin(); it != end; ++it)
     {
-        to.mMap[it->first] += scale * it->second;
-        to.mSum            += scale * it->second;
+        while (  (toit != toend)
+              && (toit->first < it->first))
+        {
+            merged.append(toit->first, toit->second);
+            ++toit;
+        }
+
+        double time = 0.0;
+        if (  (toit != toend)
+           && (toit->first == it->first))
+        {
+            time = toit->second;
+            ++toit;
+        }
+        time += scale * it->second;
+
+        merged.append(it->first, time);
+        to.mSum += scale * it->second;
+    }
+    for ( ; toit != toend; ++toit)
+    {
+        merged.append(toit->first, toit->second);
     }
+
+    to.mMap = merged;
 }
 }    // namespace scout
@@ -39,6 +39,7 @@
 #include <pearl/EventSet.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalData.h>
+#include <pearl/LocalTrace.h>
 #include <pearl/MpiCollEnd_rep.h>
 #include <pearl/MpiComm.h>
 #include <pearl/MpiGroup.h>
@@ -82,6 +83,41 @@ numBitsSet(uint8_t byte)
 
     return bitSetTable[byte];
 }
+
+
+/// @brief Combined `MPI_MINLOC`/`MPI_MAXLOC` reduction.
+///
+/// Determines the minimum of @p minSend and the maximum of @p maxSend over
+/// all ranks of @p comm using a single `MPI_Allreduce` instead of two.  This
+/// exploits that `MPI_MAXLOC` of a value is equivalent to `MPI_MINLOC` of
+/// its negation, including the tie-breaking rule (i.e., lowest rank), such
+/// that both reductions can be carried out on a two-element buffer.
+///
+/// @param minSend  Input value of the minimum reduction
+/// @param minRecv  Result of the minimum reduction
+/// @param maxSend  Input value of the maximum reduction
+/// @param maxRecv  Result of the maximum reduction
+/// @param comm     MPI communicator
+///
+static void
+allreduceMinMaxLoc(const TimeRank& minSend,
+                   TimeRank&       minRecv,
+                   const TimeRank& maxSend,
+                   TimeRank&       maxRecv,
+                   MPI_Comm        comm)
+{
+    TimeRank sendBuf[2];
+    TimeRank recvBuf[2];
+
+    sendBuf[0]       = minSend;
+    sendBuf[1].mTime = -maxSend.mTime;
+    sendBuf[1].mRank = maxSend.mRank;
+    MPI_Allreduce(sendBuf, recvBuf, 2, MPI_DOUBLE_INT, MPI_MINLOC, comm);
+
+    minRecv       = recvBuf[0];
+    maxRecv.mTime = -recvBuf[1].mTime;
+    maxRecv.mRank = recvBuf[1].mRank;
+}
 }    // namespace scout::detail
 }    // namespace scout
 
@@ -99,6 +135,7 @@ struct MpiCommunicationHandler::MpiCHImpl
 
     vector< MpiMessage* > mPendingMsgs;    ///< Pending message objects (main replay)
     vector< MPI_Request > mPendingReqs;    ///< Pending MPI requests (main replay)
+    vector< MpiMessage* > mFreeMsgs;       ///< Completed message objects for reuse
     vector< MPI_Status >  mStatuses;
     vector< int >         mIndices;
 
@@ -107,6 +144,10 @@ struct MpiCommunicationHandler::MpiCHImpl
     pearl::Event mInitEnd;
     pearl::Event mFinalizeEnd;
 
+    // Trace segments holding mInitEnd and mFinalizeEnd
+    uint64_t mInitSegment;
+    uint64_t mFinalizeSegment;
+
     // Offsets into RMA analysis window
     static const int LOCAL_POST     = 0;
     static const int LAST_POST      = 1 * sizeof(TimeRank);
@@ -116,6 +157,9 @@ struct MpiCommunicationHandler::MpiCHImpl
 
     static const TimeRank UNDEFINED_TIME_RANK;
 
+    // Maximum number of completed message objects kept for reuse
+    static const size_t MAX_FREE_MSGS = 64;
+
     typedef map< uint32_t, pearl::timestamp_t > TimeMap;
     typedef map< uint32_t, TimeRank >           TimeRankMap;
     typedef struct
@@ -139,6 +183,12 @@ struct MpiCommunicationHandler::MpiCHImpl
 
     WindowInfoMap mWindows;
 
+    MpiCHImpl()
+        : mInitSegment(0),
+          mFinalizeSegment(0)
+    {
+    }
+
     ~MpiCHImpl()
     {
         for (communicator_map_t::iterator it = mInvComms.begin();
@@ -147,6 +197,12 @@ struct MpiCommunicationHandler::MpiCHImpl
         {
             delete it->second;
         }
+        for (vector< MpiMessage* >::iterator it = mFreeMsgs.begin();
+             it != mFreeMsgs.end();
+             ++it)
+        {
+            delete *it;
+        }
     }
 
     //
@@ -179,7 +235,7 @@ struct MpiCommunicationHandler::MpiCHImpl
         {
             int index = mIndices[i];
 
-            delete mPendingMsgs[index];
+            releaseMsg(mPendingMsgs[index]);
             mPendingMsgs[index] = 0;
         }
 
@@ -194,6 +250,43 @@ struct MpiCommunicationHandler::MpiCHImpl
         }
     }
 
+    void
+    postSend(const LocalData& local,
+             const MpiComm&   comm,
+             int              dest,
+             int              tag)
+    {
+        MpiMessage* msg;
+        if (mFreeMsgs.empty())
+        {
+            msg = new MpiMessage(comm);
+        }
+        else
+        {
+            msg = mFreeMsgs.back();
+            mFreeMsgs.pop_back();
+            msg->reset(comm.getHandle());
+        }
+
+        local.isend(*msg, dest, tag);
+
+        mPendingMsgs.push_back(msg);
+        mPendingReqs.push_back(msg->get_request());
+    }
+
+    void
+    releaseMsg(MpiMessage* msg)
+    {
+        if (mFreeMsgs.size() < MAX_FREE_MSGS)
+        {
+            mFreeMsgs.push_back(msg);
+        }
+        else
+        {
+            delete msg;
+        }
+    }
+
     void
     processPendingActiveMsgs(RmaWindow* window)
     {
@@ -295,33 +388,49 @@ struct MpiCommunicationHandler::MpiCHImpl
         mPendingReqs.clear();
     }
 
+    SCOUT_CALLBACK(cb_end_segment)
+    {
+        // Collective information is keyed by events, which are only valid
+        // within a trace segment.  It is only needed by the backward replay
+        // of the delay analysis, which is not available for segments.
+        mCollInfo.clear();
+    }
+
     //
     // --- init/finalize
     //
 
     SCOUT_CALLBACK(cb_pre_leave_cache)
     {
+        CbData* const data = static_cast< CbData* >(cdata);
+
         const Region& region = event->getRegion();
         if (  !mInitEnd.is_valid()
            && is_mpi_init(region))
         {
-            mInitEnd = event;
+            mInitEnd     = event;
+            mInitSegment = data->mTrace->segment_begin();
         }
         else if (  !mFinalizeEnd.is_valid()
                 && is_mpi_finalize(region))
         {
-            mFinalizeEnd = event;
+            mFinalizeEnd     = event;
+            mFinalizeSegment = data->mTrace->segment_begin();
         }
     }
 
     SCOUT_CALLBACK(cb_pre_leave)
     {
-        if (event == mInitEnd)
+        // Events are only unique within a trace segment
+        const uint64_t segment = static_cast< CbData* >(cdata)->mTrace->segment_begin();
+        if (  (event == mInitEnd)
+           && (segment == mInitSegment))
         {
             cbmanager.notify(PRE_INIT, event, cdata);
             cbmanager.notify(INIT, event, cdata);
         }
-        else if (event == mFinalizeEnd)
+        else if (  (event == mFinalizeEnd)
+                && (segment == mFinalizeSegment))
         {
             cbmanager.notify(PRE_FINALIZE, event, cdata);
             cbmanager.notify(FINALIZE, event, cdata);
@@ -348,15 +457,10 @@ struct MpiCommunicationHandler::MpiCHImpl
         // All ranks are synchronizing at Init/Finalize
         data->mIsSyncpoint = true;
 
-        // latest ENTER
-        TimeRank sendBuf = ci.my;
-        MPI_Allreduce(&sendBuf, &ci.latest, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
-                      MPI_COMM_WORLD);
-
-        // earliest LEAVE
-        sendBuf.mTime = event->getTimestamp();
-        MPI_Allreduce(&sendBuf, &ci.earliest_end, 1, MPI_DOUBLE_INT, MPI_MINLOC,
-                      MPI_COMM_WORLD);
+        // latest ENTER & earliest LEAVE
+        TimeRank sendBuf(event->getTimestamp(), ci.my.mRank);
+        detail::allreduceMinMaxLoc(sendBuf, ci.earliest_end, ci.my, ci.latest,
+                                   MPI_COMM_WORLD);
 
         UTILS_DLOG_LEVEL(SCALASCA_DEBUG_WAITSTATE)
             << "latest ENTER: " << ci.latest
@@ -391,13 +495,10 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         // --- transfer message
 
-        MpiComm*    comm = event->getComm();
-        MpiMessage* msg;
-
-        msg = data->mLocal->isend(*comm, event->getDestination(), event->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        MpiComm* comm = event->getComm();
+        postSend(*data->mLocal, *comm,
+                 event->getDestination(),
+                 event->getTag());
 
         // --- run post-send callbacks
 
@@ -627,21 +728,23 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         CollectiveInfo& ci = data->mCollinfo;
 
-        // Distribute root BEGIN
-        ci.root = ci.my;
-        MPI_Bcast(&ci.root, 1, MPI_DOUBLE_INT, event->getRoot(),
-                  comm->getHandle());
-
-        // Latest BEGIN of all senders
+        // Distribute root BEGIN (as the minimum over the root's BEGIN and
+        // the largest representable value of all other ranks) & determine
+        // latest BEGIN of all senders
         const uint64_t bytesSent = event->getBytesSent();
 
+        TimeRank rootBuf = ci.my;
+        if (ci.my.mRank != static_cast< int >(event->getRoot()))
+        {
+            rootBuf.mTime = numeric_limits< double >::max();
+        }
         TimeRank sendBuf = ci.my;
         if (bytesSent == 0)
         {
             sendBuf.mTime = -numeric_limits< double >::max();
         }
-        MPI_Allreduce(&sendBuf, &ci.latest, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
-                      comm->getHandle());
+        detail::allreduceMinMaxLoc(rootBuf, ci.root, sendBuf, ci.latest,
+                                   comm->getHandle());
 
         // The latest sender and the root rank are considered synchronizing
         // if the root enters the operation earlier than the sender.
@@ -707,16 +810,10 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         // --- Step 1: check for full overlap
 
-        // Latest BEGIN of all ranks
-        TimeRank sendBuf = ci.my;
-        MPI_Allreduce(&sendBuf, &ci.latest, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
-                      comm->getHandle());
-
-
-        // Earliest END of all ranks
-        sendBuf.mTime = event->getTimestamp();
-        MPI_Allreduce(&sendBuf, &ci.earliest_end, 1, MPI_DOUBLE_INT, MPI_MINLOC,
-                      comm->getHandle());
+        // Latest BEGIN & earliest END of all ranks
+        TimeRank sendBuf(event->getTimestamp(), ci.my.mRank);
+        detail::allreduceMinMaxLoc(sendBuf, ci.earliest_end, ci.my, ci.latest,
+                                   comm->getHandle());
 
         if (ci.earliest_end.mTime > ci.latest.mTime)
         {
@@ -777,15 +874,10 @@ struct MpiCommunicationHandler::MpiCHImpl
         // All ranks are synchronizing at a Barrier
         data->mIsSyncpoint = true;
 
-        // latest BEGIN
-        TimeRank sendBuf = ci.my;
-        MPI_Allreduce(&sendBuf, &ci.latest, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
-                      comm->getHandle());
-
-        // earliest END
-        sendBuf.mTime = event->getTimestamp();
-        MPI_Allreduce(&sendBuf, &ci.earliest_end, 1, MPI_DOUBLE_INT, MPI_MINLOC,
-                      comm->getHandle());
+        // latest BEGIN & earliest END
+        TimeRank sendBuf(event->getTimestamp(), ci.my.mRank);
+        detail::allreduceMinMaxLoc(sendBuf, ci.earliest_end, ci.my, ci.latest,
+                                   comm->getHandle());
 
         UTILS_DLOG_LEVEL(SCALASCA_DEBUG_WAITSTATE)
             << "latest BEGIN: " << globalize(ci.latest, *comm)
@@ -859,18 +951,10 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         CollectiveInfo& ci(data->mCollinfo);
 
-        TimeRank trbuf;
-
-        // latest BEGIN
-        trbuf = ci.my;
-
-        MPI_Allreduce(&trbuf, &ci.latest, 1, MPI_DOUBLE_INT, MPI_MAXLOC, comm->getHandle());
-
-        // earliest END
-        trbuf.mTime = event->getTimestamp();
-        trbuf.mRank = ci.my.mRank;
+        // latest BEGIN & earliest END
+        TimeRank trbuf(event->getTimestamp(), ci.my.mRank);
 
-        MPI_Allreduce(&trbuf, &ci.earliest_end, 1, MPI_DOUBLE_INT, MPI_MINLOC, comm->getHandle());
+        detail::allreduceMinMaxLoc(trbuf, ci.earliest_end, ci.my, ci.latest, comm->getHandle());
     }
 
     SCOUT_CALLBACK(cb_pre_rma_win_create)
@@ -1265,13 +1349,10 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         // --- transfer message
 
-        MpiComm*    comm = event->getComm();
-        MpiMessage* msg;
-
-        msg = data->mLocal->isend(*comm, event->getSource(), event->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        MpiComm* comm = event->getComm();
+        postSend(*data->mLocal, *comm,
+                 event->getSource(),
+                 event->getTag());
 
         // --- run post-send callbacks
 
@@ -1298,13 +1379,10 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         // --- transfer message
 
-        MpiComm*    comm = event->getComm();
-        MpiMessage* msg;
-
-        msg = data->mLocal->isend(*comm, event->getDestination(), event->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        MpiComm* comm = event->getComm();
+        postSend(*data->mLocal, *comm,
+                 event->getDestination(),
+                 event->getTag());
 
         mInvComms.insert(make_pair(comm->getId(), static_cast< MpiComm* >(0)));
 
@@ -1399,14 +1477,9 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         assert((cit != mInvComms.end()) && (cit->second != 0));
 
-        MpiMessage* msg;
-
-        msg = data->mInvLocal->isend(*(cit->second),
-                                     recvevt->getSource(),
-                                     recvevt->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        postSend(*data->mInvLocal, *(cit->second),
+                 recvevt->getSource(),
+                 recvevt->getTag());
     }
 
     //
@@ -1565,14 +1638,9 @@ struct MpiCommunicationHandler::MpiCHImpl
 
         assert((cit != mInvComms.end()) && (cit->second != 0));
 
-        MpiMessage* msg;
-
-        msg = data->mInvLocal->isend(*(cit->second),
-                                     sendevt->getDestination(),
-                                     sendevt->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        postSend(*data->mInvLocal, *(cit->second),
+                 sendevt->getDestination(),
+                 sendevt->getTag());
     }
 
     SCOUT_CALLBACK(cb_bw_pre_recvreq)
@@ -1685,6 +1753,7 @@ struct MpiCommunicationHandler::MpiCHImpl
             { MPI_RMA_WIN_WAIT,     &MpiCHImpl::cb_pre_mpi_win_wait     },
 
             { FINISHED,             &MpiCHImpl::cb_finished             },
+            { SEGMENT_END,          &MpiCHImpl::cb_end_segment          },
 
             { 0,                    0                                   }
         };
@@ -18,8 +18,12 @@
 
 #include "Pattern.h"
 
+#include <algorithm>
 #include <cstring>
+#include <utility>
+#include <vector>
 
+#include <pearl/Error.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
 #include <pearl/LocationGroup.h>
@@ -39,6 +43,50 @@ using namespace pearl;
 using namespace scout;
 
 
+#if defined(_MPI)
+
+namespace
+{
+/// @brief Convert severity values into their report representation
+///
+/// Stores the @p count severity values at @p values in the 8-byte data type
+/// @p type used for the metric in the report (see cube_write_sev_segment_start()),
+/// the same way as cube_write_sev_row_of_doubles() would.
+
+void
+pack_row(const double* values,
+         int           count,
+         DataType      type,
+         char*         buffer)
+{
+    switch (type)
+    {
+        case CUBE_DATA_TYPE_INT64:
+            for (int i = 0; i < count; ++i)
+            {
+                const int64_t value = static_cast< int64_t >(values[i]);
+                memcpy(buffer + i * sizeof(value), &value, sizeof(value));
+            }
+            break;
+
+        case CUBE_DATA_TYPE_UINT64:
+            for (int i = 0; i < count; ++i)
+            {
+                const uint64_t value = static_cast< uint64_t >(values[i]);
+                memcpy(buffer + i * sizeof(value), &value, sizeof(value));
+            }
+            break;
+
+        default:
+            memcpy(buffer, values, count * sizeof(double));
+            break;
+    }
+}
+}    // unnamed namespace
+
+#endif    // _MPI
+
+
 // --- Symbolic names -------------------------------------------------------
 
 #define PATTERNS_URL    "@mirror@scalasca_patterns.html#"
@@ -188,7 +236,8 @@ Pattern::is_hidden() const
  *  Therefore, it first collates the values from each process/thread on the
  *  "master node" (the details depend on the parallel programming paradigm
  *  used) and then writes the gathered data to file. This is done incrementally
- *  per call-tree node.
+ *  either per call-tree node or in batches of call-tree nodes, depending on
+ *  whether batched collation was enabled when creating @a data.
  *
  *  @param  data   Temporary data used for report writing
  *  @param  rank   Global process rank (MPI rank or 0)
@@ -203,16 +252,6 @@ Pattern::gen_severities(ReportData&              data,
 {
     const pearl::GlobalDefs& defs = trace.get_definitions();
 
-    // --- Determine thread information ---
-    // FIXME: deal with non-CPU locations / non-process groups
-    int num_threads = defs.getLocationGroup(rank).numLocations();
-    int thread_id;
-    #if defined(_OPENMP)
-        thread_id = omp_get_thread_num();
-    #else    // !_OPENMP
-        thread_id = 0;
-    #endif    // !_OPENMP
-
     // --- Set up callpath usage bit vectors ---
     uint32_t total_cpaths = defs.numCallpaths();
     uint32_t use_size     = (total_cpaths + 7) / 8;
@@ -311,14 +350,143 @@ Pattern::gen_severities(ReportData&              data,
     }
 
     // --- Collate results ---
-    for (uint32_t i = 0; i < (total_cpaths - num_unknowns); i++)
+    bool collated = false;
+    #if defined(_MPI)
+        if (data.mWriterStride > 0)
+        {
+            collated = collate_parallel(data, rank, trace, cpath_order,
+                                        total_cpaths - num_unknowns, num_unknowns);
+        }
+    #endif    // _MPI
+    if (collated)
+    {
+        // Nothing to do
+    }
+    else if (  (data.mBatchSize > 0)
+            && (data.mWriterStride == 0))
+    {
+        collate_batched(data, rank, trace, cpath_order,
+                        total_cpaths - num_unknowns, num_unknowns);
+    }
+    else
+    {
+        collate_per_callpath(data, rank, trace, cpath_order,
+                             total_cpaths - num_unknowns, num_unknowns);
+    }
+
+    // --- Release local & global severity buffers ---
+    #pragma omp barrier
+    #pragma omp master
+    {
+        delete[] cpath_order;
+        delete[] global_use;
+    }
+
+    // Synchronize threads to avoid race conditions due to temporary
+    // data fields freed above
+    #pragma omp barrier
+}
+
+
+// --- Data collation (private) ---------------------------------------------
+
+/**
+ *  @brief Determines the collation layout of the calling thread.
+ *
+ *  Returns the number of locations of the process with the given @a rank,
+ *  i.e., the number of severity values contributed per call path, as well
+ *  as the index of the calling thread within this set.
+ *
+ *  @param  defs        Global definitions object
+ *  @param  rank        Global process rank (MPI rank or 0)
+ *  @param  numThreads  Number of locations of the process (output)
+ *  @param  threadId    Index of the calling thread (output)
+ **/
+void
+Pattern::get_thread_info(const pearl::GlobalDefs& defs,
+                         int                      rank,
+                         int&                     numThreads,
+                         int&                     threadId)
+{
+    // FIXME: deal with non-CPU locations / non-process groups
+    numThreads = defs.getLocationGroup(rank).numLocations();
+    #if defined(_OPENMP)
+        threadId = omp_get_thread_num();
+    #else    // !_OPENMP
+        threadId = 0;
+    #endif    // !_OPENMP
+}
+
+
+/**
+ *  @brief Determines the call paths for which severities are collated.
+ *
+ *  Maps the entries of @a cpathOrder to the corresponding call-tree nodes
+ *  and drops those excluded via skip_cnode(), preserving the order.
+ *
+ *  @param  defs         Global definitions object
+ *  @param  cpathOrder   Call-path IDs in CUBE writing order
+ *  @param  numCpaths    Number of entries in @a cpathOrder
+ *  @param  numUnknowns  Number of "UNKNOWN" call paths to be skipped
+ *  @param  callpaths    Call paths to be collated (output)
+ **/
+void
+Pattern::get_collated_cnodes(const pearl::GlobalDefs&   defs,
+                             const uint32_t*            cpathOrder,
+                             uint32_t                   numCpaths,
+                             uint32_t                   numUnknowns,
+                             vector< pearl::Callpath* >& callpaths) const
+{
+    callpaths.clear();
+    callpaths.reserve(numCpaths);
+    for (uint32_t i = 0; i < numCpaths; ++i)
     {
         // FIXME: This assumes that only one "UNKNOWN" callpath exists and has ID 0
-        Callpath* callpath = defs.get_cnode(cpath_order[i] + num_unknowns);
-        if (skip_cnode(*callpath))
+        Callpath* callpath = defs.get_cnode(cpathOrder[i] + numUnknowns);
+        if (!skip_cnode(*callpath))
         {
-            continue;
+            callpaths.push_back(callpath);
         }
+    }
+}
+
+
+/**
+ *  @brief Collates and writes the severities one call path at a time.
+ *
+ *  Gathers the severity values of all locations for each call-tree node
+ *  individually on rank 0 and writes the corresponding row to the CUBE
+ *  report.  This requires one collective operation (plus a barrier) per
+ *  call path.
+ *
+ *  @param  data         Temporary data used for report writing
+ *  @param  rank         Global process rank (MPI rank or 0)
+ *  @param  trace        Local trace-data object
+ *  @param  cpathOrder   Call-path IDs in CUBE writing order
+ *  @param  numCpaths    Number of entries in @a cpathOrder
+ *  @param  numUnknowns  Number of "UNKNOWN" call paths to be skipped
+ **/
+void
+Pattern::collate_per_callpath(ReportData&              data,
+                              int                      rank,
+                              const pearl::LocalTrace& trace,
+                              const uint32_t*          cpathOrder,
+                              uint32_t                 numCpaths,
+                              uint32_t                 numUnknowns)
+{
+    const pearl::GlobalDefs& defs = trace.get_definitions();
+
+    int num_threads;
+    int thread_id;
+    get_thread_info(defs, rank, num_threads, thread_id);
+
+    vector< Callpath* > callpaths;
+    get_collated_cnodes(defs, cpathOrder, numCpaths, numUnknowns, callpaths);
+    for (vector< Callpath* >::const_iterator cit = callpaths.begin();
+         cit != callpaths.end();
+         ++cit)
+    {
+        Callpath* callpath = *cit;
 
         // Collate local severities
         #pragma omp barrier
@@ -361,20 +529,377 @@ Pattern::gen_severities(ReportData&              data,
             }
         }
     }
+}
 
-    // --- Release local & global severity buffers ---
-    #pragma omp barrier
+
+/**
+ *  @brief Collates and writes the severities in batches of call paths.
+ *
+ *  Packs the severity values of up to ReportData::mBatchSize call-tree nodes
+ *  into a contiguous, call path-major buffer per process and gathers the
+ *  whole batch on rank 0 with a single collective operation.  Rank 0 then
+ *  transposes the rank-major receive buffer into per-callpath rows and
+ *  writes them to the CUBE report in the requested order.  Call paths
+ *  excluded via skip_cnode() are not part of any batch.
+ *
+ *  @param  data         Temporary data used for report writing
+ *  @param  rank         Global process rank (MPI rank or 0)
+ *  @param  trace        Local trace-data object
+ *  @param  cpathOrder   Call-path IDs in CUBE writing order
+ *  @param  numCpaths    Number of entries in @a cpathOrder
+ *  @param  numUnknowns  Number of "UNKNOWN" call paths to be skipped
+ **/
+void
+Pattern::collate_batched(ReportData&              data,
+                         int                      rank,
+                         const pearl::LocalTrace& trace,
+                         const uint32_t*          cpathOrder,
+                         uint32_t                 numCpaths,
+                         uint32_t                 numUnknowns)
+{
+    const pearl::GlobalDefs& defs = trace.get_definitions();
+
+    int num_threads;
+    int thread_id;
+    get_thread_info(defs, rank, num_threads, thread_id);
+
+    // Determine call paths for which data needs to be collated
+    vector< Callpath* > callpaths;
+    get_collated_cnodes(defs, cpathOrder, numCpaths, numUnknowns, callpaths);
+
+    const uint32_t numCollated = callpaths.size();
+    for (uint32_t first = 0; first < numCollated; first += data.mBatchSize)
+    {
+        uint32_t count = numCollated - first;
+        if (count > data.mBatchSize)
+        {
+            count = data.mBatchSize;
+        }
+
+        // Pack local severities (call path-major)
+        #pragma omp barrier
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            double& value = data.mLocalBatchBuffer[i * num_threads + thread_id];
+
+            map< Callpath*, double >::const_iterator it = m_severity.find(callpaths[first + i]);
+            value = (it != m_severity.end()) ? it->second : 0.0;
+        }
+        #pragma omp barrier
+
+        #pragma omp master
+        {
+            #if defined(_MPI)
+                // Gather batch from all processes
+                if (data.mEqualThreads)
+                {
+                    MPI_Gather(data.mLocalBatchBuffer, count * num_threads, MPI_DOUBLE,
+                               data.mGlobalBatchBuffer, count * num_threads, MPI_DOUBLE,
+                               0, MPI_COMM_WORLD);
+                }
+                else
+                {
+                    if (rank == 0)
+                    {
+                        const uint32_t numRanks = defs.numLocationGroups();
+                        for (uint32_t r = 0; r < numRanks; ++r)
+                        {
+                            data.mBatchRecvCounts[r] = data.mRecvCounts[r] * count;
+                            data.mBatchRecvDispls[r] = data.mRecvDispls[r] * count;
+                        }
+                    }
+                    MPI_Gatherv(data.mLocalBatchBuffer, count * num_threads, MPI_DOUBLE,
+                                data.mGlobalBatchBuffer, data.mBatchRecvCounts, data.mBatchRecvDispls, MPI_DOUBLE,
+                                0, MPI_COMM_WORLD);
+                }
+            #else    // !_MPI
+                memcpy(data.mGlobalBatchBuffer, data.mLocalBatchBuffer,
+                       count * num_threads * sizeof(double));
+            #endif    // !_MPI
+
+            if (rank == 0)
+            {
+                const uint32_t numRanks = defs.numLocationGroups();
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    // Extract row of call path from rank-major batch buffer
+                    for (uint32_t r = 0; r < numRanks; ++r)
+                    {
+                        int threads;
+                        int displ;
+                        #if defined(_MPI)
+                            if (data.mEqualThreads)
+                            {
+                                threads = num_threads;
+                                displ   = r * num_threads;
+                            }
+                            else
+                            {
+                                threads = data.mRecvCounts[r];
+                                displ   = data.mRecvDispls[r];
+                            }
+                        #else    // !_MPI
+                            threads = num_threads;
+                            displ   = 0;
+                        #endif    // !_MPI
+
+                        const double* src = data.mGlobalBatchBuffer
+                                            + (displ * count) + (i * threads);
+                        memcpy(data.mGlobalSevBuffer + displ, src,
+                               threads * sizeof(double));
+                    }
+
+                    // Write data to file
+                    cube_write_sev_row_of_doubles(data.cb, data.metrics[get_id()],
+                                                  data.cnodes[callpaths[first + i]->getId()],
+                                                  data.mGlobalSevBuffer);
+                }
+            }
+        }
+    }
+}
+
+
+#if defined(_MPI)
+
+/**
+ *  @brief Collates and writes the severities in parallel on aggregator ranks.
+ *
+ *  Rank 0 reserves the data segment of the metric in the report file and
+ *  broadcasts the file offsets of all rows.  Each writer group then gathers
+ *  batches of severity values of its locations on the aggregator rank,
+ *  which converts them into the data type stored in the report.  The
+ *  aggregators then write the partial rows of each batch collectively into
+ *  the reserved segment using MPI-IO, and rank 0 finally lets CUBE continue
+ *  after the segment.  This way, rank 0 neither receives nor writes the
+ *  severity data of other writer groups.
+ *
+ *  If the report layout does not support writing pre-built segments (e.g.,
+ *  for compressed reports or values other than 8-byte doubles or integers),
+ *  nothing is collated and @em false is returned.
+ *
+ *  @param  data         Temporary data used for report writing
+ *  @param  rank         Global process rank (MPI rank)
+ *  @param  trace        Local trace-data object
+ *  @param  cpathOrder   Call-path IDs in CUBE writing order
+ *  @param  numCpaths    Number of entries in @a cpathOrder
+ *  @param  numUnknowns  Number of "UNKNOWN" call paths to be skipped
+ *  @return Returns @em true if the severities have been written, @em false
+ *          otherwise
+ *
+ *  @throw  pearl::FatalError  if writing the report file failed.
+ **/
+bool
+Pattern::collate_parallel(ReportData&              data,
+                          int                      rank,
+                          const pearl::LocalTrace& trace,
+                          const uint32_t*          cpathOrder,
+                          uint32_t                 numCpaths,
+                          uint32_t                 numUnknowns)
+{
+    const pearl::GlobalDefs& defs = trace.get_definitions();
+
+    int num_threads;
+    int thread_id;
+    get_thread_info(defs, rank, num_threads, thread_id);
+
+    // Determine call paths for which data needs to be collated
+    vector< Callpath* > callpaths;
+    get_collated_cnodes(defs, cpathOrder, numCpaths, numUnknowns, callpaths);
+
+    const uint32_t numCollated = callpaths.size();
+    if (numCollated == 0)
+    {
+        return true;
+    }
+
+    // Reserve data segment on rank 0 and distribute row offsets.  The last
+    // two entries hold the segment offset (0 if not supported) and the data
+    // type of the metric values stored in the report.
+    // These variables are implicitly shared!
+    static int64_t* offsets = NULL;
+    static int      error   = 0;
     #pragma omp master
     {
-        delete[] cpath_order;
-        delete[] global_use;
+        offsets = new int64_t[numCollated + 2];
+        error   = 0;
+        if (rank == 0)
+        {
+            cube_metric* metric = data.metrics[get_id()];
+
+            offsets[numCollated]     = cube_write_sev_segment_start(data.cb, metric);
+            offsets[numCollated + 1] = cube_metric_get_data_type(metric);
+            for (uint32_t i = 0; i < numCollated; ++i)
+            {
+                offsets[i] = cube_get_sev_row_offset(data.cb, metric,
+                                                     data.cnodes[callpaths[i]->getId()]);
+            }
+        }
+        MPI_Bcast(offsets, numCollated + 2, SCALASCA_MPI_INT64_T, 0, MPI_COMM_WORLD);
+    }
+    {
+        // FCCpx requires block
+        #pragma omp barrier
     }
 
-    // Synchronize threads to avoid race conditions due to temporary
-    // data fields freed above
-    #pragma omp barrier
+    const int64_t segment = offsets[numCollated];
+    if (segment == 0)
+    {
+        #pragma omp barrier
+        #pragma omp master
+        {
+            delete[] offsets;
+        }
+        {
+            // FCCpx requires block
+            #pragma omp barrier
+        }
+
+        return false;
+    }
+
+    const DataType dataType = static_cast< DataType >(offsets[numCollated + 1]);
+    const MPI_Aint rowStart = data.mGroupFirstLocation * sizeof(double);
+    const int      rowBytes = data.mGroupNumLocations * sizeof(double);
+
+    vector< char >     packBuffer;
+    vector< MPI_Aint > displacements;
+    vector< int >      blockLengths;
+    if (data.mAggregatorComm != MPI_COMM_NULL)
+    {
+        packBuffer.resize(static_cast< size_t >(data.mBatchSize) * rowBytes);
+        displacements.reserve(data.mBatchSize);
+        blockLengths.reserve(data.mBatchSize);
+    }
+
+    for (uint32_t first = 0; first < numCollated; first += data.mBatchSize)
+    {
+        uint32_t count = numCollated - first;
+        if (count > data.mBatchSize)
+        {
+            count = data.mBatchSize;
+        }
+
+        // Pack local severities (call path-major)
+        #pragma omp barrier
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            double& value = data.mLocalBatchBuffer[i * num_threads + thread_id];
+
+            map< Callpath*, double >::const_iterator it = m_severity.find(callpaths[first + i]);
+            value = (it != m_severity.end()) ? it->second : 0.0;
+        }
+        #pragma omp barrier
+
+        #pragma omp master
+        {
+            // Gather batch on the aggregator of the writer group
+            int groupSize;
+            MPI_Comm_size(data.mWriterComm, &groupSize);
+
+            vector< int > recvCounts;
+            vector< int > recvDispls;
+            if (data.mGroupBatchBuffer)
+            {
+                recvCounts.resize(groupSize);
+                recvDispls.resize(groupSize);
+                for (int r = 0; r < groupSize; ++r)
+                {
+                    recvCounts[r] = data.mGroupRecvCounts[r] * count;
+                    recvDispls[r] = data.mGroupRecvDispls[r] * count;
+                }
+            }
+            MPI_Gatherv(data.mLocalBatchBuffer, count * num_threads, MPI_DOUBLE,
+                        data.mGroupBatchBuffer,
+                        recvCounts.empty() ? NULL : &recvCounts[0],
+                        recvDispls.empty() ? NULL : &recvDispls[0],
+                        MPI_DOUBLE, 0, data.mWriterComm);
+
+            // Write partial rows of the group.  As all groups process the
+            // same call paths per batch, the aggregators jointly write
+            // complete rows with a single collective operation.
+            if (data.mAggregatorComm != MPI_COMM_NULL)
+            {
+                vector< pair< int64_t, uint32_t > > rows;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const int64_t offset = offsets[first + i];
+                    if (offset >= 0)
+                    {
+                        rows.push_back(make_pair(offset, i));
+                    }
+                }
+                sort(rows.begin(), rows.end());
+
+                displacements.clear();
+                blockLengths.clear();
+                for (size_t k = 0; k < rows.size(); ++k)
+                {
+                    char* row = &packBuffer[k * rowBytes];
+
+                    // Extract partial row of call path from rank-major batch
+                    // buffer
+                    for (int r = 0; r < groupSize; ++r)
+                    {
+                        const int threads = data.mGroupRecvCounts[r];
+                        const int displ   = data.mGroupRecvDispls[r];
+
+                        const double* src = data.mGroupBatchBuffer
+                                            + (displ * count) + (rows[k].second * threads);
+                        pack_row(src, threads, dataType, row + displ * sizeof(double));
+                    }
+
+                    displacements.push_back(segment + rows[k].first + rowStart);
+                    blockLengths.push_back(rowBytes);
+                }
+
+                MPI_Datatype fileType;
+                MPI_Type_create_hindexed(rows.size(),
+                                         blockLengths.empty() ? NULL : &blockLengths[0],
+                                         displacements.empty() ? NULL : &displacements[0],
+                                         MPI_BYTE, &fileType);
+                MPI_Type_commit(&fileType);
+
+                MPI_Status status;
+                if (  (MPI_File_set_view(data.mWriterFile, 0, MPI_BYTE, fileType,
+                                         const_cast< char* >("native"),
+                                         MPI_INFO_NULL) != MPI_SUCCESS)
+                   || (MPI_File_write_all(data.mWriterFile,
+                                          packBuffer.empty() ? NULL : &packBuffer[0],
+                                          rows.size() * rowBytes, MPI_BYTE,
+                                          &status) != MPI_SUCCESS))
+                {
+                    error = 1;
+                }
+                MPI_Type_free(&fileType);
+            }
+        }
+    }
+
+    // Ensure the segment is complete before rank 0 continues writing
+    #pragma omp master
+    {
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        if (rank == 0)
+        {
+            cube_write_sev_segment_end(data.cb, data.metrics[get_id()]);
+        }
+        delete[] offsets;
+    }
+    {
+        // FCCpx requires block
+        #pragma omp barrier
+    }
+    if (error)
+    {
+        throw FatalError("Could not write CUBE report!");
+    }
+
+    return true;
 }
 
+#endif    // _MPI
+
 
 // --- Pattern management ---------------------------------------------------
 
@@ -20,6 +20,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include <cubew_metric.h>
 
@@ -146,6 +147,50 @@ class Pattern
         skip_cnode(const pearl::Callpath& cnode) const;
 
         /// @}
+
+
+    private:
+        /// @name Data collation
+        /// @{
+
+        static void
+        get_thread_info(const pearl::GlobalDefs& defs,
+                        int                      rank,
+                        int&                     numThreads,
+                        int&                     threadId);
+
+        void
+        get_collated_cnodes(const pearl::GlobalDefs&         defs,
+                            const uint32_t*                  cpathOrder,
+                            uint32_t                         numCpaths,
+                            uint32_t                         numUnknowns,
+                            std::vector< pearl::Callpath* >& callpaths) const;
+
+        void
+        collate_per_callpath(ReportData&              data,
+                             int                      rank,
+                             const pearl::LocalTrace& trace,
+                             const uint32_t*          cpathOrder,
+                             uint32_t                 numCpaths,
+                             uint32_t                 numUnknowns);
+
+        void
+        collate_batched(ReportData&              data,
+                        int                      rank,
+                        const pearl::LocalTrace& trace,
+                        const uint32_t*          cpathOrder,
+                        uint32_t                 numCpaths,
+                        uint32_t                 numUnknowns);
+
+        bool
+        collate_parallel(ReportData&              data,
+                         int                      rank,
+                         const pearl::LocalTrace& trace,
+                         const uint32_t*          cpathOrder,
+                         uint32_t                 numCpaths,
+                         uint32_t                 numUnknowns);
+
+        /// @}
 };
 }    // namespace scout
 
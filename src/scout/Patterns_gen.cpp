@@ -77,11 +77,14 @@ extern bool enableAsynchronous;
 
 #include <cfloat>
 #include <list>
+#include <map>
+#include <vector>
 
 #define SCALASCA_DEBUG_MODULE_NAME    SCOUT
 #include <UTILS_Debug.h>
 
 #include <pearl/CallbackManager.h>
+#include <pearl/LocalTrace.h>
 #include <pearl/Region.h>
 #include <pearl/String.h>
 
@@ -964,7 +967,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 176 "MPI.pattern"
+        #line 179 "MPI.pattern"
 
         if (data->mCompletion > 0)
         {
@@ -992,7 +995,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 152 "MPI.pattern"
+        #line 155 "MPI.pattern"
 
         const CollectiveInfo& ci = data->mCollinfo;
 
@@ -1143,7 +1146,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 243 "MPI.pattern"
+        #line 246 "MPI.pattern"
 
         if (data->mIdle > 0)
         {
@@ -1171,7 +1174,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 220 "MPI.pattern"
+        #line 223 "MPI.pattern"
 
         const CollectiveInfo& ci = data->mCollinfo;
 
@@ -1316,7 +1319,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 387 "MPI.pattern"
+        #line 390 "MPI.pattern"
 
         const CollectiveInfo& ci = data->mCollinfo;
 
@@ -1455,7 +1458,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 438 "MPI.pattern"
+        #line 441 "MPI.pattern"
 
         if (data->mIdle > 0)
         {
@@ -1588,7 +1591,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 482 "MPI.pattern"
+        #line 485 "MPI.pattern"
 
         if (data->mCompletion > 0)
         {
@@ -1750,7 +1753,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 566 "MPI.pattern"
+        #line 569 "MPI.pattern"
 
         // Validate clock condition
         RemoteEvent send = data->mRemote->get_event(ROLE_SEND);
@@ -1774,7 +1777,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 560 "MPI.pattern"
+        #line 563 "MPI.pattern"
 
         data->mLocal->add_event(event, ROLE_RECV);
         data->mLocal->add_event(event.enterptr(), ROLE_ENTER_RECV);
@@ -1790,7 +1793,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 555 "MPI.pattern"
+        #line 558 "MPI.pattern"
 
         data->mLocal->add_event(event, ROLE_SEND);
         data->mLocal->add_event(event.enterptr(), ROLE_ENTER_SEND);
@@ -1903,7 +1906,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
             virtual void
             init()
             {
-                #line 620 "MPI.pattern"
+                #line 623 "MPI.pattern"
 
                 m_max_idle = 0.0;
             }
@@ -1912,7 +1915,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
 
 
         private:
-            #line 613 "MPI.pattern"
+            #line 616 "MPI.pattern"
 
             // *INDENT-OFF*    Uncrustify issue #2789
             double         m_max_idle;
@@ -1970,7 +1973,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 693 "MPI.pattern"
+        #line 696 "MPI.pattern"
 
         if (  (m_max_idle > 0.0)
            && is_mpi_wait_multi(event.enterptr()->getRegion()))
@@ -2007,7 +2010,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 636 "MPI.pattern"
+        #line 639 "MPI.pattern"
 
         RemoteEvent enter_send = data->mRemote->get_event(ROLE_ENTER_SEND_LS);
         RemoteEvent leave_send = data->mRemote->get_event(ROLE_LEAVE_SEND_LS);
@@ -2074,7 +2077,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 630 "MPI.pattern"
+        #line 633 "MPI.pattern"
 
         data->mLocal->add_event(event, ROLE_RECV_LS);
         data->mLocal->add_event(event.enterptr(), ROLE_ENTER_RECV_LS);
@@ -2090,7 +2093,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 624 "MPI.pattern"
+        #line 627 "MPI.pattern"
 
         data->mLocal->add_event(event, ROLE_SEND_LS);
         data->mLocal->add_event(event.enterptr(), ROLE_ENTER_SEND_LS);
@@ -2182,11 +2185,17 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
                           const Event&           event,
                           CallbackData*          cdata);
 
+            void
+            segment_end__cb(const CallbackManager& cbmanager,
+                            int                    user_event,
+                            const Event&           event,
+                            CallbackData*          cdata);
+
             /// @}
 
 
         private:
-            #line 751 "MPI.pattern"
+            #line 754 "MPI.pattern"
 
             static const uint32_t BUFFERSIZE = 100;
 
@@ -2228,6 +2237,11 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
         assert(it != cbmanagers.end());
 
         cbmanager = it->second;
+        cbmanager->register_callback(
+            SEGMENT_END,
+            PEARL_create_callback(
+                this,
+                &PatternMPI_LateSenderWO::segment_end__cb));
         cbmanager->register_callback(
             LATE_SENDER,
             PEARL_create_callback(
@@ -2251,7 +2265,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 776 "MPI.pattern"
+        #line 785 "MPI.pattern"
 
         // Construct entry
         LateSender item(data->mRemote->get_event(ROLE_SEND_LS),
@@ -2274,7 +2288,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 789 "MPI.pattern"
+        #line 798 "MPI.pattern"
 
         RemoteEvent send = data->mRemote->get_event(ROLE_SEND);
 
@@ -2304,6 +2318,20 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
             }
         }
     }
+
+
+    void
+    PatternMPI_LateSenderWO::segment_end__cb(const CallbackManager& cbmanager,
+                                             int                    user_event,
+                                             const Event&           event,
+                                             CallbackData*          cdata)
+    {
+        #line 779 "MPI.pattern"
+
+        // Messages never cross segment boundaries, thus wrong-order
+        // situations are confined to a single segment
+        m_buffer.clear();
+    }
 #endif    // _MPI
 
 
@@ -2421,7 +2449,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 846 "MPI.pattern"
+        #line 855 "MPI.pattern"
 
         Event recv = data->mLocal->get_event(ROLE_RECV_LSWO);
 
@@ -2547,7 +2575,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 881 "MPI.pattern"
+        #line 890 "MPI.pattern"
 
         Event recv = data->mLocal->get_event(ROLE_RECV_LSWO);
 
@@ -2660,6 +2688,18 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
                             const Event&           event,
                             CallbackData*          cdata);
 
+            void
+            segment_begin_bws_cb(const CallbackManager& cbmanager,
+                                 int                    user_event,
+                                 const Event&           event,
+                                 CallbackData*          cdata);
+
+            void
+            segment_end__cb(const CallbackManager& cbmanager,
+                            int                    user_event,
+                            const Event&           event,
+                            CallbackData*          cdata);
+
             /// @}
 
 
@@ -2670,7 +2710,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
             virtual void
             init()
             {
-                #line 945 "MPI.pattern"
+                #line 960 "MPI.pattern"
 
                 #ifdef DEBUG_MULTI_LR
                     std::ostringstream fnamestr;
@@ -2684,7 +2724,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
 
 
         private:
-            #line 923 "MPI.pattern"
+            #line 932 "MPI.pattern"
 
             struct multiwait_info_t
             {
@@ -2700,8 +2740,14 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
             typedef std::map< Event, multiwait_info_t, pearl::EventKeyCompare >
                 multiwait_map_t;
 
-            event_set_t     m_ls_set;
-            multiwait_map_t m_multiwait_map;
+            // Late-sender candidate events saved per trace segment (indexed by
+            // segment begin) for the backward replay
+            typedef std::map< uint64_t, std::vector< uint32_t > >
+                ls_segment_map_t;
+
+            event_set_t      m_ls_set;
+            multiwait_map_t  m_multiwait_map;
+            ls_segment_map_t m_ls_segments;
 
             #ifdef DEBUG_MULTI_LR
                 std::ofstream m_dbg_out;
@@ -2729,12 +2775,22 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
             PEARL_create_callback(
                 this,
                 &PatternMPI_LateReceiver::late_sender_candidate__cb));
+        cbmanager->register_callback(
+            SEGMENT_END,
+            PEARL_create_callback(
+                this,
+                &PatternMPI_LateReceiver::segment_end__cb));
 
         // Register bws callbacks
         it = cbmanagers.find("bws");
         assert(it != cbmanagers.end());
 
         cbmanager = it->second;
+        cbmanager->register_callback(
+            SEGMENT_BEGIN,
+            PEARL_create_callback(
+                this,
+                &PatternMPI_LateReceiver::segment_begin_bws_cb));
         cbmanager->register_callback(
             PRE_SEND,
             PEARL_create_callback(
@@ -2766,7 +2822,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
                                                        const Event&           event,
                                                        CallbackData*          cdata)
     {
-        #line 954 "MPI.pattern"
+        #line 969 "MPI.pattern"
 
         m_ls_set.insert(event.enterptr());
     }
@@ -2778,7 +2834,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
                                                       const Event&           event,
                                                       CallbackData*          cdata)
     {
-        #line 1037 "MPI.pattern"
+        #line 1080 "MPI.pattern"
 
         Event enter = event.enterptr();
 
@@ -2812,7 +2868,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 969 "MPI.pattern"
+        #line 1012 "MPI.pattern"
 
         // backward replay: msg received from destination here
 
@@ -2890,7 +2946,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1061 "MPI.pattern"
+        #line 1104 "MPI.pattern"
 
         data->mLocal->add_event(event, ROLE_RECV_LR);
 
@@ -2909,7 +2965,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 960 "MPI.pattern"
+        #line 1003 "MPI.pattern"
 
         data->mLocal->add_event(event, ROLE_SEND_LR);
 
@@ -2918,6 +2974,54 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
         data->mLocal->add_event(completion.enterptr(), ROLE_ENTER_SEND_LR);
         data->mLocal->add_event(completion.leaveptr(), ROLE_LEAVE_SEND_LR);
     }
+
+
+    void
+    PatternMPI_LateReceiver::segment_begin_bws_cb(const CallbackManager& cbmanager,
+                                                  int                    user_event,
+                                                  const Event&           event,
+                                                  CallbackData*          cdata)
+    {
+        CbData* data = static_cast< CbData* >(cdata);
+
+        #line 986 "MPI.pattern"
+
+        m_ls_set.clear();
+
+        ls_segment_map_t::iterator entry =
+            m_ls_segments.find(data->mTrace->segment_begin());
+        if (entry != m_ls_segments.end())
+        {
+            for (std::vector< uint32_t >::const_iterator it = entry->second.begin();
+                 it != entry->second.end();
+                 ++it)
+            {
+                m_ls_set.insert(data->mTrace->at(*it));
+            }
+            m_ls_segments.erase(entry);
+        }
+    }
+
+
+    void
+    PatternMPI_LateReceiver::segment_end__cb(const CallbackManager& cbmanager,
+                                             int                    user_event,
+                                             const Event&           event,
+                                             CallbackData*          cdata)
+    {
+        CbData* data = static_cast< CbData* >(cdata);
+
+        #line 973 "MPI.pattern"
+
+        std::vector< uint32_t >& ids = m_ls_segments[data->mTrace->segment_begin()];
+        for (event_set_t::const_iterator it = m_ls_set.begin();
+             it != m_ls_set.end();
+             ++it)
+        {
+            ids.push_back(it->get_id());
+        }
+        m_ls_set.clear();
+    }
 #endif    // _MPI
 
 
@@ -3073,7 +3177,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1117 "MPI.pattern"
+        #line 1160 "MPI.pattern"
 
         if (data->mIsSyncpoint)
         {
@@ -3109,7 +3213,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1169 "MPI.pattern"
+        #line 1212 "MPI.pattern"
 
         if (data->mIsSyncpoint)
         {
@@ -3145,7 +3249,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1143 "MPI.pattern"
+        #line 1186 "MPI.pattern"
 
         if (data->mIsSyncpoint)
         {
@@ -3181,7 +3285,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1195 "MPI.pattern"
+        #line 1238 "MPI.pattern"
 
         if (data->mIsSyncpoint)
         {
@@ -3322,7 +3426,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1246 "MPI.pattern"
+        #line 1289 "MPI.pattern"
 
         if (data->mIdle > 0)
         {
@@ -3457,7 +3561,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1288 "MPI.pattern"
+        #line 1331 "MPI.pattern"
 
         if (data->mIdle > 0)
         {
@@ -3591,7 +3695,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1332 "MPI.pattern"
+        #line 1375 "MPI.pattern"
 
         if (data->mIdle > 0)
         {
@@ -3726,7 +3830,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1383 "MPI.pattern"
+        #line 1426 "MPI.pattern"
 
         if (data->mIdle > 0)
         {
@@ -3861,7 +3965,7 @@ PatternVisits::thread_task_complete__cb(const CallbackManager& cbmanager,
     {
         CbData* data = static_cast< CbData* >(cdata);
 
-        #line 1428 "MPI.pattern"
+        #line 1471 "MPI.pattern"
 
         if (data->mCompletion > 0)
         {
@@ -12554,7 +12658,7 @@ PatternStatistics::prepare__cb(const CallbackManager& cbmanager,
         cb.register_callback(THREAD_ACQUIRE_LOCK, PEARL_create_callback(this, &PatternStatistics::acquire_cb));
     #endif    // _OPENMP
 
-    PEARL_forward_replay(*(data->mTrace), cb, &durations);
+    PEARL_selective_forward_replay(*(data->mTrace), cb, &durations);
 
     // Determine global upper bounds for pattern durations
     #pragma omp master
@@ -19,10 +19,20 @@
 #include "ReadDefinitionsTask.h"
 
 #include <cstddef>
+#include <exception>
+#include <string>
 
+#include <pearl/Error.h>
 #include <pearl/TraceArchive.h>
 
 #include "TaskData.h"
+#include "Timer.h"
+
+#if defined(_MPI)
+    #include <mpi.h>
+
+    #include <pearl/MpiMessage.h>
+#endif    // _MPI
 
 using namespace std;
 using namespace pearl;
@@ -37,11 +47,18 @@ using namespace scout;
  *  This constructor creates a new ReadDefinitionsTask instance with the
  *  given parameters.
  *
- *  @param  sharedData  Shared task data object
+ *  @param  sharedData    Shared task data object
+ *  @param  singleReader  Read definitions only on rank 0 and broadcast them
+ *                        (ignored for non-MPI builds)
  **/
-ReadDefinitionsTask::ReadDefinitionsTask(TaskDataShared& sharedData)
+ReadDefinitionsTask::ReadDefinitionsTask(TaskDataShared& sharedData,
+                                         bool            singleReader)
     : Task(),
-      mSharedData(sharedData)
+      mSharedData(sharedData),
+      mSingleReader(singleReader),
+      mReadTime(0.0),
+      mBroadcastTime(0.0),
+      mUnpackTime(0.0)
 {
 }
 
@@ -52,15 +69,128 @@ ReadDefinitionsTask::ReadDefinitionsTask(TaskDataShared& sharedData)
  *  @brief Executes the task.
  *
  *  Initializes the global definitions object by reading the global definition
- *  data from the experiment archive.
+ *  data from the experiment archive.  In single-reader mode, rank 0 reads the
+ *  definitions and broadcasts them in packed form to all other ranks, which
+ *  then reconstruct the definitions object without accessing the file system.
  *
  *  @return Returns @em true if successful, @em false otherwise
  **/
 bool
 ReadDefinitionsTask::execute()
 {
+    #if defined(_MPI)
+        if (mSingleReader)
+        {
+            int rank;
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+            // Read & pack definitions on rank 0; errors have to be propagated
+            // before the broadcast to avoid deadlocks
+            MpiMessage message(MPI_COMM_WORLD);
+            Timer      timer;
+            int        status = 0;
+            string     errorMessage;
+            if (rank == 0)
+            {
+                try
+                {
+                    mSharedData.mArchive->packDefinitions(message);
+                }
+                catch (const std::exception& ex)
+                {
+                    status       = 1;
+                    errorMessage = ex.what();
+                }
+            }
+            timer.stop();
+            double localTimes[3] = { timer.value(), 0.0, 0.0 };
+
+            MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+            if (status != 0)
+            {
+                if (rank == 0)
+                {
+                    throw RuntimeError(errorMessage);
+                }
+                throw RuntimeError("Reading definitions on rank 0 failed!");
+            }
+
+            // Broadcast packed definitions
+            timer.start();
+            message.bcast(0);
+            timer.stop();
+            localTimes[1] = timer.value();
+
+            // Unpack definitions on all ranks (including rank 0), as creating
+            // the definition objects involves collective MPI operations
+            timer.start();
+            mSharedData.mDefinitions =
+                mSharedData.mArchive->getDefinitions(message);
+            timer.stop();
+            localTimes[2] = timer.value();
+
+            double maxTimes[3];
+            MPI_Reduce(localTimes, maxTimes, 3, MPI_DOUBLE, MPI_MAX, 0,
+                       MPI_COMM_WORLD);
+            mReadTime      = maxTimes[0];
+            mBroadcastTime = maxTimes[1];
+            mUnpackTime    = maxTimes[2];
+
+            return (mSharedData.mDefinitions != NULL);
+        }
+    #endif    // _MPI
+
     // Read definitions
+    Timer timer;
     mSharedData.mDefinitions = mSharedData.mArchive->getDefinitions();
+    timer.stop();
+    mReadTime = timer.value();
 
     return (mSharedData.mDefinitions != NULL);
 }
+
+
+// --- Timing information ---------------------------------------------------
+
+/**
+ *  @brief Returns the time spent reading the definition data.
+ *
+ *  In single-reader mode, the value is only valid on rank 0.
+ *
+ *  @return Read time in seconds
+ **/
+double
+ReadDefinitionsTask::getReadTime() const
+{
+    return mReadTime;
+}
+
+
+/**
+ *  @brief Returns the maximum time spent broadcasting the packed definitions.
+ *
+ *  The value is only valid on rank 0 and zero unless single-reader mode is
+ *  used.
+ *
+ *  @return Broadcast time in seconds
+ **/
+double
+ReadDefinitionsTask::getBroadcastTime() const
+{
+    return mBroadcastTime;
+}
+
+
+/**
+ *  @brief Returns the maximum time spent unpacking the broadcast definitions.
+ *
+ *  The value is only valid on rank 0 and zero unless single-reader mode is
+ *  used.
+ *
+ *  @return Unpack time in seconds
+ **/
+double
+ReadDefinitionsTask::getUnpackTime() const
+{
+    return mUnpackTime;
+}
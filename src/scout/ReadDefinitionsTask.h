@@ -45,7 +45,9 @@ struct TaskDataShared;
  *  @brief Task reading the global definition data.
  *
  *  The ReadDefinitionsTask class is used to read the global definition data
- *  of an experiment.
+ *  of an experiment.  In single-reader mode, only rank 0 accesses the file
+ *  system; the definitions are then broadcast in a packed binary format to
+ *  all other ranks.
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -56,7 +58,8 @@ class ReadDefinitionsTask
         /// @name Constructors & destructor
         /// @{
 
-        ReadDefinitionsTask(TaskDataShared& sharedData);
+        ReadDefinitionsTask(TaskDataShared& sharedData,
+                            bool            singleReader = false);
 
         /// @}
         /// @name Execution control
@@ -66,11 +69,36 @@ class ReadDefinitionsTask
         execute();
 
         /// @}
+        /// @name Timing information
+        /// @{
+
+        double
+        getReadTime() const;
+
+        double
+        getBroadcastTime() const;
+
+        double
+        getUnpackTime() const;
+
+        /// @}
 
 
     private:
         /// Shared task data object
         TaskDataShared& mSharedData;
+
+        /// Flag indicating whether only a single rank reads the definitions
+        bool mSingleReader;
+
+        /// Maximum time spent reading the definitions from file
+        double mReadTime;
+
+        /// Maximum time spent broadcasting the packed definitions
+        double mBroadcastTime;
+
+        /// Maximum time spent unpacking the broadcast definitions
+        double mUnpackTime;
 };
 }    // namespace scout
 
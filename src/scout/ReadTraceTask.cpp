@@ -23,11 +23,15 @@
 #include <pearl/Error.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/LocationGroup.h>
 #include <pearl/TraceArchive.h>
 
 #include "CheckedTask.h"
 #include "TaskData.h"
 #include "TimedPhase.h"
+#include "TraceSegments.h"
+#include "scout_options.h"
 
 #if defined(_MPI)
     #include <mpi.h>
@@ -36,6 +40,7 @@
     #include <omp.h>
 #endif    // _OPENMP
 
+using namespace std;
 using namespace pearl;
 using namespace scout;
 
@@ -268,8 +273,13 @@ ReadTraceTask::ReadTraceTask(const TaskDataShared& sharedData,
             "  Reading ID maps (local defs)   ");
     SUBTASK(new ReadTraceData(sharedData, privateData),
             "  Reading trace data             ");
-    SUBTASK(new CloseTraceContainer(sharedData),
-            "  Closing trace container        ");
+    // When analyzing the trace in segments, the container has to stay open
+    // for reading the segments again; it is closed with the archive
+    if (maxTraceMemory == 0)
+    {
+        SUBTASK(new CloseTraceContainer(sharedData),
+                "  Closing trace container        ");
+    }
     #if defined(_OPENMP)
         SUBTASK(new CheckTraceData(privateData),
                 "  Checking trace properties      ");
@@ -428,7 +438,9 @@ ReadTraceData::ReadTraceData(const TaskDataShared& sharedData,
  *  @brief Executes the task.
  *
  *  Reads the trace data associated to the executing process/thread into
- *  memory.
+ *  memory.  If a trace memory limit is given, the trace is only prescanned
+ *  to determine the segments in which it is analyzed, and the first
+ *  segment is read.
  *
  *  @return Returns true if successful, false otherwise.
  *  @throw  pearl::FatalError  if the trace data contains inconsistent data
@@ -453,6 +465,30 @@ ReadTraceData::execute()
     const LocationGroup& process  = defs.getLocationGroup(rank);
     const Location&      location = process.getLocation(tid);
 
+    // Read trace data in segments
+    if (maxTraceMemory > 0)
+    {
+        if (process.numLocations() > 1)
+        {
+            throw FatalError("Analyzing traces in segments is only supported "
+                             "for a single location per process!");
+        }
+
+        // Only the very beginning of the trace is read here, the chunk
+        // sizes of the prescan are chosen by TraceSegments::determine()
+        mPrivateData.mTrace =
+            mSharedData.mArchive->getTraceSegment(defs,
+                                                  location,
+                                                  0,
+                                                  mPrivateData.mIdMaps);
+        mPrivateData.mSegments = new TraceSegments(*mSharedData.mArchive,
+                                                   *mSharedData.mDefinitions,
+                                                   *mPrivateData.mTrace);
+        mPrivateData.mSegments->determine(maxTraceMemory);
+
+        return true;
+    }
+
     // Read trace data
     mPrivateData.mTrace = mSharedData.mArchive->getTrace(defs,
                                                          location,
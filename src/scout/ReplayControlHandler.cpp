@@ -46,6 +46,12 @@ struct ReplayControlHandler::RepCHImpl
         data->mCallstack->setUpdate(false);
     }
 
+    SCOUT_CALLBACK(cb_begin_fw_segment)
+    {
+        CbData* data = static_cast< CbData* >(cdata);
+        data->mCallstack->rebuild(*data->mTrace);
+    }
+
     //
     // --- callback registration -----------------------------------------
     //
@@ -77,9 +83,10 @@ struct ReplayControlHandler::RepCHImpl
 
         // *INDENT-OFF*
         const struct cb_uevt_table_t fw_uevt_tbl[] = {
-            { PREPARE, &RepCHImpl::cb_prepare_fw_replay },
+            { PREPARE,       &RepCHImpl::cb_prepare_fw_replay },
+            { SEGMENT_BEGIN, &RepCHImpl::cb_begin_fw_segment  },
 
-            { 0,       0                                }
+            { 0,             0                                }
         };
         // *INDENT-ON*
 
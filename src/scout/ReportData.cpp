@@ -14,6 +14,8 @@
 
 #include "ReportData.h"
 
+#include <algorithm>
+#include <climits>
 #include <cstring>
 
 using namespace std;
@@ -33,16 +35,103 @@ using namespace scout;
 
 
 ReportData::ReportData(const GlobalDefs& defs,
-                       int               rank)
+                       int               rank,
+                       size_t            batchBytes,
+                       uint32_t          numWriters)
     : cb(0),
       mLocalSevBuffer(0),
       mGlobalSevBuffer(0),
       mRecvCounts(0),
       mRecvDispls(0),
-      mEqualThreads(true)
+      mEqualThreads(true),
+      mBatchSize(0),
+      mLocalBatchBuffer(0),
+      mGlobalBatchBuffer(0),
+      mBatchRecvCounts(0),
+      mBatchRecvDispls(0),
+      mWriterStride(0),
+      mGroupFirstLocation(0),
+      mGroupNumLocations(0),
+      mGroupBatchBuffer(0),
+      mGroupRecvCounts(0),
+      mGroupRecvDispls(0)
+      #if defined(_MPI)
+          , mWriterComm(MPI_COMM_NULL)
+          , mAggregatorComm(MPI_COMM_NULL)
+          , mWriterFile(MPI_FILE_NULL)
+      #endif    // _MPI
 {
-    // This variable is implicitly shared!
-    static double* localSevBuffer = 0;
+    // These variables are implicitly shared!
+    static double* localSevBuffer   = 0;
+    static double* localBatchBuffer = 0;
+
+    // Determine writer groups (if requested).  Each group consists of
+    // consecutive ranks and therefore covers a contiguous range of locations
+    // in the report rows.
+    const uint32_t numRanks          = defs.numLocationGroups();
+    uint32_t       maxGroupLocations = 0;
+    #if defined(_MPI)
+        if (numWriters > 0)
+        {
+            const uint32_t writers = std::min(numWriters, numRanks);
+
+            mWriterStride = (numRanks + writers - 1) / writers;
+
+            const uint32_t leader = (rank / mWriterStride) * mWriterStride;
+            for (uint32_t first = 0; first < numRanks; first += mWriterStride)
+            {
+                const uint32_t last      = std::min(first + mWriterStride, numRanks);
+                uint32_t       locations = 0;
+                for (uint32_t i = first; i < last; ++i)
+                {
+                    locations += defs.getLocationGroup(i).numLocations();
+                }
+                if (first < leader)
+                {
+                    mGroupFirstLocation += locations;
+                }
+                else if (first == leader)
+                {
+                    mGroupNumLocations = locations;
+                }
+                maxGroupLocations = std::max(maxGroupLocations, locations);
+            }
+        }
+    #endif    // _MPI
+
+    // Determine batch size (if requested).  It is limited by the size of the
+    // global batch buffer on rank 0, which needs to hold the severities of all
+    // locations for each call path of a batch.  With parallel report writing,
+    // it is limited by the size of the largest group batch buffer instead,
+    // as all writer groups have to process the same call paths per batch to
+    // write complete rows collectively.  In both cases, all element counts
+    // and displacements used in the gather operations have to be
+    // representable as 'int'.
+    if (  (batchBytes > 0)
+       || (mWriterStride > 0))
+    {
+        const size_t rowLocations = (mWriterStride > 0)
+                                    ? maxGroupLocations
+                                    : defs.numLocations();
+        const size_t rowBytes     = rowLocations * sizeof(double);
+        const size_t numCallpaths = defs.numCallpaths();
+        const size_t maxBatchSize = INT_MAX / rowLocations;
+
+        size_t batchSize = batchBytes / rowBytes;
+        if (batchSize > numCallpaths)
+        {
+            batchSize = numCallpaths;
+        }
+        if (batchSize > maxBatchSize)
+        {
+            batchSize = maxBatchSize;
+        }
+        if (batchSize == 0)
+        {
+            batchSize = 1;
+        }
+        mBatchSize = batchSize;
+    }
 
     // Initialize collation arrays
     #pragma omp master
@@ -55,7 +144,6 @@ ReportData::ReportData(const GlobalDefs& defs,
 
         // Allocate and initialize global collation data structures
         // (only relevant on rank 0)
-        const uint32_t numRanks = defs.numLocationGroups();
         if (rank == 0)
         {
             // Global severity buffer
@@ -94,11 +182,62 @@ ReportData::ReportData(const GlobalDefs& defs,
                 mEqualThreads = mEqualThreads && (threads == numThreads);
             }
         }
+
+        // Allocate batch collation buffers (if requested)
+        localBatchBuffer = 0;
+        if (mBatchSize > 0)
+        {
+            const uint32_t totalThreads = defs.numLocations();
+
+            localBatchBuffer = new double[mBatchSize * numThreads];
+            if (  (rank == 0)
+               && (mWriterStride == 0))
+            {
+                mGlobalBatchBuffer = new double[mBatchSize * totalThreads];
+                mBatchRecvCounts   = new int[numRanks];
+                mBatchRecvDispls   = new int[numRanks];
+            }
+        }
+
+        // Set up writer group (if requested)
+        #if defined(_MPI)
+            if (mWriterStride > 0)
+            {
+                MPI_Comm_split(MPI_COMM_WORLD, rank / mWriterStride, rank,
+                               &mWriterComm);
+
+                const uint32_t leader = (rank / mWriterStride) * mWriterStride;
+                MPI_Comm_split(MPI_COMM_WORLD,
+                               (rank == static_cast< int >(leader)) ? 0 : MPI_UNDEFINED,
+                               rank, &mAggregatorComm);
+                if (rank == static_cast< int >(leader))
+                {
+                    const uint32_t last    = std::min(leader + mWriterStride, numRanks);
+                    const uint32_t members = last - leader;
+
+                    mGroupBatchBuffer = new double[mBatchSize * mGroupNumLocations];
+                    mGroupRecvCounts  = new int[members];
+                    mGroupRecvDispls  = new int[members];
+
+                    int displacement = 0;
+                    for (uint32_t i = 0; i < members; ++i)
+                    {
+                        const int threads = defs.getLocationGroup(leader + i).numLocations();
+
+                        mGroupRecvCounts[i] = threads;
+                        mGroupRecvDispls[i] = displacement;
+
+                        displacement += threads;
+                    }
+                }
+            }
+        #endif    // _MPI
     }
 
-    // Share process-local severity buffer across all threads
+    // Share process-local severity & batch buffers across all threads
     #pragma omp barrier
-    mLocalSevBuffer = localSevBuffer;
+    mLocalSevBuffer   = localSevBuffer;
+    mLocalBatchBuffer = localBatchBuffer;
 }
 
 
@@ -110,5 +249,27 @@ ReportData::~ReportData()
         delete[] mGlobalSevBuffer;
         delete[] mRecvCounts;
         delete[] mRecvDispls;
+        delete[] mLocalBatchBuffer;
+        delete[] mGlobalBatchBuffer;
+        delete[] mBatchRecvCounts;
+        delete[] mBatchRecvDispls;
+        delete[] mGroupBatchBuffer;
+        delete[] mGroupRecvCounts;
+        delete[] mGroupRecvDispls;
+
+        #if defined(_MPI)
+            if (mWriterFile != MPI_FILE_NULL)
+            {
+                MPI_File_close(&mWriterFile);
+            }
+            if (mAggregatorComm != MPI_COMM_NULL)
+            {
+                MPI_Comm_free(&mAggregatorComm);
+            }
+            if (mWriterComm != MPI_COMM_NULL)
+            {
+                MPI_Comm_free(&mWriterComm);
+            }
+        #endif    // _MPI
     }
 }
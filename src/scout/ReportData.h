@@ -18,6 +18,7 @@
 #define SCOUT_REPORTDATA_H
 
 
+#include <cstddef>
 #include <map>
 #include <vector>
 
@@ -26,6 +27,10 @@
 #include <pearl/GlobalDefs.h>
 #include <pearl/Location.h>
 
+#if defined(_MPI)
+    #include <mpi.h>
+#endif    // _MPI
+
 
 /*-------------------------------------------------------------------------*/
 /**
@@ -68,11 +73,30 @@ struct ReportData
     /// according to the process/thread configuration from the global
     /// definitions object.
     ///
-    /// @param  defs  Global defintions object
-    /// @param  rank  MPI rank
+    /// If @a batchBytes is non-zero, additional buffers are allocated to
+    /// collate the severities of multiple call paths with a single collective
+    /// operation.  The number of call paths per batch is chosen such that the
+    /// global batch buffer on rank 0 does not exceed @a batchBytes bytes.
+    ///
+    /// If @a numWriters is non-zero (MPI only), the ranks are partitioned
+    /// into at most @a numWriters groups of consecutive ranks.  The lowest
+    /// rank of each group acts as aggregator, which collates the severities
+    /// of its group in batches and writes the corresponding partial rows
+    /// collectively into the report file.  In this case, the batch size is
+    /// derived from the number of locations of the largest group, and no
+    /// global batch buffer is allocated on rank 0.
+    ///
+    /// @param  defs        Global defintions object
+    /// @param  rank        MPI rank
+    /// @param  batchBytes  Size limit of the global batch buffer in bytes
+    ///                     (0 selects per-callpath collation)
+    /// @param  numWriters  Number of aggregator ranks for parallel report
+    ///                     writing (0 selects central writing on rank 0)
     ///
     ReportData(const pearl::GlobalDefs& defs,
-               int                      rank);
+               int                      rank,
+               size_t                   batchBytes = 0,
+               uint32_t                 numWriters = 0);
 
     /// @brief Destructor.
     ///
@@ -114,6 +138,53 @@ struct ReportData
 
     /// Flag indicating whether all MPI ranks use the same number of threads
     bool mEqualThreads;
+
+    /// Number of call paths collated per batch; 0 if batching is disabled
+    uint32_t mBatchSize;
+
+    /// Process-local batch buffer (call path-major); shared across all threads
+    double* mLocalBatchBuffer;
+
+    /// Global batch buffer (rank-major); only relevant on MPI rank 0
+    double* mGlobalBatchBuffer;
+
+    /// Batched gatherv receive counts; only relevant on MPI rank 0
+    int* mBatchRecvCounts;
+
+    /// Batched gatherv receive displacements; only relevant on MPI rank 0
+    int* mBatchRecvDispls;
+
+    /// Number of consecutive ranks per writer group; 0 if parallel report
+    /// writing is disabled
+    uint32_t mWriterStride;
+
+    /// Global index of the first location of the writer group
+    uint32_t mGroupFirstLocation;
+
+    /// Number of locations of the writer group
+    uint32_t mGroupNumLocations;
+
+    /// Group batch buffer (rank-major); only relevant on aggregator ranks
+    double* mGroupBatchBuffer;
+
+    /// Group gatherv receive counts; only relevant on aggregator ranks
+    int* mGroupRecvCounts;
+
+    /// Group gatherv receive displacements; only relevant on aggregator ranks
+    int* mGroupRecvDispls;
+
+    #if defined(_MPI)
+        /// Communicator of the writer group; only valid on the master thread
+        MPI_Comm mWriterComm;
+
+        /// Communicator of all aggregator ranks; only valid on the master
+        /// thread of aggregator ranks
+        MPI_Comm mAggregatorComm;
+
+        /// Report file opened for collective writing; only valid on the
+        /// master thread of aggregator ranks
+        MPI_File mWriterFile;
+    #endif    // _MPI
 };
 }    // namespace scout
 
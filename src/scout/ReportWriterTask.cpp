@@ -47,6 +47,7 @@
 #include "Logging.h"
 #include "ReportData.h"
 #include "TaskData.h"
+#include "scout_options.h"
 
 #if defined(_MPI)
     #include <mpi.h>
@@ -132,7 +133,8 @@ ReportWriterTask::execute()
     // This variable is implicitly shared!
     static int error = 0;
 
-    ReportData data(*mSharedData.mDefinitions, mRank);
+    ReportData data(*mSharedData.mDefinitions, mRank, reportBatchBytes,
+                    reportWriters);
     if (mRank == 0)
     {
         #pragma omp master
@@ -154,6 +156,7 @@ ReportWriterTask::execute()
         {
             throw FatalError("Could not create CUBE report!");
         }
+        open_writers(data);
         #pragma omp master
         {
             // Write static definition data
@@ -178,6 +181,7 @@ ReportWriterTask::execute()
 
         // Collate severity data
         mAnalyzer->genCubeSeverities(data, mRank);
+        close_writers(data);
 
         // Clean up
         #pragma omp master
@@ -201,15 +205,139 @@ ReportWriterTask::execute()
         {
             throw FatalError("Could not create CUBE report!");
         }
+        open_writers(data);
 
         // Collate severity data
         mAnalyzer->genCubeSeverities(data, mRank);
+        close_writers(data);
     }
 
     return true;
 }
 
 
+// --- Parallel report writing ----------------------------------------------
+
+/**
+ *  @brief Opens the report file on the aggregator ranks.
+ *
+ *  Opens the CUBE report file created by rank 0 for writing on each
+ *  aggregator rank if parallel report writing has been requested.  If the
+ *  file could not be opened on any of the aggregators, parallel report
+ *  writing is disabled on all ranks and the severities are collated on
+ *  rank 0 instead.  Has to be called by all threads of all ranks.
+ *
+ *  @param data
+ *      Report data structure
+ **/
+void
+ReportWriterTask::open_writers(ReportData& data) const
+{
+    if (data.mWriterStride == 0)
+    {
+        return;
+    }
+
+    // This variable is implicitly shared!
+    static int error = 0;
+
+    #pragma omp master
+    {
+        #if defined(_MPI)
+            error = 0;
+            if (data.mAggregatorComm != MPI_COMM_NULL)
+            {
+                const string filename = mDirname + "/" OUTPUT_FILENAME ".cubex";
+
+                // Rows are written collectively as non-overlapping segments,
+                // so no data sieving (read-modify-write) is required
+                MPI_Info info;
+                MPI_Info_create(&info);
+                MPI_Info_set(info, const_cast< char* >("romio_ds_write"),
+                             const_cast< char* >("disable"));
+                if (MPI_File_open(data.mAggregatorComm,
+                                  const_cast< char* >(filename.c_str()),
+                                  MPI_MODE_WRONLY, info, &data.mWriterFile)
+                    != MPI_SUCCESS)
+                {
+                    data.mWriterFile = MPI_FILE_NULL;
+                    error            = 1;
+                }
+                MPI_Info_free(&info);
+            }
+            MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        #endif    // _MPI
+    }
+    {
+        // FCCpx requires block
+        #pragma omp barrier
+    }
+    if (error)
+    {
+        LogMsg(0,
+               "Could not open report file for parallel writing.\n"
+               "   Collating report data on rank 0 instead.\n\n");
+
+        // No global batch buffer available => fall back to per-callpath
+        data.mWriterStride = 0;
+        data.mBatchSize    = 0;
+    }
+}
+
+
+/**
+ *  @brief Closes the report file on the aggregator ranks.
+ *
+ *  Flushes and closes the CUBE report file on each aggregator rank if
+ *  parallel report writing is active, and waits until all aggregators are
+ *  done before rank 0 finalizes the report.  Has to be called by all
+ *  threads of all ranks.
+ *
+ *  @param data
+ *      Report data structure
+ *
+ *  @throw  pearl::FatalError  if flushing or closing the report file failed
+ *                             on any aggregator.
+ **/
+void
+ReportWriterTask::close_writers(ReportData& data) const
+{
+    if (data.mWriterStride == 0)
+    {
+        return;
+    }
+
+    // This variable is implicitly shared!
+    static int error = 0;
+
+    #pragma omp master
+    {
+        #if defined(_MPI)
+            error = 0;
+            if (data.mWriterFile != MPI_FILE_NULL)
+            {
+                if (MPI_File_close(&data.mWriterFile) != MPI_SUCCESS)
+                {
+                    error = 1;
+                }
+            }
+
+            // Also acts as barrier: rank 0 must not write the trailer before
+            // all partial rows have reached the file
+            MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+        #endif    // _MPI
+    }
+    {
+        // FCCpx requires block
+        #pragma omp barrier
+    }
+    if (error)
+    {
+        throw FatalError("Could not write CUBE report!");
+    }
+}
+
+
 // --- Report data generation -----------------------------------------------
 
 /**
@@ -102,6 +102,18 @@ class ReportWriterTask
         /// @}
 
 
+        /// @name Parallel report writing
+        /// @{
+
+        void
+        open_writers(ReportData& data) const;
+
+        void
+        close_writers(ReportData& data) const;
+
+        /// @}
+
+
         /// Shared task data object
         const TaskDataShared& mSharedData;
 
@@ -24,6 +24,7 @@
 
 #include "Logging.h"
 #include "TaskData.h"
+#include "TraceSegments.h"
 #include "epk_memory.h"
 #include "user_events.h"
 
@@ -129,7 +130,9 @@ StatisticsTask::execute()
     // Calculate event statistics
     #pragma omp critical
     {
-        num_events += mPrivateData.mTrace->size();
+        num_events += mPrivateData.mSegments
+                      ? mPrivateData.mSegments->numEvents()
+                      : mPrivateData.mTrace->size();
     }
     #pragma omp barrier
     #pragma omp master
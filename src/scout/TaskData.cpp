@@ -24,6 +24,8 @@
 #include <pearl/LocalTrace.h>
 #include <pearl/TraceArchive.h>
 
+#include "TraceSegments.h"
+
 using namespace std;
 using namespace pearl;
 using namespace scout;
@@ -62,6 +64,7 @@ TaskDataShared::~TaskDataShared()
 TaskDataPrivate::TaskDataPrivate()
     : mIdMaps(NULL),
       mTrace(NULL),
+      mSegments(NULL),
       mSynchronizer(NULL)
 {
 }
@@ -69,5 +72,6 @@ TaskDataPrivate::TaskDataPrivate()
 
 TaskDataPrivate::~TaskDataPrivate()
 {
+    delete mSegments;
     delete mTrace;
 }
@@ -44,6 +44,12 @@ class TraceArchive;
 }    // namespace pearl
 
 
+namespace scout
+{
+class TraceSegments;
+}    // namespace scout
+
+
 namespace scout
 {
 /*-------------------------------------------------------------------------*/
@@ -137,6 +143,10 @@ struct TaskDataPrivate
     /// Local trace data object
     pearl::LocalTrace* mTrace;
 
+    /// Trace segment partitioning; only used if the trace is analyzed in
+    /// segments
+    TraceSegments* mSegments;
+
     /// Timestamp synchronization object
     Synchronizer* mSynchronizer;
 };
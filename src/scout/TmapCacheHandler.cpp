@@ -18,6 +18,8 @@
 
 #include "TmapCacheHandler.h"
 
+#include <algorithm>
+
 #include <pearl/CallbackManager.h>
 #include <pearl/Event.h>
 #include <pearl/EventSet.h>
@@ -61,9 +63,33 @@ struct TmapCacheHandler::TmapCHImpl
         tmapcache_map_t;
 
 
+    // Cache entries of a single call path: positions of the entries in the
+    // cache, and checkpoints of the accumulated time of the entries
+    // preceding every CHECKPOINT_STRIDE-th entry (starting with 0.0)
+    struct cnode_entries_t
+    {
+        vector< uint32_t > positions;
+        vector< double >   checkpoints;
+    };
+
+
+    // Ranges spanning less than this many cache entries per cached call
+    // path are summed up directly rather than using the checkpoints
+    static const tmapcache_vec_t::size_type SCAN_FACTOR = 8;
+
+    // Number of entries per call path between two checkpoints
+    static const uint32_t CHECKPOINT_STRIDE = 8;
+
+
     tmapcache_map_t mCacheIndices;
     tmapcache_vec_t mCache;
 
+    // Per-call-path cache entries (indexed by call path ID), and the IDs of
+    // all call paths with cache entries.  This adds about 5 bytes per cache
+    // entry on top of the 16 bytes of the entry itself.
+    vector< cnode_entries_t >  mEntries;
+    vector< Callpath::IdType > mCachedCnodes;
+
     timemap_t mTmap;
 
     double mLaststamp;
@@ -118,9 +144,62 @@ struct TmapCacheHandler::TmapCHImpl
 
         timemap_t tmap;
 
-        for (tmapcache_vec_t::const_iterator it = begin; it != end; ++it)
+        // Short ranges: sum up cache entries directly
+        if (  static_cast< tmapcache_vec_t::size_type >(end - begin)
+            < (SCAN_FACTOR * mCachedCnodes.size()))
         {
-            tmap[it->id] += it->time;
+            for (tmapcache_vec_t::const_iterator it = begin; it != end; ++it)
+            {
+                tmap[it->id] += it->time;
+            }
+
+            return tmap;
+        }
+
+        // Long ranges: determine per-call-path sums from the partial sums
+        // S(n) of the first n entries of each call path.  As all times are
+        // non-negative, the difference S(hi) - S(lo) has an absolute error
+        // of at most about (hi + 1) * DBL_EPSILON * S(hi), compared to
+        // (hi - lo) * DBL_EPSILON * (S(hi) - S(lo)) for direct summation;
+        // i.e., the relative error additionally grows with the ratio
+        // S(hi) / (S(hi) - S(lo)).  Ranges starting at the beginning of the
+        // cache or covering at most CHECKPOINT_STRIDE entries of a call path
+        // are summed up in the same order as above and are bit-identical.
+        const uint32_t first = begin - mCache.begin();
+        const uint32_t last  = end - mCache.begin();
+        for (vector< Callpath::IdType >::const_iterator it = mCachedCnodes.begin();
+             it != mCachedCnodes.end();
+             ++it)
+        {
+            const cnode_entries_t& entries = mEntries[*it];
+
+            const uint32_t lo = lower_bound(entries.positions.begin(),
+                                            entries.positions.end(),
+                                            first)
+                                - entries.positions.begin();
+            const uint32_t hi = lower_bound(entries.positions.begin() + lo,
+                                            entries.positions.end(),
+                                            last)
+                                - entries.positions.begin();
+            if (lo == hi)
+            {
+                continue;
+            }
+
+            double time;
+            if ((hi - lo) <= CHECKPOINT_STRIDE)
+            {
+                time = sum_entries(entries, lo, hi, 0.0);
+            }
+            else if (lo == 0)
+            {
+                time = partial_sum(entries, hi);
+            }
+            else
+            {
+                time = partial_sum(entries, hi) - partial_sum(entries, lo);
+            }
+            tmap[*it] += time;
         }
 
         return tmap;
@@ -130,6 +209,70 @@ struct TmapCacheHandler::TmapCHImpl
     // --- helper functions
     //
 
+    double
+    sum_entries(const cnode_entries_t& entries,
+                uint32_t               lo,
+                uint32_t               hi,
+                double                 time) const
+    {
+        for (uint32_t i = lo; i < hi; ++i)
+        {
+            time += mCache[entries.positions[i]].time;
+        }
+
+        return time;
+    }
+
+    // Accumulated time of the first @a count entries of a call path
+    double
+    partial_sum(const cnode_entries_t& entries,
+                uint32_t               count) const
+    {
+        const uint32_t index = count / CHECKPOINT_STRIDE;
+
+        return sum_entries(entries,
+                           index * CHECKPOINT_STRIDE,
+                           count,
+                           entries.checkpoints[index]);
+    }
+
+    void
+    append_entry(Callpath::IdType id,
+                 double           time)
+    {
+        // --- update per-call-path entries
+
+        if (id >= mEntries.size())
+        {
+            mEntries.resize(id + 1);
+        }
+
+        cnode_entries_t& entries = mEntries[id];
+        if (entries.positions.empty())
+        {
+            mCachedCnodes.push_back(id);
+            entries.checkpoints.push_back(0.0);
+        }
+
+        // --- update cache
+
+        cnode_time_t e = { id, time };
+
+        entries.positions.push_back(mCache.size());
+        mCache.push_back(e);
+
+        // --- add checkpoint after every CHECKPOINT_STRIDE-th entry
+
+        const uint32_t count = entries.positions.size();
+        if ((count % CHECKPOINT_STRIDE) == 0)
+        {
+            entries.checkpoints.push_back(sum_entries(entries,
+                                                      count - CHECKPOINT_STRIDE,
+                                                      count,
+                                                      entries.checkpoints.back()));
+        }
+    }
+
     void
     save_synchpoint(const Event& event)
     {
@@ -139,9 +282,7 @@ struct TmapCacheHandler::TmapCHImpl
              it != mTmap.end();
              ++it)
         {
-            cnode_time_t e = { it->first, it->second };
-
-            mCache.push_back(e);
+            append_entry(it->first, it->second);
         }
 
         mCacheIndices.insert(std::make_pair(event, mCache.size()));
@@ -266,9 +407,7 @@ struct TmapCacheHandler::TmapCHImpl
              it != mTmap.end();
              ++it)
         {
-            cnode_time_t e = { it->first, it->second };
-
-            mCache.push_back(e);
+            append_entry(it->first, it->second);
         }
     }
 
@@ -0,0 +1,516 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "TraceSegments.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <exception>
+#include <map>
+#include <string>
+
+#include <pearl/Error.h>
+#include <pearl/Event.h>
+#include <pearl/Event_rep.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/MpiCollEnd_rep.h>
+#include <pearl/Region.h>
+#include <pearl/TraceArchive.h>
+#include <pearl/pearl.h>
+
+#if defined(_MPI)
+    #include <mpi.h>
+
+    #include <pearl/MpiComm.h>
+#endif    // _MPI
+
+using namespace std;
+using namespace pearl;
+using namespace scout;
+
+
+// --- Local constants & helpers --------------------------------------------
+
+namespace
+{
+/// Minimum number of events read per chunk during the prescan
+const uint64_t MIN_CHUNK_EVENTS = 4096;
+
+#if !defined(_MPI)
+    /// Granularity (in events) at which possible segment boundaries are
+    /// kept during the prescan
+    const uint64_t CANDIDATE_BLOCK = 1024;
+#endif    // !_MPI
+
+
+/// Possible segment boundary found during the prescan
+struct CutPoint
+{
+    /// Position of the first event following the boundary
+    uint64_t position;
+
+    /// Communicator of the MPI collective operation preceding the boundary
+    int64_t commId;
+
+    /// Number of messages sent minus number of messages received so far
+    int64_t balance;
+
+    /// Flag indicating whether the boundary is locally admissible
+    bool eligible;
+};
+
+
+#if defined(_MPI)
+    /// @brief Check for synchronizing MPI collective operations.
+    ///
+    /// Returns whether the given MPI collective operation @p event involves
+    /// all processes and cannot complete on any process before all
+    /// processes have entered it.
+    ///
+    /// @param event
+    ///     MPI collective end event
+    /// @param worldSize
+    ///     Number of processes
+    /// @returns
+    ///     True if the collective operation is synchronizing, false otherwise
+    ///
+    bool
+    isSynchronizing(const MpiCollEnd_rep& event,
+                    const uint32_t        worldSize)
+    {
+        if (event.getComm()->getSize() != worldSize)
+        {
+            return false;
+        }
+
+        switch (event.getCollType())
+        {
+            case MpiCollEnd_rep::BARRIER:
+                return true;
+
+            case MpiCollEnd_rep::ALLGATHER:
+            case MpiCollEnd_rep::ALLTOALL:
+            case MpiCollEnd_rep::ALLREDUCE:
+                return (event.getBytesSent() > 0);
+
+            default:
+                break;
+        }
+
+        return false;
+    }
+#endif    // _MPI
+
+
+/// Bookkeeping of the prescan, collecting possible segment boundaries
+class Prescan
+{
+    public:
+        Prescan(const Region& flushRegion)
+            : mFlushRegion(flushRegion),
+              mFlushTime(-DBL_MAX),
+              mBalance(0),
+              mCollEnd(0),
+              mWorldSize(1)
+        {
+            #if defined(_MPI)
+                int size;
+                MPI_Comm_size(MPI_COMM_WORLD, &size);
+                mWorldSize = size;
+            #endif    // _MPI
+        }
+
+        void
+        examine(const Event_rep& event,
+                uint64_t         position);
+
+        /// Possible segment boundaries
+        vector< CutPoint > mCuts;
+
+
+    private:
+        /// Buffer flush region
+        const Region& mFlushRegion;
+
+        /// Pending nonblocking requests, mapped to a send request flag
+        map< uint64_t, bool > mRequests;
+
+        /// Latest timestamp of a buffer flush event
+        timestamp_t mFlushTime;
+
+        /// Number of messages sent minus number of messages received
+        int64_t mBalance;
+
+        /// Synchronizing MPI collective end event preceding the current event
+        const MpiCollEnd_rep* mCollEnd;
+
+        /// Number of processes
+        uint32_t mWorldSize;
+};
+
+
+/// @brief Examine an event.
+///
+/// Updates the prescan state with the given @p event, which has to be
+/// examined in the order the events are read, and records a possible
+/// segment boundary after it if applicable.
+///
+/// @param event
+///     Event representation
+/// @param position
+///     Event position
+///
+/// @throws pearl::FatalError
+///     on threading or RMA events
+///
+void
+Prescan::examine(const Event_rep& event,
+                 const uint64_t   position)
+{
+    const event_t type = event.getType();
+    if (  ((type >= THREAD_ACQUIRE_LOCK) && (type <= THREAD_TEAM_END))
+       || ((type >= RMA_PUT_START) && (type <= MPI_RMA_UNLOCK)))
+    {
+        throw FatalError("Analyzing traces with threading or RMA events in "
+                         "segments is not supported!");
+    }
+
+    const MpiCollEnd_rep* const collEnd = mCollEnd;
+    mCollEnd = 0;
+
+    if (event.isOfType(GROUP_ENTER))
+    {
+        if (event.getRegion() == mFlushRegion)
+        {
+            mFlushTime = max(mFlushTime, event.getTimestamp());
+        }
+    }
+    else if (event.isOfType(GROUP_LEAVE))
+    {
+        if (event.getRegion() == mFlushRegion)
+        {
+            mFlushTime = max(mFlushTime, event.getTimestamp());
+        }
+
+        // Segments may only end after all buffer flushes and nonblocking
+        // requests issued so far
+        CutPoint cut;
+        cut.position = position + 1;
+        cut.commId   = 0;
+        cut.balance  = mBalance;
+        cut.eligible = (  mRequests.empty()
+                       && (event.getTimestamp() > mFlushTime));
+
+        #if defined(_MPI)
+            // All processes need to know the same candidates, i.e., the
+            // LEAVE events of the synchronizing collective operations
+            if (collEnd)
+            {
+                cut.commId = collEnd->getComm()->getId();
+                mCuts.push_back(cut);
+            }
+        #else    // !_MPI
+            // Keep only the last candidate per block
+            if (cut.eligible && (cut.balance == 0))
+            {
+                if (  !mCuts.empty()
+                   && (  (mCuts.back().position / CANDIDATE_BLOCK)
+                      == (cut.position / CANDIDATE_BLOCK)))
+                {
+                    mCuts.back() = cut;
+                }
+                else
+                {
+                    mCuts.push_back(cut);
+                }
+            }
+        #endif    // !_MPI
+    }
+    else if (type == MPI_COLLECTIVE_END)
+    {
+        #if defined(_MPI)
+            const MpiCollEnd_rep& coll =
+                static_cast< const MpiCollEnd_rep& >(event);
+            if (isSynchronizing(coll, mWorldSize))
+            {
+                mCollEnd = &coll;
+            }
+        #endif    // _MPI
+    }
+    else if (type == MPI_CANCELLED)
+    {
+        map< uint64_t, bool >::iterator it =
+            mRequests.find(event.getRequestId());
+        if (it != mRequests.end())
+        {
+            if (it->second)
+            {
+                --mBalance;
+            }
+            mRequests.erase(it);
+        }
+    }
+    else
+    {
+        if (event.isOfType(GROUP_SEND))
+        {
+            ++mBalance;
+        }
+        else if (event.isOfType(GROUP_RECV))
+        {
+            --mBalance;
+        }
+
+        if (  (type == MPI_SEND_REQUEST)
+           || (type == MPI_RECV_REQUEST))
+        {
+            mRequests[event.getRequestId()] = (type == MPI_SEND_REQUEST);
+        }
+        else if (  (type == MPI_SEND_COMPLETE)
+                || (type == MPI_RECV_COMPLETE))
+        {
+            mRequests.erase(event.getRequestId());
+        }
+    }
+}
+}    // unnamed namespace
+
+
+// --- Constructors & destructor --------------------------------------------
+
+TraceSegments::TraceSegments(TraceArchive& archive,
+                             GlobalDefs&   defs,
+                             LocalTrace&   trace)
+    : mArchive(archive),
+      mDefinitions(defs),
+      mTrace(trace),
+      mCurrent(0),
+      mNumEvents(0)
+{
+}
+
+
+// --- Segment handling -----------------------------------------------------
+
+void
+TraceSegments::determine(const size_t maxMemory)
+{
+    Prescan                    prescan(mDefinitions.getFlushingRegion());
+    vector< const Event_rep* > readOrder;
+    uint64_t                   bytesPerEvent = 1;
+    uint32_t                   largestChunk  = 0;
+
+    // Scan the trace chunk by chunk; each chunk is also verified to
+    // complete the local call tree before it is unified.  Errors are only
+    // reported after the following collective operations.
+    string error;
+    try
+    {
+        while (true)
+        {
+            // Verification may reorder buffer flush events, whereas segment
+            // boundaries refer to the order in which events are read
+            const uint32_t numCarried = mTrace.num_carried();
+            readOrder.clear();
+            for (uint32_t index = numCarried; index < mTrace.size(); ++index)
+            {
+                readOrder.push_back(&*mTrace.at(index));
+            }
+
+            PEARL_verify_calltree(mDefinitions, mTrace);
+
+            const uint64_t chunkBegin = mTrace.segment_begin();
+            for (size_t index = 0; index < readOrder.size(); ++index)
+            {
+                prescan.examine(*readOrder[index], chunkBegin + index);
+            }
+
+            // Estimate the memory per event from the largest chunk, as the
+            // arena allocates memory in large slabs; also account for the
+            // ENTER/LEAVE matching index built during preprocessing
+            if ((mTrace.size() > 0) && (mTrace.size() >= largestChunk))
+            {
+                largestChunk  = mTrace.size();
+                bytesPerEvent = max< uint64_t >(1, mTrace.memory_usage()
+                                                   / mTrace.size())
+                                + 2 * sizeof(uint32_t);
+            }
+
+            if (!mTrace.is_partial())
+            {
+                break;
+            }
+            mArchive.readTraceSegment(mTrace,
+                                      mTrace.segment_end(),
+                                      max(MIN_CHUNK_EVENTS,
+                                          maxMemory / bytesPerEvent));
+        }
+    }
+    catch (const exception& ex)
+    {
+        error = ex.what();
+    }
+    mNumEvents = mTrace.segment_end();
+
+    // Determine segment boundaries valid on all processes
+    const vector< CutPoint >& cuts = prescan.mCuts;
+    vector< uint64_t >        candidates;
+    #if defined(_MPI)
+        int64_t numCuts[3] = { static_cast< int64_t >(cuts.size()),
+                               -static_cast< int64_t >(cuts.size()),
+                               error.empty() ? 0 : -1 };
+        MPI_Allreduce(MPI_IN_PLACE, numCuts, 3, SCALASCA_MPI_INT64_T,
+                      MPI_MIN, MPI_COMM_WORLD);
+        if (numCuts[2] < 0)
+        {
+            throw FatalError(error.empty()
+                             ? "Prescan of the trace failed on another process!"
+                             : error);
+        }
+        if (numCuts[0] != -numCuts[1])
+        {
+            throw FatalError("Mismatching MPI collective operations on "
+                             "MPI_COMM_WORLD-sized communicators!");
+        }
+
+        if (!cuts.empty())
+        {
+            vector< int64_t > keys;
+            vector< int64_t > balances;
+            keys.reserve(3 * cuts.size());
+            balances.reserve(cuts.size());
+            for (vector< CutPoint >::const_iterator it = cuts.begin();
+                 it != cuts.end();
+                 ++it)
+            {
+                keys.push_back(it->commId);
+                keys.push_back(-it->commId);
+                keys.push_back((it->eligible && (it->position < mNumEvents))
+                               ? 1 : 0);
+                balances.push_back(it->balance);
+            }
+            MPI_Allreduce(MPI_IN_PLACE, &keys[0], keys.size(),
+                          SCALASCA_MPI_INT64_T, MPI_MIN, MPI_COMM_WORLD);
+            MPI_Allreduce(MPI_IN_PLACE, &balances[0], balances.size(),
+                          SCALASCA_MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+
+            // A boundary is valid if it follows the same collective operation
+            // on all processes, and all messages sent before have also been
+            // received before
+            for (size_t i = 0; i < cuts.size(); ++i)
+            {
+                if (  (keys[3 * i] == -keys[3 * i + 1])
+                   && (keys[3 * i + 2] == 1)
+                   && (balances[i] == 0))
+                {
+                    candidates.push_back(cuts[i].position);
+                }
+            }
+        }
+    #else    // !_MPI
+        if (!error.empty())
+        {
+            throw FatalError(error);
+        }
+        for (vector< CutPoint >::const_iterator it = cuts.begin();
+             it != cuts.end();
+             ++it)
+        {
+            if (it->position < mNumEvents)
+            {
+                candidates.push_back(it->position);
+            }
+        }
+    #endif    // !_MPI
+
+    // Greedily choose the farthest boundary within the memory budget; if
+    // there is none, the segment extends to the next valid boundary
+    const uint64_t budget        = max< uint64_t >(1, maxMemory / bytesPerEvent);
+    const uint64_t numCandidates = candidates.size();
+    uint64_t       next          = 0;
+    mBounds.clear();
+    mBounds.push_back(0);
+    while (true)
+    {
+        const uint64_t begin  = mBounds.back();
+        uint64_t       choice = numCandidates;
+        if (mNumEvents - begin > budget)
+        {
+            choice = next;
+            while (  (choice + 1 < numCandidates)
+                  && (candidates[choice + 1] - begin <= budget))
+            {
+                ++choice;
+            }
+        }
+        #if defined(_MPI)
+            MPI_Allreduce(MPI_IN_PLACE, &choice, 1, SCALASCA_MPI_UINT64_T,
+                          MPI_MIN, MPI_COMM_WORLD);
+        #endif    // _MPI
+
+        if (choice == numCandidates)
+        {
+            mBounds.push_back(mNumEvents);
+            break;
+        }
+        mBounds.push_back(candidates[choice]);
+        next = choice + 1;
+    }
+
+    // Leave the raw events of the first segment for the regular
+    // preprocessing
+    mArchive.readTraceSegment(mTrace, 0, mBounds[1]);
+    mCurrent = 0;
+}
+
+
+uint32_t
+TraceSegments::numSegments() const
+{
+    return mBounds.empty() ? 0 : (mBounds.size() - 1);
+}
+
+
+uint64_t
+TraceSegments::numEvents() const
+{
+    return mNumEvents;
+}
+
+
+void
+TraceSegments::load(const uint32_t index)
+{
+    assert(index < numSegments());
+
+    if (index == mCurrent)
+    {
+        return;
+    }
+
+    const uint64_t begin = mBounds[index];
+    const uint64_t end   = mBounds[index + 1];
+    mArchive.readTraceSegment(mTrace, begin, end - begin);
+    if (mTrace.segment_end() != end)
+    {
+        throw FatalError("Trace segment does not match the boundaries "
+                         "determined by the prescan!");
+    }
+    mCurrent = index;
+
+    PEARL_verify_calltree(mDefinitions, mTrace);
+    PEARL_preprocess_trace(mDefinitions, mTrace);
+}
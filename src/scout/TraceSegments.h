@@ -0,0 +1,168 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_TRACESEGMENTS_H
+#define SCOUT_TRACESEGMENTS_H
+
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <vector>
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  TraceSegments.h
+ *  @brief Declaration of the class TraceSegments.
+ *
+ *  This header file provides the declaration of the class TraceSegments,
+ *  which partitions the event trace of a process into segments that can
+ *  be analyzed one after another.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+// --- Forward declarations -------------------------------------------------
+
+namespace pearl
+{
+class GlobalDefs;
+class LocalTrace;
+class TraceArchive;
+}    // namespace pearl
+
+
+namespace scout
+{
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class TraceSegments
+ *  @brief Partitioning of the local event trace into replay segments.
+ *
+ *  The TraceSegments class manages the analysis of event traces that do
+ *  not fit into memory as a whole.  A prescan of the trace determines the
+ *  segment boundaries such that the memory needed for each segment stays
+ *  within a given limit where possible, and that each segment can be
+ *  replayed on its own: segments only end right after world-wide
+ *  synchronizing MPI collective operations at which no point-to-point
+ *  message or nonblocking request is in flight on any process.  All
+ *  processes therefore use the same number of segments, which are then
+ *  loaded (and reloaded for backward replays) in lock-step.
+ *
+ *  Only a single location per process is supported, and traces with RMA
+ *  or threading events are rejected.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class TraceSegments
+{
+    public:
+        /// @name Constructors & destructor
+        /// @{
+
+        /// @brief Constructor.
+        ///
+        /// Creates a new instance for the given @p trace, which has to be
+        /// created by pearl::TraceArchive::getTraceSegment() for @p archive
+        /// and hold its first segment.
+        ///
+        /// @param archive
+        ///     Experiment archive
+        /// @param defs
+        ///     Global definitions object
+        /// @param trace
+        ///     Local trace data object
+        ///
+        TraceSegments(pearl::TraceArchive& archive,
+                      pearl::GlobalDefs&   defs,
+                      pearl::LocalTrace&   trace);
+
+        /// @}
+        /// @name Segment handling
+        /// @{
+
+        /// @brief Determine the segment boundaries.
+        ///
+        /// Scans the entire event trace in chunks to complete the global
+        /// call tree and to determine the segment boundaries, and leaves the
+        /// (unprocessed) events of the first segment in the trace object.
+        /// This is a collective operation in MPI builds.
+        ///
+        /// @param maxMemory
+        ///     Upper bound (in bytes) for the memory of a single segment
+        ///
+        /// @throws pearl::FatalError
+        ///     if the trace contains unsupported events or the collective
+        ///     operations do not match across processes
+        ///
+        void
+        determine(size_t maxMemory);
+
+        /// @brief Get number of segments.
+        ///
+        /// @returns
+        ///     Number of segments
+        ///
+        uint32_t
+        numSegments() const;
+
+        /// @brief Get number of events.
+        ///
+        /// @returns
+        ///     Total number of events in the local trace
+        ///
+        uint64_t
+        numEvents() const;
+
+        /// @brief Load a segment.
+        ///
+        /// Replaces the contents of the trace object by the events of the
+        /// segment with the given @p index and prepares them for replay.
+        /// Does nothing if the segment is already loaded.
+        ///
+        /// @param index
+        ///     Segment index
+        ///
+        /// @throws pearl::FatalError
+        ///     if the segment read does not match the expected boundaries
+        ///
+        void
+        load(uint32_t index);
+
+        /// @}
+
+
+    private:
+        /// Experiment archive
+        pearl::TraceArchive& mArchive;
+
+        /// Global definitions object
+        pearl::GlobalDefs& mDefinitions;
+
+        /// Local trace data object
+        pearl::LocalTrace& mTrace;
+
+        /// Event positions of the segment boundaries, including the end
+        /// of the trace
+        std::vector< uint64_t > mBounds;
+
+        /// Index of the currently loaded segment
+        uint32_t mCurrent;
+
+        /// Total number of events
+        uint64_t mNumEvents;
+};
+}    // namespace scout
+
+
+#endif    // !SCOUT_TRACESEGMENTS_H
@@ -83,6 +83,12 @@ class fixed_priority_map
             return count;
         }
 
+        static int
+        max_size()
+        {
+            return maxsize;
+        }
+
         bool
         is_empty() const
         {
@@ -119,6 +125,29 @@ class fixed_priority_map
             count = 0;
         }
 
+        // Appends a new element whose key is larger than all keys currently
+        // stored, thus avoiding the search and element shifting of
+        // operator[].  Falls back to operator[] otherwise (or if the map is
+        // full), i.e., the resulting map is the same in either case.
+        void
+        append(const key_type&    key,
+               const mapped_type& value)
+        {
+            purge();
+
+            if (  (count == maxsize)
+               || (  (count > 0)
+                  && !KeyCmp()(array[count - 1].first, key)))
+            {
+                (*this)[key] = value;
+
+                return;
+            }
+
+            array[count] = std::make_pair(key, value);
+            ++count;
+        }
+
         mapped_type&
         operator[](const key_type& key)
         {
@@ -18,8 +18,11 @@
 
 #include <unistd.h>
 
+#include <cctype>
+#include <cerrno>
 #include <climits>
 #include <cstdlib>
+#include <limits>
 #include <sstream>
 
 #include <pearl/CompoundTask.h>
@@ -82,6 +85,10 @@ int mpiRank = 0;
 
     /// Flag indicating whether MPI has been finalized
     bool finalized = false;
+
+    /// Flag indicating whether the global definitions should only be read
+    /// by rank 0 and broadcast to all other ranks
+    bool singleReader = false;
 #endif // _MPI
 }      // unnamed namespace
 
@@ -109,6 +116,19 @@ bool enableAsynchronous = false;
 /// Flag indicating whether only a single-pass replay should be used
 bool enableSinglePass = false;
 
+/// Size limit (in bytes) of the buffer used for collating severities of
+/// multiple call paths in a single collective operation; zero selects
+/// per-callpath collation
+size_t reportBatchBytes = 16 * 1024 * 1024;
+
+/// Number of aggregator ranks writing the report in parallel; zero selects
+/// central writing on rank 0
+uint32_t reportWriters = 0;
+
+/// Upper bound (in bytes) for the per-process memory used for the event
+/// trace data; zero reads the trace at once
+size_t maxTraceMemory = 0;
+
 
 // --- Function prototypes --------------------------------------------------
 
@@ -324,6 +344,47 @@ ProcessArguments(int    argc,
                    "   Critical-path and root-cause analysis will be disabled.\n"
                    "   Late-receiver wait states can not be detected.\n\n");
         }
+        else if (arg.compare(0, 15, "--report-batch=") == 0)
+        {
+            const char* value = arg.c_str() + 15;
+            char*       end;
+
+            // strtoul() silently negates values with a leading minus sign,
+            // thus only plain digit sequences are accepted
+            errno = 0;
+            const unsigned long size = strtoul(value, &end, 10);
+            if (  !isdigit(static_cast< unsigned char >(*value))
+               || (*end != '\0')
+               || (errno == ERANGE)
+               || (size > numeric_limits< size_t >::max() / (1024 * 1024)))
+            {
+                LogMsg(0, "Invalid argument for option '--report-batch'.\n\n");
+                Usage(argv[0]);
+                error = true;
+                break;
+            }
+            reportBatchBytes = static_cast< size_t >(size) * 1024 * 1024;
+        }
+        else if (arg.compare(0, 19, "--max-trace-memory=") == 0)
+        {
+            const char* value = arg.c_str() + 19;
+            char*       end;
+
+            // See '--report-batch' above
+            errno = 0;
+            const unsigned long size = strtoul(value, &end, 10);
+            if (  !isdigit(static_cast< unsigned char >(*value))
+               || (*end != '\0')
+               || (errno == ERANGE)
+               || (size > numeric_limits< size_t >::max() / (1024 * 1024)))
+            {
+                LogMsg(0, "Invalid argument for option '--max-trace-memory'.\n\n");
+                Usage(argv[0]);
+                error = true;
+                break;
+            }
+            maxTraceMemory = static_cast< size_t >(size) * 1024 * 1024;
+        }
 
         // MPI-specific options
         #if defined(_MPI)
@@ -335,6 +396,26 @@ ProcessArguments(int    argc,
             {
                 synchronize = false;
             }
+            else if (arg.compare(0, 17, "--report-writers=") == 0)
+            {
+                const char* value = arg.c_str() + 17;
+                char*       end;
+
+                const unsigned long writers = strtoul(value, &end, 10);
+                if (  (*value == '\0')
+                   || (*end != '\0'))
+                {
+                    LogMsg(0, "Invalid argument for option '--report-writers'.\n\n");
+                    Usage(argv[0]);
+                    error = true;
+                    break;
+                }
+                reportWriters = writers;
+            }
+            else if (arg == "--single-reader")
+            {
+                singleReader = true;
+            }
         #endif    // _MPI
 
         // Unknown option
@@ -342,7 +423,9 @@ ProcessArguments(int    argc,
         {
             #if !defined(_MPI)
                 if (  (arg == "--time-correct")
-                   || (arg == "--no-time-correct"))
+                   || (arg == "--no-time-correct")
+                   || (arg.compare(0, 17, "--report-writers=") == 0)
+                   || (arg == "--single-reader"))
                 {
                     LogMsg(0,
                            "Ignoring command-line option '%s': not supported.\n\n",
@@ -371,6 +454,27 @@ ProcessArguments(int    argc,
         enableDelayAnalysis = false;
     }
 
+    // Analyses that need the entire trace at once are not available when
+    // replaying it in segments
+    if (maxTraceMemory > 0)
+    {
+        enableStatistics    = false;
+        enableCriticalPath  = false;
+        enableDelayAnalysis = false;
+        LogMsg(0,
+               "Analyzing trace data in segments.\n"
+               "   Statistics, critical-path and root-cause analysis will be disabled.\n\n");
+
+        #if defined(_MPI)
+            if (synchronize)
+            {
+                LogMsg(0, "Option '--time-correct' cannot be combined with"
+                          " '--max-trace-memory'.\n\n");
+                error = true;
+            }
+        #endif    // _MPI
+    }
+
     // Treat first remaining argument as experiment archive name
     anchorName = argv[index - 1];
 
@@ -406,9 +510,22 @@ Usage(const char* command)
            "  --rootcause        Enables root-cause analysis [default]\n"
            "  --no-rootcause     Disables root-cause analysis\n"
            "  --single-pass      Single-pass forward analysis only\n"
+           "  --report-batch=<MB>\n"
+           "                     Collates report data in batches using a buffer\n"
+           "                     of at most <MB> MiB (0 = per call path) [16]\n"
+           "  --max-trace-memory=<MB>\n"
+           "                     Analyzes the trace in segments using at most\n"
+           "                     about <MB> MiB of trace data per process;\n"
+           "                     disables statistics, critical-path and root-\n"
+           "                     cause analysis (0 = entire trace) [0]\n"
            #if defined(_MPI)
                "  --time-correct     Enables enhanced timestamp correction\n"
                "  --no-time-correct  Disables enhanced timestamp correction [default]\n"
+               "  --report-writers=<N>\n"
+               "                     Writes the report in parallel using <N>\n"
+               "                     aggregator ranks (0 = rank 0 only) [0]\n"
+               "  --single-reader    Reads definitions on rank 0 only and broadcasts\n"
+               "                     them to all other ranks\n"
            #endif    // _MPI
            "  --verbose, -v      Increase verbosity\n"
            "  --help             Display this information and exit\n\n",
@@ -443,8 +560,12 @@ ReadDefinitions(TaskDataShared& sharedData)
 
     // Set up definition reading phase
     ReadDefinitionsTask* reader;
-    phase  = new TimedPhase("Reading definition data   ");
-    reader = new ReadDefinitionsTask(sharedData);
+    phase = new TimedPhase("Reading definition data   ");
+    #if defined(_MPI)
+        reader = new ReadDefinitionsTask(sharedData, singleReader);
+    #else    // !_MPI
+        reader = new ReadDefinitionsTask(sharedData);
+    #endif    // !_MPI
     phase->add_task(CheckedTask::make_checked(reader));
     prep.add_task(phase);
 
@@ -454,6 +575,18 @@ ReadDefinitions(TaskDataShared& sharedData)
         return true;
     }
 
+    // Display timing breakdown of definition reading phase
+    #if defined(_MPI)
+        if (singleReader)
+        {
+            LogMsg(1,
+                   "  (read: %.3fs, broadcast: %.3fs, unpack: %.3fs)\n",
+                   reader->getReadTime(),
+                   reader->getBroadcastTime(),
+                   reader->getUnpackTime());
+        }
+    #endif    // _MPI
+
     anchorName       = sharedData.mArchive->getAnchorName();
     archiveDirectory = sharedData.mArchive->getArchiveDirectory();
 
@@ -0,0 +1,47 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_SCOUT_OPTIONS_H
+#define SCOUT_SCOUT_OPTIONS_H
+
+
+#include <stdint.h>
+
+#include <cstddef>
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  scout_options.h
+ *  @brief Declaration of the global SCOUT configuration variables.
+ *
+ *  This header file provides the declaration of the global variables
+ *  holding the SCOUT configuration set via command-line options.  They are
+ *  defined in scout.cpp.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+// --- Global variables -----------------------------------------------------
+
+extern bool enableStatistics;
+extern bool enableCriticalPath;
+extern bool enableDelayAnalysis;
+extern bool enableSinglePass;
+
+extern size_t   reportBatchBytes;
+extern uint32_t reportWriters;
+
+extern size_t maxTraceMemory;
+
+
+#endif    // !SCOUT_SCOUT_OPTIONS_H
@@ -42,6 +42,9 @@ const int INIT         = 4;
 const int PRE_FINALIZE = 5;
 const int FINALIZE     = 6;
 
+const int SEGMENT_BEGIN = 7;
+const int SEGMENT_END   = 8;
+
 const int PRE_SEND              = 10;
 const int POST_SEND             = 11;
 const int PRE_RECV              = 12;
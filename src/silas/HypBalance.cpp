@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -23,7 +23,6 @@
 #include <pearl/Callpath.h>
 #include <pearl/Event.h>
 #include <pearl/Region.h>
-#include <pearl/String.h>
 
 #include "ReenactCallbackData.h"
 #include "silas_events.h"
@@ -51,6 +50,9 @@ HypBalance::register_callbacks(const int               run,
        && !registered_regions.empty())
     {
         log("Registering balance hypothesis part for ATOMIC_REGION_EXIT\n");
+        cbmanager->register_callback(START,
+                                     PEARL_create_callback(this,
+                                                           &HypBalance::cb_resolve_regions));
         cbmanager->register_callback(ATOMIC_REGION_EXIT,
                                      PEARL_create_callback(this,
                                                            &HypBalance::cb_balance_region));
@@ -58,6 +60,18 @@ HypBalance::register_callbacks(const int               run,
 }
 
 
+void
+HypBalance::cb_resolve_regions(const pearl::CallbackManager& cbmanager,
+                               int                           user_event,
+                               const pearl::Event&           event,
+                               pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    registered_regions.resolve(data->get_global_defs());
+}
+
+
 void
 HypBalance::cb_balance_region(const pearl::CallbackManager& cbmanager,
                               int                           user_event,
@@ -71,8 +85,7 @@ HypBalance::cb_balance_region(const pearl::CallbackManager& cbmanager,
     int    num_processes;
 
     /* check if current region is registered to be balanced */
-    if (registered_regions.find(event.get_cnode()->getRegion().getDisplayName().getString())
-        == registered_regions.end())
+    if (!registered_regions.is_selected(event.get_cnode()->getRegion().getId()))
     {
         return;
     }
@@ -97,5 +110,14 @@ void
 HypBalance::register_region(string region_name)
 {
     log("Registering region \"%s\" for balancing\n", region_name.c_str());
-    registered_regions.insert(region_name);
+    registered_regions.add_name(region_name, 1.0);
+}
+
+
+bool
+HypBalance::register_region_pattern(string pattern)
+{
+    log("Registering regions matching \"%s\" for balancing\n", pattern.c_str());
+
+    return registered_regions.add_pattern(pattern, 1.0);
 }
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -18,12 +18,12 @@
 #define SILAS_HYPBALANCE_H
 
 
-#include <set>
 #include <string>
 
 #include <pearl/CallbackManager.h>
 
 #include "HypothesisPart.h"
+#include "RegionFilter.h"
 
 
 namespace silas
@@ -58,8 +58,24 @@ class HypBalance
         virtual void
         register_region(std::string region_name);
 
+        /**
+         * register all regions matching a regular expression to be balanced
+         * @return false if the pattern is not a valid regular expression
+         */
+        virtual bool
+        register_region_pattern(std::string pattern);
+
 
     private:
+        /**
+         * callback to resolve registered regions against the definitions
+         */
+        void
+        cb_resolve_regions(const pearl::CallbackManager& cbmanager,
+                           int                           user_event,
+                           const pearl::Event&           event,
+                           pearl::CallbackData*          cdata);
+
         /**
          * callback to perform balancing of region timespans
          */
@@ -69,7 +85,7 @@ class HypBalance
                           const pearl::Event&           event,
                           pearl::CallbackData*          cdata);
 
-        std::set< std::string > registered_regions;
+        RegionFilter registered_regions;
 };
 }    // namespace silas
 
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -21,7 +21,6 @@
 #include <pearl/Callpath.h>
 #include <pearl/Event.h>
 #include <pearl/Region.h>
-#include <pearl/String.h>
 
 #include "ReenactCallbackData.h"
 #include "silas_events.h"
@@ -49,6 +48,9 @@ HypScale::register_callbacks(const int               run,
        && !registered_regions.empty())
     {
         log("Registering HypScale for ATOMIC_REGION_EXIT\n");
+        cbmanager->register_callback(START,
+                                     PEARL_create_callback(this,
+                                                           &HypScale::cb_resolve_regions));
         cbmanager->register_callback(ATOMIC_REGION_EXIT,
                                      PEARL_create_callback(this,
                                                            &HypScale::cb_scale_region));
@@ -56,6 +58,18 @@ HypScale::register_callbacks(const int               run,
 }
 
 
+void
+HypScale::cb_resolve_regions(const pearl::CallbackManager& cbmanager,
+                             int                           user_event,
+                             const pearl::Event&           event,
+                             pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    registered_regions.resolve(data->get_global_defs());
+}
+
+
 void
 HypScale::cb_scale_region(const pearl::CallbackManager& cbmanager,
                           int                           user_event,
@@ -66,11 +80,10 @@ HypScale::cb_scale_region(const pearl::CallbackManager& cbmanager,
 
     double local_timespan, new_timespan;
 
-    std::map< std::string, double >::iterator entry =
-        registered_regions.find(event.get_cnode()->getRegion().getDisplayName().getString());
+    pearl::Region::IdType region = event.get_cnode()->getRegion().getId();
 
     /* check if current region is registered to be scaled */
-    if (entry == registered_regions.end())
+    if (!registered_regions.is_selected(region))
     {
         return;
     }
@@ -78,7 +91,7 @@ HypScale::cb_scale_region(const pearl::CallbackManager& cbmanager,
     /* calculate original timespan of current region */
     local_timespan = event->getTimestamp() - event.prev()->getTimestamp();
     /* scale to new timespan */
-    new_timespan = local_timespan * entry->second;
+    new_timespan = local_timespan * registered_regions.get_value(region);
 
     /* set new time */
     event->setTimestamp(event.prev()->getTimestamp() + new_timespan);
@@ -91,5 +104,15 @@ HypScale::register_region(string region_name,
                           double ratio)
 {
     log("Registering region \"%s\" for scaling\n", region_name.c_str());
-    registered_regions.insert(make_pair(region_name, ratio));
+    registered_regions.add_name(region_name, ratio);
+}
+
+
+bool
+HypScale::register_region_pattern(string pattern,
+                                  double ratio)
+{
+    log("Registering regions matching \"%s\" for scaling\n", pattern.c_str());
+
+    return registered_regions.add_pattern(pattern, ratio);
 }
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2015                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -18,12 +18,12 @@
 #define SILAS_HYPSCALE_H
 
 
-#include <map>
 #include <string>
 
 #include <pearl/CallbackManager.h>
 
 #include "HypothesisPart.h"
+#include "RegionFilter.h"
 
 
 namespace silas
@@ -59,8 +59,25 @@ class HypScale
         register_region(std::string region_name,
                         double      ratio);
 
+        /**
+         * register all regions matching a regular expression to be scaled
+         * @return false if the pattern is not a valid regular expression
+         */
+        virtual bool
+        register_region_pattern(std::string pattern,
+                                double      ratio);
+
 
     private:
+        /**
+         * callback to resolve registered regions against the definitions
+         */
+        void
+        cb_resolve_regions(const pearl::CallbackManager& cbmanager,
+                           int                           user_event,
+                           const pearl::Event&           event,
+                           pearl::CallbackData*          cdata);
+
         /**
          * callback to perform scaling of region timespans
          */
@@ -71,7 +88,7 @@ class HypScale
                         pearl::CallbackData*          cdata);
 
 
-        std::map< std::string, double > registered_regions;
+        RegionFilter registered_regions;
 };
 }    // namespace silas
 
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2020                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -25,7 +25,8 @@ using namespace pearl;
 using namespace silas;
 
 
-Hypothesis::Hypothesis()
+Hypothesis::Hypothesis(const string& name)
+    : m_name(name)
 {
 }
 
@@ -47,6 +48,13 @@ Hypothesis::add_part(HypothesisPart* part)
 }
 
 
+const string&
+Hypothesis::get_name() const
+{
+    return m_name;
+}
+
+
 void
 Hypothesis::register_callbacks(const int        run,
                                CallbackManager* cbmanager) const
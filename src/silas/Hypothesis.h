@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2020                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -18,6 +18,7 @@
 #define SILAS_HYPOTHESIS_H
 
 
+#include <string>
 #include <vector>
 
 #include <pearl/CallbackManager.h>
@@ -38,9 +39,11 @@ class Hypothesis
 {
     public:
         /**
-         * Default constructor.
+         * Constructor.
+         * @param name Name of the hypothesis used in log output
          */
-        Hypothesis();
+        explicit
+        Hypothesis(const std::string& name);
 
         /**
          * Destructor.  Cleans up registered partial hypotheses.
@@ -55,6 +58,13 @@ class Hypothesis
         void
         add_part(HypothesisPart* part);
 
+        /**
+         * Return the name of the hypothesis.
+         * @return name of the hypothesis
+         */
+        const std::string&
+        get_name() const;
+
         /**
          * Register all callbacks of the included partial hypotheses
          * @param run       ID of the replay run the callbacks will
@@ -68,6 +78,11 @@ class Hypothesis
 
 
     private:
+        /**
+         * Name of the hypothesis
+         */
+        std::string m_name;
+
         /**
          * List of partial hypotheses
          */
@@ -21,6 +21,7 @@
 #include <cstddef>
 
 #include "ReenactModel.h"
+#include "VirtualTimeModel.h"
 
 using namespace std;
 using namespace silas;
@@ -33,6 +34,10 @@ ModelFactory::create_model(const string& model)
     {
         return new ReenactModel();
     }
+    if (model == "VirtualTime")
+    {
+        return new VirtualTimeModel();
+    }
 
     return NULL;
 }
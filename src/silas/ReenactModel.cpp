@@ -48,6 +48,8 @@ static double idle_overhead  = 5e-07;
 
 static double min_latency = 1e-08;
 
+static char* bsend_buffer = NULL;
+
 const std::string
 ReenactModel::get_name() const
 {
@@ -332,12 +334,22 @@ ReenactModel::cb_finish_prepare(const pearl::CallbackManager& cbmanager,
     data->set_max_count(global_max_count[0]);
     data->set_max_pt2pt_count(global_max_count[1]);
 
+    if (bsend_buffer)
+    {
+        /* release buffer attached for a previous simulation */
+        void* buffer;
+        int   size;
+        MPI_Buffer_detach(&buffer, &size);
+        delete[] bsend_buffer;
+        bsend_buffer = NULL;
+    }
+
     local_max_count[1] = data->get_max_buffered_count();
     if (local_max_count[1] > MPI_BSEND_OVERHEAD)
     {
         /* prepare for bufferend send in simulation */
-        char* buffer = new char[local_max_count[1] + MPI_BSEND_OVERHEAD];
-        MPI_Buffer_attach(buffer, local_max_count[1]);
+        bsend_buffer = new char[local_max_count[1] + MPI_BSEND_OVERHEAD];
+        MPI_Buffer_attach(bsend_buffer, local_max_count[1]);
     }
 
     /* preallocate dummy buffers */
@@ -581,7 +593,7 @@ ReenactModel::cb_any_prepare(const pearl::CallbackManager& cbmanager,
         int e, a = 0;
 
         for (e = 0;
-             cbmap[e].cbtbl && event->isOfType(cbmap[e].event_type);
+             cbmap[e].cbtbl && !event->isOfType(cbmap[e].event_type);
              ++e)
         {
         }
@@ -2420,7 +2432,7 @@ ReenactModel::get_wtime()
 }
 
 
-inline int
+int
 ReenactModel::get_commsize(MPI_Comm comm)
 {
     map< MPI_Comm, int >::iterator it;
@@ -64,7 +64,7 @@ class ReenactModel
         get_run_configuration() const;
 
 
-    private:
+    protected:
         /// @name Preparation step callbacks
         /// @{
         void
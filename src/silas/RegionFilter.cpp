@@ -0,0 +1,110 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "RegionFilter.h"
+
+#include <pearl/GlobalDefs.h>
+#include <pearl/String.h>
+
+using namespace std;
+using namespace pearl;
+using namespace silas;
+
+
+RegionFilter::RegionFilter()
+{
+}
+
+
+RegionFilter::~RegionFilter()
+{
+    for (vector< Pattern >::iterator it = m_patterns.begin();
+         it != m_patterns.end();
+         ++it)
+    {
+        regfree(it->regex);
+        delete it->regex;
+    }
+}
+
+
+void
+RegionFilter::add_name(const string& name,
+                       double        value)
+{
+    m_names.insert(make_pair(name, value));
+}
+
+
+bool
+RegionFilter::add_pattern(const string& pattern,
+                          double        value)
+{
+    // Patterns always have to match the entire region name
+    const string anchored = "^(" + pattern + ")$";
+
+    Pattern entry;
+    entry.regex = new regex_t;
+    entry.value = value;
+    if (regcomp(entry.regex, anchored.c_str(), REG_EXTENDED | REG_NOSUB) != 0)
+    {
+        delete entry.regex;
+
+        return false;
+    }
+    m_patterns.push_back(entry);
+
+    return true;
+}
+
+
+bool
+RegionFilter::empty() const
+{
+    return (m_names.empty() && m_patterns.empty());
+}
+
+
+void
+RegionFilter::resolve(const GlobalDefs& defs)
+{
+    const size_t count = defs.numRegions();
+
+    m_selected.assign(count, false);
+    m_values.assign(count, 0.0);
+    for (size_t id = 0; id < count; ++id)
+    {
+        const string& name = defs.getRegion(id).getDisplayName().getString();
+
+        map< string, double >::const_iterator entry = m_names.find(name);
+        if (entry != m_names.end())
+        {
+            m_selected[id] = true;
+            m_values[id]   = entry->second;
+            continue;
+        }
+
+        for (vector< Pattern >::const_iterator it = m_patterns.begin();
+             it != m_patterns.end();
+             ++it)
+        {
+            if (regexec(it->regex, name.c_str(), 0, NULL, 0) == 0)
+            {
+                m_selected[id] = true;
+                m_values[id]   = it->value;
+                break;
+            }
+        }
+    }
+}
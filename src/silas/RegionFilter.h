@@ -0,0 +1,140 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SILAS_REGIONFILTER_H
+#define SILAS_REGIONFILTER_H
+
+
+#include <regex.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <pearl/Region.h>
+
+
+namespace pearl
+{
+class GlobalDefs;
+}    // namespace pearl
+
+
+namespace silas
+{
+/**
+ * Selection of regions by name or by regular expression, each associated
+ * with a value.  Once the global definitions are available, the selection
+ * is resolved into a dense table indexed by region ID, so that checking
+ * an event's region does not require any string comparison.
+ *
+ * Exact names take precedence over patterns; if several patterns match a
+ * region, the one registered first is used.
+ */
+class RegionFilter
+{
+    public:
+        /// @name Constructors & Destructors
+        /// @{
+
+        RegionFilter();
+
+        ~RegionFilter();
+
+        /// @}
+
+        /**
+         * Select the region with the given name
+         * @param name          region name
+         * @param value         associated value
+         */
+        void
+        add_name(const std::string& name,
+                 double             value);
+
+        /**
+         * Select all regions whose full name matches the given POSIX
+         * extended regular expression
+         * @param pattern       regular expression
+         * @param value         associated value
+         * @return false if the pattern is not a valid regular expression
+         */
+        bool
+        add_pattern(const std::string& pattern,
+                    double             value);
+
+        /**
+         * Check whether any regions have been selected
+         */
+        bool
+        empty() const;
+
+        /**
+         * Build the region lookup table from the given definitions
+         * @param defs          global definitions
+         */
+        void
+        resolve(const pearl::GlobalDefs& defs);
+
+        /**
+         * Check whether the region with the given ID is selected
+         * (only valid after resolve())
+         */
+        bool
+        is_selected(pearl::Region::IdType id) const
+        {
+            return m_selected[id];
+        }
+
+        /**
+         * Retrieve value associated with the region with the given ID
+         * (only valid after resolve() and if the region is selected)
+         */
+        double
+        get_value(pearl::Region::IdType id) const
+        {
+            return m_values[id];
+        }
+
+
+    private:
+        /// compiled regular expression and associated value
+        struct Pattern
+        {
+            regex_t* regex;
+            double   value;
+        };
+
+
+        /// not copyable
+        RegionFilter(const RegionFilter&);
+
+        RegionFilter&
+        operator=(const RegionFilter&);
+
+
+        /// selected region names
+        std::map< std::string, double > m_names;
+
+        /// selection patterns, in order of registration
+        std::vector< Pattern > m_patterns;
+
+        /// selection flags, indexed by region ID
+        std::vector< bool > m_selected;
+
+        /// associated values, indexed by region ID
+        std::vector< double > m_values;
+};
+}    // namespace silas
+
+
+#endif    // !SILAS_REGIONFILTER_H
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -26,6 +26,8 @@ Config::Config()
 {
     m_input_trace_name  = "epik_a";
     m_output_trace_name = "epik_sim";
+
+    m_write_batch_traces = false;
 }
 
 
@@ -72,3 +74,17 @@ Config::get_output_trace()
 {
     return m_output_trace_name;
 }
+
+
+void
+Config::set_write_batch_traces(bool enable)
+{
+    m_write_batch_traces = enable;
+}
+
+
+bool
+Config::get_write_batch_traces()
+{
+    return m_write_batch_traces;
+}
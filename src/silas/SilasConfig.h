@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -75,6 +75,20 @@ class Config
         std::string
         get_output_trace();
 
+        /**
+         * Enable or disable writing of predicted traces in batch mode
+         * @param enable Flag indicating whether traces will be written
+         */
+        void
+        set_write_batch_traces(bool enable);
+
+        /**
+         * Check whether predicted traces are written in batch mode
+         * @return True if traces will be written, false otherwise
+         */
+        bool
+        get_write_batch_traces();
+
 
     private:
         /**
@@ -82,6 +96,11 @@ class Config
          */
         std::string m_input_trace_name;
         std::string m_output_trace_name;
+
+        /**
+         * Write predicted trace per hypothesis in batch mode
+         */
+        bool m_write_batch_traces;
 };
 }    // namespace silas
 
@@ -2,7 +2,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2020                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -58,6 +58,9 @@ yyerror(const string& message);
 void
 parse_config(const std::string& filename);
 
+extern void
+begin_hypothesis(const std::string& name);
+
 extern int
 yylex();
 
@@ -71,6 +74,7 @@ yylex();
 
 
 Config          :   Model Hypothesis
+                |   Model Hypothesis Batch
                 ;
 
 
@@ -154,6 +158,18 @@ HypothesisItem  :   Balance
                 ;
 
 
+Batch           :   BatchItem
+                |   Batch BatchItem
+                ;
+
+
+BatchItem       :   String '{'
+                    {
+                        begin_hypothesis($1);
+                    }   Hypothesis '}'
+                ;
+
+
 Region          :   SC_REGION String
                     {
                         $$ = $2;
@@ -161,10 +177,24 @@ Region          :   SC_REGION String
                 ;
 
 
+RegionPattern   :   SC_REGION '~' String
+                    {
+                        $$ = $3;
+                    }
+                ;
+
+
 Balance         :   SC_BALANCE Region
                     {
                         balancer->register_region($2);
                     }
+                |   SC_BALANCE RegionPattern
+                    {
+                        if (!balancer->register_region_pattern($2))
+                        {
+                            yyerror("Invalid regular expression!");
+                        }
+                    }
                 ;
 
 
@@ -199,6 +229,15 @@ Scale           :   SC_SCALE Region Number
 
                         rescaler->register_region($2.c_str(),value);
                     }
+                |   SC_SCALE RegionPattern Number
+                    {
+                        double value = strtod($3.c_str(), NULL);
+
+                        if (!rescaler->register_region_pattern($2, value))
+                        {
+                            yyerror("Invalid regular expression!");
+                        }
+                    }
                 ;
 
 
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -34,39 +34,36 @@ using namespace silas;
 
 
 /**
- * Create a simulator object with references on the event trace, a
- * pointer to the model, as well as the hypothesis.
+ * Create a simulator object with references on the event trace and a
+ * pointer to the model.
  * @param trace Reference of the local event trace
  * @param model Pointer to the model used for simulation
- * @param hypothesis Pointer to the simulation hypothesis
  */
 Simulator::Simulator(pearl::LocalTrace& trace,
-                     Model*             model,
-                     Hypothesis*        hypothesis)
+                     Model*             model)
     : m_trace(trace)
 {
     /* initialize local objects */
-    m_model      = model;
-    m_hypothesis = hypothesis;
+    m_model = model;
 }
 
 
 /**
- * Clean up model and hypothesis objects
+ * Clean up model object
  */
 Simulator::~Simulator()
 {
     /* free objects */
     delete m_model;
-    delete m_hypothesis;
 }
 
 
 /**
  * Start the simulation.
+ * @param hypothesis Reference of the simulation hypothesis
  */
 void
-Simulator::run() const
+Simulator::run(const Hypothesis& hypothesis) const
 {
     Timer timer;
 
@@ -79,7 +76,7 @@ Simulator::run() const
         pearl::CallbackManager m_cbmanager;
 
         m_model->register_callbacks(run, &m_cbmanager);
-        m_hypothesis->register_callbacks(run, &m_cbmanager);
+        hypothesis.register_callbacks(run, &m_cbmanager);
 
         log("%s ...\n", runtime_config[run].description);
         timer.start();
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2021                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -39,8 +39,7 @@ class Simulator
          * The trace object will be modified by the simulation.
          */
         Simulator(pearl::LocalTrace& trace,
-                  Model*             model,
-                  Hypothesis*        hypothesis);
+                  Model*             model);
 
         /**
          * Cleaning up simulator
@@ -49,9 +48,10 @@ class Simulator
 
         /**
          * Starting the simulator
+         * @param hypothesis Hypothesis to be simulated
          */
         void
-        run() const;
+        run(const Hypothesis& hypothesis) const;
 
 
     private:
@@ -59,8 +59,6 @@ class Simulator
         pearl::LocalTrace& m_trace;
         /** model to be used */
         Model* m_model;
-        /** hypothesis to be simulated */
-        Hypothesis* m_hypothesis;
 };
 }    // namespace silas
 
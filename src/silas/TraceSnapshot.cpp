@@ -0,0 +1,91 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "TraceSnapshot.h"
+
+#include <pearl/Event.h>
+#include <pearl/Event_rep.h>
+#include <pearl/LocalTrace.h>
+
+using namespace std;
+using namespace pearl;
+using namespace silas;
+
+
+// --- Constructors & destructor --------------------------------------------
+
+TraceSnapshot::TraceSnapshot(const LocalTrace& trace)
+{
+    m_events.reserve(trace.size());
+    for (Event event = trace.begin(); event != trace.end(); ++event)
+    {
+        EventState state;
+        state.event      = &*event;
+        state.timestamp  = event->getTimestamp();
+        state.request_id = event->isOfType(GROUP_NONBLOCK)
+                           ? event->getRequestId()
+                           : PEARL_NO_REQUEST;
+
+        m_events.push_back(state);
+    }
+}
+
+
+// --- Restoring the trace --------------------------------------------------
+
+void
+TraceSnapshot::restore(LocalTrace& trace) const
+{
+    /* Re-establish the original event order if it was changed.  Event
+     * representations are never deleted during a simulation, so all
+     * pointers in the snapshot are still valid. */
+    bool reordered = (trace.size() != m_events.size());
+    if (!reordered)
+    {
+        vector< EventState >::const_iterator it = m_events.begin();
+        for (Event event = trace.begin(); event != trace.end(); ++event, ++it)
+        {
+            if (&*event != it->event)
+            {
+                reordered = true;
+                break;
+            }
+        }
+    }
+    if (reordered)
+    {
+        if (trace.size() > 0)
+        {
+            trace.erase(trace.begin(), trace.end());
+        }
+        for (vector< EventState >::const_iterator it = m_events.begin();
+             it != m_events.end();
+             ++it)
+        {
+            trace.insert(trace.end(), it->event);
+        }
+    }
+
+    /* restore event data */
+    for (vector< EventState >::const_iterator it = m_events.begin();
+         it != m_events.end();
+         ++it)
+    {
+        it->event->setTimestamp(it->timestamp);
+        if (it->event->isOfType(GROUP_NONBLOCK))
+        {
+            it->event->setRequestId(it->request_id);
+        }
+    }
+}
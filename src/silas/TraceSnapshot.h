@@ -0,0 +1,77 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SILAS_TRACESNAPSHOT_H
+#define SILAS_TRACESNAPSHOT_H
+
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <pearl/pearl_types.h>
+
+
+namespace pearl
+{
+class Event_rep;
+class LocalTrace;
+}    // namespace pearl
+
+
+namespace silas
+{
+/**
+ * Snapshot of all event data of a local trace that is modified by a
+ * simulation.  Besides the timestamps (which are also set to -1 for
+ * events deleted by a hypothesis), this includes the order of the events
+ * and the request identifiers of non-blocking communication events, as
+ * the ReenactModel reorders completion events and swaps their request
+ * identifiers.  Restoring a snapshot allows multiple hypotheses to be
+ * simulated on trace data read only once.
+ */
+class TraceSnapshot
+{
+    public:
+        /**
+         * Take a snapshot of the given trace.
+         * @param trace Reference to event trace
+         */
+        explicit
+        TraceSnapshot(const pearl::LocalTrace& trace);
+
+        /**
+         * Restore the state of the trace at the time the snapshot was
+         * taken.  The trace has to be the one passed to the constructor.
+         * @param trace Reference to event trace
+         */
+        void
+        restore(pearl::LocalTrace& trace) const;
+
+
+    private:
+        /** Modifiable data of a single event */
+        struct EventState
+        {
+            pearl::Event_rep*  event;
+            pearl::timestamp_t timestamp;
+            uint64_t           request_id;
+        };
+
+
+        /** event data in trace order */
+        std::vector< EventState > m_events;
+};
+}    // namespace silas
+
+
+#endif    // !SILAS_TRACESNAPSHOT_H
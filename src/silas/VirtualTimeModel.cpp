@@ -0,0 +1,597 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "VirtualTimeModel.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <pearl/CallbackManager.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/MpiComm.h>
+
+#include "ReenactCallbackData.h"
+#include "silas_events.h"
+#include "silas_util.h"
+
+using namespace std;
+using namespace pearl;
+using namespace silas;
+
+
+// --- Constructors & destructor --------------------------------------------
+
+VirtualTimeModel::VirtualTimeModel()
+    : m_clock(0.0),
+      m_latency(1e-06),
+      m_bandwidth(1e09),
+      m_overhead(5e-07)
+{
+    // Requests are always completed as recorded in the trace, as there is
+    // no real message progress that could reorder them
+    m_flags.insert("deterministic");
+}
+
+
+const std::string
+VirtualTimeModel::get_name() const
+{
+    return "Virtual Time Model";
+}
+
+
+void
+VirtualTimeModel::register_callbacks(const int               run,
+                                     pearl::CallbackManager* cbmanager)
+{
+    switch (run)
+    {
+        case 0:    // Preprocessing
+            {
+                cbmanager->register_callback(silas::INIT,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_any_prepare));
+                cbmanager->register_callback(silas::START,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_start_prepare));
+                cbmanager->register_callback(silas::FINISHED,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_finish_prepare_virtual));
+                break;
+            }
+
+        case 2:    // Simulation
+            {
+                cbmanager->register_callback(silas::START,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_start_virtual));
+                cbmanager->register_callback(silas::FINISHED,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_finish_virtual));
+                cbmanager->register_callback(silas::BEGIN,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_begin_virtual));
+                cbmanager->register_callback(silas::END,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_end_virtual));
+                if (!is_set("aggregate idle"))
+                {
+                    cbmanager->register_callback(silas::NOOP,
+                                                 PEARL_create_callback(this, &VirtualTimeModel::cb_begin_virtual));
+                }
+                cbmanager->register_callback(silas::IDLE,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_idle_virtual));
+                cbmanager->register_callback(silas::IDLE_WRITE,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_idle_write_virtual));
+
+                // Synchronous and buffered sends are modeled as standard sends
+                cbmanager->register_callback(silas::SEND,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_send_virtual));
+                cbmanager->register_callback(silas::SSEND,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_send_virtual));
+                cbmanager->register_callback(silas::BSEND,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_send_virtual));
+                cbmanager->register_callback(silas::ISEND,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_isend_virtual));
+                cbmanager->register_callback(silas::ISSEND,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_isend_virtual));
+                cbmanager->register_callback(silas::IBSEND,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_isend_virtual));
+                cbmanager->register_callback(silas::RECV,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_recv_virtual));
+                cbmanager->register_callback(silas::IRECV,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_irecv_virtual));
+                cbmanager->register_callback(silas::MPISTART,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_start_virtual));
+                cbmanager->register_callback(silas::SENDRECV,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_sendrecv_virtual));
+
+                // In deterministic mode, only WAIT and WAITALL actions occur
+                cbmanager->register_callback(silas::WAIT,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_wait_virtual));
+                cbmanager->register_callback(silas::WAITALL,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_wait_virtual));
+
+                cbmanager->register_callback(silas::BARRIER,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                cbmanager->register_callback(silas::BCAST,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                cbmanager->register_callback(silas::ALLREDUCE,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                cbmanager->register_callback(silas::ALLGATHER,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                cbmanager->register_callback(silas::ALLTOALL,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                cbmanager->register_callback(silas::SCAN,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                cbmanager->register_callback(silas::EXSCAN,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                cbmanager->register_callback(silas::REDUCE,
+                                             PEARL_create_callback(this, &VirtualTimeModel::cb_mpi_collective_virtual));
+                break;
+            }
+
+        default:    // Idle time aggregation, postprocessing & verification
+            ReenactModel::register_callbacks(run, cbmanager);
+            break;
+    }
+}
+
+
+// --- Preprocessing callbacks ----------------------------------------------
+
+void
+VirtualTimeModel::cb_finish_prepare_virtual(const pearl::CallbackManager& cbmanager,
+                                            int                           user_event,
+                                            const pearl::Event&           event,
+                                            pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    // no dummy buffers required, only timestamps are exchanged
+    data->reset_action_idx();
+
+    /* clear diff vector so push_back restarts at the beginning */
+    data->clear_diff_vector();
+}
+
+
+// --- Simulation callbacks -------------------------------------------------
+
+void
+VirtualTimeModel::cb_start_virtual(const pearl::CallbackManager& cbmanager,
+                                   int                           user_event,
+                                   const pearl::Event&           event,
+                                   pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    data->activate_action_list();
+
+    /* reset delta_t */
+    data->set_delta_t(0.);
+
+    /* virtual clocks start at the original process start times */
+    reference_timestamp = 0.;
+    m_clock             = event->getTimestamp();
+
+    const string latency_str = get_option("network latency");
+    if (!latency_str.empty())
+    {
+        m_latency = strtod(latency_str.c_str(), NULL);
+    }
+    const string bandwidth_str = get_option("network bandwidth");
+    if (!bandwidth_str.empty())
+    {
+        m_bandwidth = strtod(bandwidth_str.c_str(), NULL);
+    }
+    const string overhead_str = get_option("network overhead");
+    if (!overhead_str.empty())
+    {
+        m_overhead = strtod(overhead_str.c_str(), NULL);
+    }
+    log("Network latency:   %e\n", m_latency);
+    log("Network bandwidth: %e\n", m_bandwidth);
+    log("Network overhead:  %e\n", m_overhead);
+}
+
+
+void
+VirtualTimeModel::cb_finish_virtual(const pearl::CallbackManager& cbmanager,
+                                    int                           user_event,
+                                    const pearl::Event&           event,
+                                    pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    // complete outstanding virtual-time messages
+    while (!m_sends.empty())
+    {
+        MPI_Wait(&m_sends.front().request, MPI_STATUS_IGNORE);
+        m_sends.pop_front();
+    }
+    for (map< uint64_t, TimeMessage >::iterator it = m_recvs.begin();
+         it != m_recvs.end();
+         ++it)
+    {
+        MPI_Cancel(&it->second.request);
+        MPI_Wait(&it->second.request, MPI_STATUS_IGNORE);
+    }
+    m_recvs.clear();
+    m_send_completions.clear();
+
+    data->reset_action_idx();
+}
+
+
+void
+VirtualTimeModel::cb_begin_virtual(const pearl::CallbackManager& cbmanager,
+                                   int                           user_event,
+                                   const pearl::Event&           event,
+                                   pearl::CallbackData*          cdata)
+{
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_end_virtual(const pearl::CallbackManager& cbmanager,
+                                 int                           user_event,
+                                 const pearl::Event&           event,
+                                 pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    // the preceeding NOOP or IDLE did not save the time yet
+    event.prev()->setTimestamp(m_clock);
+
+    m_clock += data->get_original_timestamp() - data->get_preceeding_timestamp();
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_idle_virtual(const pearl::CallbackManager& cbmanager,
+                                  int                           user_event,
+                                  const pearl::Event&           event,
+                                  pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    m_clock += data->get_original_timestamp() - data->get_preceeding_timestamp();
+}
+
+
+void
+VirtualTimeModel::cb_idle_write_virtual(const pearl::CallbackManager& cbmanager,
+                                        int                           user_event,
+                                        const pearl::Event&           event,
+                                        pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    m_clock += data->get_original_timestamp() - data->get_preceeding_timestamp();
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_send_virtual(const pearl::CallbackManager& cbmanager,
+                                      int                           user_event,
+                                      const pearl::Event&           event,
+                                      pearl::CallbackData*          cdata)
+{
+    // blocking sends return once the message has been injected
+    m_clock = post_send(event.prev());
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_isend_virtual(const pearl::CallbackManager& cbmanager,
+                                       int                           user_event,
+                                       const pearl::Event&           event,
+                                       pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    pearl::Event       send       = event.prev();
+    uint64_t           requestId  = send->getRequestId();
+    pearl::timestamp_t completion = post_send(send);
+
+    if (!data->get_uncomplete_requests().count(requestId))
+    {
+        m_send_completions[requestId] = completion;
+    }
+
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_recv_virtual(const pearl::CallbackManager& cbmanager,
+                                      int                           user_event,
+                                      const pearl::Event&           event,
+                                      pearl::CallbackData*          cdata)
+{
+    pearl::Event recv = event.prev();
+    double       data[2];
+
+    MPI_Recv(data, 2, MPI_DOUBLE, recv->getSource(), recv->getTag(),
+             recv->getComm()->getHandle(), MPI_STATUS_IGNORE);
+
+    m_clock = std::max(m_clock, arrival_time(data)) + m_overhead;
+    recv->setTimestamp(m_clock);
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_irecv_virtual(const pearl::CallbackManager& cbmanager,
+                                       int                           user_event,
+                                       const pearl::Event&           event,
+                                       pearl::CallbackData*          cdata)
+{
+    post_irecv(event.prev());
+
+    m_clock += m_overhead;
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_start_virtual(const pearl::CallbackManager& cbmanager,
+                                       int                           user_event,
+                                       const pearl::Event&           event,
+                                       pearl::CallbackData*          cdata)
+{
+    silas::CallbackData* data = static_cast< silas::CallbackData* >(cdata);
+
+    // process requests in trace order to keep timestamps monotonic
+    for (pearl::Event ev_it = event.enterptr().next(); ev_it != event; ++ev_it)
+    {
+        if (ev_it->isOfType(GROUP_SEND))
+        {
+            uint64_t           requestId  = ev_it->getRequestId();
+            pearl::timestamp_t completion = post_send(ev_it);
+
+            if (!data->get_uncomplete_requests().count(requestId))
+            {
+                m_send_completions[requestId] = completion;
+            }
+        }
+        else if (ev_it->isOfType(MPI_RECV_REQUEST))
+        {
+            post_irecv(ev_it);
+        }
+        else
+        {
+            ev_it->setTimestamp(m_clock);
+        }
+    }
+
+    m_clock += m_overhead;
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_sendrecv_virtual(const pearl::CallbackManager& cbmanager,
+                                          int                           user_event,
+                                          const pearl::Event&           event,
+                                          pearl::CallbackData*          cdata)
+{
+    pearl::Event recv = event.prev();
+    pearl::Event send = recv.prev();
+    double       data[2];
+
+    pearl::timestamp_t completion = post_send(send);
+
+    MPI_Recv(data, 2, MPI_DOUBLE, recv->getSource(), recv->getTag(),
+             recv->getComm()->getHandle(), MPI_STATUS_IGNORE);
+
+    m_clock = std::max(completion, arrival_time(data)) + m_overhead;
+    recv->setTimestamp(m_clock);
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_wait_virtual(const pearl::CallbackManager& cbmanager,
+                                      int                           user_event,
+                                      const pearl::Event&           event,
+                                      pearl::CallbackData*          cdata)
+{
+    // complete all requests in the order recorded in the trace
+    for (pearl::Event ev_it = event.enterptr().next(); ev_it != event; ++ev_it)
+    {
+        if (ev_it->isOfType(MPI_SEND_COMPLETE))
+        {
+            map< uint64_t, pearl::timestamp_t >::iterator it =
+                m_send_completions.find(ev_it->getRequestId());
+            if (it != m_send_completions.end())
+            {
+                m_clock = std::max(m_clock, it->second);
+                m_send_completions.erase(it);
+            }
+        }
+        else if (ev_it->isOfType(MPI_RECV_COMPLETE))
+        {
+            map< uint64_t, TimeMessage >::iterator it =
+                m_recvs.find(ev_it->getRequestId());
+            if (it != m_recvs.end())
+            {
+                MPI_Wait(&it->second.request, MPI_STATUS_IGNORE);
+                m_clock = std::max(m_clock, arrival_time(it->second.data));
+                m_recvs.erase(it);
+            }
+        }
+
+        ev_it->setTimestamp(m_clock);
+    }
+
+    m_clock += m_overhead;
+    event->setTimestamp(m_clock);
+}
+
+
+void
+VirtualTimeModel::cb_mpi_collective_virtual(const pearl::CallbackManager& cbmanager,
+                                            int                           user_event,
+                                            const pearl::Event&           event,
+                                            pearl::CallbackData*          cdata)
+{
+    MPI_Comm mpicomm  = event->getComm()->getHandle();
+    int      commsize = get_commsize(mpicomm);
+    uint64_t scount   = event->getBytesSent();
+    uint64_t rcount   = event->getBytesReceived();
+
+    pearl::timestamp_t start = m_clock;
+    pearl::timestamp_t end   = start;
+
+    switch (user_event)
+    {
+        case silas::BARRIER:
+            MPI_Allreduce(&start, &end, 1, MPI_DOUBLE, MPI_MAX, mpicomm);
+            end += tree_cost(commsize, 0);
+            break;
+
+        case silas::ALLREDUCE:
+            // reduction followed by a broadcast
+            MPI_Allreduce(&start, &end, 1, MPI_DOUBLE, MPI_MAX, mpicomm);
+            end += 2 * tree_cost(commsize, scount / commsize);
+            break;
+
+        case silas::ALLGATHER:
+        case silas::ALLTOALL:
+            MPI_Allreduce(&start, &end, 1, MPI_DOUBLE, MPI_MAX, mpicomm);
+            end += tree_cost(commsize, 0) + rcount / m_bandwidth;
+            break;
+
+        case silas::SCAN:
+        case silas::EXSCAN:
+            MPI_Scan(&start, &end, 1, MPI_DOUBLE, MPI_MAX, mpicomm);
+            end += tree_cost(commsize, std::max(scount, rcount) / commsize);
+            break;
+
+        case silas::BCAST:
+            {
+                // one-to-all: wait for the root to enter the operation
+                int                rank;
+                int                root      = event->getRoot();
+                pearl::timestamp_t rootStart = start;
+
+                MPI_Comm_rank(mpicomm, &rank);
+                MPI_Bcast(&rootStart, 1, MPI_DOUBLE, root, mpicomm);
+                if (rank == root)
+                {
+                    end = start + m_overhead;
+                }
+                else
+                {
+                    end = rootStart + tree_cost(commsize, rcount);
+                }
+                break;
+            }
+
+        case silas::REDUCE:
+            {
+                // all-to-one: the root waits for the last process to enter
+                int                rank;
+                int                root = event->getRoot();
+                pearl::timestamp_t maxStart;
+
+                MPI_Comm_rank(mpicomm, &rank);
+                MPI_Reduce(&start, &maxStart, 1, MPI_DOUBLE, MPI_MAX, root, mpicomm);
+                if (rank == root)
+                {
+                    end = maxStart + tree_cost(commsize, scount);
+                }
+                else
+                {
+                    end = start + m_overhead;
+                }
+                break;
+            }
+    }
+
+    m_clock = std::max(start, end);
+    event->setTimestamp(m_clock);
+}
+
+
+/*-- HELPER FUNCTIONS * ------------------------------------------------*/
+
+pearl::timestamp_t
+VirtualTimeModel::post_send(const pearl::Event& send)
+{
+    m_sends.push_back(TimeMessage());
+
+    const double bytes   = send->getBytesSent();
+    TimeMessage& message = m_sends.back();
+    message.data[0] = m_clock;
+    message.data[1] = bytes;
+
+    MPI_Isend(message.data, 2, MPI_DOUBLE, send->getDestination(),
+              send->getTag(), send->getComm()->getHandle(), &message.request);
+    purge_sends();
+
+    send->setTimestamp(m_clock);
+    m_clock += m_overhead;
+
+    return m_clock + bytes / m_bandwidth;
+}
+
+
+void
+VirtualTimeModel::post_irecv(const pearl::Event& request)
+{
+    pearl::Event comp    = request.completion();
+    TimeMessage& message = m_recvs[request->getRequestId()];
+
+    MPI_Irecv(message.data, 2, MPI_DOUBLE, comp->getSource(), comp->getTag(),
+              comp->getComm()->getHandle(), &message.request);
+
+    request->setTimestamp(m_clock);
+}
+
+
+pearl::timestamp_t
+VirtualTimeModel::arrival_time(const double* data) const
+{
+    return data[0] + m_overhead + m_latency + data[1] / m_bandwidth;
+}
+
+
+pearl::timestamp_t
+VirtualTimeModel::tree_cost(const int      commsize,
+                            const uint64_t bytes) const
+{
+    int stages = 0;
+    for (int procs = 1; procs < commsize; procs *= 2)
+    {
+        ++stages;
+    }
+
+    return stages * (m_latency + m_overhead + bytes / m_bandwidth);
+}
+
+
+void
+VirtualTimeModel::purge_sends()
+{
+    while (!m_sends.empty())
+    {
+        int done;
+        MPI_Test(&m_sends.front().request, &done, MPI_STATUS_IGNORE);
+        if (!done)
+        {
+            break;
+        }
+        m_sends.pop_front();
+    }
+}
@@ -0,0 +1,252 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SILAS_VIRTUALTIMEMODEL_H
+#define SILAS_VIRTUALTIMEMODEL_H
+
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include <mpi.h>
+
+#include "ReenactModel.h"
+
+
+namespace silas
+{
+/**
+ * Simulation model based on per-location virtual clocks. Instead of
+ * re-enacting user time and message transfers in real time, the clock
+ * of each location is advanced analytically: computation phases take
+ * their (possibly modified) traced duration, while point-to-point and
+ * collective completion times are derived from a LogGP-style network
+ * cost model with latency L, per-message overhead o and per-byte gap
+ * G = 1 / bandwidth.  Only virtual timestamps are exchanged between
+ * processes during the replay, so the simulation time is independent
+ * of the runtime of the traced application.
+ *
+ * Hypothesis application, idle-time aggregation and postprocessing are
+ * shared with the ReenactModel.  Multiple-completion calls are always
+ * handled deterministically, i.e., requests complete as recorded in
+ * the trace.
+ *
+ * The following model options are supported (times in seconds):
+ *  - "network latency"   (default: 1e-6)
+ *  - "network bandwidth" (in bytes/s; default: 1e9)
+ *  - "network overhead"  (default: 5e-7)
+ */
+class VirtualTimeModel
+    : public ReenactModel
+{
+    public:
+        /**
+         * Constructor.
+         */
+        VirtualTimeModel();
+
+        /**
+         * Return the model name as a std::string to be used in
+         * log functions etc.
+         * @return name of the model
+         */
+        virtual const std::string
+        get_name() const;
+
+        /**
+         * Trigger callback registration
+         */
+        virtual void
+        register_callbacks(const int               run,
+                           pearl::CallbackManager* cbmanager);
+
+
+    private:
+        /// Payload of virtual-time messages: send time and message size
+        struct TimeMessage
+        {
+            MPI_Request request;
+            double      data[2];
+        };
+
+
+        /// @name Preparation step callbacks
+        /// @{
+        void
+        cb_finish_prepare_virtual(const pearl::CallbackManager& cbmanager,
+                                  int                           user_event,
+                                  const pearl::Event&           event,
+                                  pearl::CallbackData*          cdata);
+
+        /// @}
+        /// @name Simulation step callbacks
+        /// @{
+        void
+        cb_start_virtual(const pearl::CallbackManager& cbmanager,
+                         int                           user_event,
+                         const pearl::Event&           event,
+                         pearl::CallbackData*          cdata);
+
+        void
+        cb_finish_virtual(const pearl::CallbackManager& cbmanager,
+                          int                           user_event,
+                          const pearl::Event&           event,
+                          pearl::CallbackData*          cdata);
+
+        void
+        cb_begin_virtual(const pearl::CallbackManager& cbmanager,
+                         int                           user_event,
+                         const pearl::Event&           event,
+                         pearl::CallbackData*          cdata);
+
+        void
+        cb_end_virtual(const pearl::CallbackManager& cbmanager,
+                       int                           user_event,
+                       const pearl::Event&           event,
+                       pearl::CallbackData*          cdata);
+
+        void
+        cb_idle_virtual(const pearl::CallbackManager& cbmanager,
+                        int                           user_event,
+                        const pearl::Event&           event,
+                        pearl::CallbackData*          cdata);
+
+        void
+        cb_idle_write_virtual(const pearl::CallbackManager& cbmanager,
+                              int                           user_event,
+                              const pearl::Event&           event,
+                              pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_send_virtual(const pearl::CallbackManager& cbmanager,
+                            int                           user_event,
+                            const pearl::Event&           event,
+                            pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_isend_virtual(const pearl::CallbackManager& cbmanager,
+                             int                           user_event,
+                             const pearl::Event&           event,
+                             pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_recv_virtual(const pearl::CallbackManager& cbmanager,
+                            int                           user_event,
+                            const pearl::Event&           event,
+                            pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_irecv_virtual(const pearl::CallbackManager& cbmanager,
+                             int                           user_event,
+                             const pearl::Event&           event,
+                             pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_start_virtual(const pearl::CallbackManager& cbmanager,
+                             int                           user_event,
+                             const pearl::Event&           event,
+                             pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_sendrecv_virtual(const pearl::CallbackManager& cbmanager,
+                                int                           user_event,
+                                const pearl::Event&           event,
+                                pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_wait_virtual(const pearl::CallbackManager& cbmanager,
+                            int                           user_event,
+                            const pearl::Event&           event,
+                            pearl::CallbackData*          cdata);
+
+        void
+        cb_mpi_collective_virtual(const pearl::CallbackManager& cbmanager,
+                                  int                           user_event,
+                                  const pearl::Event&           event,
+                                  pearl::CallbackData*          cdata);
+
+        /// @}
+
+        /**
+         * Post the virtual-time message for the given send event and
+         * advance the virtual clock by the send overhead
+         * @param send          the send event
+         * @return local completion time of the send operation
+         */
+        pearl::timestamp_t
+        post_send(const pearl::Event& send);
+
+        /**
+         * Post a nonblocking receive for the virtual-time message matching
+         * the given receive request event
+         * @param request       the receive request event
+         */
+        void
+        post_irecv(const pearl::Event& request);
+
+        /**
+         * Determine the arrival time of a received virtual-time message
+         * @param data          message payload
+         * @return arrival time
+         */
+        pearl::timestamp_t
+        arrival_time(const double* data) const;
+
+        /**
+         * Determine the virtual duration of a tree-based collective
+         * transferring the given number of bytes per stage
+         * @param commsize      number of processes involved
+         * @param bytes         number of bytes per stage
+         */
+        pearl::timestamp_t
+        tree_cost(int      commsize,
+                  uint64_t bytes) const;
+
+        /**
+         * Release virtual-time messages which have already been sent
+         */
+        void
+        purge_sends();
+
+
+        /// current virtual time of the local location
+        pearl::timestamp_t m_clock;
+
+        /// @name Network cost model parameters
+        /// @{
+
+        double m_latency;
+        double m_bandwidth;
+        double m_overhead;
+
+        /// @}
+        /// @name Outstanding virtual-time messages
+        /// @{
+
+        /// sends in flight, in posting order
+        std::deque< TimeMessage > m_sends;
+
+        /// nonblocking receives, indexed by request ID
+        std::map< uint64_t, TimeMessage > m_recvs;
+
+        /// local completion times of nonblocking sends, indexed by request ID
+        std::map< uint64_t, pearl::timestamp_t > m_send_completions;
+
+        /// @}
+};
+}    // namespace silas
+
+
+#endif    // !SILAS_VIRTUALTIMEMODEL_H
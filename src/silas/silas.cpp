@@ -18,12 +18,14 @@
 
 #include <sys/stat.h>
 
+#include <cctype>
 #include <cstdarg>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <UTILS_Debug.h>
 #include <UTILS_Error.h>
@@ -45,6 +47,7 @@
 #include "SilasConfig.h"
 #include "Simulator.h"
 #include "Timer.h"
+#include "TraceSnapshot.h"
 
 using namespace std;
 using namespace pearl;
@@ -65,14 +68,16 @@ int mpiRank;
 
 /* Using reenact model for simulation */
 Model* model = NULL;
-/* Using an empty hypothesis will result in identity simulation */
-Hypothesis* hypothesis = new Hypothesis();
+/* Hypotheses to be simulated; the first one is the default hypothesis,
+ * further ones are evaluated in batch mode.  Using an empty hypothesis
+ * will result in identity simulation */
+vector< Hypothesis* > hypotheses;
 /* Hypothesis Part to simulate load balance */
-HypBalance* balancer = new HypBalance();
+HypBalance* balancer = NULL;
 /* Hypothesis Part to cut zero sized messages */
-HypCutMessage* message_surgeon = new HypCutMessage();
+HypCutMessage* message_surgeon = NULL;
 /* Region scaler */
-HypScale* rescaler = new HypScale();
+HypScale* rescaler = NULL;
 
 
 // --- Function prototypes --------------------------------------------------
@@ -107,7 +112,20 @@ preprocess_trace(GlobalDefs& defs,
                  LocalTrace& trace);
 
 void
-simulate_trace(LocalTrace& trace);
+begin_hypothesis(const string& name);
+
+void
+simulate_trace(Simulator&        simulator,
+               const Hypothesis& hypothesis);
+
+void
+simulate_batch(Simulator&  simulator,
+               GlobalDefs& defs,
+               LocalTrace& trace,
+               Config&     config);
+
+double
+get_predicted_runtime(const LocalTrace& trace);
 
 void
 write_trace(GlobalDefs& defs,
@@ -133,7 +151,10 @@ show_help(int exitcode)
         "    -c <config>   Configuration file to use for simulation\n"
         "    -h            Show this help and exit\n"
         "    -i            Input trace (anchor file | EPIK directory)\n"
-        "    -o            Output experiment directory name\n");
+        "    -o            Output experiment directory name\n"
+        "    -t            In batch mode, also write the predicted traces of\n"
+        "                  the named hypotheses (as <output>_<hypothesis name>);\n"
+        "                  the default hypothesis is always written to <output>\n");
 
     exit(exitcode);
 }
@@ -187,6 +208,12 @@ parse_commandline(int            argc,
                         break;
                     }
 
+                case 't':
+                    {
+                        config->set_write_batch_traces(true);
+                        break;
+                    }
+
                 default:
                     {
                         /* unknown option */
@@ -214,6 +241,9 @@ main(int    argc,
     /* display copyright notice */
     log("SILAS   %s\n\n", copyright);
 
+    /* hypothesis parts given outside of named hypotheses */
+    begin_hypothesis("default");
+
     parse_commandline(argc, argv, config);
 
     /* validate and open trace archive */
@@ -228,14 +258,30 @@ main(int    argc,
 
     /* preprocess trace for simulation: unification, etc. */
     preprocess_trace(*defs, *trace);
-    /* trigger simulation */
-    simulate_trace(*trace);
 
-    /* write trace to disk */
-    write_trace(*defs, *trace, config->get_output_trace().c_str());
+    /* Creating simulator object with model */
+    Simulator simulator(*trace, model);
+    if (hypotheses.size() == 1)
+    {
+        /* trigger simulation */
+        simulate_trace(simulator, *hypotheses.front());
+
+        /* write trace to disk */
+        write_trace(*defs, *trace, config->get_output_trace().c_str());
+    }
+    else
+    {
+        /* simulate all hypotheses on the same trace data */
+        simulate_batch(simulator, *defs, *trace, *config);
+    }
 
     log("\nTotal processing time: %s\n\n", total_time.value_str().c_str());
 
+    while (!hypotheses.empty())
+    {
+        delete hypotheses.back();
+        hypotheses.pop_back();
+    }
     delete config;
 
     PEARL_finalize();
@@ -506,27 +552,42 @@ preprocess_trace(GlobalDefs& defs,
 
 
 /**
- * Start simulation process
- * @param trace Reference to event trace
+ * Create a new hypothesis and make it the target of subsequent
+ * hypothesis parts given in the configuration file
+ * @param name Name of the hypothesis
  */
 void
-simulate_trace(LocalTrace& trace)
+begin_hypothesis(const string& name)
 {
-    /* Creating simulator object with model and hypothesis */
-    Simulator simulator(trace, model, hypothesis);
-    /* Time object to time overall simulation time */
-    Timer simulation_time;
+    Hypothesis* result = new Hypothesis(name);
+
+    balancer        = new HypBalance();
+    message_surgeon = new HypCutMessage();
+    rescaler        = new HypScale();
+
+    result->add_part(balancer);
+    result->add_part(message_surgeon);
+    result->add_part(rescaler);
+
+    hypotheses.push_back(result);
+}
 
-    hypothesis->add_part(balancer);
-    hypothesis->add_part(message_surgeon);
-    hypothesis->add_part(rescaler);
 
+/**
+ * Start simulation process
+ * @param simulator Reference to simulator object
+ * @param hypothesis Reference to hypothesis to be simulated
+ */
+void
+simulate_trace(Simulator&        simulator,
+               const Hypothesis& hypothesis)
+{
     /* start simulation */
     string message;
     bool   error = false;
     try
     {
-        simulator.run();
+        simulator.run(hypothesis);
     }
     catch (const exception& ex)
     {
@@ -538,6 +599,105 @@ simulate_trace(LocalTrace& trace)
 }
 
 
+/**
+ * Simulate all hypotheses one after another on the trace read once,
+ * restoring the original trace data in between, and print a summary of
+ * the predicted runtimes.  The predicted trace of the default hypothesis
+ * is written to the output experiment; those of the named hypotheses only
+ * if requested.
+ * @param simulator Reference to simulator object
+ * @param defs Reference to global definitions
+ * @param trace Reference to event trace
+ * @param config Reference to simulator configuration
+ */
+void
+simulate_batch(Simulator&  simulator,
+               GlobalDefs& defs,
+               LocalTrace& trace,
+               Config&     config)
+{
+    /* save original event order, timestamps and request IDs */
+    const TraceSnapshot snapshot(trace);
+
+    vector< double > runtimes;
+    runtimes.reserve(hypotheses.size());
+    for (size_t i = 0; i < hypotheses.size(); ++i)
+    {
+        const Hypothesis& hypothesis = *hypotheses[i];
+
+        if (i > 0)
+        {
+            snapshot.restore(trace);
+        }
+
+        log("\nHypothesis \"%s\" (%lu of %lu)\n",
+            hypothesis.get_name().c_str(),
+            static_cast< unsigned long >(i + 1),
+            static_cast< unsigned long >(hypotheses.size()));
+        simulate_trace(simulator, hypothesis);
+        runtimes.push_back(get_predicted_runtime(trace));
+
+        if (i == 0)
+        {
+            /* the default hypothesis is written as in single mode */
+            write_trace(defs, trace, config.get_output_trace().c_str());
+        }
+        else if (config.get_write_batch_traces())
+        {
+            /* derive a valid directory name from the hypothesis name */
+            string suffix = hypothesis.get_name();
+            for (string::iterator it = suffix.begin(); it != suffix.end(); ++it)
+            {
+                if (!isalnum(*it) && (*it != '-') && (*it != '.'))
+                {
+                    *it = '_';
+                }
+            }
+            write_trace(defs, trace,
+                        (config.get_output_trace() + "_" + suffix).c_str());
+        }
+    }
+
+    /* display summary table */
+    log("\nPredicted runtimes:\n\n"
+        "  %-40s %14s %10s\n", "Hypothesis", "Runtime [s]", "Relative");
+    for (size_t i = 0; i < hypotheses.size(); ++i)
+    {
+        log("  %-40s %14.6f %10.3f\n",
+            hypotheses[i]->get_name().c_str(),
+            runtimes[i],
+            (runtimes[0] > 0.0) ? runtimes[i] / runtimes[0] : 0.0);
+    }
+}
+
+
+/**
+ * Determine the predicted runtime of the simulated trace, i.e., the time
+ * between the earliest first event and the latest last event of all
+ * processes
+ * @param trace Reference to event trace
+ * @return Predicted runtime (valid on rank 0 only)
+ */
+double
+get_predicted_runtime(const LocalTrace& trace)
+{
+    double local[2] = { 0.0, 0.0 };
+    double global[2];
+
+    if (trace.size() > 0)
+    {
+        Event last = trace.end();
+        --last;
+
+        local[0] = -trace.begin()->getTimestamp();
+        local[1] = last->getTimestamp();
+    }
+    MPI_Reduce(local, global, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    return global[0] + global[1];
+}
+
+
 /**
  * Writing the predicted event trace to disk
  * @param defs Reference to global definitions
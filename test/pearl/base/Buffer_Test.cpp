@@ -0,0 +1,131 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include <pearl/Buffer.h>
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+
+
+// --- Helper ---------------------------------------------------------------
+
+namespace
+{
+// Buffer providing access to the byte-order marker, used to simulate data
+// originating from a system with a different byte order
+class ForeignBuffer
+    : public Buffer
+{
+    public:
+        void
+        markForeign()
+        {
+            m_data[0] = static_cast< uint8_t >(~m_data[0]);
+        }
+};
+
+
+// Buffer providing read access to its raw contents
+class RawBuffer
+    : public Buffer
+{
+    public:
+        RawBuffer(std::size_t capacity = 512)
+            : Buffer(capacity)
+        {
+        }
+
+        const uint8_t*
+        data() const
+        {
+            return m_data;
+        }
+};
+}    // unnamed namespace
+
+
+// --- Buffer tests ---------------------------------------------------------
+
+TEST(BufferT,
+     putUint32Array_values_matchesScalarEncoding)
+{
+    const uint32_t values[] = { 1, 0xdeadbeef, 42 };
+
+    RawBuffer bulk(4);
+    bulk.put_uint32_array(values, 3);
+    RawBuffer scalar;
+    for (int i = 0; i < 3; ++i)
+    {
+        scalar.put_uint32(values[i]);
+    }
+
+    ASSERT_EQ(scalar.size(), bulk.size());
+    EXPECT_EQ(0, memcmp(scalar.data(), bulk.data(), bulk.size()));
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(values[i], bulk.get_uint32());
+    }
+}
+
+
+TEST(BufferT,
+     getArray_packedArrays_returnsValues)
+{
+    const uint32_t ids[]   = { 3, 1, 4 };
+    const uint64_t sizes[] = { 1, 0x0123456789abcdefULL };
+    const double   times[] = { 0.5, -2.25, 1e10 };
+
+    Buffer buffer;
+    buffer.put_uint32_array(ids, 3);
+    buffer.put_uint64_array(sizes, 2);
+    buffer.put_double_array(times, 3);
+    buffer.put_uint32_array(ids, 0);
+
+    uint32_t resultIds[3];
+    uint64_t resultSizes[2];
+    double   resultTimes[3];
+    buffer.get_uint32_array(resultIds, 3);
+    buffer.get_uint64_array(resultSizes, 2);
+    buffer.get_double_array(resultTimes, 3);
+
+    EXPECT_EQ(buffer.size(), buffer.position());
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(ids[i], resultIds[i]);
+        EXPECT_EQ(times[i], resultTimes[i]);
+    }
+    EXPECT_EQ(sizes[0], resultSizes[0]);
+    EXPECT_EQ(sizes[1], resultSizes[1]);
+}
+
+
+TEST(BufferT,
+     getUint32Array_foreignByteOrder_swapsBytes)
+{
+    const uint32_t values[] = { 0x01020304, 0xa0b0c0d0 };
+
+    ForeignBuffer buffer;
+    buffer.put_uint32_array(values, 2);
+    buffer.markForeign();
+
+    uint32_t result[2];
+    buffer.get_uint32_array(result, 2);
+    EXPECT_EQ(0x04030201u, result[0]);
+    EXPECT_EQ(0xd0c0b0a0u, result[1]);
+}
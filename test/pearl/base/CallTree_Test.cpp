@@ -0,0 +1,251 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "CallTree.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pearl/Buffer.h>
+#include <pearl/Callpath.h>
+#include <pearl/Callsite.h>
+#include <pearl/Paradigm.h>
+#include <pearl/Region.h>
+#include <pearl/String.h>
+
+#include "MutableGlobalDefs.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace pearl::detail;
+
+
+// --- Helper ---------------------------------------------------------------
+
+namespace
+{
+// Number of regions; large enough to exceed the hash index threshold
+const uint32_t NUM_REGIONS = 100;
+
+
+// Test fixture for CallTree tests
+class CallTreeT
+    : public Test
+{
+    public:
+        CallTreeT();
+
+
+    protected:
+        MutableGlobalDefs mDefs;
+        vector< Region* > mRegions;
+        const Callsite&   mCallsite;
+        CallTree          mItem;
+};
+}    // unnamed namespace
+
+
+// --- CallTree tests -------------------------------------------------------
+
+TEST_F(CallTreeT,
+       getCallpath_newRoot_createsCallpath)
+{
+    Callpath* root = mItem.getCallpath(*mRegions[0], Callsite::UNDEFINED, NULL);
+
+    ASSERT_TRUE(root != NULL);
+    EXPECT_EQ(0u, root->getId());
+    EXPECT_EQ(*mRegions[0], root->getRegion());
+    EXPECT_TRUE(root->getParent() == NULL);
+    EXPECT_EQ(1u, mItem.numCallpaths());
+    EXPECT_TRUE(mItem.getModified());
+}
+
+
+TEST_F(CallTreeT,
+       getCallpath_existingChild_returnsSameCallpath)
+{
+    Callpath* root  = mItem.getCallpath(*mRegions[0], Callsite::UNDEFINED, NULL);
+    Callpath* child = mItem.getCallpath(*mRegions[1], Callsite::UNDEFINED, root);
+
+    EXPECT_EQ(child, mItem.getCallpath(*mRegions[1], Callsite::UNDEFINED, root));
+    EXPECT_EQ(2u, mItem.numCallpaths());
+}
+
+
+TEST_F(CallTreeT,
+       getCallpath_differentCallsite_createsCallpath)
+{
+    Callpath* root   = mItem.getCallpath(*mRegions[0], Callsite::UNDEFINED, NULL);
+    Callpath* child1 = mItem.getCallpath(*mRegions[1], Callsite::UNDEFINED, root);
+    Callpath* child2 = mItem.getCallpath(*mRegions[1], mCallsite, root);
+
+    EXPECT_NE(child1, child2);
+    EXPECT_EQ(mCallsite, child2->getCallsite());
+    EXPECT_EQ(3u, mItem.numCallpaths());
+}
+
+
+TEST_F(CallTreeT,
+       getCallpath_wideFanOut_returnsExistingChildren)
+{
+    Callpath*           root = mItem.getCallpath(*mRegions[0], Callsite::UNDEFINED, NULL);
+    vector< Callpath* > children;
+    for (uint32_t i = 1; i < NUM_REGIONS; ++i)
+    {
+        children.push_back(mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, root));
+        children.push_back(mItem.getCallpath(*mRegions[i], mCallsite, root));
+    }
+    ASSERT_EQ(2 * (NUM_REGIONS - 1), root->numChildren());
+
+    for (uint32_t i = 1; i < NUM_REGIONS; ++i)
+    {
+        EXPECT_EQ(children[2 * (i - 1)],
+                  mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, root));
+        EXPECT_EQ(children[2 * (i - 1) + 1],
+                  mItem.getCallpath(*mRegions[i], mCallsite, root));
+    }
+    EXPECT_EQ(2 * NUM_REGIONS - 1, mItem.numCallpaths());
+}
+
+
+TEST_F(CallTreeT,
+       getCallpath_wideFanOutSameRegions_distinguishesParents)
+{
+    vector< Callpath* > roots;
+    vector< Callpath* > children;
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        roots.push_back(mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, NULL));
+    }
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        children.push_back(mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, roots[0]));
+    }
+
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        EXPECT_NE(roots[i], children[i]);
+        EXPECT_EQ(roots[i],
+                  mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, NULL));
+        EXPECT_EQ(children[i],
+                  mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, roots[0]));
+    }
+    EXPECT_EQ(2 * NUM_REGIONS, mItem.numCallpaths());
+}
+
+
+TEST_F(CallTreeT,
+       getCallpath_manyRoots_returnsExistingRoots)
+{
+    vector< Callpath* > roots;
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        roots.push_back(mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, NULL));
+    }
+
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        EXPECT_EQ(roots[i],
+                  mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, NULL));
+    }
+    EXPECT_EQ(NUM_REGIONS, mItem.numCallpaths());
+}
+
+
+TEST_F(CallTreeT,
+       truncate_addedCallpaths_restoresCommonCallpaths)
+{
+    Callpath* root  = mItem.getCallpath(*mRegions[0], Callsite::UNDEFINED, NULL);
+    Callpath* child = mItem.getCallpath(*mRegions[1], Callsite::UNDEFINED, root);
+    mItem.setCommon();
+    for (uint32_t i = 2; i < NUM_REGIONS; ++i)
+    {
+        mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, root);
+        mItem.getCallpath(*mRegions[i], Callsite::UNDEFINED, NULL);
+    }
+
+    mItem.truncate(mItem.numCommon());
+
+    EXPECT_EQ(2u, mItem.numCallpaths());
+    EXPECT_EQ(1u, root->numChildren());
+    EXPECT_EQ(child, mItem.getCallpath(*mRegions[1], Callsite::UNDEFINED, root));
+    EXPECT_EQ(2u, mItem.getCallpath(*mRegions[2], Callsite::UNDEFINED, root)->getId());
+}
+
+
+TEST_F(CallTreeT,
+       mergeDelta_packedDelta_addsMissingCallpaths)
+{
+    CallTree  other;
+    Callpath* root      = mItem.getCallpath(*mRegions[0], Callsite::UNDEFINED, NULL);
+    Callpath* otherRoot = other.getCallpath(*mRegions[0], Callsite::UNDEFINED, NULL);
+    mItem.setCommon();
+    other.setCommon();
+
+    // Partially overlapping deltas
+    Callpath* child  = mItem.getCallpath(*mRegions[1], Callsite::UNDEFINED, root);
+    Callpath* nested = mItem.getCallpath(*mRegions[2], mCallsite, child);
+    other.getCallpath(*mRegions[3], Callsite::UNDEFINED, otherRoot);
+    Callpath* otherChild = other.getCallpath(*mRegions[1], Callsite::UNDEFINED, otherRoot);
+    other.getCallpath(*mRegions[4], Callsite::UNDEFINED, otherChild);
+
+    Buffer buffer;
+    other.packDelta(buffer, other.numCommon());
+    mItem.mergeDelta(mDefs, buffer);
+
+    ASSERT_EQ(5u, mItem.numCallpaths());
+    EXPECT_EQ(child, mItem.getCallpath(*mRegions[1], Callsite::UNDEFINED, root));
+    EXPECT_EQ(nested, mItem.getCallpath(*mRegions[2], mCallsite, child));
+    EXPECT_EQ(mItem.getCallpath(3), mItem.getCallpath(*mRegions[3], Callsite::UNDEFINED, root));
+    EXPECT_EQ(mItem.getCallpath(4), mItem.getCallpath(*mRegions[4], Callsite::UNDEFINED, child));
+}
+
+
+// --- Helper ---------------------------------------------------------------
+
+namespace
+{
+const Callsite&
+createCallsite(MutableGlobalDefs& defs)
+{
+    String* const name     = new String(0, "foo");
+    String* const fileName = new String(1, "foo.c");
+    defs.addString(name);
+    defs.addString(fileName);
+
+    Callsite* const callsite = new Callsite(0, *fileName, 42, Region::UNDEFINED);
+    defs.addCallsite(callsite);
+
+    return *callsite;
+}
+
+
+CallTreeT::CallTreeT()
+    : mCallsite(createCallsite(mDefs))
+{
+    const String& name     = mDefs.getString(0);
+    const String& fileName = mDefs.getString(1);
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        Region* const region = new Region(i, name, name, String::UNDEFINED,
+                                          Region::ROLE_FUNCTION,
+                                          Paradigm::COMPILER, fileName, 17, 24);
+        mDefs.addRegion(region);
+        mRegions.push_back(region);
+    }
+}
+}    // unnamed namespace
@@ -0,0 +1,651 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include <pearl/LocalTrace.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pearl/Callback.h>
+#include <pearl/CallbackData.h>
+#include <pearl/CallbackManager.h>
+#include <pearl/Enter_rep.h>
+#include <pearl/Event.h>
+#include <pearl/Leave_rep.h>
+#include <pearl/Location.h>
+#include <pearl/Paradigm.h>
+#include <pearl/Region.h>
+#include <pearl/ScopedPtr.h>
+#include <pearl/String.h>
+#include <pearl/SystemNode.h>
+#include <pearl/ThreadFork_rep.h>
+#include <pearl/ThreadJoin_rep.h>
+#include <pearl/TraceArchive.h>
+#include <pearl/pearl_replay.h>
+
+#include "MutableGlobalDefs.h"
+#include "Process.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace pearl::detail;
+
+
+// --- Helper ---------------------------------------------------------------
+
+namespace
+{
+// Number of events in the test trace; spans three blocks of the block type
+// index used by LocalTrace::find()
+const uint32_t NUM_EVENTS = 600;
+
+// Positions of the only THREAD_FORK/THREAD_JOIN events, located in the
+// second and third block, respectively
+const uint32_t FORK_INDEX = 301;
+const uint32_t JOIN_INDEX = 522;
+
+
+// Trace archive creating a fixed in-memory event sequence:
+//
+//   ENTER(main) { ENTER(foo) LEAVE(foo) }* THREAD_FORK
+//               { ENTER(foo) LEAVE(foo) }* THREAD_JOIN
+//               { ENTER(foo) LEAVE(foo) }* LEAVE(main)
+//
+// The timestamp of each event equals its index.
+class TestArchive
+    : public TraceArchive
+{
+    public:
+        TestArchive(const Region& main,
+                    const Region& foo);
+
+
+    private:
+        const Region& mMain;
+        const Region& mFoo;
+
+
+        virtual void
+        openArchive();
+
+        virtual void
+        openContainer(const LocationGroup& locGroup);
+
+        virtual void
+        closeContainer();
+
+        virtual void
+        readDefinitions(GlobalDefs* defs);
+
+        virtual LocalIdMaps*
+        readIdMaps(const Location& location);
+
+        virtual void
+        readTrace(const GlobalDefs& defs,
+                  const Location&   location,
+                  LocalIdMaps*      idMaps,
+                  LocalTrace*       trace);
+};
+
+
+// Test fixture for LocalTrace tests
+class LocalTraceT
+    : public Test
+{
+    public:
+        LocalTraceT();
+
+
+    protected:
+        MutableGlobalDefs       mDefs;
+        Location*               mLocation;
+        ScopedPtr< LocalTrace > mTrace;
+};
+
+
+// Records the sequence of callback invocations and visited events
+class Recorder
+    : public CallbackData
+{
+    public:
+        // Callback invocations as (callback tag, event index) pairs
+        vector< pair< char, uint32_t > > mCalls;
+
+        // Indices of the events passed to preprocess()
+        vector< uint32_t > mVisited;
+
+
+        virtual void
+        preprocess(const Event& event);
+
+        void
+        cbFork(const CallbackManager& cbmanager,
+               int                    userEvent,
+               const Event&           event,
+               CallbackData*          data);
+
+        void
+        cbForkLater(const CallbackManager& cbmanager,
+                    int                    userEvent,
+                    const Event&           event,
+                    CallbackData*          data);
+
+        void
+        cbJoin(const CallbackManager& cbmanager,
+               int                    userEvent,
+               const Event&           event,
+               CallbackData*          data);
+
+        void
+        cbLeave(const CallbackManager& cbmanager,
+                int                    userEvent,
+                const Event&           event,
+                CallbackData*          data);
+};
+
+
+// Returns a set of event types containing only @p type
+LocalTrace::type_set
+typeSet(const event_t type)
+{
+    LocalTrace::type_set result;
+    result.set(type);
+
+    return result;
+}
+
+
+// Returns the index of the event referenced by the reverse iterator @p it
+uint32_t
+index(const LocalTrace::reverse_iterator& it)
+{
+    return it.base().get_id() - 1;
+}
+}    // unnamed namespace
+
+
+// --- LocalTrace::find() tests ---------------------------------------------
+
+TEST_F(LocalTraceT,
+       find_firstEvent_returnsBegin)
+{
+    LocalTrace::iterator it = mTrace->find(mTrace->begin(), mTrace->end(),
+                                           typeSet(ENTER));
+
+    EXPECT_TRUE(it == mTrace->begin());
+    EXPECT_EQ(0u, it.get_id());
+}
+
+
+TEST_F(LocalTraceT,
+       find_eventInLaterBlock_returnsMatch)
+{
+    LocalTrace::iterator it = mTrace->find(mTrace->begin(), mTrace->end(),
+                                           typeSet(THREAD_JOIN));
+
+    ASSERT_FALSE(it == mTrace->end());
+    EXPECT_EQ(JOIN_INDEX, it.get_id());
+    EXPECT_EQ(THREAD_JOIN, it->getType());
+}
+
+
+TEST_F(LocalTraceT,
+       find_multipleTypes_returnsFirstMatch)
+{
+    LocalTrace::type_set types;
+    types.set(THREAD_FORK);
+    types.set(THREAD_JOIN);
+
+    LocalTrace::iterator it = mTrace->find(mTrace->begin(), mTrace->end(),
+                                           types);
+    EXPECT_EQ(FORK_INDEX, it.get_id());
+
+    it = mTrace->find(++it, mTrace->end(), types);
+    EXPECT_EQ(JOIN_INDEX, it.get_id());
+
+    it = mTrace->find(++it, mTrace->end(), types);
+    EXPECT_TRUE(it == mTrace->end());
+}
+
+
+TEST_F(LocalTraceT,
+       find_lastEvent_returnsMatch)
+{
+    LocalTrace::iterator it = mTrace->find(mTrace->at(NUM_EVENTS - 1),
+                                           mTrace->end(),
+                                           typeSet(LEAVE));
+
+    EXPECT_EQ(NUM_EVENTS - 1, it.get_id());
+    EXPECT_TRUE(++it == mTrace->end());
+}
+
+
+TEST_F(LocalTraceT,
+       find_unknownType_returnsLast)
+{
+    LocalTrace::iterator it = mTrace->find(mTrace->begin(), mTrace->end(),
+                                           typeSet(MPI_SEND));
+
+    EXPECT_TRUE(it == mTrace->end());
+}
+
+
+TEST_F(LocalTraceT,
+       find_matchOutsideRange_returnsLast)
+{
+    // Range end is exclusive
+    LocalTrace::iterator last = mTrace->at(JOIN_INDEX);
+    LocalTrace::iterator it   = mTrace->find(mTrace->begin(), last,
+                                             typeSet(THREAD_JOIN));
+    EXPECT_TRUE(it == last);
+
+    // Match before the range start
+    it = mTrace->find(mTrace->at(FORK_INDEX + 1), mTrace->end(),
+                      typeSet(THREAD_FORK));
+    EXPECT_TRUE(it == mTrace->end());
+}
+
+
+TEST_F(LocalTraceT,
+       find_emptyRange_returnsLast)
+{
+    LocalTrace::iterator it = mTrace->find(mTrace->at(FORK_INDEX),
+                                           mTrace->at(FORK_INDEX),
+                                           typeSet(THREAD_FORK));
+
+    EXPECT_EQ(FORK_INDEX, it.get_id());
+}
+
+
+TEST_F(LocalTraceT,
+       findReverse_lastEvent_returnsRbegin)
+{
+    LocalTrace::reverse_iterator it = mTrace->find(mTrace->rbegin(),
+                                                   mTrace->rend(),
+                                                   typeSet(LEAVE));
+
+    EXPECT_TRUE(it == mTrace->rbegin());
+    EXPECT_EQ(NUM_EVENTS - 1, index(it));
+}
+
+
+TEST_F(LocalTraceT,
+       findReverse_eventInEarlierBlock_returnsMatch)
+{
+    LocalTrace::reverse_iterator it = mTrace->find(mTrace->rbegin(),
+                                                   mTrace->rend(),
+                                                   typeSet(THREAD_FORK));
+
+    ASSERT_FALSE(it == mTrace->rend());
+    EXPECT_EQ(FORK_INDEX, index(it));
+    EXPECT_EQ(THREAD_FORK, it->getType());
+}
+
+
+TEST_F(LocalTraceT,
+       findReverse_firstEvent_returnsMatch)
+{
+    LocalTrace::reverse_iterator it = mTrace->find(mTrace->rbegin(),
+                                                   mTrace->rend(),
+                                                   typeSet(ENTER));
+    EXPECT_EQ(NUM_EVENTS - 3, index(it));
+
+    // Restrict search to the first block
+    it = mTrace->find(LocalTrace::reverse_iterator(mTrace->at(1)),
+                      mTrace->rend(),
+                      typeSet(ENTER));
+    EXPECT_EQ(0u, index(it));
+    EXPECT_TRUE(++it == mTrace->rend());
+}
+
+
+TEST_F(LocalTraceT,
+       findReverse_unknownType_returnsLast)
+{
+    LocalTrace::reverse_iterator it = mTrace->find(mTrace->rbegin(),
+                                                   mTrace->rend(),
+                                                   typeSet(MPI_SEND));
+
+    EXPECT_TRUE(it == mTrace->rend());
+}
+
+
+TEST_F(LocalTraceT,
+       findReverse_matchOutsideRange_returnsLast)
+{
+    // Search backwards starting just before the THREAD_FORK event
+    LocalTrace::reverse_iterator it =
+        mTrace->find(LocalTrace::reverse_iterator(mTrace->at(FORK_INDEX)),
+                     mTrace->rend(),
+                     typeSet(THREAD_FORK));
+    EXPECT_TRUE(it == mTrace->rend());
+
+    // Search backwards to (but excluding) the THREAD_JOIN event
+    LocalTrace::reverse_iterator last(mTrace->at(JOIN_INDEX + 1));
+    it = mTrace->find(mTrace->rbegin(), last, typeSet(THREAD_JOIN));
+    EXPECT_TRUE(it == last);
+}
+
+
+TEST_F(LocalTraceT,
+       find_afterModification_usesUpdatedIndex)
+{
+    const LocalTrace::type_set types = typeSet(THREAD_FORK);
+
+    // Build block type index, then append a new matching event
+    EXPECT_EQ(FORK_INDEX,
+              mTrace->find(mTrace->begin(), mTrace->end(), types).get_id());
+    mTrace->add_event(new ThreadFork_rep(NUM_EVENTS, 2, Paradigm::OPENMP));
+
+    LocalTrace::iterator it = mTrace->find(mTrace->at(FORK_INDEX + 1),
+                                           mTrace->end(),
+                                           types);
+    EXPECT_EQ(NUM_EVENTS, it.get_id());
+}
+
+
+// --- Selective replay tests -----------------------------------------------
+
+TEST_F(LocalTraceT,
+       selectiveForwardReplay_callbacks_fireInTraceOrder)
+{
+    Recorder        recorder;
+    CallbackManager cbmanager;
+    cbmanager.register_callback(THREAD_FORK,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbFork));
+    cbmanager.register_callback(THREAD_JOIN,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbJoin));
+    cbmanager.register_callback(THREAD_FORK,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbForkLater));
+
+    PEARL_selective_forward_replay(*mTrace, cbmanager, &recorder);
+
+    // Callbacks registered for the same event type fire in order of
+    // registration
+    ASSERT_EQ(3u, recorder.mCalls.size());
+    EXPECT_EQ(make_pair('F', FORK_INDEX), recorder.mCalls[0]);
+    EXPECT_EQ(make_pair('f', FORK_INDEX), recorder.mCalls[1]);
+    EXPECT_EQ(make_pair('J', JOIN_INDEX), recorder.mCalls[2]);
+
+    ASSERT_EQ(2u, recorder.mVisited.size());
+    EXPECT_EQ(FORK_INDEX, recorder.mVisited[0]);
+    EXPECT_EQ(JOIN_INDEX, recorder.mVisited[1]);
+}
+
+
+TEST_F(LocalTraceT,
+       selectiveBackwardReplay_callbacks_fireInReverseTraceOrder)
+{
+    Recorder        recorder;
+    CallbackManager cbmanager;
+    cbmanager.register_callback(THREAD_FORK,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbFork));
+    cbmanager.register_callback(THREAD_JOIN,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbJoin));
+    cbmanager.register_callback(THREAD_FORK,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbForkLater));
+
+    PEARL_selective_backward_replay(*mTrace, cbmanager, &recorder);
+
+    ASSERT_EQ(3u, recorder.mCalls.size());
+    EXPECT_EQ(make_pair('J', JOIN_INDEX), recorder.mCalls[0]);
+    EXPECT_EQ(make_pair('F', FORK_INDEX), recorder.mCalls[1]);
+    EXPECT_EQ(make_pair('f', FORK_INDEX), recorder.mCalls[2]);
+
+    ASSERT_EQ(2u, recorder.mVisited.size());
+    EXPECT_EQ(JOIN_INDEX, recorder.mVisited[0]);
+    EXPECT_EQ(FORK_INDEX, recorder.mVisited[1]);
+}
+
+
+TEST_F(LocalTraceT,
+       selectiveReplay_frequentType_visitsAllMatches)
+{
+    Recorder        recorder;
+    CallbackManager cbmanager;
+    cbmanager.register_callback(LEAVE,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbLeave));
+
+    // Collect the expected LEAVE events using a full traversal
+    vector< uint32_t > expected;
+    for (LocalTrace::iterator it = mTrace->begin();
+         it != mTrace->end();
+         ++it)
+    {
+        if (it->getType() == LEAVE)
+        {
+            expected.push_back(it.get_id());
+        }
+    }
+
+    PEARL_selective_forward_replay(*mTrace, cbmanager, &recorder);
+    EXPECT_EQ(expected, recorder.mVisited);
+    EXPECT_EQ(2u, recorder.mCalls.front().second);
+    EXPECT_EQ(NUM_EVENTS - 1, recorder.mCalls.back().second);
+    EXPECT_EQ(expected.size(), recorder.mCalls.size());
+
+    recorder.mCalls.clear();
+    recorder.mVisited.clear();
+    PEARL_selective_backward_replay(*mTrace, cbmanager, &recorder);
+    EXPECT_EQ(vector< uint32_t >(expected.rbegin(), expected.rend()),
+              recorder.mVisited);
+}
+
+
+TEST_F(LocalTraceT,
+       selectiveReplay_subrange_respectsBounds)
+{
+    Recorder        recorder;
+    CallbackManager cbmanager;
+    cbmanager.register_callback(THREAD_FORK,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbFork));
+    cbmanager.register_callback(THREAD_JOIN,
+                                PEARL_create_callback(&recorder,
+                                                      &Recorder::cbJoin));
+
+    // Forward: [FORK_INDEX + 1, end)
+    PEARL_selective_forward_replay(*mTrace, cbmanager, &recorder,
+                                   mTrace->at(FORK_INDEX + 1), mTrace->end());
+    ASSERT_EQ(1u, recorder.mCalls.size());
+    EXPECT_EQ(make_pair('J', JOIN_INDEX), recorder.mCalls[0]);
+
+    // Backward: events preceding JOIN_INDEX
+    recorder.mCalls.clear();
+    PEARL_selective_backward_replay(*mTrace, cbmanager, &recorder,
+                                    LocalTrace::reverse_iterator(
+                                        mTrace->at(JOIN_INDEX)),
+                                    mTrace->rend());
+    ASSERT_EQ(1u, recorder.mCalls.size());
+    EXPECT_EQ(make_pair('F', FORK_INDEX), recorder.mCalls[0]);
+}
+
+
+TEST_F(LocalTraceT,
+       selectiveReplay_noCallbacks_visitsNothing)
+{
+    Recorder        recorder;
+    CallbackManager cbmanager;
+
+    PEARL_selective_forward_replay(*mTrace, cbmanager, &recorder);
+    PEARL_selective_backward_replay(*mTrace, cbmanager, &recorder);
+
+    EXPECT_TRUE(recorder.mCalls.empty());
+    EXPECT_TRUE(recorder.mVisited.empty());
+}
+
+
+// --- Helper ---------------------------------------------------------------
+
+namespace
+{
+TestArchive::TestArchive(const Region& main,
+                         const Region& foo)
+    : TraceArchive("test", "test"),
+      mMain(main),
+      mFoo(foo)
+{
+}
+
+
+void
+TestArchive::openArchive()
+{
+}
+
+
+void
+TestArchive::openContainer(const LocationGroup&)
+{
+}
+
+
+void
+TestArchive::closeContainer()
+{
+}
+
+
+void
+TestArchive::readDefinitions(GlobalDefs*)
+{
+}
+
+
+LocalIdMaps*
+TestArchive::readIdMaps(const Location&)
+{
+    return NULL;
+}
+
+
+void
+TestArchive::readTrace(const GlobalDefs&,
+                       const Location&,
+                       LocalIdMaps*,
+                       LocalTrace* trace)
+{
+    trace->add_event(new Enter_rep(0, mMain, NULL));
+    while (trace->size() < NUM_EVENTS - 1)
+    {
+        const timestamp_t timestamp = trace->size();
+        if (timestamp == FORK_INDEX)
+        {
+            trace->add_event(new ThreadFork_rep(timestamp, 2,
+                                                Paradigm::OPENMP));
+        }
+        else if (timestamp == JOIN_INDEX)
+        {
+            trace->add_event(new ThreadJoin_rep(timestamp, Paradigm::OPENMP));
+        }
+        else
+        {
+            trace->add_event(new Enter_rep(timestamp, mFoo, NULL));
+            trace->add_event(new Leave_rep(timestamp + 1, mFoo, NULL));
+        }
+    }
+    trace->add_event(new Leave_rep(NUM_EVENTS - 1, mMain, NULL));
+}
+
+
+LocalTraceT::LocalTraceT()
+    : mLocation(0)
+{
+    String* const name = new String(0, "main");
+    String* const foo  = new String(1, "foo");
+    mDefs.addString(name);
+    mDefs.addString(foo);
+
+    SystemNode* const node = new SystemNode(0, String::UNDEFINED,
+                                            String::UNDEFINED, 0);
+    mDefs.addSystemNode(node);
+    Process* const process = new Process(0, String::UNDEFINED, node);
+    mDefs.addLocationGroup(process);
+    mLocation = new Location(0, String::UNDEFINED, Location::TYPE_CPU_THREAD,
+                             NUM_EVENTS, process);
+    mDefs.addLocation(mLocation);
+
+    Region* const mainRegion = new Region(0, *name, *name, String::UNDEFINED,
+                                          Region::ROLE_FUNCTION,
+                                          Paradigm::USER, String::UNDEFINED,
+                                          0, 0);
+    Region* const fooRegion = new Region(1, *foo, *foo, String::UNDEFINED,
+                                         Region::ROLE_FUNCTION,
+                                         Paradigm::USER, String::UNDEFINED,
+                                         0, 0);
+    mDefs.addRegion(mainRegion);
+    mDefs.addRegion(fooRegion);
+
+    TestArchive archive(*mainRegion, *fooRegion);
+    mTrace.reset(archive.getTrace(mDefs, *mLocation));
+}
+
+
+void
+Recorder::preprocess(const Event& event)
+{
+    mVisited.push_back(event.get_id());
+}
+
+
+void
+Recorder::cbFork(const CallbackManager&,
+                 int,
+                 const Event& event,
+                 CallbackData*)
+{
+    mCalls.push_back(make_pair('F', event.get_id()));
+}
+
+
+void
+Recorder::cbForkLater(const CallbackManager&,
+                      int,
+                      const Event& event,
+                      CallbackData*)
+{
+    mCalls.push_back(make_pair('f', event.get_id()));
+}
+
+
+void
+Recorder::cbJoin(const CallbackManager&,
+                 int,
+                 const Event& event,
+                 CallbackData*)
+{
+    mCalls.push_back(make_pair('J', event.get_id()));
+}
+
+
+void
+Recorder::cbLeave(const CallbackManager&,
+                  int,
+                  const Event& event,
+                  CallbackData*)
+{
+    mCalls.push_back(make_pair('L', event.get_id()));
+}
+}    // unnamed namespace
@@ -0,0 +1,81 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "RequestTable.h"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl::detail;
+
+
+// --- RequestTable tests ---------------------------------------------------
+
+TEST(RequestTableT,
+     find_unknownRequest_returnsNoIndex)
+{
+    RequestTable table;
+
+    EXPECT_EQ(RequestTable::NO_INDEX, table.find(42));
+    EXPECT_EQ(0u, table.size());
+}
+
+
+TEST(RequestTableT,
+     insert_existingRequest_replacesIndex)
+{
+    RequestTable table;
+    table.insert(42, 1);
+    table.insert(42, 7);
+
+    EXPECT_EQ(7u, table.find(42));
+    EXPECT_EQ(1u, table.size());
+}
+
+
+TEST(RequestTableT,
+     insertErase_manyRequests_matchesStdMap)
+{
+    RequestTable              table;
+    map< uint64_t, uint32_t > reference;
+
+    // Interleave insertions and removals to exercise growth as well as
+    // backward-shift deletion within clusters
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        const uint64_t requestId = (i * 7919u) % 5003u;
+        if (reference.count(requestId) && (i % 3 != 0))
+        {
+            table.erase(requestId);
+            reference.erase(requestId);
+        }
+        else
+        {
+            table.insert(requestId, i);
+            reference[requestId] = i;
+        }
+    }
+
+    ASSERT_EQ(reference.size(), table.size());
+    for (uint64_t requestId = 0; requestId < 5003u; ++requestId)
+    {
+        map< uint64_t, uint32_t >::const_iterator it = reference.find(requestId);
+        const uint32_t                            expected =
+            (it == reference.end()) ? RequestTable::NO_INDEX : it->second;
+        ASSERT_EQ(expected, table.find(requestId));
+    }
+}
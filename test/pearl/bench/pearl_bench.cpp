@@ -0,0 +1,957 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <otf2/otf2.h>
+
+#include <pearl/Buffer.h>
+#include <pearl/Callback.h>
+#include <pearl/CallbackManager.h>
+#include <pearl/Error.h>
+#include <pearl/Event.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/LocationGroup.h>
+#include <pearl/TraceArchive.h>
+#include <pearl/pearl.h>
+#include <pearl/pearl_replay.h>
+
+#include "CallTree.h"
+#include "MutableGlobalDefs.h"
+
+using namespace std;
+using namespace pearl;
+using namespace pearl::detail;
+
+
+/*
+ *  PEARL benchmark driver
+ *
+ *  Generates synthetic OTF2 trace archives of an MPI application with
+ *  configurable size, call-tree shape, and number of ranks.  The archives
+ *  serve as input for timing the analysis tools (e.g., the phase timings
+ *  reported by SCOUT), and for the benchmark cases of this driver.  Each
+ *  benchmark case reads the trace of the first location of an archive and
+ *  times a PEARL operation on it; the median of several repetitions is
+ *  reported.
+ *
+ *  Usage:
+ *    pearl_bench.compute generate [options] <directory>
+ *    pearl_bench.compute <case> [--repeat <n>] <archive>
+ *
+ *  See usage() for the available options and benchmark cases.
+ */
+
+
+namespace
+{
+// --- Constants ------------------------------------------------------------
+
+// Fixed region identifiers of the synthetic application; the identifiers
+// of the 'dispatch' callees of 'main' follow REGION_RECURSE
+enum RegionId
+{
+    REGION_MAIN,
+    REGION_INIT,
+    REGION_FINALIZE,
+    REGION_SEND,
+    REGION_RECV,
+    REGION_RECURSE,
+    NUM_FIXED_REGIONS
+};
+
+
+// --- Type definitions -----------------------------------------------------
+
+// Shape parameters of the synthetic application
+struct Shape
+{
+    uint32_t numRanks;
+    uint32_t numIterations;
+    uint32_t fanout;
+    uint32_t depth;
+    uint32_t drift;    // clock drift of the last rank [ppm]
+};
+
+
+// Result of a single measurement of a benchmark case
+struct Measurement
+{
+    string   label;
+    double   seconds;
+    uint64_t items;       // number of processed items (e.g., events)
+    uint64_t checksum;    // cross-check value, independent of the timing
+};
+
+
+// Trace data of the first location of an experiment archive
+struct Experiment
+{
+    string        anchor;
+    TraceArchive* archive;
+    GlobalDefs*   defs;
+    LocalTrace*   trace;
+};
+
+
+// Benchmark case: runs one repetition on the given experiment and appends
+// its measurements to @p results
+typedef void (* CaseFunction)(Experiment&           experiment,
+                              vector< Measurement >& results);
+
+
+// Table entry of a benchmark case
+struct BenchmarkCase
+{
+    const char*  name;
+    const char*  description;
+    bool         preprocess;    // run PEARL preprocessing before the case
+    CaseFunction function;
+};
+
+
+// Per-rank state while writing the event streams
+struct RankWriter
+{
+    OTF2_EvtWriter* writer;
+    uint64_t        time;
+    uint32_t        drift;
+    uint64_t        numEvents;
+    uint64_t        sendTime;
+};
+
+
+// --- Synthetic trace generation -------------------------------------------
+
+OTF2_FlushType
+preFlush(void*            userData,
+         OTF2_FileType    fileType,
+         OTF2_LocationRef location,
+         void*            callerData,
+         bool             final)
+{
+    return OTF2_FLUSH;
+}
+
+
+OTF2_TimeStamp
+postFlush(void*            userData,
+          OTF2_FileType    fileType,
+          OTF2_LocationRef location)
+{
+    return 0;
+}
+
+
+OTF2_FlushCallbacks flushCallbacks = { preFlush, postFlush };
+
+
+// Returns the timestamp of the current time of the given rank, as recorded
+// by its local clock running slow by 'drift' parts per million
+OTF2_TimeStamp
+timestamp(const RankWriter& rank)
+{
+    return rank.time - rank.time * rank.drift / 1000000;
+}
+
+
+void
+enter(RankWriter& rank,
+      uint32_t    region)
+{
+    OTF2_EvtWriter_Enter(rank.writer, NULL, timestamp(rank), region);
+    rank.time += 10;
+    rank.numEvents++;
+}
+
+
+void
+leave(RankWriter& rank,
+      uint32_t    region)
+{
+    rank.time += 10;
+    OTF2_EvtWriter_Leave(rank.writer, NULL, timestamp(rank), region);
+    rank.numEvents++;
+}
+
+
+// Writes the event streams of the synthetic application.  In iteration
+// 'i', each rank calls the dispatch routine 'i % fanout' from 'main', which
+// recurses 'depth' levels deep.  With more than one rank, each iteration
+// ends with a zero-byte blocking message ring (rank r sends to rank r+1).
+// The clock of the last rank may drift, causing clock condition violations.
+// Returns the end time of the application.
+uint64_t
+writeEvents(OTF2_Archive*         archive,
+            const Shape&          shape,
+            vector< RankWriter >& ranks)
+{
+    const uint32_t numRanks = shape.numRanks;
+
+    for (uint32_t r = 0; r < numRanks; ++r)
+    {
+        ranks[r].writer    = OTF2_Archive_GetEvtWriter(archive, r);
+        ranks[r].time      = 1000;
+        ranks[r].drift     = (r + 1 == numRanks) ? shape.drift : 0;
+        ranks[r].numEvents = 0;
+
+        enter(ranks[r], REGION_MAIN);
+        enter(ranks[r], REGION_INIT);
+        ranks[r].time += 100 * r;
+        leave(ranks[r], REGION_INIT);
+    }
+
+    for (uint32_t it = 0; it < shape.numIterations; ++it)
+    {
+        const uint32_t dispatch = NUM_FIXED_REGIONS + (it % shape.fanout);
+
+        for (uint32_t r = 0; r < numRanks; ++r)
+        {
+            RankWriter& rank = ranks[r];
+
+            enter(rank, dispatch);
+            for (uint32_t level = 0; level < shape.depth; ++level)
+            {
+                enter(rank, REGION_RECURSE);
+            }
+            rank.time += 100 * (1 + (r + it) % 4);
+            for (uint32_t level = 0; level < shape.depth; ++level)
+            {
+                leave(rank, REGION_RECURSE);
+            }
+            leave(rank, dispatch);
+        }
+
+        if (numRanks < 2)
+        {
+            continue;
+        }
+        for (uint32_t r = 0; r < numRanks; ++r)
+        {
+            RankWriter& rank = ranks[r];
+
+            enter(rank, REGION_SEND);
+            rank.sendTime = rank.time;
+            OTF2_EvtWriter_MpiSend(rank.writer, NULL, timestamp(rank),
+                                   (r + 1) % numRanks, 0, it, 0);
+            rank.numEvents++;
+            leave(rank, REGION_SEND);
+        }
+        for (uint32_t r = 0; r < numRanks; ++r)
+        {
+            RankWriter&       rank   = ranks[r];
+            const uint32_t    source = (r + numRanks - 1) % numRanks;
+            const RankWriter& sender = ranks[source];
+
+            // Messages take 5us, well above the minimum latency assumed
+            // by the timestamp correction (clc)
+            enter(rank, REGION_RECV);
+            rank.time = max(rank.time, sender.sendTime + 5000);
+            OTF2_EvtWriter_MpiRecv(rank.writer, NULL, timestamp(rank),
+                                   source, 0, it, 0);
+            rank.numEvents++;
+            leave(rank, REGION_RECV);
+        }
+    }
+
+    // MPI_Finalize synchronizes all ranks
+    uint64_t latest = 0;
+    for (uint32_t r = 0; r < numRanks; ++r)
+    {
+        enter(ranks[r], REGION_FINALIZE);
+        latest = max(latest, ranks[r].time);
+    }
+    for (uint32_t r = 0; r < numRanks; ++r)
+    {
+        ranks[r].time = latest;
+        leave(ranks[r], REGION_FINALIZE);
+        leave(ranks[r], REGION_MAIN);
+
+        OTF2_Archive_CloseEvtWriter(archive, ranks[r].writer);
+    }
+
+    return latest + 20;
+}
+
+
+// Writes the global definitions of the synthetic application
+void
+writeDefinitions(OTF2_Archive*               archive,
+                 const Shape&                shape,
+                 const vector< RankWriter >& ranks,
+                 uint64_t                    endTime)
+{
+    static const char* const fixedNames[NUM_FIXED_REGIONS] = {
+        "main", "MPI_Init", "MPI_Finalize", "MPI_Send", "MPI_Recv", "recurse"
+    };
+    const uint32_t numRegions = NUM_FIXED_REGIONS + shape.fanout;
+    const uint32_t numRanks   = shape.numRanks;
+
+    OTF2_GlobalDefWriter* writer = OTF2_Archive_GetGlobalDefWriter(archive);
+    OTF2_GlobalDefWriter_WriteClockProperties(writer, 1000000000, 0,
+                                              endTime + 1);
+
+    // Strings: region names, followed by the fixed strings below and the
+    // location group names
+    const uint32_t STRING_EMPTY   = numRegions;
+    const uint32_t STRING_THREAD  = numRegions + 1;
+    const uint32_t STRING_MPI     = numRegions + 2;
+    const uint32_t STRING_MACHINE = numRegions + 3;
+    const uint32_t STRING_NODE    = numRegions + 4;
+    const uint32_t STRING_WORLD   = numRegions + 5;
+    const uint32_t STRING_RANK    = numRegions + 6;
+    for (uint32_t i = 0; i < numRegions; ++i)
+    {
+        char name[32];
+        if (i < NUM_FIXED_REGIONS)
+        {
+            snprintf(name, sizeof(name), "%s", fixedNames[i]);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "dispatch_%u", i - NUM_FIXED_REGIONS);
+        }
+        OTF2_GlobalDefWriter_WriteString(writer, i, name);
+    }
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_EMPTY, "");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_THREAD, "Master thread");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_MPI, "MPI");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_MACHINE, "machine");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_NODE, "node");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_WORLD, "MPI_COMM_WORLD");
+    for (uint32_t r = 0; r < numRanks; ++r)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "MPI Rank %u", r);
+        OTF2_GlobalDefWriter_WriteString(writer, STRING_RANK + r, name);
+    }
+
+    OTF2_GlobalDefWriter_WriteParadigm(writer, OTF2_PARADIGM_MPI, STRING_MPI,
+                                       OTF2_PARADIGM_CLASS_PROCESS);
+    for (uint32_t i = 0; i < numRegions; ++i)
+    {
+        const bool isUser = (i == REGION_MAIN) || (i >= REGION_RECURSE);
+
+        OTF2_RegionRole role = OTF2_REGION_ROLE_POINT2POINT;
+        if (isUser)
+        {
+            role = OTF2_REGION_ROLE_FUNCTION;
+        }
+        else if ((i == REGION_INIT) || (i == REGION_FINALIZE))
+        {
+            role = OTF2_REGION_ROLE_ARTIFICIAL;
+        }
+
+        OTF2_GlobalDefWriter_WriteRegion(writer, i, i, i, STRING_EMPTY, role,
+                                         isUser
+                                         ? OTF2_PARADIGM_USER
+                                         : OTF2_PARADIGM_MPI,
+                                         OTF2_REGION_FLAG_NONE,
+                                         isUser ? STRING_EMPTY : STRING_MPI,
+                                         0, 0);
+    }
+
+    // The timestamp correction (clc) expects a system tree with a root node
+    // of class "machine"
+    OTF2_GlobalDefWriter_WriteSystemTreeNode(writer, 0, STRING_MACHINE,
+                                             STRING_MACHINE,
+                                             OTF2_UNDEFINED_SYSTEM_TREE_NODE);
+    OTF2_GlobalDefWriter_WriteSystemTreeNode(writer, 1, STRING_NODE,
+                                             STRING_NODE, 0);
+    vector< uint64_t > members(numRanks);
+    for (uint32_t r = 0; r < numRanks; ++r)
+    {
+        OTF2_GlobalDefWriter_WriteLocationGroup(writer, r, STRING_RANK + r,
+                                                OTF2_LOCATION_GROUP_TYPE_PROCESS,
+                                                1);
+        OTF2_GlobalDefWriter_WriteLocation(writer, r, STRING_THREAD,
+                                           OTF2_LOCATION_TYPE_CPU_THREAD,
+                                           ranks[r].numEvents, r);
+        members[r] = r;
+    }
+    OTF2_GlobalDefWriter_WriteGroup(writer, 0, STRING_EMPTY,
+                                    OTF2_GROUP_TYPE_COMM_LOCATIONS,
+                                    OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE,
+                                    numRanks, &members[0]);
+    OTF2_GlobalDefWriter_WriteGroup(writer, 1, STRING_EMPTY,
+                                    OTF2_GROUP_TYPE_COMM_GROUP,
+                                    OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE,
+                                    numRanks, &members[0]);
+    OTF2_GlobalDefWriter_WriteComm(writer, 0, STRING_WORLD, 1,
+                                   OTF2_UNDEFINED_COMM);
+
+    OTF2_Archive_CloseGlobalDefWriter(archive, writer);
+}
+
+
+// Writes the trace archive of the synthetic application to the given
+// directory; returns the number of events per rank
+uint64_t
+writeTrace(const string& directory,
+           const Shape&  shape)
+{
+    OTF2_Archive* archive = OTF2_Archive_Open(directory.c_str(), "traces",
+                                              OTF2_FILEMODE_WRITE,
+                                              1024 * 1024, 4 * 1024 * 1024,
+                                              OTF2_SUBSTRATE_POSIX,
+                                              OTF2_COMPRESSION_NONE);
+    if (archive == NULL)
+    {
+        return 0;
+    }
+    OTF2_Archive_SetFlushCallbacks(archive, &flushCallbacks, NULL);
+    OTF2_Archive_SetSerialCollectiveCallbacks(archive);
+
+    vector< RankWriter > ranks(shape.numRanks);
+    OTF2_Archive_OpenEvtFiles(archive);
+    const uint64_t endTime = writeEvents(archive, shape, ranks);
+    OTF2_Archive_CloseEvtFiles(archive);
+
+    OTF2_Archive_OpenDefFiles(archive);
+    for (uint32_t r = 0; r < shape.numRanks; ++r)
+    {
+        OTF2_DefWriter* writer = OTF2_Archive_GetDefWriter(archive, r);
+        OTF2_Archive_CloseDefWriter(archive, writer);
+    }
+    OTF2_Archive_CloseDefFiles(archive);
+
+    writeDefinitions(archive, shape, ranks, endTime);
+    OTF2_Archive_Close(archive);
+
+    return ranks[0].numEvents;
+}
+
+
+// --- Benchmark cases ------------------------------------------------------
+
+// Returns a timestamp in seconds
+double
+wtime()
+{
+    struct timeval tv;
+
+    if (gettimeofday(&tv, NULL) == 0)
+    {
+        return (tv.tv_sec + (tv.tv_usec * 1.0e-6));
+    }
+
+    return 0.0;
+}
+
+
+// Calls Event::enterptr() for all events enclosed by the outermost region
+// and Event::leaveptr() for all ENTER events except the first one, as done
+// by the call-path lookups of the analysis
+void
+caseCallstack(Experiment&            experiment,
+              vector< Measurement >& results)
+{
+    const LocalTrace& trace = *experiment.trace;
+    Measurement       enterResult = { "enterptr (enclosed events)", 0.0, 0, 0 };
+    Measurement       leaveResult = { "leaveptr (ENTER events)", 0.0, 0, 0 };
+
+    const Event first = trace.begin();
+    const Event last  = trace.end().prev();
+
+    double start = wtime();
+    for (Event event = first.next(); event != last; ++event)
+    {
+        enterResult.checksum += event.enterptr().get_id();
+        enterResult.items++;
+    }
+    enterResult.seconds = wtime() - start;
+
+    start = wtime();
+    for (Event event = first.next(); event != last; ++event)
+    {
+        if (event->isOfType(GROUP_ENTER))
+        {
+            leaveResult.checksum += event.leaveptr().get_id();
+            leaveResult.items++;
+        }
+    }
+    leaveResult.seconds = wtime() - start;
+
+    results.push_back(enterResult);
+    results.push_back(leaveResult);
+}
+
+
+// Trivial replay callback counting its invocations
+class CallbackCounter
+{
+    public:
+        CallbackCounter()
+            : mCount(0)
+        {
+        }
+
+        void
+        count(const CallbackManager& cbmanager,
+              int                    user_event,
+              const Event&           event,
+              CallbackData*          data)
+        {
+            ++mCount;
+        }
+
+        uint64_t
+        getCount() const
+        {
+            return mCount;
+        }
+
+
+    private:
+        uint64_t mCount;
+};
+
+
+// Runs a forward replay with no callback, one callback, and eight
+// callbacks registered for ENTER events
+void
+caseReplay(Experiment&            experiment,
+           vector< Measurement >& results)
+{
+    static const uint32_t numCallbacks[] = { 0, 1, 8 };
+    static const char*    labels[]       = {
+        "forward replay, no callbacks",
+        "forward replay, 1 ENTER cb",
+        "forward replay, 8 ENTER cbs"
+    };
+
+    for (size_t i = 0; i < sizeof(numCallbacks) / sizeof(numCallbacks[0]); ++i)
+    {
+        CallbackCounter counter;
+        CallbackManager cbmanager;
+        for (uint32_t j = 0; j < numCallbacks[i]; ++j)
+        {
+            cbmanager.register_callback(ENTER,
+                                        PEARL_create_callback(&counter,
+                                                              &CallbackCounter::count));
+        }
+
+        const double start = wtime();
+        PEARL_forward_replay(*experiment.trace, cbmanager, NULL);
+
+        Measurement result = { labels[i], wtime() - start,
+                               experiment.trace->size(), counter.getCount() };
+        results.push_back(result);
+    }
+}
+
+
+// Builds the call tree from the trace and preprocesses the trace, timing
+// both steps separately
+void
+casePreprocess(Experiment&            experiment,
+               vector< Measurement >& results)
+{
+    LocalTrace& trace = *experiment.trace;
+
+    double start = wtime();
+    PEARL_verify_calltree(*experiment.defs, trace);
+
+    Measurement verifyResult = { "verify call tree", wtime() - start,
+                                 trace.size(),
+                                 experiment.defs->numCallpaths() };
+
+    start = wtime();
+    PEARL_preprocess_trace(*experiment.defs, trace);
+
+    Measurement preprocessResult = { "preprocess trace", wtime() - start,
+                                     trace.size(),
+                                     experiment.defs->numCallpaths() };
+
+    results.push_back(verifyResult);
+    results.push_back(preprocessResult);
+}
+
+
+// Serializes the call tree into a memory buffer and reconstructs it from
+// there, as done when unifying the call trees of all processes
+void
+casePack(Experiment&            experiment,
+         vector< Measurement >& results)
+{
+    const MutableGlobalDefs& mutableDefs =
+        dynamic_cast< const MutableGlobalDefs& >(*experiment.defs);
+    const CallTree&          ctree = *mutableDefs.getCallTree();
+
+    Buffer buffer;
+    double start = wtime();
+    ctree.pack(buffer);
+
+    Measurement packResult = { "pack call tree", wtime() - start,
+                               ctree.numCallpaths(), buffer.size() };
+
+    start = wtime();
+    CallTree copy(*experiment.defs, buffer);
+
+    Measurement unpackResult = { "unpack call tree", wtime() - start,
+                                 copy.numCallpaths(), copy.numCallpaths() };
+
+    results.push_back(packResult);
+    results.push_back(unpackResult);
+}
+
+
+// Reads the global definitions and the trace data of the first location
+// through a second archive instance, timing both steps separately
+void
+caseRead(Experiment&            experiment,
+         vector< Measurement >& results)
+{
+    TraceArchive* archive = TraceArchive::open(experiment.anchor);
+
+    double      start = wtime();
+    GlobalDefs* defs  = archive->getDefinitions();
+
+    Measurement defsResult = { "read definitions", wtime() - start,
+                               defs->numRegions(), defs->numLocations() };
+
+    const LocationGroup& process = defs->getLocationGroup(0);
+    start = wtime();
+    archive->openTraceContainer(process);
+    LocalTrace* trace = archive->getTrace(*defs, process.getLocation(0));
+    archive->closeTraceContainer();
+
+    Measurement traceResult = { "read trace", wtime() - start,
+                                trace->size(), trace->num_events() };
+
+    delete trace;
+    delete defs;
+    delete archive;
+
+    results.push_back(defsResult);
+    results.push_back(traceResult);
+}
+
+
+const BenchmarkCase benchmarkCases[] = {
+    {
+        "callstack",
+        "Look up enclosing ENTER and matching LEAVE events",
+        true, caseCallstack
+    },
+    {
+        "replay",
+        "Dispatch events to replay callbacks",
+        true, caseReplay
+    },
+    {
+        "preprocess",
+        "Build the call tree and preprocess the trace",
+        false, casePreprocess
+    },
+    {
+        "pack",
+        "Serialize and deserialize the call tree",
+        true, casePack
+    },
+    {
+        "read",
+        "Read the global definitions and the trace data",
+        false, caseRead
+    }
+};
+
+const size_t numBenchmarkCases = sizeof(benchmarkCases)
+                                 / sizeof(benchmarkCases[0]);
+
+
+// Reads the global definitions and the trace data of the first location of
+// the given experiment archive
+void
+readExperiment(const string& anchor,
+               bool          preprocess,
+               Experiment&   experiment)
+{
+    experiment.anchor  = anchor;
+    experiment.archive = TraceArchive::open(anchor);
+    experiment.defs    = experiment.archive->getDefinitions();
+
+    const LocationGroup& process = experiment.defs->getLocationGroup(0);
+    experiment.archive->openTraceContainer(process);
+    experiment.trace = experiment.archive->getTrace(*experiment.defs,
+                                                    process.getLocation(0));
+    experiment.archive->closeTraceContainer();
+
+    if (preprocess)
+    {
+        PEARL_verify_calltree(*experiment.defs, *experiment.trace);
+        PEARL_preprocess_trace(*experiment.defs, *experiment.trace);
+    }
+}
+
+
+// Releases the data of the given experiment
+void
+releaseExperiment(Experiment& experiment)
+{
+    delete experiment.trace;
+    delete experiment.defs;
+    delete experiment.archive;
+}
+
+
+// Runs the given benchmark case @p numRepeats times on the experiment
+// archive and prints the median of each measurement
+void
+runBenchmark(const BenchmarkCase& benchmark,
+             const string&        anchor,
+             uint32_t             numRepeats)
+{
+    vector< vector< Measurement > > repeats(numRepeats);
+    for (uint32_t i = 0; i < numRepeats; ++i)
+    {
+        Experiment experiment;
+        readExperiment(anchor, benchmark.preprocess, experiment);
+        benchmark.function(experiment, repeats[i]);
+        releaseExperiment(experiment);
+    }
+
+    cout << benchmark.name << ": " << benchmark.description << " ("
+         << anchor << ", median of " << numRepeats << ")" << endl;
+    for (size_t m = 0; m < repeats[0].size(); ++m)
+    {
+        vector< double > seconds;
+        for (uint32_t i = 0; i < numRepeats; ++i)
+        {
+            seconds.push_back(repeats[i][m].seconds);
+        }
+        sort(seconds.begin(), seconds.end());
+
+        const Measurement& result = repeats[0][m];
+        const double       median = seconds[numRepeats / 2];
+        cout << "  " << left << setw(32) << result.label << right
+             << fixed << setprecision(6) << setw(12) << median << " s";
+        if (median > 0.0)
+        {
+            cout << setprecision(2) << setw(10)
+                 << result.items / median / 1.0e6 << " M/s";
+        }
+        cout << "  (" << result.items << " items, checksum "
+             << result.checksum << ")" << endl;
+    }
+}
+
+
+// --- Command line handling ------------------------------------------------
+
+void
+usage()
+{
+    cerr << "Usage: pearl_bench.compute generate [options] <directory>\n"
+         << "       pearl_bench.compute <case> [--repeat <n>] <archive>\n"
+         << "\n"
+         << "Writes a synthetic OTF2 trace archive of an MPI application to\n"
+         << "<directory>.  In each iteration, 'main' calls one of <fanout>\n"
+         << "dispatch routines, which recurses <depth> levels deep; with more\n"
+         << "than one rank, a message ring follows.\n"
+         << "\n"
+         << "Options:\n"
+         << "  --ranks <n>        Number of MPI ranks (default: 1)\n"
+         << "  --iterations <n>   Number of iterations (default: 10000)\n"
+         << "  --fanout <n>       Number of dispatch routines (default: 16)\n"
+         << "  --depth <n>        Recursion depth (default: 8)\n"
+         << "  --drift <n>        Clock drift of the last rank in ppm (default: 0)\n"
+         << "\n"
+         << "Runs the given benchmark case on the trace of the first location\n"
+         << "of the experiment archive <archive> (anchor file) and reports\n"
+         << "the median of <n> repetitions (default: 5).  Benchmark cases:\n";
+    for (size_t i = 0; i < numBenchmarkCases; ++i)
+    {
+        cerr << "  " << left << setw(19) << benchmarkCases[i].name
+             << benchmarkCases[i].description << "\n";
+    }
+    exit(EXIT_FAILURE);
+}
+
+
+// Parses the value of a numerical option; aborts on invalid values
+uint32_t
+parseValue(int    argc,
+           char** argv,
+           int&   index,
+           bool   allowZero)
+{
+    if (index + 1 >= argc)
+    {
+        usage();
+    }
+
+    char*               end;
+    const unsigned long value = strtoul(argv[++index], &end, 10);
+    if (  (*end != '\0')
+       || (value > 0xFFFFFFFFul)
+       || (!allowZero && (value == 0)))
+    {
+        cerr << "Invalid value for option '" << argv[index - 1] << "'" << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return value;
+}
+
+
+// Handles the 'generate' command
+int
+generate(int    argc,
+         char** argv)
+{
+    Shape shape;
+    shape.numRanks      = 1;
+    shape.numIterations = 10000;
+    shape.fanout        = 16;
+    shape.depth         = 8;
+    shape.drift         = 0;
+
+    int index = 2;
+    for (; (index < argc) && (argv[index][0] == '-'); ++index)
+    {
+        const string arg(argv[index]);
+        if (arg == "--ranks")
+        {
+            shape.numRanks = parseValue(argc, argv, index, false);
+        }
+        else if (arg == "--iterations")
+        {
+            shape.numIterations = parseValue(argc, argv, index, false);
+        }
+        else if (arg == "--fanout")
+        {
+            shape.fanout = parseValue(argc, argv, index, false);
+        }
+        else if (arg == "--depth")
+        {
+            shape.depth = parseValue(argc, argv, index, true);
+        }
+        else if (arg == "--drift")
+        {
+            shape.drift = parseValue(argc, argv, index, true);
+            if (shape.drift >= 1000000)
+            {
+                cerr << "Invalid value for option '--drift'" << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        else
+        {
+            usage();
+        }
+    }
+    if (index + 1 != argc)
+    {
+        usage();
+    }
+
+    const string   directory(argv[index]);
+    const uint64_t numEvents = writeTrace(directory, shape);
+    if (numEvents == 0)
+    {
+        cerr << "Cannot write trace archive '" << directory << "'" << endl;
+
+        return EXIT_FAILURE;
+    }
+    cout << "Wrote " << directory << "/traces.otf2: " << shape.numRanks
+         << " rank(s), " << numEvents << " events per rank, "
+         << 1 + shape.fanout * (shape.depth + 1) << " user call paths"
+         << endl;
+
+    return EXIT_SUCCESS;
+}
+
+
+// Handles the benchmark case commands
+int
+benchmark(int    argc,
+          char** argv)
+{
+    const BenchmarkCase* selected = NULL;
+    for (size_t i = 0; i < numBenchmarkCases; ++i)
+    {
+        if (benchmarkCases[i].name == string(argv[1]))
+        {
+            selected = &benchmarkCases[i];
+        }
+    }
+    if (selected == NULL)
+    {
+        usage();
+    }
+
+    uint32_t numRepeats = 5;
+    int      index      = 2;
+    for (; (index < argc) && (argv[index][0] == '-'); ++index)
+    {
+        const string arg(argv[index]);
+        if (arg == "--repeat")
+        {
+            numRepeats = parseValue(argc, argv, index, false);
+        }
+        else
+        {
+            usage();
+        }
+    }
+    if (index + 1 != argc)
+    {
+        usage();
+    }
+
+    PEARL_init();
+    try
+    {
+        runBenchmark(*selected, argv[index], numRepeats);
+    }
+    catch (const Error& error)
+    {
+        cerr << error.what() << endl;
+
+        return EXIT_FAILURE;
+    }
+    PEARL_finalize();
+
+    return EXIT_SUCCESS;
+}
+}    // unnamed namespace
+
+
+int
+main(int    argc,
+     char** argv)
+{
+    if (argc < 2)
+    {
+        usage();
+    }
+
+    if (string(argv[1]) == "generate")
+    {
+        return generate(argc, argv);
+    }
+
+    return benchmark(argc, argv);
+}
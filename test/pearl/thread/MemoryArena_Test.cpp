@@ -0,0 +1,111 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "MemoryArena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl::detail;
+
+
+namespace
+{
+// --- Constants ------------------------------------------------------------
+
+// Number of blocks to allocate; this fills several slabs
+static const size_t MAX_BLOCKS = 100000;
+}    // unnamed namespace
+
+
+// --- MemoryArena tests ----------------------------------------------------
+
+TEST(MemoryArenaT,
+     allocate_manyBlocks_returnsDisjointAlignedBlocks)
+{
+    MemoryArena     arena;
+    vector< char* > blocks;
+    for (size_t i = 0; i < MAX_BLOCKS; ++i)
+    {
+        char* const ptr = static_cast< char* >(arena.allocate(20 + i % 5));
+        memset(ptr, 0xff, 20 + i % 5);
+        blocks.push_back(ptr);
+
+        EXPECT_EQ(0u, reinterpret_cast< size_t >(ptr) % 8);
+    }
+
+    // Consecutive sorted pointers must be at least one block apart
+    sort(blocks.begin(), blocks.end());
+    for (size_t i = 1; i < blocks.size(); ++i)
+    {
+        ASSERT_LE(blocks[i - 1] + 20, blocks[i]);
+    }
+}
+
+
+TEST(MemoryArenaT,
+     contains_allocatedBlocks_returnsTrue)
+{
+    MemoryArena     arena;
+    vector< void* > blocks;
+    for (size_t i = 0; i < MAX_BLOCKS; ++i)
+    {
+        blocks.push_back(arena.allocate(40));
+    }
+    blocks.push_back(arena.allocate(1024 * 1024));
+
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        ASSERT_TRUE(arena.contains(blocks[i]));
+    }
+}
+
+
+TEST(MemoryArenaT,
+     contains_foreignPointers_returnsFalse)
+{
+    MemoryArena arena;
+    int         local;
+    EXPECT_FALSE(arena.contains(&local));
+
+    arena.allocate(16);
+    char* const heap = new char[16];
+    EXPECT_FALSE(arena.contains(heap));
+    EXPECT_FALSE(arena.contains(&local));
+    delete[] heap;
+}
+
+
+TEST(MemoryArenaT,
+     size_allocatedBlocks_coversAllBlocks)
+{
+    MemoryArena arena;
+    EXPECT_EQ(0u, arena.size());
+
+    for (size_t i = 0; i < MAX_BLOCKS; ++i)
+    {
+        arena.allocate(40);
+    }
+    EXPECT_LE(MAX_BLOCKS * 40, arena.size());
+
+    const size_t size = arena.size();
+    arena.allocate(1024 * 1024);
+    EXPECT_EQ(size + 1024 * 1024, arena.size());
+}
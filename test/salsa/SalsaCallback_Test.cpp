@@ -0,0 +1,730 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "SalsaCallback.h"
+
+#include <dirent.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+#include <otf2/otf2.h>
+
+#include <pearl/CallbackManager.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/LocationGroup.h>
+#include <pearl/TraceArchive.h>
+#include <pearl/pearl.h>
+#include <pearl/pearl_replay.h>
+
+#include <gtest/gtest.h>
+
+#include "MessageChecker.h"
+#include "SalsaCsrWriter.h"
+#include "salsa.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+
+
+namespace
+{
+// --- Constants ------------------------------------------------------------
+
+// Region identifiers of the synthetic application
+enum RegionId
+{
+    REGION_MAIN,
+    REGION_SEND,
+    REGION_RECV,
+    NUM_REGIONS
+};
+
+
+// Sizes of the messages sent by rank r to rank r+1.  With the zero-byte
+// message in the middle, the minimum is only correct if zero is treated
+// as a regular value rather than "no value yet".
+const uint64_t nextSizes[] = { 64, 0, 32 };
+const int      numNextSizes = sizeof(nextSizes) / sizeof(nextSizes[0]);
+
+// Sizes of the messages sent by rank r to rank r+2 (if different from
+// rank r and rank r+1)
+const uint64_t secondSizes[] = { 16, 48 };
+const int      numSecondSizes = sizeof(secondSizes) / sizeof(secondSizes[0]);
+
+
+// --- Synthetic trace generation -------------------------------------------
+
+// MPI rank and number of ranks of the calling process
+int mpiRank;
+int mpiSize;
+
+// Anchor file name of the trace archive shared by all tests
+string archiveAnchor;
+
+// Directory holding the trace archive and the files written by the tests
+string testDirectory;
+
+
+OTF2_FlushType
+preFlush(void*            userData,
+         OTF2_FileType    fileType,
+         OTF2_LocationRef location,
+         void*            callerData,
+         bool             final)
+{
+    return OTF2_FLUSH;
+}
+
+
+OTF2_TimeStamp
+postFlush(void*            userData,
+          OTF2_FileType    fileType,
+          OTF2_LocationRef location)
+{
+    return 0;
+}
+
+
+OTF2_FlushCallbacks flushCallbacks = { preFlush, postFlush };
+
+
+// Writes an MPI_Send call with the given message parameters
+void
+send(OTF2_EvtWriter* writer,
+     uint64_t&       time,
+     uint64_t&       numEvents,
+     int             destination,
+     uint32_t        tag,
+     uint64_t        bytes)
+{
+    OTF2_EvtWriter_Enter(writer, NULL, time, REGION_SEND);
+    OTF2_EvtWriter_MpiSend(writer, NULL, time + 5, destination, 0, tag,
+                           bytes);
+    OTF2_EvtWriter_Leave(writer, NULL, time + 10, REGION_SEND);
+    time      += 20;
+    numEvents += 3;
+}
+
+
+// Writes an MPI_Recv call with the given message parameters
+void
+recv(OTF2_EvtWriter* writer,
+     uint64_t&       time,
+     uint64_t&       numEvents,
+     int             source,
+     uint32_t        tag,
+     uint64_t        bytes)
+{
+    OTF2_EvtWriter_Enter(writer, NULL, time, REGION_RECV);
+    OTF2_EvtWriter_MpiRecv(writer, NULL, time + 5, source, 0, tag, bytes);
+    OTF2_EvtWriter_Leave(writer, NULL, time + 10, REGION_RECV);
+    time      += 20;
+    numEvents += 3;
+}
+
+
+// Writes the trace archive of a synthetic MPI application with the given
+// number of ranks to the given directory.  Each rank first sends all of
+// its messages (see nextSizes and secondSizes) and then receives the
+// messages of its predecessors.
+void
+writeTrace(const string& directory,
+           int           numRanks)
+{
+    OTF2_Archive* archive = OTF2_Archive_Open(directory.c_str(), "traces",
+                                              OTF2_FILEMODE_WRITE,
+                                              1024 * 1024, 4 * 1024 * 1024,
+                                              OTF2_SUBSTRATE_POSIX,
+                                              OTF2_COMPRESSION_NONE);
+    OTF2_Archive_SetFlushCallbacks(archive, &flushCallbacks, NULL);
+    OTF2_Archive_SetSerialCollectiveCallbacks(archive);
+
+    vector< uint64_t > numEvents(numRanks, 0);
+    uint64_t           endTime = 0;
+    OTF2_Archive_OpenEvtFiles(archive);
+    for (int r = 0; r < numRanks; ++r)
+    {
+        OTF2_EvtWriter* writer = OTF2_Archive_GetEvtWriter(archive, r);
+        uint64_t        time   = 1000;
+
+        OTF2_EvtWriter_Enter(writer, NULL, time, REGION_MAIN);
+        numEvents[r]++;
+
+        for (int i = 0; i < numNextSizes; ++i)
+        {
+            send(writer, time, numEvents[r], (r + 1) % numRanks, i,
+                 nextSizes[i]);
+        }
+        if (numRanks > 2)
+        {
+            for (int i = 0; i < numSecondSizes; ++i)
+            {
+                send(writer, time, numEvents[r], (r + 2) % numRanks,
+                     numNextSizes + i, secondSizes[i]);
+            }
+        }
+
+        time += 1000;
+        for (int i = 0; i < numNextSizes; ++i)
+        {
+            recv(writer, time, numEvents[r], (r + numRanks - 1) % numRanks,
+                 i, nextSizes[i]);
+        }
+        if (numRanks > 2)
+        {
+            for (int i = 0; i < numSecondSizes; ++i)
+            {
+                recv(writer, time, numEvents[r],
+                     (r + numRanks - 2) % numRanks, numNextSizes + i,
+                     secondSizes[i]);
+            }
+        }
+
+        OTF2_EvtWriter_Leave(writer, NULL, time, REGION_MAIN);
+        numEvents[r]++;
+
+        endTime = max(endTime, time);
+        OTF2_Archive_CloseEvtWriter(archive, writer);
+    }
+    OTF2_Archive_CloseEvtFiles(archive);
+
+    OTF2_Archive_OpenDefFiles(archive);
+    for (int r = 0; r < numRanks; ++r)
+    {
+        OTF2_DefWriter* writer = OTF2_Archive_GetDefWriter(archive, r);
+        OTF2_Archive_CloseDefWriter(archive, writer);
+    }
+    OTF2_Archive_CloseDefFiles(archive);
+
+    static const char* const regionNames[NUM_REGIONS] = {
+        "main", "MPI_Send", "MPI_Recv"
+    };
+
+    // Strings: region names, followed by the fixed strings below and the
+    // location group names
+    const uint32_t STRING_EMPTY  = NUM_REGIONS;
+    const uint32_t STRING_THREAD = NUM_REGIONS + 1;
+    const uint32_t STRING_MPI    = NUM_REGIONS + 2;
+    const uint32_t STRING_NODE   = NUM_REGIONS + 3;
+    const uint32_t STRING_WORLD  = NUM_REGIONS + 4;
+    const uint32_t STRING_RANK   = NUM_REGIONS + 5;
+
+    OTF2_GlobalDefWriter* writer = OTF2_Archive_GetGlobalDefWriter(archive);
+    OTF2_GlobalDefWriter_WriteClockProperties(writer, 1000000000, 0,
+                                              endTime + 1);
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        OTF2_GlobalDefWriter_WriteString(writer, i, regionNames[i]);
+    }
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_EMPTY, "");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_THREAD, "Master thread");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_MPI, "MPI");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_NODE, "node");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_WORLD, "MPI_COMM_WORLD");
+    for (int r = 0; r < numRanks; ++r)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "MPI Rank %d", r);
+        OTF2_GlobalDefWriter_WriteString(writer, STRING_RANK + r, name);
+    }
+
+    OTF2_GlobalDefWriter_WriteParadigm(writer, OTF2_PARADIGM_MPI, STRING_MPI,
+                                       OTF2_PARADIGM_CLASS_PROCESS);
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        const bool isUser = (i == REGION_MAIN);
+
+        OTF2_GlobalDefWriter_WriteRegion(writer, i, i, i, STRING_EMPTY,
+                                         isUser
+                                         ? OTF2_REGION_ROLE_FUNCTION
+                                         : OTF2_REGION_ROLE_POINT2POINT,
+                                         isUser
+                                         ? OTF2_PARADIGM_USER
+                                         : OTF2_PARADIGM_MPI,
+                                         OTF2_REGION_FLAG_NONE,
+                                         isUser ? STRING_EMPTY : STRING_MPI,
+                                         0, 0);
+    }
+
+    OTF2_GlobalDefWriter_WriteSystemTreeNode(writer, 0, STRING_NODE,
+                                             STRING_NODE,
+                                             OTF2_UNDEFINED_SYSTEM_TREE_NODE);
+    vector< uint64_t > members(numRanks);
+    for (int r = 0; r < numRanks; ++r)
+    {
+        OTF2_GlobalDefWriter_WriteLocationGroup(writer, r, STRING_RANK + r,
+                                                OTF2_LOCATION_GROUP_TYPE_PROCESS,
+                                                0);
+        OTF2_GlobalDefWriter_WriteLocation(writer, r, STRING_THREAD,
+                                           OTF2_LOCATION_TYPE_CPU_THREAD,
+                                           numEvents[r], r);
+        members[r] = r;
+    }
+    OTF2_GlobalDefWriter_WriteGroup(writer, 0, STRING_EMPTY,
+                                    OTF2_GROUP_TYPE_COMM_LOCATIONS,
+                                    OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE,
+                                    numRanks, &members[0]);
+    OTF2_GlobalDefWriter_WriteGroup(writer, 1, STRING_EMPTY,
+                                    OTF2_GROUP_TYPE_COMM_GROUP,
+                                    OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE,
+                                    numRanks, &members[0]);
+    OTF2_GlobalDefWriter_WriteComm(writer, 0, STRING_WORLD, 1,
+                                   OTF2_UNDEFINED_COMM);
+    OTF2_Archive_CloseGlobalDefWriter(archive, writer);
+
+    OTF2_Archive_Close(archive);
+}
+
+
+// Recursively removes the given directory
+void
+removeDirectory(const string& path)
+{
+    DIR* directory = opendir(path.c_str());
+    if (directory == NULL)
+    {
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL)
+    {
+        const string name(entry->d_name);
+        if (  (name == ".")
+           || (name == ".."))
+        {
+            continue;
+        }
+
+        const string child = path + "/" + name;
+        struct stat  info;
+        if (  (lstat(child.c_str(), &info) == 0)
+           && S_ISDIR(info.st_mode))
+        {
+            removeDirectory(child);
+        }
+        else
+        {
+            unlink(child.c_str());
+        }
+    }
+    closedir(directory);
+    rmdir(path.c_str());
+}
+
+
+// Initializes PEARL and writes the trace archive shared by all tests to a
+// temporary directory, which is removed again afterwards
+class SalsaEnvironment
+    : public Environment
+{
+    public:
+        virtual void
+        SetUp()
+        {
+            MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+            MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+            PEARL_mpi_init();
+
+            char directory[] = "salsa_Test.XXXXXX";
+            if (mpiRank == 0)
+            {
+                if (mkdtemp(directory) == NULL)
+                {
+                    directory[0] = '\0';
+                }
+                else
+                {
+                    writeTrace(directory, mpiSize);
+                }
+            }
+            MPI_Bcast(directory, sizeof(directory), MPI_CHAR, 0,
+                      MPI_COMM_WORLD);
+
+            testDirectory = directory;
+            if (!testDirectory.empty())
+            {
+                archiveAnchor = testDirectory + "/traces.otf2";
+            }
+        }
+
+        virtual void
+        TearDown()
+        {
+            MPI_Barrier(MPI_COMM_WORLD);
+            if (  (mpiRank == 0)
+               && !testDirectory.empty())
+            {
+                removeDirectory(testDirectory);
+            }
+            PEARL_finalize();
+        }
+};
+
+
+Environment* const salsaEnvironment =
+    AddGlobalTestEnvironment(new SalsaEnvironment);
+
+
+// --- Helpers --------------------------------------------------------------
+
+// Replays the synthetic trace with SALSA callbacks accumulating the
+// statistics of all received messages, the same way as the SALSA main
+// program
+class Replay
+{
+    public:
+        Replay()
+            : mArchive(TraceArchive::open(archiveAnchor)),
+              mDefs(mArchive->getDefinitions()),
+              mTrace(0),
+              mCallbacks(mpiRank, mpiSize, MessageChecker())
+        {
+            const LocationGroup& process = mDefs->getLocationGroup(mpiRank);
+
+            mArchive->openTraceContainer(process);
+            mTrace = mArchive->getTrace(*mDefs, process.getLocation(0));
+            mArchive->closeTraceContainer();
+
+            PEARL_verify_calltree(*mDefs, *mTrace);
+            PEARL_mpi_unify_calltree(*mDefs);
+            PEARL_preprocess_trace(*mDefs, *mTrace);
+
+            CallbackManager manager;
+            CallbackDataneu data;
+            data.defs = mDefs;
+            manager.register_callback(GROUP_SEND,
+                                      PEARL_create_callback(&mCallbacks,
+                                                            &SalsaCallback::send));
+            manager.register_callback(GROUP_RECV,
+                                      PEARL_create_callback(&mCallbacks,
+                                                            &SalsaCallback::recv));
+            PEARL_selective_forward_replay(*mTrace, manager, &data);
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
+
+        ~Replay()
+        {
+            delete mTrace;
+            delete mDefs;
+            delete mArchive;
+        }
+
+        const SalsaCallback&
+        getCallbacks() const
+        {
+            return mCallbacks;
+        }
+
+
+    private:
+        TraceArchive* mArchive;
+        GlobalDefs*   mDefs;
+        LocalTrace*   mTrace;
+        SalsaCallback mCallbacks;
+};
+
+
+// Returns the rank sending the messages of nextSizes to @p rank
+int
+prevRank(int rank)
+{
+    return (rank + mpiSize - 1) % mpiSize;
+}
+
+
+// Returns the rank sending the messages of secondSizes to @p rank, or -1
+// if there is no such rank
+int
+secondPrevRank(int rank)
+{
+    return (mpiSize > 2) ? (rank + mpiSize - 2) % mpiSize : -1;
+}
+
+
+// Returns the expected sparse row of @p rank for the given statistic of
+// the message lengths
+void
+expectedRow(int               rank,
+            modes             m,
+            vector< int >&    columns,
+            vector< double >& values)
+{
+    double nextValue   = 0.0;
+    double secondValue = 0.0;
+    switch (m)
+    {
+        case MINIMUM:
+            nextValue   = 0.0;
+            secondValue = 16.0;
+            break;
+
+        case MAXIMUM:
+            nextValue   = 64.0;
+            secondValue = 48.0;
+            break;
+
+        case AVERAGE:
+            nextValue   = 32.0;
+            secondValue = 32.0;
+            break;
+
+        case SUM:
+            nextValue   = 96.0;
+            secondValue = 64.0;
+            break;
+    }
+
+    columns.clear();
+    values.clear();
+    columns.push_back(prevRank(rank));
+    values.push_back(nextValue);
+    if (secondPrevRank(rank) >= 0)
+    {
+        columns.push_back(secondPrevRank(rank));
+        values.push_back(secondValue);
+        if (columns[1] < columns[0])
+        {
+            swap(columns[0], columns[1]);
+            swap(values[0], values[1]);
+        }
+    }
+}
+
+
+// Reads the CSR file written by write_csr_matrix() for a matrix with
+// @p numRows rows.  Returns false if the file cannot be read or its size
+// does not match the number of non-zero elements given by the row offsets.
+bool
+readCsrFile(const string&      filename,
+            int                numRows,
+            vector< int64_t >& offsets,
+            vector< int >&     columns,
+            vector< double >&  values)
+{
+    ifstream file(filename.c_str(), ios::in | ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    offsets.resize(numRows + 1);
+    file.read(reinterpret_cast< char* >(&offsets[0]),
+              offsets.size() * sizeof(int64_t));
+
+    const int64_t nnz = offsets.back();
+    columns.resize(nnz);
+    values.resize(nnz);
+    if (nnz > 0)
+    {
+        file.read(reinterpret_cast< char* >(&columns[0]),
+                  nnz * sizeof(int));
+        file.read(reinterpret_cast< char* >(&values[0]),
+                  nnz * sizeof(double));
+    }
+
+    // Any trailing data indicates inconsistent offsets
+    return file && (file.peek() == char_traits< char >::eof());
+}
+}    // unnamed namespace
+
+
+// --- SalsaCallback tests --------------------------------------------------
+
+TEST(SalsaCallbackT,
+     getResults_messageLengths_returnsDenseStatistics)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    const Replay         replay;
+    const SalsaCallback& callbacks = replay.getCallbacks();
+
+    const modes allModes[] = { MINIMUM, MAXIMUM, AVERAGE, SUM };
+    for (size_t i = 0; i < sizeof(allModes) / sizeof(allModes[0]); ++i)
+    {
+        SCOPED_TRACE(allModes[i]);
+
+        vector< int >    columns;
+        vector< double > values;
+        expectedRow(mpiRank, allModes[i], columns, values);
+
+        vector< double > expected(mpiSize, 0.0);
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+            expected[columns[j]] = values[j];
+        }
+
+        vector< double > row;
+        callbacks.get_results(LENGTH, allModes[i], row);
+        EXPECT_EQ(expected, row);
+    }
+
+    vector< double > row;
+    callbacks.get_results(COUNT, SUM, row);
+    ASSERT_EQ(size_t(mpiSize), row.size());
+    EXPECT_EQ(numNextSizes, row[prevRank(mpiRank)]);
+    if (secondPrevRank(mpiRank) >= 0)
+    {
+        EXPECT_EQ(numSecondSizes, row[secondPrevRank(mpiRank)]);
+    }
+}
+
+
+TEST(SalsaCallbackT,
+     getResults_zeroByteMessage_countsZeroAsMinimum)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    const Replay replay;
+
+    // A zero-byte message received between larger ones determines the
+    // minimum, regardless of the order of arrival
+    vector< double > row;
+    replay.getCallbacks().get_results(LENGTH, MINIMUM, row);
+    EXPECT_EQ(0.0, row[prevRank(mpiRank)]);
+}
+
+
+TEST(SalsaCallbackT,
+     getSparseResults_messageLengths_returnsSendersInAscendingOrder)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    const Replay replay;
+
+    const modes allModes[] = { MINIMUM, MAXIMUM, AVERAGE, SUM };
+    for (size_t i = 0; i < sizeof(allModes) / sizeof(allModes[0]); ++i)
+    {
+        SCOPED_TRACE(allModes[i]);
+
+        vector< int >    expectedColumns;
+        vector< double > expectedValues;
+        expectedRow(mpiRank, allModes[i], expectedColumns, expectedValues);
+
+        vector< int >    columns;
+        vector< double > values;
+        replay.getCallbacks().get_sparse_results(LENGTH, allModes[i],
+                                                 columns, values);
+        EXPECT_EQ(expectedColumns, columns);
+        EXPECT_EQ(expectedValues, values);
+    }
+}
+
+
+// --- write_csr_matrix tests -----------------------------------------------
+
+TEST(SalsaCsrWriterT,
+     writeCsrMatrix_replayResults_writesRowOffsetsColumnsAndValues)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    const Replay     replay;
+    vector< int >    columns;
+    vector< double > values;
+    replay.getCallbacks().get_sparse_results(LENGTH, MINIMUM, columns,
+                                             values);
+
+    const string filename = testDirectory + "/replay.csr";
+    ASSERT_TRUE(write_csr_matrix(filename, columns, values, MPI_COMM_WORLD));
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (mpiRank != 0)
+    {
+        return;
+    }
+
+    vector< int64_t > expectedOffsets(1, 0);
+    vector< int >     expectedColumns;
+    vector< double >  expectedValues;
+    for (int r = 0; r < mpiSize; ++r)
+    {
+        vector< int >    rowColumns;
+        vector< double > rowValues;
+        expectedRow(r, MINIMUM, rowColumns, rowValues);
+        expectedColumns.insert(expectedColumns.end(),
+                               rowColumns.begin(), rowColumns.end());
+        expectedValues.insert(expectedValues.end(),
+                              rowValues.begin(), rowValues.end());
+        expectedOffsets.push_back(expectedColumns.size());
+    }
+    vector< int64_t > offsets;
+    vector< int >     fileColumns;
+    vector< double >  fileValues;
+    ASSERT_TRUE(readCsrFile(filename, mpiSize, offsets, fileColumns,
+                            fileValues));
+    EXPECT_EQ(expectedOffsets, offsets);
+    EXPECT_EQ(expectedColumns, fileColumns);
+    EXPECT_EQ(expectedValues, fileValues);
+}
+
+
+TEST(SalsaCsrWriterT,
+     writeCsrMatrix_emptyRows_writesRepeatedRowOffsets)
+{
+    ASSERT_FALSE(testDirectory.empty());
+
+    // Only odd ranks contribute entries: rank r stores the values r and
+    // r + 0.5 in columns 0 and r
+    vector< int >    columns;
+    vector< double > values;
+    if (mpiRank % 2 == 1)
+    {
+        columns.push_back(0);
+        columns.push_back(mpiRank);
+        values.push_back(mpiRank);
+        values.push_back(mpiRank + 0.5);
+    }
+
+    const string filename = testDirectory + "/empty.csr";
+    ASSERT_TRUE(write_csr_matrix(filename, columns, values, MPI_COMM_WORLD));
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (mpiRank != 0)
+    {
+        return;
+    }
+
+    vector< int64_t > expectedOffsets(1, 0);
+    vector< int >     expectedColumns;
+    vector< double >  expectedValues;
+    for (int r = 0; r < mpiSize; ++r)
+    {
+        if (r % 2 == 1)
+        {
+            expectedColumns.push_back(0);
+            expectedColumns.push_back(r);
+            expectedValues.push_back(r);
+            expectedValues.push_back(r + 0.5);
+        }
+        expectedOffsets.push_back(expectedColumns.size());
+    }
+    vector< int64_t > offsets;
+    vector< int >     fileColumns;
+    vector< double >  fileValues;
+    ASSERT_TRUE(readCsrFile(filename, mpiSize, offsets, fileColumns,
+                            fileValues));
+    EXPECT_EQ(expectedOffsets, offsets);
+    EXPECT_EQ(expectedColumns, fileColumns);
+    EXPECT_EQ(expectedValues, fileValues);
+}
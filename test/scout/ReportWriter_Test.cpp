@@ -0,0 +1,669 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "Pattern.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+#include <otf2/otf2.h>
+
+#include <cubew_cube.h>
+
+#include <pearl/Callpath.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/LocationGroup.h>
+#include <pearl/Region.h>
+#include <pearl/String.h>
+#include <pearl/TraceArchive.h>
+#include <pearl/pearl.h>
+
+#include <gtest/gtest.h>
+
+#include "ReportData.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace scout;
+
+
+namespace
+{
+// --- Constants ------------------------------------------------------------
+
+// Region identifiers of the synthetic application
+enum RegionId
+{
+    REGION_MAIN,
+    REGION_SETUP,
+    REGION_SOLVE,
+    REGION_KERNEL,
+    REGION_OUTPUT,
+    NUM_REGIONS
+};
+
+
+// --- Synthetic trace generation -------------------------------------------
+
+// MPI rank of the calling process
+int mpiRank;
+
+// Anchor file name of the trace archive shared by all tests
+string archiveAnchor;
+
+// Directory holding the trace archive and the reports written by the tests
+string testDirectory;
+
+
+OTF2_FlushType
+preFlush(void*            userData,
+         OTF2_FileType    fileType,
+         OTF2_LocationRef location,
+         void*            callerData,
+         bool             final)
+{
+    return OTF2_FLUSH;
+}
+
+
+OTF2_TimeStamp
+postFlush(void*            userData,
+          OTF2_FileType    fileType,
+          OTF2_LocationRef location)
+{
+    return 0;
+}
+
+
+OTF2_FlushCallbacks flushCallbacks = { preFlush, postFlush };
+
+
+// Writes an enter/leave pair of the given region
+void
+visit(OTF2_EvtWriter* writer,
+      uint64_t&       time,
+      uint64_t&       numEvents,
+      RegionId        region)
+{
+    OTF2_EvtWriter_Enter(writer, NULL, time, region);
+    OTF2_EvtWriter_Leave(writer, NULL, time + 10, region);
+    time      += 20;
+    numEvents += 2;
+}
+
+
+// Writes the trace archive of a synthetic application with the given number
+// of ranks to the given directory.  Parts of the call tree are only visited
+// by some of the ranks, so that the unified call tree differs from each of
+// the local ones.
+void
+writeTrace(const string& directory,
+           int           numRanks)
+{
+    OTF2_Archive* archive = OTF2_Archive_Open(directory.c_str(), "traces",
+                                              OTF2_FILEMODE_WRITE,
+                                              1024 * 1024, 4 * 1024 * 1024,
+                                              OTF2_SUBSTRATE_POSIX,
+                                              OTF2_COMPRESSION_NONE);
+    OTF2_Archive_SetFlushCallbacks(archive, &flushCallbacks, NULL);
+    OTF2_Archive_SetSerialCollectiveCallbacks(archive);
+
+    vector< uint64_t > numEvents(numRanks, 0);
+    uint64_t           endTime = 0;
+    OTF2_Archive_OpenEvtFiles(archive);
+    for (int r = 0; r < numRanks; ++r)
+    {
+        OTF2_EvtWriter* writer = OTF2_Archive_GetEvtWriter(archive, r);
+        uint64_t        time   = 1000;
+
+        OTF2_EvtWriter_Enter(writer, NULL, time, REGION_MAIN);
+        numEvents[r]++;
+        visit(writer, time, numEvents[r], REGION_SETUP);
+
+        OTF2_EvtWriter_Enter(writer, NULL, time, REGION_SOLVE);
+        numEvents[r]++;
+        for (int i = 0; i <= r % 3; ++i)
+        {
+            visit(writer, time, numEvents[r], REGION_KERNEL);
+        }
+        if (r % 2 == 1)
+        {
+            visit(writer, time, numEvents[r], REGION_OUTPUT);
+        }
+        OTF2_EvtWriter_Leave(writer, NULL, time, REGION_SOLVE);
+        numEvents[r]++;
+
+        if (r == numRanks - 1)
+        {
+            visit(writer, time, numEvents[r], REGION_OUTPUT);
+        }
+        OTF2_EvtWriter_Leave(writer, NULL, time, REGION_MAIN);
+        numEvents[r]++;
+
+        endTime = max(endTime, time);
+        OTF2_Archive_CloseEvtWriter(archive, writer);
+    }
+    OTF2_Archive_CloseEvtFiles(archive);
+
+    OTF2_Archive_OpenDefFiles(archive);
+    for (int r = 0; r < numRanks; ++r)
+    {
+        OTF2_DefWriter* writer = OTF2_Archive_GetDefWriter(archive, r);
+        OTF2_Archive_CloseDefWriter(archive, writer);
+    }
+    OTF2_Archive_CloseDefFiles(archive);
+
+    static const char* const regionNames[NUM_REGIONS] = {
+        "main", "setup", "solve", "kernel", "output"
+    };
+
+    // Strings: region names, followed by the fixed strings below and the
+    // location group names
+    const uint32_t STRING_EMPTY  = NUM_REGIONS;
+    const uint32_t STRING_THREAD = NUM_REGIONS + 1;
+    const uint32_t STRING_NODE   = NUM_REGIONS + 2;
+    const uint32_t STRING_RANK   = NUM_REGIONS + 3;
+
+    OTF2_GlobalDefWriter* writer = OTF2_Archive_GetGlobalDefWriter(archive);
+    OTF2_GlobalDefWriter_WriteClockProperties(writer, 1000000000, 0,
+                                              endTime + 1);
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        OTF2_GlobalDefWriter_WriteString(writer, i, regionNames[i]);
+    }
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_EMPTY, "");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_THREAD, "Master thread");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_NODE, "node");
+    for (int r = 0; r < numRanks; ++r)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "MPI Rank %d", r);
+        OTF2_GlobalDefWriter_WriteString(writer, STRING_RANK + r, name);
+    }
+    for (uint32_t i = 0; i < NUM_REGIONS; ++i)
+    {
+        OTF2_GlobalDefWriter_WriteRegion(writer, i, i, i, STRING_EMPTY,
+                                         OTF2_REGION_ROLE_FUNCTION,
+                                         OTF2_PARADIGM_USER,
+                                         OTF2_REGION_FLAG_NONE,
+                                         STRING_EMPTY, 0, 0);
+    }
+    OTF2_GlobalDefWriter_WriteSystemTreeNode(writer, 0, STRING_NODE,
+                                             STRING_NODE,
+                                             OTF2_UNDEFINED_SYSTEM_TREE_NODE);
+    for (int r = 0; r < numRanks; ++r)
+    {
+        OTF2_GlobalDefWriter_WriteLocationGroup(writer, r, STRING_RANK + r,
+                                                OTF2_LOCATION_GROUP_TYPE_PROCESS,
+                                                0);
+        OTF2_GlobalDefWriter_WriteLocation(writer, r, STRING_THREAD,
+                                           OTF2_LOCATION_TYPE_CPU_THREAD,
+                                           numEvents[r], r);
+    }
+    OTF2_Archive_CloseGlobalDefWriter(archive, writer);
+
+    OTF2_Archive_Close(archive);
+}
+
+
+// Recursively removes the given directory
+void
+removeDirectory(const string& path)
+{
+    DIR* directory = opendir(path.c_str());
+    if (directory == NULL)
+    {
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL)
+    {
+        const string name(entry->d_name);
+        if (  (name == ".")
+           || (name == ".."))
+        {
+            continue;
+        }
+
+        const string child = path + "/" + name;
+        struct stat  info;
+        if (  (lstat(child.c_str(), &info) == 0)
+           && S_ISDIR(info.st_mode))
+        {
+            removeDirectory(child);
+        }
+        else
+        {
+            unlink(child.c_str());
+        }
+    }
+    closedir(directory);
+    rmdir(path.c_str());
+}
+
+
+// Initializes PEARL and writes the trace archive shared by all tests to a
+// temporary directory, which is removed again afterwards
+class ScoutEnvironment
+    : public Environment
+{
+    public:
+        virtual void
+        SetUp()
+        {
+            int numRanks;
+            MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+            MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+            PEARL_mpi_init();
+
+            char directory[] = "scout_Test.XXXXXX";
+            if (mpiRank == 0)
+            {
+                if (mkdtemp(directory) == NULL)
+                {
+                    directory[0] = '\0';
+                }
+                else
+                {
+                    writeTrace(directory, numRanks);
+                }
+            }
+            MPI_Bcast(directory, sizeof(directory), MPI_CHAR, 0,
+                      MPI_COMM_WORLD);
+
+            testDirectory = directory;
+            if (!testDirectory.empty())
+            {
+                archiveAnchor = testDirectory + "/traces.otf2";
+            }
+        }
+
+        virtual void
+        TearDown()
+        {
+            MPI_Barrier(MPI_COMM_WORLD);
+            if (  (mpiRank == 0)
+               && !testDirectory.empty())
+            {
+                removeDirectory(testDirectory);
+            }
+            PEARL_finalize();
+        }
+};
+
+
+Environment* const scoutEnvironment =
+    AddGlobalTestEnvironment(new ScoutEnvironment);
+
+
+// --- Helpers --------------------------------------------------------------
+
+// Experiment data read from the synthetic trace archive, with the call tree
+// unified the same way as in the SCOUT main program
+class Experiment
+{
+    public:
+        Experiment()
+            : mArchive(TraceArchive::open(archiveAnchor)),
+              mDefs(mArchive->getDefinitions()),
+              mTrace(0)
+        {
+            const LocationGroup& process = mDefs->getLocationGroup(mpiRank);
+
+            mArchive->openTraceContainer(process);
+            mTrace = mArchive->getTrace(*mDefs, process.getLocation(0));
+            mArchive->closeTraceContainer();
+
+            PEARL_verify_calltree(*mDefs, *mTrace);
+            PEARL_mpi_unify_calltree(*mDefs);
+        }
+
+        ~Experiment()
+        {
+            delete mTrace;
+            delete mDefs;
+            delete mArchive;
+        }
+
+        const GlobalDefs&
+        getDefinitions() const
+        {
+            return *mDefs;
+        }
+
+        const LocalTrace&
+        getTrace() const
+        {
+            return *mTrace;
+        }
+
+
+    private:
+        TraceArchive* mArchive;
+        GlobalDefs*   mDefs;
+        LocalTrace*   mTrace;
+};
+
+
+// Pattern providing rank- and call path-dependent severities, some of which
+// are zero or missing.  Values of time-based metrics have a fractional part.
+class TestPattern
+    : public Pattern
+{
+    public:
+        TestPattern(long              id,
+                    const string&     unit,
+                    const string&     dataType,
+                    const GlobalDefs& defs)
+            : mId(id),
+              mUnit(unit),
+              mDataType(dataType)
+        {
+            const uint32_t numCallpaths = defs.numCallpaths();
+            for (uint32_t i = 0; i < numCallpaths; ++i)
+            {
+                if ((i + mpiRank + id) % 4 == 0)
+                {
+                    continue;
+                }
+
+                double value = (mpiRank + 1) * (i + id) * 3;
+                if (unit == "sec")
+                {
+                    value += 0.375 * (i + 1) / (mpiRank + 1);
+                }
+                m_severity[defs.get_cnode(i)] = value;
+            }
+        }
+
+        virtual long
+        get_id() const
+        {
+            return mId;
+        }
+
+        virtual string
+        get_name() const
+        {
+            return "Test metric";
+        }
+
+        virtual string
+        get_unique_name() const
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "test_%ld", mId);
+
+            return name;
+        }
+
+        virtual string
+        get_descr() const
+        {
+            return "Synthetic test metric";
+        }
+
+        virtual string
+        get_unit() const
+        {
+            return mUnit;
+        }
+
+        virtual CubeMetricType
+        get_mode() const
+        {
+            return CUBE_METRIC_EXCLUSIVE;
+        }
+
+        const string&
+        getDataType() const
+        {
+            return mDataType;
+        }
+
+
+    private:
+        long   mId;
+        string mUnit;
+        string mDataType;
+};
+
+
+// Defines the static parts of the CUBE report on rank 0, equivalent to the
+// definitions written by the ReportWriterTask
+void
+defineReport(ReportData&                  data,
+             const GlobalDefs&            defs,
+             const vector< TestPattern* >& patterns)
+{
+    cube_system_tree_node* node = cube_def_system_tree_node(data.cb, "node", "",
+                                                             "machine", NULL);
+    for (uint32_t r = 0; r < defs.numLocationGroups(); ++r)
+    {
+        const LocationGroup& group  = defs.getLocationGroup(r);
+        cube_location_group* cgroup =
+            cube_def_location_group(data.cb,
+                                    group.getName().getCString(), r,
+                                    CUBE_LOCATION_GROUP_TYPE_PROCESS, node);
+        for (uint32_t t = 0; t < group.numLocations(); ++t)
+        {
+            const Location& location = group.getLocation(t);
+
+            data.locs[location.getId()] =
+                cube_def_location(data.cb,
+                                  location.getName().getCString(), t,
+                                  CUBE_LOCATION_TYPE_CPU_THREAD, cgroup);
+        }
+    }
+
+    for (uint32_t i = 0; i < defs.numRegions(); ++i)
+    {
+        const Region& region = defs.getRegion(i);
+        const char*   name   = region.getDisplayName().getCString();
+
+        data.regions.push_back(cube_def_region(data.cb, name, name, "user",
+                                               "function", -1, -1, "", "",
+                                               ""));
+    }
+
+    for (uint32_t i = 0; i < defs.numCallpaths(); ++i)
+    {
+        const Callpath& callpath = defs.getCallpathByIndex(i);
+        Callpath*       parent   = callpath.getParent();
+
+        data.cnodes.push_back(cube_def_cnode(data.cb,
+                                             data.regions[callpath.getRegion().getId()],
+                                             parent
+                                             ? data.cnodes[parent->getId()]
+                                             : NULL));
+    }
+
+    for (size_t i = 0; i < patterns.size(); ++i)
+    {
+        const TestPattern* pattern = patterns[i];
+
+        data.metrics[pattern->get_id()] =
+            cube_def_met(data.cb,
+                         pattern->get_name().c_str(),
+                         pattern->get_unique_name().c_str(),
+                         pattern->getDataType().c_str(),
+                         pattern->get_unit().c_str(),
+                         "", "",
+                         pattern->get_descr().c_str(),
+                         NULL,
+                         pattern->get_mode());
+    }
+}
+
+
+// Writes a report with the given base name, using the given collation
+// settings (see ReportData).  Returns whether the severities have been
+// written in parallel by the aggregator ranks.
+bool
+writeReport(const Experiment& experiment,
+            const string&     name,
+            size_t            batchBytes,
+            uint32_t          numWriters)
+{
+    const GlobalDefs& defs     = experiment.getDefinitions();
+    const string      basename = testDirectory + "/" + name;
+
+    ReportData data(defs, mpiRank, batchBytes, numWriters);
+
+    vector< TestPattern* > patterns;
+    patterns.push_back(new TestPattern(1, "sec", "FLOAT", defs));
+    patterns.push_back(new TestPattern(2, "occ", "INTEGER", defs));
+    patterns.push_back(new TestPattern(3, "sec", "INTEGER", defs));
+    patterns.push_back(new TestPattern(4, "bytes", "UINT64", defs));
+
+    int error = 0;
+    if (mpiRank == 0)
+    {
+        data.cb = cube_create(const_cast< char* >(basename.c_str()),
+                              CUBE_MASTER, CUBE_FALSE);
+        if (data.cb == NULL)
+        {
+            error = 1;
+        }
+        else
+        {
+            defineReport(data, defs, patterns);
+        }
+    }
+    MPI_Bcast(&error, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (error)
+    {
+        ADD_FAILURE() << "Could not create report " << basename;
+
+        return false;
+    }
+
+    // Open report file on aggregators, as done by the ReportWriterTask
+    if (data.mAggregatorComm != MPI_COMM_NULL)
+    {
+        const string filename = basename + ".cubex";
+        if (MPI_File_open(data.mAggregatorComm,
+                          const_cast< char* >(filename.c_str()),
+                          MPI_MODE_WRONLY, MPI_INFO_NULL, &data.mWriterFile)
+            != MPI_SUCCESS)
+        {
+            error = 1;
+        }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    EXPECT_EQ(0, error);
+
+    const bool parallel = (data.mWriterStride > 0);
+    for (size_t i = 0; i < patterns.size(); ++i)
+    {
+        patterns[i]->gen_severities(data, mpiRank, experiment.getTrace());
+        delete patterns[i];
+    }
+
+    if (data.mWriterFile != MPI_FILE_NULL)
+    {
+        MPI_File_close(&data.mWriterFile);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (mpiRank == 0)
+    {
+        cube_free(data.cb);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    return parallel;
+}
+
+
+// Reads the given report file, with the modification times and checksums
+// of all tar headers cleared, as these depend on the time of writing
+vector< char >
+readReport(const string& name)
+{
+    ifstream       stream((testDirectory + "/" + name + ".cubex").c_str(),
+                          ios::binary);
+    vector< char > contents((istreambuf_iterator< char >(stream)),
+                            istreambuf_iterator< char >());
+
+    const size_t BLOCK_SIZE   = 512;
+    const size_t MTIME_OFFSET = 136;
+    const size_t MTIME_END    = 156;    // includes checksum
+    const size_t MAGIC_OFFSET = 257;
+    for (size_t block = 0;
+         block + BLOCK_SIZE <= contents.size();
+         block += BLOCK_SIZE)
+    {
+        if (string(&contents[block + MAGIC_OFFSET], 5) == "ustar")
+        {
+            fill(contents.begin() + block + MTIME_OFFSET,
+                 contents.begin() + block + MTIME_END, '\0');
+        }
+    }
+
+    return contents;
+}
+}    // unnamed namespace
+
+
+// --- ReportWriter tests ---------------------------------------------------
+
+TEST(ReportWriterT, parallel_writers_match_serial_report)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    int numRanks;
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    Experiment experiment;
+    EXPECT_FALSE(writeReport(experiment, "serial", 0, 0));
+    EXPECT_FALSE(writeReport(experiment, "batched", 64, 0));
+
+    // Use single, uneven, and one-rank-per-group writer configurations
+    const uint32_t writers[] = { 1, 3, static_cast< uint32_t >(numRanks) };
+    for (size_t i = 0; i < sizeof(writers) / sizeof(writers[0]); ++i)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "writers%u", writers[i]);
+
+        EXPECT_TRUE(writeReport(experiment, name, 0, writers[i]));
+        if (mpiRank == 0)
+        {
+            const vector< char > expected = readReport("serial");
+            const vector< char > actual   = readReport(name);
+
+            ASSERT_FALSE(expected.empty());
+            EXPECT_EQ(expected.size(), actual.size()) << name;
+            EXPECT_TRUE(expected == actual) << name;
+        }
+    }
+
+    if (mpiRank == 0)
+    {
+        EXPECT_TRUE(readReport("serial") == readReport("batched"));
+    }
+}
@@ -0,0 +1,173 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "ReenactModel.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <pearl/CallbackManager.h>
+#include <pearl/Callpath.h>
+#include <pearl/Event.h>
+#include <pearl/Event_rep.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Region.h>
+#include <pearl/String.h>
+
+#include <gtest/gtest.h>
+
+#include "ReenactCallbackData.h"
+#include "SyntheticTrace.h"
+#include "VirtualTimeModel.h"
+#include "silas_events.h"
+#include "silas_replay.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace silas;
+
+
+// --- Helpers --------------------------------------------------------------
+
+namespace
+{
+// Runs the preparation step of the given model on @p trace and returns
+// the actions assigned to the individual events
+vector< int >
+prepare(LocalTrace& trace,
+        Model&      model)
+{
+    silas::CallbackData data(trace.get_definitions(), trace, model);
+    CallbackManager     cbmanager;
+
+    model.register_callbacks(0, &cbmanager);
+    cbmanager.notify(START, trace.begin(), &data);
+    SILAS_forward_replay(trace, cbmanager, &data,
+                         model.get_run_configuration()[0].mincbevent);
+    cbmanager.notify(FINISHED, trace.begin(), &data);
+
+    vector< int > result;
+    for (Event event = trace.begin(); event != trace.end(); ++event)
+    {
+        result.push_back(data.get_action(event));
+    }
+
+    return result;
+}
+
+
+// Verifies the actions assigned by the preparation step: communication
+// events are skipped, and the replay of each MPI call is triggered by the
+// corresponding LEAVE event
+void
+expectPreparedActions(LocalTrace&          trace,
+                      const Model&         model,
+                      const vector< int >& actions)
+{
+    const int skip = model.is_set("aggregate idle")
+                     ? silas::AGGREGATE_IGNORE
+                     : silas::SKIP;
+
+    map< string, int > exitActions;
+    exitActions["MPI_Send"]    = silas::SEND;
+    exitActions["MPI_Recv"]    = silas::RECV;
+    exitActions["MPI_Isend"]   = silas::ISEND;
+    exitActions["MPI_Irecv"]   = silas::IRECV;
+    exitActions["MPI_Waitall"] = silas::WAITALL;
+
+    map< int, int > numActions;
+    for (Event event = trace.begin(); event != trace.end(); ++event)
+    {
+        const int     action = actions[event.get_id()];
+        const string& region =
+            event.get_cnode()->getRegion().getCanonicalName().getString();
+        SCOPED_TRACE(event.get_id());
+
+        ++numActions[action];
+        switch (event->getType())
+        {
+            case MPI_SEND:
+            case MPI_RECV:
+            case MPI_SEND_REQUEST:
+            case MPI_RECV_REQUEST:
+            case MPI_SEND_COMPLETE:
+            case MPI_RECV_COMPLETE:
+                EXPECT_EQ(skip, action) << region;
+                break;
+
+            case MPI_COLLECTIVE_END:
+                EXPECT_EQ(silas::ALLREDUCE, action);
+                break;
+
+            case LEAVE:
+                if (exitActions.count(region))
+                {
+                    EXPECT_EQ(exitActions[region], action) << region;
+                    break;
+                }
+            // Fall through
+
+            default:
+                EXPECT_TRUE(  (action == silas::BEGIN)
+                           || (action == silas::END)
+                           || (action == silas::NOOP)
+                           || (action == silas::IDLE)
+                           || (action == silas::IDLE_WRITE))
+                    << region << ": " << action;
+                break;
+        }
+    }
+
+    EXPECT_EQ(NUM_ITERATIONS, numActions[silas::SEND]);
+    EXPECT_EQ(NUM_ITERATIONS, numActions[silas::RECV]);
+    EXPECT_EQ(NUM_ITERATIONS, numActions[silas::ISEND]);
+    EXPECT_EQ(NUM_ITERATIONS, numActions[silas::IRECV]);
+    EXPECT_EQ(NUM_ITERATIONS, numActions[silas::WAITALL]);
+    EXPECT_EQ(NUM_ITERATIONS, numActions[silas::ALLREDUCE]);
+    EXPECT_EQ(1, numActions[silas::BEGIN]);
+    EXPECT_EQ(1, numActions[silas::END]);
+}
+}    // unnamed namespace
+
+
+// --- ReenactModel tests ---------------------------------------------------
+
+TEST(ReenactModelT,
+     prepare_mpiEvents_assignsActionByEventType)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    Experiment   experiment;
+    LocalTrace&  trace = experiment.getTrace();
+    ReenactModel model;
+
+    expectPreparedActions(trace, model, prepare(trace, model));
+}
+
+
+TEST(ReenactModelT,
+     prepare_virtualTimeModel_assignsSameActions)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    // The virtual-time model inherits the preparation step; its
+    // deterministic mode does not affect the actions of this trace
+    Experiment       experiment;
+    LocalTrace&      trace = experiment.getTrace();
+    VirtualTimeModel model;
+
+    expectPreparedActions(trace, model, prepare(trace, model));
+}
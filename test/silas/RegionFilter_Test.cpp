@@ -0,0 +1,222 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "RegionFilter.h"
+
+#include <string>
+
+#include <pearl/Paradigm.h>
+#include <pearl/Region.h>
+#include <pearl/String.h>
+
+#include <gtest/gtest.h>
+
+#include "HypBalance.h"
+#include "HypScale.h"
+#include "MutableGlobalDefs.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace pearl::detail;
+using namespace silas;
+
+
+// --- Helper ---------------------------------------------------------------
+
+namespace
+{
+// Region identifiers of the test definitions
+enum RegionId
+{
+    REGION_MPI_SEND,
+    REGION_MPI_SENDRECV,
+    REGION_MPI_RECV,
+    REGION_MY_MPI_SEND,
+    REGION_FOO,
+    REGION_FOOBAR,
+    REGION_BAR,
+    NUM_REGIONS
+};
+
+// Region names, indexed by region identifier
+const char* const regionNames[NUM_REGIONS] = {
+    "MPI_Send",
+    "MPI_Sendrecv",
+    "MPI_Recv",
+    "my_MPI_Send",
+    "foo",
+    "foobar",
+    "bar"
+};
+
+
+// Test fixture for RegionFilter tests
+class RegionFilterT
+    : public Test
+{
+    public:
+        RegionFilterT();
+
+
+    protected:
+        MutableGlobalDefs mDefs;
+        RegionFilter      mFilter;
+};
+}    // unnamed namespace
+
+
+// --- RegionFilter tests ---------------------------------------------------
+
+TEST_F(RegionFilterT,
+       empty_newFilter_returnsTrue)
+{
+    EXPECT_TRUE(mFilter.empty());
+
+    mFilter.resolve(mDefs);
+    for (uint32_t id = 0; id < NUM_REGIONS; ++id)
+    {
+        EXPECT_FALSE(mFilter.is_selected(id));
+    }
+}
+
+
+TEST_F(RegionFilterT,
+       addName_exactName_selectsOnlyThatRegion)
+{
+    mFilter.add_name("MPI_Send", 2.0);
+    EXPECT_FALSE(mFilter.empty());
+
+    mFilter.resolve(mDefs);
+    for (uint32_t id = 0; id < NUM_REGIONS; ++id)
+    {
+        EXPECT_EQ(id == REGION_MPI_SEND, mFilter.is_selected(id))
+            << regionNames[id];
+    }
+    EXPECT_EQ(2.0, mFilter.get_value(REGION_MPI_SEND));
+}
+
+
+TEST_F(RegionFilterT,
+       addPattern_literal_matchesEntireNameOnly)
+{
+    ASSERT_TRUE(mFilter.add_pattern("MPI_Send", 1.0));
+    ASSERT_TRUE(mFilter.add_pattern("foo", 1.0));
+    EXPECT_FALSE(mFilter.empty());
+
+    // Neither prefix ("MPI_Sendrecv", "foobar") nor suffix ("my_MPI_Send")
+    // matches are accepted
+    mFilter.resolve(mDefs);
+    EXPECT_TRUE(mFilter.is_selected(REGION_MPI_SEND));
+    EXPECT_FALSE(mFilter.is_selected(REGION_MPI_SENDRECV));
+    EXPECT_FALSE(mFilter.is_selected(REGION_MY_MPI_SEND));
+    EXPECT_TRUE(mFilter.is_selected(REGION_FOO));
+    EXPECT_FALSE(mFilter.is_selected(REGION_FOOBAR));
+    EXPECT_FALSE(mFilter.is_selected(REGION_MPI_RECV));
+    EXPECT_FALSE(mFilter.is_selected(REGION_BAR));
+}
+
+
+TEST_F(RegionFilterT,
+       addPattern_wildcard_matchesEntireName)
+{
+    ASSERT_TRUE(mFilter.add_pattern("MPI_.*", 1.0));
+
+    mFilter.resolve(mDefs);
+    EXPECT_TRUE(mFilter.is_selected(REGION_MPI_SEND));
+    EXPECT_TRUE(mFilter.is_selected(REGION_MPI_SENDRECV));
+    EXPECT_TRUE(mFilter.is_selected(REGION_MPI_RECV));
+    EXPECT_FALSE(mFilter.is_selected(REGION_MY_MPI_SEND));
+}
+
+
+TEST_F(RegionFilterT,
+       addPattern_alternation_anchorsAllBranches)
+{
+    // Without grouping, "^foo|bar$" would also match "foobar"
+    ASSERT_TRUE(mFilter.add_pattern("foo|bar", 1.0));
+    ASSERT_TRUE(mFilter.add_pattern("MPI_(Send|Recv)", 1.0));
+
+    mFilter.resolve(mDefs);
+    EXPECT_TRUE(mFilter.is_selected(REGION_FOO));
+    EXPECT_TRUE(mFilter.is_selected(REGION_BAR));
+    EXPECT_FALSE(mFilter.is_selected(REGION_FOOBAR));
+    EXPECT_TRUE(mFilter.is_selected(REGION_MPI_SEND));
+    EXPECT_TRUE(mFilter.is_selected(REGION_MPI_RECV));
+    EXPECT_FALSE(mFilter.is_selected(REGION_MPI_SENDRECV));
+    EXPECT_FALSE(mFilter.is_selected(REGION_MY_MPI_SEND));
+}
+
+
+TEST_F(RegionFilterT,
+       resolve_overlappingSelections_usesPrecedence)
+{
+    ASSERT_TRUE(mFilter.add_pattern("MPI_.*", 2.0));
+    ASSERT_TRUE(mFilter.add_pattern("MPI_Send.*", 3.0));
+    mFilter.add_name("MPI_Send", 4.0);
+
+    // Exact names take precedence, then the first matching pattern
+    mFilter.resolve(mDefs);
+    EXPECT_EQ(4.0, mFilter.get_value(REGION_MPI_SEND));
+    EXPECT_EQ(2.0, mFilter.get_value(REGION_MPI_SENDRECV));
+    EXPECT_EQ(2.0, mFilter.get_value(REGION_MPI_RECV));
+}
+
+
+TEST_F(RegionFilterT,
+       addPattern_invalidRegex_returnsFalse)
+{
+    EXPECT_FALSE(mFilter.add_pattern("MPI_(Send", 1.0));
+    EXPECT_FALSE(mFilter.add_pattern("foo[", 1.0));
+    EXPECT_TRUE(mFilter.empty());
+
+    mFilter.resolve(mDefs);
+    for (uint32_t id = 0; id < NUM_REGIONS; ++id)
+    {
+        EXPECT_FALSE(mFilter.is_selected(id));
+    }
+}
+
+
+TEST_F(RegionFilterT,
+       registerRegionPattern_invalidRegex_reportsError)
+{
+    // The configuration parser raises a syntax error if a hypothesis
+    // rejects a region pattern
+    HypScale   rescaler;
+    HypBalance balancer;
+
+    EXPECT_FALSE(rescaler.register_region_pattern("MPI_(Send", 0.5));
+    EXPECT_FALSE(balancer.register_region_pattern("MPI_(Send"));
+    EXPECT_TRUE(rescaler.register_region_pattern("MPI_(Send|Recv)", 0.5));
+    EXPECT_TRUE(balancer.register_region_pattern("MPI_(Send|Recv)"));
+}
+
+
+// --- Helper ---------------------------------------------------------------
+
+namespace
+{
+RegionFilterT::RegionFilterT()
+{
+    for (uint32_t id = 0; id < NUM_REGIONS; ++id)
+    {
+        String* const name = new String(id, regionNames[id]);
+        mDefs.addString(name);
+        mDefs.addRegion(new Region(id, *name, *name, String::UNDEFINED,
+                                   Region::ROLE_FUNCTION, Paradigm::USER,
+                                   String::UNDEFINED, 0, 0));
+    }
+}
+}    // unnamed namespace
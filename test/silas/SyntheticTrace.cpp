@@ -0,0 +1,568 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "SyntheticTrace.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+#include <otf2/otf2.h>
+
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/LocationGroup.h>
+#include <pearl/TraceArchive.h>
+#include <pearl/pearl.h>
+
+#include <gtest/gtest.h>
+
+#include "HypBalance.h"
+#include "HypCutMessage.h"
+#include "HypScale.h"
+#include "Hypothesis.h"
+#include "Model.h"
+#include "Simulator.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace silas;
+
+
+// --- Symbols provided by the SILAS main program ---------------------------
+
+int mpiRank;
+
+
+void
+log(const char* fmt,
+    ...)
+{
+}
+
+
+// Anchor file name of the trace archive shared by all tests
+string archiveAnchor;
+
+
+namespace
+{
+// --- Constants ------------------------------------------------------------
+
+// Region identifiers of the synthetic application
+enum RegionId
+{
+    REGION_MAIN,
+    REGION_INIT,
+    REGION_FINALIZE,
+    REGION_COMPUTE,
+    REGION_IRECV,
+    REGION_ISEND,
+    REGION_WAITALL,
+    REGION_SEND,
+    REGION_RECV,
+    REGION_ALLREDUCE
+};
+
+
+// --- Synthetic trace generation -------------------------------------------
+
+OTF2_FlushType
+preFlush(void*            userData,
+         OTF2_FileType    fileType,
+         OTF2_LocationRef location,
+         void*            callerData,
+         bool             final)
+{
+    return OTF2_FLUSH;
+}
+
+
+OTF2_TimeStamp
+postFlush(void*            userData,
+          OTF2_FileType    fileType,
+          OTF2_LocationRef location)
+{
+    return 0;
+}
+
+
+OTF2_FlushCallbacks flushCallbacks = { preFlush, postFlush };
+
+
+// Per-rank state while writing the event streams
+struct RankWriter
+{
+    OTF2_EvtWriter* writer;
+    uint64_t        time;
+    uint64_t        numEvents;
+    uint64_t        sendTime;
+};
+
+
+void
+enter(RankWriter& rank,
+      RegionId    region)
+{
+    OTF2_EvtWriter_Enter(rank.writer, NULL, rank.time, region);
+    rank.time += 10;
+    rank.numEvents++;
+}
+
+
+void
+leave(RankWriter& rank,
+      RegionId    region)
+{
+    rank.time += 10;
+    OTF2_EvtWriter_Leave(rank.writer, NULL, rank.time, region);
+    rank.numEvents++;
+}
+
+
+// Writes the event streams of a synthetic MPI application with the given
+// number of ranks.  Each iteration consists of a computation phase with
+// rank-dependent duration, a non-blocking and a zero-byte blocking message
+// ring, and an allreduce.  Returns the end time of the application.
+uint64_t
+writeEvents(OTF2_Archive*         archive,
+            vector< RankWriter >& ranks)
+{
+    const int numRanks = ranks.size();
+
+    for (int r = 0; r < numRanks; ++r)
+    {
+        ranks[r].writer    = OTF2_Archive_GetEvtWriter(archive, r);
+        ranks[r].time      = 1000;
+        ranks[r].numEvents = 0;
+
+        enter(ranks[r], REGION_MAIN);
+        enter(ranks[r], REGION_INIT);
+        ranks[r].time += 100 * r;
+        leave(ranks[r], REGION_INIT);
+    }
+
+    for (int it = 0; it < NUM_ITERATIONS; ++it)
+    {
+        const uint64_t recvRequest = 2 * it + 1;
+        const uint64_t sendRequest = 2 * it + 2;
+
+        for (int r = 0; r < numRanks; ++r)
+        {
+            RankWriter& rank = ranks[r];
+
+            enter(rank, REGION_COMPUTE);
+            rank.time += 1000 * (1 + (r + it) % numRanks);
+            leave(rank, REGION_COMPUTE);
+
+            enter(rank, REGION_IRECV);
+            OTF2_EvtWriter_MpiIrecvRequest(rank.writer, NULL, rank.time,
+                                           recvRequest);
+            rank.numEvents++;
+            leave(rank, REGION_IRECV);
+
+            enter(rank, REGION_ISEND);
+            rank.sendTime = rank.time;
+            OTF2_EvtWriter_MpiIsend(rank.writer, NULL, rank.time,
+                                    (r + 1) % numRanks, 0, it, 64,
+                                    sendRequest);
+            rank.numEvents++;
+            leave(rank, REGION_ISEND);
+        }
+        for (int r = 0; r < numRanks; ++r)
+        {
+            RankWriter&       rank   = ranks[r];
+            const int         source = (r + numRanks - 1) % numRanks;
+            const RankWriter& sender = ranks[source];
+
+            enter(rank, REGION_WAITALL);
+            rank.time = max(rank.time, sender.sendTime + 500);
+            OTF2_EvtWriter_MpiIsendComplete(rank.writer, NULL, rank.time,
+                                            sendRequest);
+            OTF2_EvtWriter_MpiIrecv(rank.writer, NULL, rank.time,
+                                    source, 0, it, 64, recvRequest);
+            rank.numEvents += 2;
+            leave(rank, REGION_WAITALL);
+        }
+
+        for (int r = 0; r < numRanks; ++r)
+        {
+            RankWriter& rank = ranks[r];
+
+            enter(rank, REGION_SEND);
+            rank.sendTime = rank.time;
+            OTF2_EvtWriter_MpiSend(rank.writer, NULL, rank.time,
+                                   (r + 1) % numRanks, 0, 100 + it, 0);
+            rank.numEvents++;
+            leave(rank, REGION_SEND);
+        }
+        for (int r = 0; r < numRanks; ++r)
+        {
+            RankWriter&       rank   = ranks[r];
+            const int         source = (r + numRanks - 1) % numRanks;
+            const RankWriter& sender = ranks[source];
+
+            enter(rank, REGION_RECV);
+            rank.time = max(rank.time, sender.sendTime + 500);
+            OTF2_EvtWriter_MpiRecv(rank.writer, NULL, rank.time,
+                                   source, 0, 100 + it, 0);
+            rank.numEvents++;
+            leave(rank, REGION_RECV);
+        }
+
+        uint64_t latest = 0;
+        for (int r = 0; r < numRanks; ++r)
+        {
+            enter(ranks[r], REGION_ALLREDUCE);
+            OTF2_EvtWriter_MpiCollectiveBegin(ranks[r].writer, NULL,
+                                              ranks[r].time);
+            ranks[r].numEvents++;
+            latest = max(latest, ranks[r].time);
+        }
+        for (int r = 0; r < numRanks; ++r)
+        {
+            ranks[r].time = latest + 500;
+            OTF2_EvtWriter_MpiCollectiveEnd(ranks[r].writer, NULL,
+                                            ranks[r].time,
+                                            OTF2_COLLECTIVE_OP_ALLREDUCE,
+                                            0, OTF2_UNDEFINED_UINT32, 8, 8);
+            ranks[r].numEvents++;
+            leave(ranks[r], REGION_ALLREDUCE);
+        }
+    }
+
+    uint64_t endTime = 0;
+    for (int r = 0; r < numRanks; ++r)
+    {
+        enter(ranks[r], REGION_FINALIZE);
+        leave(ranks[r], REGION_FINALIZE);
+        leave(ranks[r], REGION_MAIN);
+        endTime = max(endTime, ranks[r].time);
+
+        OTF2_Archive_CloseEvtWriter(archive, ranks[r].writer);
+    }
+
+    return endTime;
+}
+
+
+// Writes the global definitions of the synthetic MPI application
+void
+writeDefinitions(OTF2_Archive*               archive,
+                 const vector< RankWriter >& ranks,
+                 uint64_t                    endTime)
+{
+    static const char* const regionNames[] = {
+        "main", "MPI_Init", "MPI_Finalize", "compute", "MPI_Irecv",
+        "MPI_Isend", "MPI_Waitall", "MPI_Send", "MPI_Recv", "MPI_Allreduce"
+    };
+    const uint32_t numRegions = sizeof(regionNames) / sizeof(regionNames[0]);
+    const uint32_t numRanks   = ranks.size();
+
+    OTF2_GlobalDefWriter* writer = OTF2_Archive_GetGlobalDefWriter(archive);
+    OTF2_GlobalDefWriter_WriteClockProperties(writer, 1000000000, 0,
+                                              endTime + 1);
+
+    // Strings: region names, followed by the fixed strings below and the
+    // location group names
+    const uint32_t STRING_EMPTY  = numRegions;
+    const uint32_t STRING_THREAD = numRegions + 1;
+    const uint32_t STRING_MPI    = numRegions + 2;
+    const uint32_t STRING_NODE   = numRegions + 3;
+    const uint32_t STRING_WORLD  = numRegions + 4;
+    const uint32_t STRING_RANK   = numRegions + 5;
+    for (uint32_t i = 0; i < numRegions; ++i)
+    {
+        OTF2_GlobalDefWriter_WriteString(writer, i, regionNames[i]);
+    }
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_EMPTY, "");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_THREAD, "Master thread");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_MPI, "MPI");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_NODE, "node");
+    OTF2_GlobalDefWriter_WriteString(writer, STRING_WORLD, "MPI_COMM_WORLD");
+    for (uint32_t r = 0; r < numRanks; ++r)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "MPI Rank %u", r);
+        OTF2_GlobalDefWriter_WriteString(writer, STRING_RANK + r, name);
+    }
+
+    OTF2_GlobalDefWriter_WriteParadigm(writer, OTF2_PARADIGM_MPI, STRING_MPI,
+                                       OTF2_PARADIGM_CLASS_PROCESS);
+    for (uint32_t i = 0; i < numRegions; ++i)
+    {
+        const bool isUser = (i == REGION_MAIN) || (i == REGION_COMPUTE);
+
+        OTF2_RegionRole role = OTF2_REGION_ROLE_POINT2POINT;
+        if (isUser)
+        {
+            role = OTF2_REGION_ROLE_FUNCTION;
+        }
+        else if ((i == REGION_INIT) || (i == REGION_FINALIZE))
+        {
+            role = OTF2_REGION_ROLE_ARTIFICIAL;
+        }
+        else if (i == REGION_ALLREDUCE)
+        {
+            role = OTF2_REGION_ROLE_COLL_ALL2ALL;
+        }
+
+        OTF2_GlobalDefWriter_WriteRegion(writer, i, i, i, STRING_EMPTY, role,
+                                         isUser
+                                         ? OTF2_PARADIGM_USER
+                                         : OTF2_PARADIGM_MPI,
+                                         OTF2_REGION_FLAG_NONE,
+                                         isUser ? STRING_EMPTY : STRING_MPI,
+                                         0, 0);
+    }
+
+    OTF2_GlobalDefWriter_WriteSystemTreeNode(writer, 0, STRING_NODE,
+                                             STRING_NODE,
+                                             OTF2_UNDEFINED_SYSTEM_TREE_NODE);
+    vector< uint64_t > members(numRanks);
+    for (uint32_t r = 0; r < numRanks; ++r)
+    {
+        OTF2_GlobalDefWriter_WriteLocationGroup(writer, r, STRING_RANK + r,
+                                                OTF2_LOCATION_GROUP_TYPE_PROCESS,
+                                                0);
+        OTF2_GlobalDefWriter_WriteLocation(writer, r, STRING_THREAD,
+                                           OTF2_LOCATION_TYPE_CPU_THREAD,
+                                           ranks[r].numEvents, r);
+        members[r] = r;
+    }
+    OTF2_GlobalDefWriter_WriteGroup(writer, 0, STRING_EMPTY,
+                                    OTF2_GROUP_TYPE_COMM_LOCATIONS,
+                                    OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE,
+                                    numRanks, &members[0]);
+    OTF2_GlobalDefWriter_WriteGroup(writer, 1, STRING_EMPTY,
+                                    OTF2_GROUP_TYPE_COMM_GROUP,
+                                    OTF2_PARADIGM_MPI, OTF2_GROUP_FLAG_NONE,
+                                    numRanks, &members[0]);
+    OTF2_GlobalDefWriter_WriteComm(writer, 0, STRING_WORLD, 1,
+                                   OTF2_UNDEFINED_COMM);
+
+    OTF2_Archive_CloseGlobalDefWriter(archive, writer);
+}
+
+
+// Writes the trace archive of the synthetic MPI application to the given
+// directory
+void
+writeTrace(const string& directory,
+           int           numRanks)
+{
+    OTF2_Archive* archive = OTF2_Archive_Open(directory.c_str(), "traces",
+                                              OTF2_FILEMODE_WRITE,
+                                              1024 * 1024, 4 * 1024 * 1024,
+                                              OTF2_SUBSTRATE_POSIX,
+                                              OTF2_COMPRESSION_NONE);
+    OTF2_Archive_SetFlushCallbacks(archive, &flushCallbacks, NULL);
+    OTF2_Archive_SetSerialCollectiveCallbacks(archive);
+
+    vector< RankWriter > ranks(numRanks);
+    OTF2_Archive_OpenEvtFiles(archive);
+    const uint64_t endTime = writeEvents(archive, ranks);
+    OTF2_Archive_CloseEvtFiles(archive);
+
+    OTF2_Archive_OpenDefFiles(archive);
+    for (int r = 0; r < numRanks; ++r)
+    {
+        OTF2_DefWriter* writer = OTF2_Archive_GetDefWriter(archive, r);
+        OTF2_Archive_CloseDefWriter(archive, writer);
+    }
+    OTF2_Archive_CloseDefFiles(archive);
+
+    writeDefinitions(archive, ranks, endTime);
+    OTF2_Archive_Close(archive);
+}
+
+
+// Recursively removes the given directory
+void
+removeDirectory(const string& path)
+{
+    DIR* directory = opendir(path.c_str());
+    if (directory == NULL)
+    {
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL)
+    {
+        const string name(entry->d_name);
+        if (  (name == ".")
+           || (name == ".."))
+        {
+            continue;
+        }
+
+        const string child = path + "/" + name;
+        struct stat  info;
+        if (  (lstat(child.c_str(), &info) == 0)
+           && S_ISDIR(info.st_mode))
+        {
+            removeDirectory(child);
+        }
+        else
+        {
+            unlink(child.c_str());
+        }
+    }
+    closedir(directory);
+    rmdir(path.c_str());
+}
+
+
+// Initializes PEARL and writes the trace archive shared by all tests to a
+// temporary directory, which is removed again afterwards
+class SilasEnvironment
+    : public Environment
+{
+    public:
+        virtual void
+        SetUp()
+        {
+            int numRanks;
+            MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+            MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+            PEARL_mpi_init();
+
+            char directory[] = "silas_Test.XXXXXX";
+            if (mpiRank == 0)
+            {
+                if (mkdtemp(directory) == NULL)
+                {
+                    directory[0] = '\0';
+                }
+                else
+                {
+                    writeTrace(directory, numRanks);
+                }
+            }
+            MPI_Bcast(directory, sizeof(directory), MPI_CHAR, 0,
+                      MPI_COMM_WORLD);
+
+            mDirectory = directory;
+            if (!mDirectory.empty())
+            {
+                archiveAnchor = mDirectory + "/traces.otf2";
+            }
+        }
+
+        virtual void
+        TearDown()
+        {
+            MPI_Barrier(MPI_COMM_WORLD);
+            if (  (mpiRank == 0)
+               && !mDirectory.empty())
+            {
+                removeDirectory(mDirectory);
+            }
+            PEARL_finalize();
+        }
+
+
+    private:
+        string mDirectory;
+};
+
+
+Environment* const silasEnvironment =
+    AddGlobalTestEnvironment(new SilasEnvironment);
+}    // unnamed namespace
+
+
+// --- Experiment -----------------------------------------------------------
+
+Experiment::Experiment()
+    : mArchive(TraceArchive::open(archiveAnchor)),
+      mDefs(mArchive->getDefinitions()),
+      mTrace(0)
+{
+    const LocationGroup& process = mDefs->getLocationGroup(mpiRank);
+
+    mArchive->openTraceContainer(process);
+    mTrace = mArchive->getTrace(*mDefs, process.getLocation(0));
+    mArchive->closeTraceContainer();
+
+    PEARL_verify_calltree(*mDefs, *mTrace);
+    PEARL_mpi_unify_calltree(*mDefs);
+    PEARL_preprocess_trace(*mDefs, *mTrace);
+}
+
+
+Experiment::~Experiment()
+{
+    delete mTrace;
+    delete mDefs;
+    delete mArchive;
+}
+
+
+LocalTrace&
+Experiment::getTrace()
+{
+    return *mTrace;
+}
+
+
+// --- Simulation helpers ---------------------------------------------------
+
+// Creates the given hypothesis, equipped with all hypothesis parts like
+// the ones created by the SILAS main program
+Hypothesis*
+createHypothesis(HypothesisId id)
+{
+    Hypothesis* result   = new Hypothesis("test");
+    HypBalance* balancer = new HypBalance();
+    HypScale*   rescaler = new HypScale();
+
+    if (id == HYPOTHESIS_BALANCE_COMPUTE)
+    {
+        balancer->register_region("compute");
+    }
+    else if (id == HYPOTHESIS_SCALE_COMPUTE)
+    {
+        rescaler->register_region("compute", 0.5);
+    }
+
+    result->add_part(balancer);
+    result->add_part(new HypCutMessage());
+    result->add_part(rescaler);
+
+    return result;
+}
+
+
+void
+simulate(LocalTrace&  trace,
+         Model*       model,
+         HypothesisId id)
+{
+    Simulator        simulator(trace, model);
+    const Hypothesis* hypothesis = createHypothesis(id);
+
+    simulator.run(*hypothesis);
+    delete hypothesis;
+}
@@ -0,0 +1,95 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SILAS_TEST_SYNTHETICTRACE_H
+#define SILAS_TEST_SYNTHETICTRACE_H
+
+
+#include <string>
+
+
+namespace pearl
+{
+class GlobalDefs;
+class LocalTrace;
+class TraceArchive;
+}    // namespace pearl
+
+
+namespace silas
+{
+class Hypothesis;
+class Model;
+}    // namespace silas
+
+
+// --- Synthetic trace shared by the SILAS tests ----------------------------
+//
+// The trace archive is written by a global test environment before the
+// first test runs.  On each rank, the synthetic MPI application performs
+// NUM_ITERATIONS iterations, each consisting of a computation phase with
+// rank-dependent duration, a non-blocking message ring (MPI_Irecv/
+// MPI_Isend/MPI_Waitall), a zero-byte blocking message ring (MPI_Send/
+// MPI_Recv, rank r sends to rank r+1), and an MPI_Allreduce.
+
+// Number of iterations of the synthetic application
+const int NUM_ITERATIONS = 4;
+
+// Hypotheses simulated by the tests
+enum HypothesisId
+{
+    HYPOTHESIS_BALANCE_COMPUTE,
+    HYPOTHESIS_SCALE_COMPUTE,
+    HYPOTHESIS_IDENTITY,
+    NUM_HYPOTHESES
+};
+
+
+// Anchor file name of the synthetic trace archive; empty if the archive
+// could not be written
+extern std::string archiveAnchor;
+
+
+// Experiment data read from the synthetic trace archive and preprocessed
+// the same way as in the SILAS main program
+class Experiment
+{
+    public:
+        Experiment();
+
+        ~Experiment();
+
+        pearl::LocalTrace&
+        getTrace();
+
+
+    private:
+        pearl::TraceArchive* mArchive;
+        pearl::GlobalDefs*   mDefs;
+        pearl::LocalTrace*   mTrace;
+};
+
+
+// Creates the given hypothesis, equipped with all hypothesis parts like
+// the ones created by the SILAS main program
+silas::Hypothesis*
+createHypothesis(HypothesisId id);
+
+// Runs a full simulation of the given hypothesis on @p trace; takes
+// ownership of @p model
+void
+simulate(pearl::LocalTrace& trace,
+         silas::Model*      model,
+         HypothesisId       id);
+
+
+#endif    // !SILAS_TEST_SYNTHETICTRACE_H
@@ -0,0 +1,181 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "TraceSnapshot.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <pearl/Event.h>
+#include <pearl/Event_rep.h>
+#include <pearl/LocalTrace.h>
+
+#include <gtest/gtest.h>
+
+#include "ReenactModel.h"
+#include "SyntheticTrace.h"
+#include "VirtualTimeModel.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace silas;
+
+
+namespace
+{
+// --- Helpers --------------------------------------------------------------
+
+// Event data compared between traces
+struct EventRecord
+{
+    event_t     type;
+    timestamp_t timestamp;
+    uint64_t    requestId;
+};
+
+
+typedef vector< EventRecord > TraceRecord;
+
+
+TraceRecord
+recordTrace(const LocalTrace& trace)
+{
+    TraceRecord result;
+    for (Event event = trace.begin(); event != trace.end(); ++event)
+    {
+        EventRecord record;
+        record.type      = event->getType();
+        record.timestamp = event->getTimestamp();
+        record.requestId = event->isOfType(GROUP_NONBLOCK)
+                           ? event->getRequestId()
+                           : PEARL_NO_REQUEST;
+
+        result.push_back(record);
+    }
+
+    return result;
+}
+
+
+void
+expectEqualRecords(const TraceRecord& expected,
+                   const TraceRecord& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(expected[i].type, actual[i].type)
+            << "at event " << i;
+        ASSERT_EQ(expected[i].timestamp, actual[i].timestamp)
+            << "at event " << i;
+        ASSERT_EQ(expected[i].requestId, actual[i].requestId)
+            << "at event " << i;
+    }
+}
+}    // unnamed namespace
+
+
+// --- TraceSnapshot tests --------------------------------------------------
+
+TEST(TraceSnapshotT,
+     restore_modifiedEventData_restoresOriginalTrace)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    Experiment        experiment;
+    LocalTrace&       trace    = experiment.getTrace();
+    const TraceRecord original = recordTrace(trace);
+
+    const TraceSnapshot snapshot(trace);
+
+    // Apply the same kinds of modifications as the ReenactModel: swap two
+    // completion events and their request IDs, and delete an event
+    Event send = trace.begin();
+    while (  (send != trace.end())
+          && !send->isOfType(MPI_SEND_COMPLETE))
+    {
+        ++send;
+    }
+    ASSERT_TRUE(send != trace.end());
+    const Event recv = send.next();
+    ASSERT_TRUE(recv->isOfType(MPI_RECV_COMPLETE));
+
+    const uint64_t requestId = send->getRequestId();
+    send->setRequestId(recv->getRequestId());
+    recv->setRequestId(requestId);
+    trace.swap(send, recv);
+    trace.begin().next()->setTimestamp(-1);
+
+    snapshot.restore(trace);
+
+    expectEqualRecords(original, recordTrace(trace));
+}
+
+
+TEST(TraceSnapshotT,
+     restore_afterReenactSimulation_restoresOriginalTrace)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    Experiment        experiment;
+    LocalTrace&       trace    = experiment.getTrace();
+    const TraceRecord original = recordTrace(trace);
+
+    const TraceSnapshot snapshot(trace);
+    simulate(trace, new ReenactModel(), HYPOTHESIS_BALANCE_COMPUTE);
+    snapshot.restore(trace);
+
+    expectEqualRecords(original, recordTrace(trace));
+}
+
+
+TEST(TraceSnapshotT,
+     restore_batchOfHypotheses_matchesIndividualSimulations)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    // Simulate all hypotheses on the same trace data, as done by SILAS in
+    // batch mode
+    vector< TraceRecord > batch;
+    {
+        Experiment          experiment;
+        LocalTrace&         trace = experiment.getTrace();
+        const TraceSnapshot snapshot(trace);
+
+        for (int id = 0; id < NUM_HYPOTHESES; ++id)
+        {
+            if (id > 0)
+            {
+                snapshot.restore(trace);
+            }
+            simulate(trace, new VirtualTimeModel(),
+                     static_cast< HypothesisId >(id));
+            batch.push_back(recordTrace(trace));
+        }
+    }
+
+    // Simulate each hypothesis alone on a freshly read trace
+    for (int id = 0; id < NUM_HYPOTHESES; ++id)
+    {
+        Experiment  experiment;
+        LocalTrace& trace = experiment.getTrace();
+
+        simulate(trace, new VirtualTimeModel(),
+                 static_cast< HypothesisId >(id));
+
+        SCOPED_TRACE(id);
+        expectEqualRecords(batch[id], recordTrace(trace));
+    }
+}
@@ -0,0 +1,136 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2021                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+
+#include "VirtualTimeModel.h"
+
+#include <vector>
+
+#include <mpi.h>
+
+#include <pearl/Event.h>
+#include <pearl/Event_rep.h>
+#include <pearl/LocalTrace.h>
+
+#include <gtest/gtest.h>
+
+#include "SyntheticTrace.h"
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace silas;
+
+
+// --- Helpers --------------------------------------------------------------
+
+namespace
+{
+// Network parameters used by the tests; the latency is several orders of
+// magnitude larger than any duration in the synthetic trace
+const double LATENCY  = 1.0;
+const double OVERHEAD = 1.0e-3;
+
+
+// Returns the timestamps of all events of the given type in @p trace
+vector< double >
+timestamps(const LocalTrace& trace,
+           event_t           type)
+{
+    vector< double > result;
+    for (Event event = trace.begin(); event != trace.end(); ++event)
+    {
+        if (event->isOfType(type))
+        {
+            result.push_back(event->getTimestamp());
+        }
+    }
+
+    return result;
+}
+}    // unnamed namespace
+
+
+// --- VirtualTimeModel tests -----------------------------------------------
+
+TEST(VirtualTimeModelT,
+     simulate_blockingRing_receivesAfterSendPlusCost)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    Experiment  experiment;
+    LocalTrace& trace = experiment.getTrace();
+
+    VirtualTimeModel* model = new VirtualTimeModel();
+    model->set_option("network latency", "1.0");
+    model->set_option("network overhead", "1.0e-3");
+    simulate(trace, model, HYPOTHESIS_IDENTITY);
+
+    // Rank r sends the zero-byte messages of the blocking ring to rank r+1
+    int rank;
+    int numRanks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    vector< double > sends = timestamps(trace, MPI_SEND);
+    vector< double > recvs = timestamps(trace, MPI_RECV);
+    ASSERT_EQ(size_t(NUM_ITERATIONS), sends.size());
+    ASSERT_EQ(size_t(NUM_ITERATIONS), recvs.size());
+
+    vector< double > partnerSends(NUM_ITERATIONS);
+    MPI_Sendrecv(&sends[0], NUM_ITERATIONS, MPI_DOUBLE,
+                 (rank + 1) % numRanks, 0,
+                 &partnerSends[0], NUM_ITERATIONS, MPI_DOUBLE,
+                 (rank + numRanks - 1) % numRanks, 0,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    // The sender overhead, the latency, and the receiver overhead are
+    // charged on top of the virtual send time
+    for (int i = 0; i < NUM_ITERATIONS; ++i)
+    {
+        SCOPED_TRACE(i);
+        EXPECT_LE(partnerSends[i] + LATENCY + 2 * OVERHEAD - 1.0e-9,
+                  recvs[i]);
+    }
+
+    // Virtual clocks never run backwards
+    double previous = trace.begin()->getTimestamp();
+    for (Event event = trace.begin(); event != trace.end(); ++event)
+    {
+        ASSERT_LE(previous, event->getTimestamp())
+            << "at event " << event.get_id();
+        previous = event->getTimestamp();
+    }
+}
+
+
+TEST(VirtualTimeModelT,
+     simulate_largeLatency_delaysEveryIteration)
+{
+    ASSERT_FALSE(archiveAnchor.empty());
+
+    Experiment  experiment;
+    LocalTrace& trace = experiment.getTrace();
+
+    const double start = trace.begin()->getTimestamp();
+
+    VirtualTimeModel* model = new VirtualTimeModel();
+    model->set_option("network latency", "1.0");
+    model->set_option("network overhead", "1.0e-3");
+    simulate(trace, model, HYPOTHESIS_IDENTITY);
+
+    // Each iteration contains two message rings, which cannot complete
+    // before the first message of the ring has arrived
+    const double duration = trace.rbegin()->getTimestamp() - start;
+    EXPECT_LE(2 * NUM_ITERATIONS * LATENCY, duration);
+}